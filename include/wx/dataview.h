@@ -126,6 +126,10 @@ public:
 
     virtual void Resort() = 0;
 
+    // called around a group of notifications which may be processed at once
+    virtual void BeginBatch() { }
+    virtual void EndBatch() { }
+
     void SetOwner( wxDataViewModel *owner ) { m_owner = owner; }
     wxDataViewModel *GetOwner() const       { return m_owner; }
 
@@ -185,6 +189,103 @@ private:
 };
 
 
+// ---------------------------------------------------------
+// wxDataViewSortKey
+// ---------------------------------------------------------
+
+// The value used for sorting an item, see wxDataViewModel::GetSortKeys().
+class WXDLLIMPEXP_CORE wxDataViewSortKey
+{
+public:
+    // Default ctor creates a key without any value, which is less than all
+    // the other keys.
+    wxDataViewSortKey() : m_kind(Kind_None), m_integer(0), m_double(0.) { }
+
+    void SetInteger(wxLongLong_t value)
+    {
+        m_kind = Kind_Integer;
+        m_integer = value;
+    }
+
+    void SetDouble(double value)
+    {
+        m_kind = Kind_Double;
+        m_double = value;
+    }
+
+    void SetString(const wxString& value)
+    {
+        m_kind = Kind_String;
+        m_string = value;
+    }
+
+    bool IsNone() const { return m_kind == Kind_None; }
+
+    // Return negative, zero or positive value depending on whether this key
+    // is less than, equal to or greater than the other one. Numbers are less
+    // than strings and integers and floating point numbers are compared with
+    // each other as numbers.
+    int Compare(const wxDataViewSortKey& other) const
+    {
+        if ( m_kind == other.m_kind )
+        {
+            switch ( m_kind )
+            {
+                case Kind_None:
+                    return 0;
+
+                case Kind_Integer:
+                    return m_integer < other.m_integer
+                            ? -1 : m_integer > other.m_integer;
+
+                case Kind_Double:
+                    return m_double < other.m_double
+                            ? -1 : m_double > other.m_double;
+
+                case Kind_String:
+                    return m_string.Cmp(other.m_string);
+            }
+        }
+
+        if ( IsNumber() && other.IsNumber() )
+        {
+            const double d1 = GetAsDouble(),
+                         d2 = other.GetAsDouble();
+            return d1 < d2 ? -1 : d1 > d2;
+        }
+
+        return m_kind < other.m_kind ? -1 : 1;
+    }
+
+private:
+    bool IsNumber() const
+    {
+        return m_kind == Kind_Integer || m_kind == Kind_Double;
+    }
+
+    double GetAsDouble() const
+    {
+        return m_kind == Kind_Integer ? static_cast<double>(m_integer)
+                                      : m_double;
+    }
+
+    // The order of the elements of this enum determines the order of the keys
+    // of different kinds.
+    enum Kind
+    {
+        Kind_None,
+        Kind_Integer,
+        Kind_Double,
+        Kind_String
+    };
+
+    Kind m_kind;
+    wxLongLong_t m_integer;
+    double m_double;
+    wxString m_string;
+};
+
+
 // ---------------------------------------------------------
 // wxDataViewModel
 // ---------------------------------------------------------
@@ -260,6 +361,12 @@ public:
     bool BeforeReset();
     bool AfterReset();
 
+    // all change notifications between these calls may be processed at once
+    // when the outermost batch ends, the calls can be nested
+    void BeginBatch();
+    void EndBatch();
+    bool IsInBatch() const { return m_batchDepth != 0; }
+
 
     // delegated action
     virtual void Resort();
@@ -272,6 +379,17 @@ public:
                          unsigned int column, bool ascending ) const;
     virtual bool HasDefaultCompare() const { return false; }
 
+    // Fill the keys array with the values allowing to sort the given items by
+    // the given column by comparing them, which is much faster than calling
+    // Compare() for the items. Return false if sort keys are not supported,
+    // as is the case by default, in which case Compare() is used.
+    virtual bool GetSortKeys(const wxDataViewItemArray& WXUNUSED(items),
+                             unsigned int WXUNUSED(column),
+                             wxVector<wxDataViewSortKey>& WXUNUSED(keys)) const
+    {
+        return false;
+    }
+
     // internal
     virtual bool IsListModel() const { return false; }
     virtual bool IsVirtualListModel() const { return false; }
@@ -302,8 +420,19 @@ protected:
         return 0;
     }
 
+    // Helper function which can be used to implement GetSortKeys() in the
+    // derived classes which don't override Compare(): it returns the keys
+    // sorting the items in the same order as the default Compare() does or
+    // false if the column contains values of the types it doesn't handle.
+    bool GetSortKeysFromValues(const wxDataViewItemArray& items,
+                               unsigned int column,
+                               wxVector<wxDataViewSortKey>& keys) const;
+
 private:
     wxDataViewModelNotifiers  m_notifiers;
+
+    // nesting level of BeginBatch() calls
+    unsigned int m_batchDepth;
 };
 
 // ----------------------------------------------------------------------------
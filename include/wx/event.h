@@ -69,6 +69,8 @@ class WXDLLIMPEXP_FWD_BASE wxEventFilter;
 
 class WXDLLIMPEXP_FWD_BASE wxMSVC_FWD_MULTIPLE_BASES wxEvtHandler;
 class wxEventConnectionRef;
+class wxDynamicEventIndex;
+class wxQueuedEventStack;
 
 // ----------------------------------------------------------------------------
 // Event types
@@ -4015,6 +4017,17 @@ protected:
         return true;
     }
 
+    // Overriding this method allows merging the events queued for this
+    // handler: it is called, in the main thread, for a newly queued event if
+    // the last still pending event has the same type and id. If it returns
+    // true, the new event is discarded, so the pending event should be
+    // updated to include any information from it.
+    virtual bool CoalescePendingEvent(wxEvent& WXUNUSED(pending),
+                                      const wxEvent& WXUNUSED(event))
+    {
+        return false;
+    }
+
 
     static const wxEventTable sm_eventTable;
     virtual const wxEventTable *GetEventTable() const;
@@ -4028,8 +4041,16 @@ protected:
     typedef wxVector<wxDynamicEventTableEntry*> DynamicEvents;
     DynamicEvents* m_dynamicEvents;
 
+    // Index of m_dynamicEvents by event type, only created when it contains
+    // enough entries to make searching all of them for each event too slow.
+    wxDynamicEventIndex* m_dynamicEventIndex;
+
     wxList*             m_pendingEvents;
 
+    // Lock-free stack of the events queued by QueueEvent() and not moved to
+    // m_pendingEvents yet, this pointer itself never changes.
+    wxQueuedEventStack* const m_queuedEvents;
+
 #if wxUSE_THREADS
     // critical section protecting m_pendingEvents
     wxCriticalSection m_pendingEventsLock;
@@ -4070,6 +4091,14 @@ private:
     // try to process events in all handlers chained to this one
     bool DoTryChain(wxEvent& event);
 
+    // move the events from m_queuedEvents to m_pendingEvents, must be called
+    // with m_pendingEventsLock held
+    void MoveQueuedEventsToPending();
+
+    // remove this handler from the list of handlers with pending events as
+    // it doesn't have any more of them, also called with the lock held
+    void RemoveFromPendingEventHandlers();
+
     // Head of the event filter linked list.
     static wxEventFilter* ms_filterList;
 
@@ -193,6 +193,13 @@ public:
   void      LineListRemove(wxFileConfigLineList *pLine);
   bool      LineListIsEmpty();
 
+  // parse the line containing an entry of the given group, pLine is the
+  // corresponding line in the linked list or NULL for the global file
+  void ParseEntryLine(wxFileConfigGroup *pGroup,
+                      const wxString& strLine,
+                      size_t n,
+                      wxFileConfigLineList *pLine);
+
 protected:
   virtual bool DoReadString(const wxString& key, wxString *pStr) const override;
   virtual bool DoReadLong(const wxString& key, long *pl) const override;
@@ -218,9 +225,13 @@ private:
   // common part of from dtor and DeleteAll
   void CleanUp();
 
-  // parse the whole file
+  // parse the whole file: notice that the entries of the local file are only
+  // parsed when their group is accessed for the first time
   void Parse(const wxTextBuffer& buffer, bool bLocal);
 
+  // the same as LineListAppend() but without any logging
+  void DoLineListAppend(const wxString& str);
+
   // the same as SetPath("/")
   void SetRootPath();
 
@@ -177,6 +177,26 @@ private:
     friend class wxDataViewHeaderWindowMSW;
 };
 
+// ---------------------------------------------------------
+// wxDataViewUpdateStats
+// ---------------------------------------------------------
+
+// Counters of the updates done by wxDataViewCtrl in response to the model
+// changes, mostly useful for checking the efficiency of batching them.
+struct wxDataViewUpdateStats
+{
+    wxDataViewUpdateStats() : notifications(0), refreshes(0), repaints(0) { }
+
+    // Number of item or value change notifications received from the model.
+    unsigned long notifications;
+
+    // Number of times the changed rows were refreshed.
+    unsigned long refreshes;
+
+    // Number of times the items were actually repainted.
+    unsigned long repaints;
+};
+
 // ---------------------------------------------------------
 // wxDataViewCtrl
 // ---------------------------------------------------------
@@ -304,6 +324,21 @@ public:
     // This method is only available in the generic versions.
     wxHeaderCtrl* GenericGetHeader() const;
 
+    // Enable sorting the items in a background thread when the model provides
+    // sort keys for them, see wxDataViewModel::GetSortKeys(). Returns false if
+    // this is not supported, i.e. if wxUSE_THREADS is 0.
+    //
+    // This method is only available in the generic versions.
+    bool EnableAsyncSort(bool enable = true);
+    bool IsAsyncSortEnabled() const;
+
+    // Return the statistics about the updates of the control since its
+    // creation or the last call to ResetUpdateStats().
+    //
+    // These methods are only available in the generic versions.
+    const wxDataViewUpdateStats& GetUpdateStats() const;
+    void ResetUpdateStats();
+
 protected:
     void EnsureVisibleRowCol( int row, int column );
 
@@ -379,6 +414,10 @@ private:
     void InvalidateColBestWidth(int idx);
     void UpdateColWidths();
 
+    // Update the cached best width of the column after the given item changed
+    // without recomputing it from scratch, if possible.
+    void UpdateColBestWidth(int idx, const wxDataViewItem& item);
+
     void DoClearColumns();
 
     wxVector<wxDataViewColumn*> m_cols;
@@ -386,9 +425,10 @@ private:
     // respective columns from m_cols and the arrays have same size
     struct CachedColWidthInfo
     {
-        CachedColWidthInfo() : width(0), dirty(true) {}
+        CachedColWidthInfo() : width(0), dirty(true), widest(0) {}
         int width;  // cached width or 0 if not computed
         bool dirty; // column was invalidated, header needs updating
+        wxUIntPtr widest; // ID of the widest item or 0 if none
     };
     wxVector<CachedColWidthInfo> m_colsBestWidths;
     // This indicates that at least one entry in m_colsBestWidths has 'dirty'
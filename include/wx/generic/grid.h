@@ -19,6 +19,8 @@
 
 #include "wx/scrolwin.h"
 
+#include <vector>
+
 #if wxUSE_STD_CONTAINERS_COMPATIBLY
     #include <iterator>
 #endif
@@ -931,6 +933,11 @@ public:
     virtual void SetRowAttr(wxGridCellAttr *attr, int row);
     virtual void SetColAttr(wxGridCellAttr *attr, int col);
 
+    // set the same attribute for all rows or columns in the given inclusive
+    // range, this is much more efficient than setting it for each of them
+    virtual void SetRowRangeAttr(wxGridCellAttr *attr, int topRow, int bottomRow);
+    virtual void SetColRangeAttr(wxGridCellAttr *attr, int leftCol, int rightCol);
+
     // these functions must be called whenever some rows/cols are deleted
     // because the internal data must be updated then
     void UpdateAttrRows( size_t pos, int numRows );
@@ -1444,6 +1451,122 @@ private:
 
 
 
+// ------ wxGridColumnarTable
+//
+// Data table storing each column in a single contiguous buffer of values of
+// the column type. This is much more compact than wxGridStringTable for big
+// tables and doesn't create any strings for numeric cells which are not shown
+//
+
+enum wxGridColumnType
+{
+    wxGRID_COLUMN_STRING,
+    wxGRID_COLUMN_LONG,
+    wxGRID_COLUMN_DOUBLE
+};
+
+// maps the strings stored in string columns to their index in the pool
+WX_DECLARE_STRING_HASH_MAP_WITH_DECL( unsigned, wxGridStringPoolIndexMap,
+                                      class WXDLLIMPEXP_CORE );
+
+class WXDLLIMPEXP_CORE wxGridColumnarTable : public wxGridTableBase
+{
+public:
+    wxGridColumnarTable();
+    explicit wxGridColumnarTable( int numRows );
+
+    // add a new column of the given type, all its cells are initially empty
+    bool AppendColumn( wxGridColumnType type,
+                       const wxString& label = wxString() );
+    bool InsertColumn( size_t pos,
+                       wxGridColumnType type,
+                       const wxString& label = wxString() );
+
+    wxGridColumnType GetColumnType( int col ) const;
+
+    // preallocate the storage for the given total number of rows
+    void ReserveRows( size_t numRows );
+
+    // return the number of distinct non-empty strings in all string columns
+    size_t GetStringPoolSize() const { return m_pool.size() - 1; }
+
+    // these are pure virtual in wxGridTableBase
+    //
+    virtual int GetNumberRows() override { return static_cast<int>(m_numRows); }
+    virtual int GetNumberCols() override { return static_cast<int>(m_columns.size()); }
+    virtual wxString GetValue( int row, int col ) override;
+    virtual void SetValue( int row, int col, const wxString& s ) override;
+
+    // overridden functions from wxGridTableBase
+    //
+    bool IsEmptyCell( int row, int col ) override;
+
+    wxString GetTypeName( int row, int col ) override;
+    bool CanGetValueAs( int row, int col, const wxString& typeName ) override;
+    long GetValueAsLong( int row, int col ) override;
+    double GetValueAsDouble( int row, int col ) override;
+    void SetValueAsLong( int row, int col, long value ) override;
+    void SetValueAsDouble( int row, int col, double value ) override;
+
+    void Clear() override;
+    bool InsertRows( size_t pos = 0, size_t numRows = 1 ) override;
+    bool AppendRows( size_t numRows = 1 ) override;
+    bool DeleteRows( size_t pos = 0, size_t numRows = 1 ) override;
+    bool InsertCols( size_t pos = 0, size_t numCols = 1 ) override;
+    bool AppendCols( size_t numCols = 1 ) override;
+    bool DeleteCols( size_t pos = 0, size_t numCols = 1 ) override;
+
+    void SetColLabelValue( int col, const wxString& ) override;
+    void SetCornerLabelValue( const wxString& ) override;
+    wxString GetColLabelValue( int col ) override;
+    wxString GetCornerLabelValue() const override;
+
+private:
+    // Only one of the vectors is used, depending on the column type. String
+    // columns store indices into m_pool, with 0 corresponding to the empty
+    // string, while numeric columns use LONG_MIN or NaN for the empty cells.
+    struct Column
+    {
+        wxGridColumnType type;
+        std::vector<long> longs;
+        std::vector<double> doubles;
+        std::vector<unsigned> strings;
+
+        // for the numeric columns only: true for the empty cells, which
+        // store 0 value
+        std::vector<bool> empty;
+
+        // empty if the default label is used
+        wxString label;
+    };
+
+    bool IsValidCell( int row, int col ) const
+    {
+        return row >= 0 && static_cast<size_t>(row) < m_numRows &&
+               col >= 0 && static_cast<size_t>(col) < m_columns.size();
+    }
+
+    // resize the storage of the column to hold exactly m_numRows values
+    void ResizeColumn( Column& column );
+
+    // return the index of the given string in the pool, adding it if needed
+    unsigned InternString( const wxString& s );
+
+    std::vector<Column> m_columns;
+    size_t m_numRows;
+
+    // All the distinct strings used in the string columns, the strings are
+    // never removed from it, except when Clear() is called.
+    std::vector<wxString> m_pool;
+    wxGridStringPoolIndexMap m_poolIndices;
+
+    wxString m_cornerLabel;
+
+    wxDECLARE_DYNAMIC_CLASS_NO_COPY(wxGridColumnarTable);
+};
+
+
+
 // ============================================================================
 //  Grid view classes
 // ============================================================================
@@ -24,9 +24,6 @@
 // array classes
 // ----------------------------------------------------------------------------
 
-WX_DEFINE_ARRAY_WITH_DECL_PTR(wxGridCellAttr *, wxArrayAttrs,
-                                 class WXDLLIMPEXP_ADV);
-
 WX_DECLARE_HASH_MAP_WITH_DECL(wxLongLong_t, wxGridCellAttr*,
                               wxIntegerHash, wxIntegerEqual,
                               wxGridCoordsToAttrMap, class WXDLLIMPEXP_CORE);
@@ -439,6 +436,11 @@ private:
 };
 
 // this class stores attributes set for rows or columns
+//
+// The attributes are stored as a sorted vector of non-overlapping ranges, so
+// that finding the attribute of the given row or column is logarithmic in the
+// number of ranges and setting the same attribute for many consecutive rows
+// or columns only needs a single element.
 class WXDLLIMPEXP_ADV wxGridRowOrColAttrData
 {
 public:
@@ -446,13 +448,46 @@ public:
     wxGridRowOrColAttrData() {}
     ~wxGridRowOrColAttrData();
 
-    void SetAttr(wxGridCellAttr *attr, int rowOrCol);
+    void SetAttr(wxGridCellAttr *attr, int rowOrCol)
+    {
+        SetRangeAttr(attr, rowOrCol, rowOrCol);
+    }
+
+    void SetRangeAttr(wxGridCellAttr *attr, int first, int last);
     wxGridCellAttr *GetAttr(int rowOrCol) const;
     void UpdateAttrRowsOrCols( size_t pos, int numRowsOrCols );
 
 private:
-    wxArrayInt m_rowsOrCols;
-    wxArrayAttrs m_attrs;
+    // all rows or columns from first to last, inclusive, use this attribute
+    // and each range holds its own reference to it
+    struct Range
+    {
+        Range(int first_, int last_, wxGridCellAttr *attr_)
+            : first(first_), last(last_), attr(attr_)
+        {
+        }
+
+        int first,
+            last;
+        wxGridCellAttr *attr;
+    };
+
+    typedef std::vector<Range> Ranges;
+
+    // return the index of the first range ending at or after the given
+    // row or column, i.e. the range containing it or the range after it
+    size_t FindRange(int rowOrCol) const;
+
+    // split the range with the given index in two, so that the second one
+    // starts at the given row or column, and return the index of the second
+    size_t SplitRange(size_t n, int rowOrCol);
+
+    // remove the attributes of all rows or columns from first to last and
+    // return the index at which the ranges were removed
+    size_t ClearRange(int first, int last);
+
+    // sorted by position and never overlapping
+    Ranges m_ranges;
 };
 
 // NB: this is just a wrapper around 3 objects: one which stores cell
@@ -19,6 +19,8 @@
 #include "wx/timer.h"
 #include "wx/settings.h"
 
+#include "wx/generic/private/widthcalc.h"
+
 // ============================================================================
 // private classes
 // ============================================================================
@@ -30,13 +32,46 @@
 struct wxColWidthInfo
 {
     int     nMaxWidth;
-    bool    bNeedsUpdate;   //  only set to true when an item whose
-                            //  width == nMaxWidth is removed
+    bool    bNeedsUpdate;   //  only set to true when the widest item is
+                            //  removed or becomes narrower
+    wxUIntPtr widestKey;    //  the line containing the widest item or 0
 
     wxColWidthInfo(int w = 0, bool needsUpdate = false)
     {
         nMaxWidth = w;
         bNeedsUpdate = needsUpdate;
+        widestKey = 0;
+    }
+
+    // Update the max width after the item in the given line changed to have
+    // the given width.
+    void UpdateWithItem(const void* line, int width)
+    {
+        if ( !bNeedsUpdate &&
+                !wxMaxWidthCalculatorBase::UpdateMaxWidth(nMaxWidth, widestKey,
+                                                          wxPtrToUInt(line),
+                                                          width) )
+        {
+            bNeedsUpdate = true;
+        }
+    }
+
+    // Update the max width before removing the given line.
+    void RemoveItem(const void* line)
+    {
+        if ( widestKey == wxPtrToUInt(line) )
+            bNeedsUpdate = true;
+    }
+
+    // Same as RemoveItem() but for virtual controls, whose lines are reused
+    // and so are identified by their index plus one instead.
+    void RemoveVirtualItem(size_t index)
+    {
+        const wxUIntPtr key = static_cast<wxUIntPtr>(index) + 1;
+        if ( widestKey == key )
+            bNeedsUpdate = true;
+        else if ( widestKey > key )
+            widestKey--; // the following items are shifted by the removal
     }
 };
 
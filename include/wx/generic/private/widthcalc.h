@@ -16,6 +16,10 @@
 #include "wx/log.h"
 #include "wx/timer.h"
 
+#if wxUSE_SYSTEM_OPTIONS
+    #include "wx/sysopt.h"
+#endif // wxUSE_SYSTEM_OPTIONS
+
 // ----------------------------------------------------------------------------
 // wxMaxWidthCalculatorBase: base class for calculating max column width
 // ----------------------------------------------------------------------------
@@ -26,13 +30,20 @@ public:
     // column of which calculate the width
     explicit wxMaxWidthCalculatorBase(size_t column)
         : m_column(column),
-          m_width(0)
+          m_width(0),
+          m_widestKey(0)
     {
     }
 
-    void UpdateWithWidth(int width)
+    // The key identifies the item having this width, it is 0 for the widths
+    // not corresponding to any item, e.g. the column header width.
+    void UpdateWithWidth(int width, wxUIntPtr key = 0)
     {
-        m_width = wxMax(m_width, width);
+        if ( width > m_width )
+        {
+            m_width = width;
+            m_widestKey = key;
+        }
     }
 
     // Update the max with for the expected row
@@ -41,6 +52,31 @@ public:
     int GetMaxWidth() const { return m_width; }
     size_t GetColumn() const { return m_column; }
 
+    // Return the key of the widest item, or 0 if the max width doesn't come
+    // from any item.
+    wxUIntPtr GetWidestKey() const { return m_widestKey; }
+
+    // Update the max width computed before and the key of the widest item
+    // after the item with the given key changed to have the given width.
+    //
+    // Returns false if the max width can't be updated incrementally because
+    // the widest item became narrower and so it must be recomputed.
+    static bool
+    UpdateMaxWidth(int& maxWidth, wxUIntPtr& widestKey, wxUIntPtr key, int width)
+    {
+        if ( width > maxWidth )
+        {
+            maxWidth = width;
+            widestKey = key;
+        }
+        else if ( key == widestKey && key != 0 && width < maxWidth )
+        {
+            return false;
+        }
+
+        return true;
+    }
+
     void
     ComputeBestColumnWidth(size_t count,
                            size_t first_visible,
@@ -56,6 +92,22 @@ public:
         // visible miscalculations, we also include all currently visible items
         // no matter what.  Finally, the value of N is determined dynamically by
         // measuring how much time we spent on the determining item widths so far.
+        //
+        // Alternatively, the number of items to measure can be limited by the
+        // "autosize.max-rows" system option, in which case we measure the
+        // first and last quarter of this number of items and sample the rest
+        // of them uniformly from the entire control, as well as all visible
+        // items.
+
+#if wxUSE_SYSTEM_OPTIONS
+        const int maxRows = wxSystemOptions::GetOptionInt("autosize.max-rows");
+        if ( maxRows > 0 && count > static_cast<size_t>(maxRows) )
+        {
+            ComputeBestColumnWidthFromSample(count, maxRows,
+                                             first_visible, last_visible);
+            return;
+        }
+#endif // wxUSE_SYSTEM_OPTIONS
 
 #if wxUSE_STOPWATCH
         size_t top_part_end = count;
@@ -112,8 +164,43 @@ public:
     }
 
 private:
+    void
+    ComputeBestColumnWidthFromSample(size_t count,
+                                     size_t maxRows,
+                                     size_t first_visible,
+                                     size_t last_visible)
+    {
+        const size_t edge = maxRows / 4;
+
+        size_t row;
+        for ( row = 0; row < edge; row++ )
+            UpdateWithRow(row);
+
+        const size_t bottom_part_start = count - edge;
+        for ( row = bottom_part_start; row < count; row++ )
+            UpdateWithRow(row);
+
+        // Spread the remaining samples over the middle part.
+        const size_t middle = bottom_part_start - edge;
+        const size_t samples = maxRows - 2*edge;
+        for ( size_t n = 0; n < samples; n++ )
+            UpdateWithRow(edge + (n * middle) / samples);
+
+        last_visible = wxMin(last_visible, count);
+        for ( row = first_visible; row < last_visible; row++ )
+            UpdateWithRow(row);
+
+        wxLogTrace("items container",
+                   "determined best size from %zu sampled plus %zu visible "
+                   "items out of %zu total",
+                   maxRows,
+                   last_visible > first_visible ? last_visible - first_visible : 0,
+                   count);
+    }
+
     const size_t m_column;
     int m_width;
+    wxUIntPtr m_widestKey;
 
     wxDECLARE_NO_COPY_CLASS(wxMaxWidthCalculatorBase);
 };
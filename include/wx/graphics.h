@@ -100,6 +100,7 @@ class WXDLLIMPEXP_FWD_CORE wxGraphicsPen;
 class WXDLLIMPEXP_FWD_CORE wxGraphicsBrush;
 class WXDLLIMPEXP_FWD_CORE wxGraphicsFont;
 class WXDLLIMPEXP_FWD_CORE wxGraphicsBitmap;
+class WXDLLIMPEXP_FWD_CORE wxGraphicsDisplayList;
 
 
 /*
@@ -889,6 +890,12 @@ public:
     // draws a rounded rectangle
     virtual void DrawRoundedRectangle( wxDouble x, wxDouble y, wxDouble w, wxDouble h, wxDouble radius);
 
+    // fills all the rectangles with the current brush
+    virtual void FillRectangles( size_t n, const wxRect2DDouble *rects);
+
+    // draws the marker path translated to each of the points as a single shape
+    virtual void DrawMarkers( size_t n, const wxPoint2DDouble *points, const wxGraphicsPath& marker);
+
      // wrappers using wxPoint2DDouble TODO
 
     // helper to determine if a 0.5 offset should be applied for the drawing operation
@@ -945,10 +952,62 @@ private:
     wxWindow* const m_window;
     double m_contentScaleFactor;
 
+    // Needs to save and restore the current pen, brush and font.
+    friend class wxGraphicsDisplayList;
+
     wxDECLARE_NO_COPY_CLASS(wxGraphicsContext);
     wxDECLARE_ABSTRACT_CLASS(wxGraphicsContext);
 };
 
+//
+// A display list records the drawing commands issued on a special context and
+// allows to replay them later, possibly many times, on any other context using
+// the same renderer.
+//
+
+class wxGraphicsDisplayListData;
+
+class WXDLLIMPEXP_CORE wxGraphicsDisplayList
+{
+public:
+    wxGraphicsDisplayList();
+    ~wxGraphicsDisplayList();
+
+    // Create a context appending all the drawing commands issued on it to
+    // this list. The context must be deleted before the list itself.
+    wxGraphicsContext* CreateRecordingContext(wxDouble width = 0,
+                                              wxDouble height = 0,
+                                              wxGraphicsRenderer* renderer = NULL);
+
+    // Replay all the recorded commands on the given context, using its
+    // current transformation matrix as the origin.
+    void Replay(wxGraphicsContext& gc) const;
+
+    // Replay only the drawing commands affecting the given area, specified in
+    // the coordinates used when recording.
+    void Replay(wxGraphicsContext& gc, const wxRect2DDouble& area) const;
+
+    // Discard all the recorded commands.
+    void Clear();
+
+    bool IsEmpty() const { return GetCount() == 0; }
+
+    // Return the number of recorded commands.
+    size_t GetCount() const;
+
+    // Return the rectangle containing everything drawn by the commands in this
+    // list, in the coordinates used when recording. The result may be larger
+    // than the area actually drawn and is empty if nothing was drawn.
+    wxRect2DDouble GetBoundingBox() const;
+
+private:
+    void DoReplay(wxGraphicsContext& gc, const wxRect2DDouble* area) const;
+
+    wxGraphicsDisplayListData* const m_data;
+
+    wxDECLARE_NO_COPY_CLASS(wxGraphicsDisplayList);
+};
+
 #if 0
 
 //
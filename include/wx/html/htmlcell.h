@@ -25,6 +25,10 @@ class WXDLLIMPEXP_FWD_HTML wxHtmlLinkInfo;
 class WXDLLIMPEXP_FWD_HTML wxHtmlCell;
 class WXDLLIMPEXP_FWD_HTML wxHtmlContainerCell;
 
+class wxHtmlContainerIndex;
+class wxHtmlStateChange;
+class wxHtmlTextExtentCacheImpl;
+
 
 // wxHtmlSelection is data holder with information about text selection.
 // Selection is defined by two positions (beginning and end of the selection)
@@ -277,6 +281,11 @@ public:
                                int WXUNUSED(x), int WXUNUSED(y),
                                wxHtmlRenderingInfo& WXUNUSED(info)) {}
 
+    // Returns true if DrawInvisible() must be called for this cell when it is
+    // not visible. Cells which don't override DrawInvisible() should return
+    // false from here, which allows the containers to skip them entirely.
+    virtual bool NeedsDrawInvisible() const { return true; }
+
     // This method returns pointer to the FIRST cell for that
     // the condition
     // is true. It first checks if the condition is true for this
@@ -410,6 +419,48 @@ protected:
 
 
 
+// ----------------------------------------------------------------------------
+// wxHtmlTextExtentCache
+//                  Remembers the extents of the words measured by the parser,
+//                  as the same words are typically used many times.
+// ----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_HTML wxHtmlTextExtentCache
+{
+public:
+    // At most maxPerFont strings are remembered for each font, the least
+    // recently used ones are discarded when this limit is exceeded.
+    explicit wxHtmlTextExtentCache(size_t maxPerFont = 4096);
+    ~wxHtmlTextExtentCache();
+
+    // Must be called before measuring text with the given DC: discards all
+    // the cached extents if it doesn't measure text in the same way as the
+    // previously used DC.
+    void UseDC(const wxDC& dc);
+
+    // Same as wxDC::GetTextExtent() using the current font of the DC.
+    void GetTextExtent(const wxDC& dc, const wxString& text,
+                       wxCoord *width, wxCoord *height,
+                       wxCoord *descent = NULL);
+
+    // Discard all the cached extents.
+    void Clear();
+
+    // Number of GetTextExtent() calls which could or couldn't use the cache.
+    size_t GetHitCount() const { return m_hits; }
+    size_t GetMissCount() const { return m_misses; }
+    void ResetCounters() { m_hits = m_misses = 0; }
+
+private:
+    wxHtmlTextExtentCacheImpl *m_impl;
+
+    size_t m_hits,
+           m_misses;
+
+    wxDECLARE_NO_COPY_CLASS(wxHtmlTextExtentCache);
+};
+
+
 // ----------------------------------------------------------------------------
 // Inherited cells:
 // ----------------------------------------------------------------------------
@@ -423,12 +474,15 @@ protected:
 class WXDLLIMPEXP_HTML wxHtmlWordCell : public wxHtmlCell
 {
 public:
-    wxHtmlWordCell(const wxString& word, const wxDC& dc);
+    // If the cache is specified, it is used for measuring the word.
+    wxHtmlWordCell(const wxString& word, const wxDC& dc,
+                   wxHtmlTextExtentCache *cache = NULL);
     void Draw(wxDC& dc, int x, int y, int view_y1, int view_y2,
               wxHtmlRenderingInfo& info) override;
     virtual wxCursor GetMouseCursor(wxHtmlWindowInterface *window) const override;
     virtual wxString ConvertToText(wxHtmlSelection *sel) const override;
     bool IsLinebreakAllowed() const override { return m_allowLinebreak; }
+    virtual bool NeedsDrawInvisible() const override { return false; }
 
     void SetPreviousWord(wxHtmlWordCell *cell);
 
@@ -463,8 +517,9 @@ public:
     wxHtmlWordWithTabsCell(const wxString& word,
                            const wxString& wordOrig,
                            size_t linepos,
-                           const wxDC& dc)
-        : wxHtmlWordCell(word, dc),
+                           const wxDC& dc,
+                           wxHtmlTextExtentCache *cache = NULL)
+        : wxHtmlWordCell(word, dc, cache),
           m_wordOrig(wordOrig),
           m_linepos(linepos)
     {}
@@ -595,6 +650,15 @@ protected:
     int m_MaxTotalWidth;
             // Maximum possible length if ignoring line wrap
 
+private:
+    // Force the next call to Layout() of this container and all its parents
+    // to really lay out the cells again.
+    void InvalidateLayout();
+
+    wxHtmlContainerIndex *m_index;
+            // y-index of the children built by Layout(), may be NULL
+
+    friend class wxHtmlStateChange;
 
     wxDECLARE_ABSTRACT_CLASS(wxHtmlContainerCell);
     wxDECLARE_NO_COPY_CLASS(wxHtmlContainerCell);
@@ -622,6 +686,8 @@ protected:
     wxColour m_Colour;
     unsigned m_Flags;
 
+    friend class wxHtmlStateChange;
+
     wxDECLARE_ABSTRACT_CLASS(wxHtmlColourCell);
     wxDECLARE_NO_COPY_CLASS(wxHtmlColourCell);
 };
@@ -80,6 +80,19 @@ public:
     // May be called during parsing to immediately return from Parse().
     virtual void StopParsing() { m_stopParsing = true; }
 
+    // Incremental parsing of a document which becomes available in chunks:
+    // call BeginIncrementalParsing(), then ParseChunk() for each chunk and
+    // EndIncrementalParsing() after the last one to get the final product.
+    // ParseChunk() returns the product for the part of the document received
+    // so far from time to time, or NULL if it didn't parse anything. The
+    // caller is responsible for deleting all the returned products.
+    // CancelIncrementalParsing() may be used instead of the latter to just
+    // get the received document without parsing it.
+    void BeginIncrementalParsing();
+    wxObject* ParseChunk(const wxString& chunk);
+    wxObject* EndIncrementalParsing();
+    wxString CancelIncrementalParsing();
+
     // Parses the m_Source from begin_pos to end_pos-1.
     // (in noparams version it parses whole m_Source)
     void DoParsing(const wxString::const_iterator& begin_pos,
@@ -202,6 +215,11 @@ protected:
 
     // flag indicating that the parser should stop
     bool m_stopParsing;
+
+    // source received by ParseChunk() so far and the length of its part
+    // which was already parsed
+    wxString m_incrementalSource;
+    size_t m_incrementalParsedLen;
 };
 
 
@@ -27,10 +27,13 @@ class wxHtmlProcessor;
 class wxHtmlWinModule;
 class wxHtmlHistoryArray;
 class wxHtmlProcessorList;
+class wxHtmlAsyncLayout;
+class wxHtmlAsyncWindowInterface;
 class WXDLLIMPEXP_FWD_HTML wxHtmlWinAutoScrollTimer;
 class WXDLLIMPEXP_FWD_HTML wxHtmlCellEvent;
 class WXDLLIMPEXP_FWD_HTML wxHtmlLinkEvent;
 class WXDLLIMPEXP_FWD_CORE wxStatusBar;
+class WXDLLIMPEXP_FWD_CORE wxImage;
 
 // wxHtmlWindow flags:
 #define wxHW_SCROLLBAR_NEVER    0x0002
@@ -99,6 +102,14 @@ public:
     /// Returns the window used for rendering (may be NULL).
     virtual wxWindow* GetHTMLWindow() = 0;
 
+    /**
+        Returns the content scale factor of the window used for rendering.
+
+        The default implementation uses the window returned by GetHTMLWindow()
+        or the main application window if there is none.
+     */
+    virtual double GetHTMLContentScaleFactor();
+
     /// Returns background colour to use by default.
     virtual wxColour GetHTMLBackgroundColour() const = 0;
 
@@ -108,6 +119,15 @@ public:
     /// Sets window's background to given bitmap.
     virtual void SetHTMLBackgroundImage(const wxBitmapBundle& bmpBg) = 0;
 
+    /**
+        Sets window's background to given image.
+
+        This is used by the parser, which may run in a worker thread, instead
+        of SetHTMLBackgroundImage() to avoid creating the bitmap in it. The
+        default implementation simply calls SetHTMLBackgroundImage().
+     */
+    virtual void SetHTMLBackgroundFromImage(const wxImage& image);
+
     /// Sets status bar text.
     virtual void SetHTMLStatusText(const wxString& text) = 0;
 
@@ -237,6 +257,8 @@ class WXDLLIMPEXP_HTML wxHtmlWindow : public wxScrolledWindow,
 {
     wxDECLARE_DYNAMIC_CLASS(wxHtmlWindow);
     friend class wxHtmlWinModule;
+    friend class wxHtmlAsyncLayout;
+    friend class wxHtmlAsyncWindowInterface;
 
 public:
     wxHtmlWindow() : wxHtmlWindowMouseHelper(this) { Init(); }
@@ -264,6 +286,14 @@ public:
     // Return value : false if an error occurred, true otherwise
     virtual bool SetPage(const wxString& source);
 
+    // Set HTML page in the same way as SetPage(), but parse it and lay it out
+    // in a background thread, the old page remains shown until the new one
+    // is ready and wxEVT_HTML_PAGE_LOADED is sent when it is.
+    bool SetPageAsync(const wxString& source);
+
+    // Return true if the page set by SetPageAsync() is still being prepared.
+    bool IsLoadingPageAsync() const;
+
     // Append to current page
     bool AppendToPage(const wxString& source);
 
@@ -281,6 +311,13 @@ public:
     // Loads HTML page from file
     bool LoadFile(const wxFileName& filename);
 
+    // Enables or disables showing the beginning of the HTML documents opened
+    // by LoadPage() while the rest of them is still being read (disabled by
+    // default). The full page is still passed to SetPage() once it's loaded.
+    void EnableIncrementalLoading(bool enable = true)
+        { m_incrementalLoading = enable; }
+    bool IsIncrementalLoadingEnabled() const { return m_incrementalLoading; }
+
     // Returns full location of opened page
     wxString GetOpenedPage() const {return m_OpenedPage;}
     // Returns anchor within opened page
@@ -467,6 +504,12 @@ public:
     // implementation of SetPage()
     bool DoSetPage(const wxString& source);
 
+    // used by LoadPage() for HTML documents if incremental loading is
+    // enabled: read the page from the stream, showing its beginning as soon
+    // as possible, and return its full source
+    wxString DoReadPageIncrementally(wxInputStream& stream,
+                                     const wxString& mimeType);
+
 protected:
     // This is pointer to the first cell in parsed data.  (Note: the first cell
     // is usually top one = all other cells are sub-cells of this one)
@@ -518,6 +561,38 @@ private:
     // don't have any background image
     void DoEraseBackground(wxDC& dc);
 
+    // prepare the parser for parsing a new page using the given DC
+    void InitParserDC(wxDC& dc);
+
+    // show the given cell, just returned by the parser, instead of m_Cell
+    void SetPageCell(wxHtmlContainerCell *cell);
+
+    // return true if any processors need to be applied to the page source
+    bool HasProcessors() const;
+
+    // pass the page source through all the registered processors
+    wxString ApplyProcessors(const wxString& source) const;
+
+    // send wxEVT_HTML_PAGE_LOADED event
+    void SendPageLoadedEvent();
+
+#if wxUSE_THREADS
+    // stop preparing the page set by SetPageAsync(), if it's still running
+    void CancelAsyncLayout();
+
+    // called in the main thread on behalf of the worker thread used by
+    // SetPageAsync() when it needs to use the GUI and when it's done
+    void OnAsyncLayoutRequest();
+    void OnAsyncLayoutDone();
+
+    // the page being prepared in the background or NULL
+    wxHtmlAsyncLayout *m_asyncLayout;
+
+    // the window interface used by the cells of the page prepared by the
+    // last completed SetPageAsync() call, it must live as long as they do
+    wxHtmlAsyncWindowInterface *m_asyncWindowInterface;
+#endif // wxUSE_THREADS
+
     // window content for double buffered rendering, may be invalid until it is
     // really initialized in OnPaint()
     wxBitmap m_backBuffer;
@@ -548,6 +623,9 @@ private:
     // if this FLAG is false, items are not added to history
     bool m_HistoryOn;
 
+    // if this flag is true, LoadPage() shows the page while it's being read
+    bool m_incrementalLoading;
+
     // Flag used to communicate between OnPaint() and OnEraseBackground(), see
     // the comments near its use.
     bool m_isBgReallyErased;
@@ -566,6 +644,7 @@ class WXDLLIMPEXP_FWD_HTML wxHtmlCellEvent;
 wxDECLARE_EXPORTED_EVENT( WXDLLIMPEXP_HTML, wxEVT_HTML_CELL_CLICKED, wxHtmlCellEvent );
 wxDECLARE_EXPORTED_EVENT( WXDLLIMPEXP_HTML, wxEVT_HTML_CELL_HOVER, wxHtmlCellEvent );
 wxDECLARE_EXPORTED_EVENT( WXDLLIMPEXP_HTML, wxEVT_HTML_LINK_CLICKED, wxHtmlLinkEvent );
+wxDECLARE_EXPORTED_EVENT( WXDLLIMPEXP_HTML, wxEVT_HTML_PAGE_LOADED, wxCommandEvent );
 
 
 /*!
@@ -649,6 +728,8 @@ typedef void (wxEvtHandler::*wxHtmlLinkEventFunction)(wxHtmlLinkEvent&);
     wx__DECLARE_EVT1(wxEVT_HTML_CELL_HOVER, id, wxHtmlCellEventHandler(fn))
 #define EVT_HTML_LINK_CLICKED(id, fn) \
     wx__DECLARE_EVT1(wxEVT_HTML_LINK_CLICKED, id, wxHtmlLinkEventHandler(fn))
+#define EVT_HTML_PAGE_LOADED(id, fn) \
+    wx__DECLARE_EVT1(wxEVT_HTML_PAGE_LOADED, id, wxCommandEventHandler(fn))
 
 
 // old wxEVT_COMMAND_* constants
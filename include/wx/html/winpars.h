@@ -59,6 +59,9 @@ public:
     int GetCharHeight() const {return m_CharHeight;}
     int GetCharWidth() const {return m_CharWidth;}
 
+    // returns the cache used for measuring the words of the page being parsed
+    wxHtmlTextExtentCache& GetTextExtentCache() { return m_textExtentCache; }
+
     // NOTE : these functions do _not_ return _actual_
     // height/width. They return h/w of default font
     // for this DC. If you want actual values, call
@@ -169,7 +172,7 @@ private:
     void FlushWordBuf(wxChar *temp, int& len);
     void AddWord(wxHtmlWordCell *word);
     void AddWord(const wxString& word)
-        { AddWord(new wxHtmlWordCell(word, *(GetDC()))); }
+        { AddWord(new wxHtmlWordCell(word, *(GetDC()), &m_textExtentCache)); }
     void AddPreBlock(const wxString& text);
 
     bool m_tmpLastWasSpace;
@@ -207,6 +210,8 @@ private:
             // current script mode (sub/sup/normal)
     long m_ScriptBaseline;
             // current sub/supscript base
+    wxHtmlTextExtentCache m_textExtentCache;
+            // cache of the extents of the words measured using m_DC
 
     wxFont* m_FontsTable[2][2][2][2][7];
     wxString m_FontsFacesTable[2][2][2][2][7];
@@ -369,6 +369,9 @@ public:
     wxImage BlurHorizontal(int radius) const;
     wxImage BlurVertical(int radius) const;
 
+    // approximate Gaussian blur with the given standard deviation in pixels
+    wxImage GaussianBlur(double sigma) const;
+
     wxImage ShrinkBy( int xFactor , int yFactor ) const ;
 
     // rescales the image in place
@@ -606,9 +609,13 @@ protected:
     virtual wxObjectRefData* CreateRefData() const override;
     virtual wxObjectRefData* CloneRefData(const wxObjectRefData* data) const override;
 
-    // Helper function used internally by wxImage class only.
-    template <typename T>
-    void ApplyToAllPixels(void (*filter)(wxImage *, unsigned char *, T), T value);
+    // Helper functions used internally by wxImage class only: apply the given
+    // functor, taking a pointer to the RGB triplet, to all pixels or only to
+    // those which don't have the mask colour.
+    template <typename F>
+    void ApplyToAllPixels(const F& filter);
+    template <typename F>
+    void ApplyToUnmaskedPixels(const F& filter);
 
 private:
     friend class WXDLLIMPEXP_FWD_CORE wxImageHandler;
@@ -15,9 +15,34 @@
 class WXDLLIMPEXP_FWD_BASE wxLog;
 
 #if wxUSE_INTL
+#include "wx/hashmap.h"
 #include "wx/hashset.h"
 WX_DECLARE_HASH_SET(wxString, wxStringHash, wxStringEqual,
                     wxLocaleUntranslatedStrings);
+
+// The result of a previous wxGetCachedTranslation() call for some string.
+struct wxLocaleCachedTranslation
+{
+    wxLocaleCachedTranslation()
+        : context(NULL), generation(0), translation(NULL)
+    {
+    }
+
+    // the context literal used for the lookup, may be NULL
+    const char *context;
+
+    // the value of wxTranslations generation counter when the translation was
+    // looked up: it is only valid if it is still the same
+    wxUint32 generation;
+
+    // the translated (or untranslated, if there is no translation) string
+    const wxString *translation;
+};
+
+// The cached translations are indexed by the address of the string literal.
+WX_DECLARE_HASH_MAP(wxUIntPtr, wxLocaleCachedTranslation,
+                    wxIntegerHash, wxIntegerEqual,
+                    wxLocaleCachedTranslations);
 #endif
 
 
@@ -50,6 +75,13 @@ public:
 #if wxUSE_INTL
     // Storage for wxTranslations::GetUntranslatedString()
     wxLocaleUntranslatedStrings untranslatedStrings;
+
+    // Storage for wxGetCachedTranslation()
+    wxLocaleCachedTranslations cachedTranslations;
+
+    // Buffer used by wxMsgCatalog::GetString() for building the lookup keys,
+    // reused to avoid allocating memory for them every time.
+    wxString translationKey;
 #endif
 
 #if wxUSE_THREADS
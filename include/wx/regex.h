@@ -16,6 +16,7 @@
 #if wxUSE_REGEX
 
 #include "wx/string.h"
+#include "wx/dynarray.h"
 #include "wx/versioninfo.h"
 
 // ----------------------------------------------------------------------------
@@ -45,6 +46,9 @@ enum
     // after/before it regardless of the setting of wxRE_NOT[BE]OL
     wxRE_NEWLINE  = 16,
 
+    // use JIT compilation for faster matching, if supported
+    wxRE_JIT      = 256,
+
     // default flags
     wxRE_DEFAULT  = wxRE_EXTENDED
 };
@@ -70,6 +74,7 @@ enum
 // ----------------------------------------------------------------------------
 
 class WXDLLIMPEXP_FWD_BASE wxRegExImpl;
+class WXDLLIMPEXP_FWD_BASE wxRegExMatchIterator;
 
 class WXDLLIMPEXP_BASE wxRegEx
 {
@@ -99,8 +104,13 @@ public:
     //
     // may only be called after successful call to Compile()
     bool Matches(const wxString& text, int flags = 0) const;
-    bool Matches(const wxChar *text, int flags, size_t len) const
-        { return Matches(wxString(text, len), flags); }
+    bool Matches(const wxChar *text, int flags, size_t len) const;
+
+    // matches the regular expression against the UTF-8 text of the given
+    // length (in bytes), the offsets returned by GetMatch() are in bytes too
+    //
+    // text is not copied if the regex library uses UTF-8 internally
+    bool MatchesUTF8(const char *text, size_t len, int flags = 0) const;
 
     // get the start index and the length of the match of the expression
     // (index 0) or a bracketed subexpression (index != 0)
@@ -122,6 +132,16 @@ public:
     // may only be called after successful call to Compile()
     size_t GetMatchCount() const;
 
+    // return the object allowing to iterate over all non-overlapping matches
+    // in the given text, which must remain alive while it is used
+    //
+    // may only be called after successful call to Compile()
+    wxRegExMatchIterator GetMatchAll(const wxString& text, int flags = 0) const;
+
+    // the iterator only stores a reference to the text, so it can't be used
+    // with temporaries which would be destroyed before it is used
+    wxRegExMatchIterator GetMatchAll(wxString&& text, int flags = 0) const = delete;
+
     // replaces the current regular expression in the string pointed to by
     // pattern, with the text in replacement and return number of matches
     // replaced (maybe 0 if none found) or -1 on error
@@ -166,6 +186,89 @@ private:
     // instances of the handle wxRegEx must not be copied.
     wxRegEx(const wxRegEx&);
     wxRegEx &operator=(const wxRegEx&);
+
+    friend class wxRegExMatchIterator;
+};
+
+// ----------------------------------------------------------------------------
+// wxRegExMatchIterator: iterates over all matches of wxRegEx in a string
+// ----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_BASE wxRegExMatchIterator
+{
+public:
+    // find the next match, return false if there are no more of them
+    bool Next();
+
+    // these functions may only be called after Next() returned true and
+    // return the current match (index 0) or its subexpression (index != 0),
+    // with the offsets relative to the start of the entire text
+    bool GetMatch(size_t *start, size_t *len, size_t index = 0) const
+        { return m_regex.GetMatch(start, len, index); }
+    wxString GetMatch(size_t index = 0) const
+        { return m_regex.GetMatch(m_text, index); }
+
+private:
+    wxRegExMatchIterator(const wxRegEx& regex, const wxString& text, int flags)
+        : m_regex(regex),
+          m_text(text),
+          m_flags(flags)
+    {
+        m_pos = 0;
+        m_lastWasEmpty = false;
+    }
+
+    // the regex and the text being matched, both must outlive this object
+    const wxRegEx& m_regex;
+    const wxString& m_text;
+
+    // wxRE_NOTXXX flags to use for matching
+    const int m_flags;
+
+    // the offset at which to look for the next match or npos when done
+    size_t m_pos;
+
+    // true if the last match was empty, so that we must not find another one
+    // at the same position
+    bool m_lastWasEmpty;
+
+    friend class wxRegEx;
+};
+
+// ----------------------------------------------------------------------------
+// wxRegExSet: many regular expressions matched in a single pass
+// ----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_FWD_BASE wxRegExSetImpl;
+
+class WXDLLIMPEXP_BASE wxRegExSet
+{
+public:
+    wxRegExSet() { m_impl = NULL; }
+    ~wxRegExSet();
+
+    // add a new regular expression to the set, return its index or
+    // wxNOT_FOUND if it couldn't be compiled
+    int Add(const wxString& pattern, int flags = wxRE_DEFAULT);
+
+    // return the number of expressions in the set
+    size_t GetCount() const;
+
+    // remove all expressions from the set
+    void Clear();
+
+    // return true if any of the expressions matches the text and, if indices
+    // is non-NULL, fill it with the indices of all matching expressions
+    //
+    // flags may be combination of wxRE_NOTBOL, wxRE_NOTEOL and wxRE_NOTEMPTY
+    bool Matches(const wxString& text,
+                 wxArrayInt *indices = NULL,
+                 int flags = 0) const;
+
+private:
+    wxRegExSetImpl *m_impl;
+
+    wxDECLARE_NO_COPY_CLASS(wxRegExSet);
 };
 
 #endif // wxUSE_REGEX
@@ -13,6 +13,8 @@
 
 #include "wx/dynarray.h"
 
+#include <map>
+
 // ----------------------------------------------------------------------------
 // wxSelectedIndices is just a sorted array of indices
 // ----------------------------------------------------------------------------
@@ -29,23 +31,22 @@ WX_DEFINE_SORTED_EXPORTED_ARRAY_CMP_INT(unsigned, wxUIntCmp, wxSelectedIndices);
 // controls, i.e. it is well suited for storing even when the control contains
 // a huge (practically infinite) number of items.
 //
-// Of course, internally it still has to store the selected items somehow (as
-// an array currently) but the advantage is that it can handle the selection
-// of all items (common operation) efficiently and that it could be made even
-// smarter in the future (e.g. store the selections as an array of ranges +
-// individual items) without changing its API.
+// Internally it stores the selected items as a set of disjoint ranges, so
+// that selecting all items or any range of them is as cheap as selecting a
+// single one and selecting or unselecting an item only takes logarithmic time
+// in the number of ranges.
 // ----------------------------------------------------------------------------
 
 class WXDLLIMPEXP_CORE wxSelectionStore
 {
 public:
-    wxSelectionStore() : m_itemsSel(wxUIntCmp) { Init(); }
+    wxSelectionStore() { Init(); }
 
     // set the total number of items we handle
     void SetItemCount(unsigned count);
 
     // special case of SetItemCount(0)
-    void Clear() { m_itemsSel.Clear(); m_count = 0; m_defaultState = false; }
+    void Clear() { m_ranges.clear(); Init(); }
 
     // must be called when new items are inserted/added
     void OnItemsInserted(unsigned item, unsigned numItems);
@@ -76,18 +77,10 @@ public:
     bool IsSelected(unsigned item) const;
 
     // return true if no items are currently selected
-    bool IsEmpty() const
-    {
-        return m_defaultState ? m_itemsSel.size() == m_count
-                              : m_itemsSel.empty();
-    }
+    bool IsEmpty() const { return m_ranges.empty(); }
 
     // return the total number of selected items
-    unsigned GetSelectedCount() const
-    {
-        return m_defaultState ? m_count - m_itemsSel.GetCount()
-                              : m_itemsSel.GetCount();
-    }
+    unsigned GetSelectedCount() const { return m_selectedCount; }
 
     // type of a "cookie" used to preserve the iteration state, this is an
     // opaque type, don't rely on its current representation
@@ -103,19 +96,37 @@ public:
     unsigned GetNextSelectedItem(IterationState& cookie) const;
 
 private:
+    // map from the first item of a range of selected items to its last item
+    typedef std::map<unsigned, unsigned> Ranges;
+
     // (re)init
-    void Init() { m_count = 0; m_defaultState = false; }
+    void Init() { m_count = 0; m_selectedCount = 0; }
+
+    // return the range containing the given item or, if there is none, the
+    // first range after it (which may be end())
+    Ranges::iterator FindRange(unsigned item);
+    Ranges::const_iterator FindRange(unsigned item) const;
+
+    // add the given inclusive range of items to the selection or remove it
+    // from it, return the number of items whose state changed and add them
+    // to itemsChanged if it's non-null and not too many of them changed, or
+    // reset it to null otherwise
+    unsigned AddRange(unsigned itemFrom, unsigned itemTo,
+                      wxArrayInt **itemsChanged = NULL);
+    unsigned RemoveRange(unsigned itemFrom, unsigned itemTo,
+                         wxArrayInt **itemsChanged = NULL);
+
+    // shift all the ranges starting at or after the given item by delta
+    void ShiftRanges(unsigned item, int delta);
 
     // the total number of items we handle
     unsigned m_count;
 
-    // the default state: normally, false (i.e. off) but maybe set to true if
-    // there are more selected items than non selected ones - this allows to
-    // handle selection of all items efficiently
-    bool m_defaultState;
+    // the number of items in all ranges
+    unsigned m_selectedCount;
 
-    // the array of items whose selection state is different from default
-    wxSelectedIndices m_itemsSel;
+    // the disjoint and non-adjacent ranges of selected items
+    Ranges m_ranges;
 
     wxDECLARE_NO_COPY_CLASS(wxSelectionStore);
 };
@@ -57,6 +57,16 @@
 #define wxGETTEXT_IN_CONTEXT_PLURAL(c, sing, plur, n) \
     wxGetTranslation((sing), (plur), n, wxString(), c)
 
+// versions of _() and wxGETTEXT_IN_CONTEXT() which can only be used with
+// string literals and cache the translation in the current thread after
+// looking it up once, making subsequent calls much faster (use
+// --keyword="wxGETTEXT_CACHED" --keyword="wxGETTEXT_IN_CONTEXT_CACHED:1c,2"
+// options with xgettext to extract the strings)
+#define wxGETTEXT_CACHED(s) \
+    wxGetCachedTranslation("" s)
+#define wxGETTEXT_IN_CONTEXT_CACHED(c, s) \
+    wxGetCachedTranslation("" s, "" c)
+
 // another one which just marks the strings for extraction, but doesn't
 // perform the translation (use -kwxTRANSLATE with xgettext!)
 #define wxTRANSLATE(str) str
@@ -77,6 +87,9 @@ class WXDLLIMPEXP_FWD_BASE wxLocale;
 class wxPluralFormsCalculator;
 wxDECLARE_SCOPED_PTR(wxPluralFormsCalculator, wxPluralFormsCalculatorPtr)
 
+class wxMsgCatalogFile;
+wxDECLARE_SCOPED_PTR(wxMsgCatalogFile, wxMsgCatalogFilePtr)
+
 // ----------------------------------------------------------------------------
 // wxMsgCatalog corresponds to one loaded message catalog.
 // ----------------------------------------------------------------------------
@@ -120,6 +133,10 @@ private:
     wxStringToStringHashMap m_messages; // all messages in the catalog
     wxString                m_domain;   // name of the domain
 
+    // the catalog file data used for looking up the messages on demand if
+    // lazy loading is used, NULL otherwise and m_messages is used then
+    wxMsgCatalogFilePtr     m_file;
+
 #if !wxUSE_UNICODE
     // the conversion corresponding to this catalog charset if we installed it
     // as the global one
@@ -305,6 +322,13 @@ inline const wxString& wxGetTranslation(const wxString& str1,
                : wxTranslations::GetUntranslatedString(str2);
 }
 
+// get the translation of the string literal, which must remain valid during
+// the program lifetime, in the current locale, looking it up only the first
+// time this function is called for it in the current thread (this function
+// shouldn't be used directly, use wxGETTEXT_CACHED() macro instead)
+WXDLLIMPEXP_BASE const wxString& wxGetCachedTranslation(const char *str,
+                                                        const char *context = NULL);
+
 #ifdef wxNO_IMPLICIT_WXSTRING_ENCODING
 
 /*
@@ -349,6 +373,14 @@ inline const wxString& wxGetTranslation(const char *str1,
     #define wxGETTEXT_IN_CONTEXT_PLURAL(c, sing, plur, n)  wxPLURAL(sing, plur, n)
 #endif
 
+#ifndef wxNO_IMPLICIT_WXSTRING_ENCODING
+    #define wxGETTEXT_CACHED(s)                            (s)
+    #define wxGETTEXT_IN_CONTEXT_CACHED(c, s)              (s)
+#else
+    #define wxGETTEXT_CACHED(s)                            wxASCII_STR(s)
+    #define wxGETTEXT_IN_CONTEXT_CACHED(c, s)              wxASCII_STR(s)
+#endif
+
 #define wxTRANSLATE(str) str
 #define wxTRANSLATE_IN_CONTEXT(c, str) str
 
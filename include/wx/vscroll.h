@@ -16,6 +16,7 @@
 #include "wx/scrolwin.h"
 
 class WXDLLIMPEXP_FWD_CORE wxVarScrollHelperEvtHandler;
+class wxVarScrollSizeIndex;
 
 
 // Using the same techniques as the wxScrolledWindow class      |
@@ -211,6 +212,13 @@ protected:
     // unitMax (exclusive)
     wxCoord GetUnitsSize(size_t unitMin, size_t unitMax) const;
 
+    // enable or disable keeping an index of the sizes of all units: this
+    // requires calling OnGetUnitSize() for all of them whenever the number of
+    // units changes and the units must be refreshed when their size changes,
+    // but allows computing the positions of the units in logarithmic time and
+    // makes the scrollbar reflect the real size of the units
+    void EnableUnitsSizeIndex(bool enable = true);
+
     // get the offset of the first visible unit
     wxCoord GetScrollOffset() const
         { return GetUnitsSize(0, GetVisibleBegin()); }
@@ -258,6 +266,13 @@ protected:
     void IncOrient(wxCoord& x, wxCoord& y, wxCoord inc);
 
 private:
+    // (re)compute the sizes of all units stored in m_sizeIndex
+    void BuildSizeIndex();
+
+    // update the size of the given unit in m_sizeIndex, return true if it
+    // changed
+    bool UpdateIndexedUnitSize(size_t unit);
+
     // the total number of (logical) units
     size_t m_unitMax;
 
@@ -281,6 +296,10 @@ private:
 
     // handler injected into target window to forward some useful events to us
     wxVarScrollHelperEvtHandler *m_handler;
+
+    // index of the units sizes, only non-NULL if EnableUnitsSizeIndex() was
+    // called
+    wxVarScrollSizeIndex *m_sizeIndex;
 };
 
 
@@ -307,6 +326,8 @@ public:
     // operators
 
     void SetRowCount(size_t rowCount) { SetUnitCount(rowCount); }
+    void EnableRowHeightsIndex(bool enable = true)
+        { EnableUnitsSizeIndex(enable); }
     bool ScrollToRow(size_t row) { return DoScrollToUnit(row); }
 
     virtual bool ScrollRows(int rows)
@@ -381,6 +402,8 @@ public:
 
     void SetColumnCount(size_t columnCount)
         { SetUnitCount(columnCount); }
+    void EnableColumnWidthsIndex(bool enable = true)
+        { EnableUnitsSizeIndex(enable); }
 
     bool ScrollToColumn(size_t column)
         { return DoScrollToUnit(column); }
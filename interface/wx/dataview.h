@@ -6,6 +6,64 @@
 /////////////////////////////////////////////////////////////////////////////
 
 
+/**
+    @class wxDataViewSortKey
+
+    The value used for sorting an item in wxDataViewCtrl.
+
+    Objects of this class are filled by wxDataViewModel::GetSortKeys() and are
+    compared with each other instead of calling wxDataViewModel::Compare() for
+    every pair of items, which allows sorting them without calling any model
+    methods and, notably, doing it in a background thread.
+
+    A key can contain an integer, a floating point number or a string value or
+    no value at all. Keys of different kinds are ordered as listed in the
+    previous sentence, with the keys without any value coming first, except
+    that integer and floating point keys are compared with each other as
+    numbers.
+
+    @library{wxcore}
+    @category{dvc}
+
+    @since 3.3.0
+*/
+class wxDataViewSortKey
+{
+public:
+    /**
+        Default constructor creates a key without any value.
+
+        Such key is less than all keys with a value.
+    */
+    wxDataViewSortKey();
+
+    /// Set the key to the given integer value.
+    void SetInteger(wxLongLong_t value);
+
+    /// Set the key to the given floating point value.
+    void SetDouble(double value);
+
+    /**
+        Set the key to the given string value.
+
+        Strings are compared using wxString::Cmp(), i.e. case-sensitively, as
+        the default wxDataViewModel::Compare() implementation does.
+    */
+    void SetString(const wxString& value);
+
+    /// Return @true if the key doesn't have any value.
+    bool IsNone() const;
+
+    /**
+        Compare this key with another one.
+
+        Returns a negative value, zero or a positive value if this key is,
+        respectively, less than, equal to or greater than @a other.
+    */
+    int Compare(const wxDataViewSortKey& other) const;
+};
+
+
 /**
     @class wxDataViewModel
 
@@ -109,6 +167,49 @@ public:
     */
     void AddNotifier(wxDataViewModelNotifier* notifier);
 
+    /**
+        Start a batch of change notifications.
+
+        All the item and value change notifications, i.e. calls to
+        ItemChanged(), ItemsChanged() and ValueChanged(), done until the
+        matching call to EndBatch() may be processed at once when the batch
+        ends instead of individually. This is much more efficient when many
+        items change at once, as the control is only updated once for all of
+        them, and multiple changes of the same item are combined.
+
+        The calls to this function can be nested, the batch ends only when
+        EndBatch() is called for the outermost BeginBatch() call.
+
+        Notice that the @c wxEVT_DATAVIEW_ITEM_VALUE_CHANGED events are still
+        generated for all the changed items, but they are only sent when the
+        batch ends. Other notifications, such as ItemAdded() or
+        ItemDeleted(), can be used inside a batch too and apply all the
+        changes pending before them first.
+
+        Currently batching the notifications only makes a difference for the
+        generic version of wxDataViewCtrl, other ports process them as usual.
+
+        @see IsInBatch(), wxDataViewCtrl::GetUpdateStats()
+
+        @since 3.3.0
+    */
+    void BeginBatch();
+
+    /**
+        End a batch of change notifications started by BeginBatch().
+
+        @since 3.3.0
+    */
+    void EndBatch();
+
+    /**
+        Return @true if BeginBatch() was called without the matching
+        EndBatch() call yet.
+
+        @since 3.3.0
+    */
+    bool IsInBatch() const;
+
     /**
         Change the value of the given item and update the control to reflect
         it.
@@ -197,6 +298,44 @@ public:
                         unsigned int column,
                         bool ascending) const;
 
+    /**
+        Override this to provide the keys for sorting the items by the given
+        column.
+
+        If this method is overridden to return @true, wxDataViewCtrl compares
+        the returned keys instead of calling Compare() when sorting a lot of
+        items at once, e.g. when the sort column changes. Items with the same
+        keys are ordered by their IDs, i.e. the keys must order the items in
+        the same way as Compare() does for the result to be consistent with
+        the items inserted or changed later.
+
+        As the keys are compared without calling any model methods, sorting
+        them can be done in a background thread, see
+        wxDataViewCtrl::EnableAsyncSort().
+
+        Models that don't override Compare() can implement this function by
+        just calling GetSortKeysFromValues().
+
+        Currently this method is only used by the generic version of
+        wxDataViewCtrl.
+
+        @param items
+            The items to return the keys for.
+        @param column
+            The column used for sorting, it is never @c (unsigned)-1.
+        @param keys
+            The array to be filled with exactly one key for each of the items.
+        @return
+            @true if the keys were returned or @false if sorting the items
+            by this column must use Compare(). The default implementation
+            always returns @false.
+
+        @since 3.3.0
+    */
+    virtual bool GetSortKeys(const wxDataViewItemArray& items,
+                             unsigned int column,
+                             wxVector<wxDataViewSortKey>& keys) const;
+
     /**
         Override this to indicate that the item has special font attributes.
         This only affects the wxDataViewTextRendererText renderer.
@@ -430,6 +569,21 @@ protected:
     */
     virtual int DoCompareValues(const wxVariant& value1,
                                 const wxVariant& value2) const;
+
+    /**
+        Helper function which can be used to implement GetSortKeys().
+
+        This function returns the keys ordering the items in the same way as
+        the default Compare() implementation does. It handles the values of
+        all the standard types supported by Compare() but returns @false if
+        the column contains values of any other type, as DoCompareValues()
+        can't be used for them.
+
+        @since 3.3.0
+    */
+    bool GetSortKeysFromValues(const wxDataViewItemArray& items,
+                               unsigned int column,
+                               wxVector<wxDataViewSortKey>& keys) const;
 };
 
 
@@ -1688,6 +1842,65 @@ public:
     */
     bool SetHeaderAttr(const wxItemAttr& attr);
 
+    /**
+        Enable or disable sorting the items in a background thread.
+
+        When this is enabled and the model returns the sort keys from
+        wxDataViewModel::GetSortKeys(), sorting many items by a column is done
+        in a background thread without blocking the UI. The items are shown
+        in their previous order until sorting is done and are rearranged all
+        at once when it finishes. Any change to the items in the meanwhile
+        waits for sorting to finish first.
+
+        This method is only available in the generic version of
+        wxDataViewCtrl, i.e. under MSW and when using wxGenericDataViewCtrl
+        explicitly.
+
+        @return @true if asynchronous sorting is supported or @false if it
+            isn't, i.e. when @c wxUSE_THREADS is 0.
+
+        @since 3.3.0
+    */
+    bool EnableAsyncSort(bool enable = true);
+
+    /**
+        Return @true if sorting the items in a background thread is enabled.
+
+        This method is only available in the generic version of
+        wxDataViewCtrl.
+
+        @see EnableAsyncSort()
+
+        @since 3.3.0
+    */
+    bool IsAsyncSortEnabled() const;
+
+    /**
+        Return the statistics about the updates done by the control.
+
+        The counters in the returned object are accumulated since the control
+        creation or the last call to ResetUpdateStats() and can be used to
+        check how many model change notifications result in the control
+        refreshes and repaints, e.g. to verify that wxDataViewModel::BeginBatch()
+        is used efficiently.
+
+        This method is only available in the generic version of
+        wxDataViewCtrl.
+
+        @since 3.3.0
+    */
+    const wxDataViewUpdateStats& GetUpdateStats() const;
+
+    /**
+        Reset all the counters returned by GetUpdateStats() to 0.
+
+        This method is only available in the generic version of
+        wxDataViewCtrl.
+
+        @since 3.3.0
+    */
+    void ResetUpdateStats();
+
     /**
         Sets the indentation.
     */
@@ -1767,6 +1980,30 @@ public:
 
 
 
+/**
+    Counters of the updates done by wxDataViewCtrl in response to the changes
+    in its model.
+
+    @see wxDataViewCtrl::GetUpdateStats()
+
+    @since 3.3.0
+*/
+struct wxDataViewUpdateStats
+{
+    /// Default constructor initializes all counters to 0.
+    wxDataViewUpdateStats();
+
+    /// Number of item or value change notifications received from the model.
+    unsigned long notifications;
+
+    /// Number of times the changed rows were refreshed.
+    unsigned long refreshes;
+
+    /// Number of times the items were actually repainted.
+    unsigned long repaints;
+};
+
+
 /**
     @class wxDataViewModelNotifier
 
@@ -1790,6 +2027,28 @@ public:
     */
     virtual ~wxDataViewModelNotifier();
 
+    /**
+        Called by owning model when a batch of notifications starts.
+
+        The notifications received until EndBatch() is called may be
+        processed at once when it is. The calls are not nested, i.e. this
+        function is only called for the outermost wxDataViewModel::BeginBatch().
+
+        The default implementation does nothing.
+
+        @since 3.3.0
+    */
+    virtual void BeginBatch();
+
+    /**
+        Called by owning model when a batch of notifications ends.
+
+        The default implementation does nothing.
+
+        @since 3.3.0
+    */
+    virtual void EndBatch();
+
     /**
         Called by owning model.
     */
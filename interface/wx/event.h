@@ -416,8 +416,8 @@ public:
         moment).
 
         QueueEvent() can be used for inter-thread communication from the worker
-        threads to the main thread, it is safe in the sense that it uses
-        locking internally and avoids the problem mentioned in AddPendingEvent()
+        threads to the main thread, it is safe in the sense that it is
+        thread-safe and avoids the problem mentioned in AddPendingEvent()
         documentation by ensuring that the @a event object is not used by the
         calling thread any more. Care should still be taken to avoid that some
         fields of this object are used by it, notably any wxString members of
@@ -454,6 +454,12 @@ public:
         if it is currently idle by calling ::wxWakeUpIdle() so there is no need
         to do it manually when using it.
 
+        Since wxWidgets 3.3.0 this method doesn't use any locks, so it can be
+        called very often from many threads at once, and only wakes up the
+        event loop when the first event is queued after the previously queued
+        ones had been already processed. The events queued by it may also be
+        merged together before being processed, see CoalescePendingEvent().
+
         @since 2.9.0
 
         @param event
@@ -672,9 +678,8 @@ public:
 
     /**
         Processes the pending events previously queued using QueueEvent() or
-        AddPendingEvent(); you must call this function only if you are sure
-        there are pending events for this handler, otherwise a @c wxCHECK
-        will fail.
+        AddPendingEvent(); this function does nothing if there are no pending
+        events for this handler.
 
         The real processing still happens in ProcessEvent() which is called by this
         function.
@@ -1279,6 +1284,55 @@ protected:
         @see ProcessEvent()
      */
     virtual bool TryAfter(wxEvent& event);
+
+    /**
+        Method called to merge the events queued for this handler.
+
+        This method is called from the main thread, when the events queued by
+        QueueEvent() are about to be added to the list of the pending events,
+        for each new event whose type and ID are the same as those of the last
+        event already in this list.
+
+        If this method returns @true, the new @a event is deleted without
+        being processed and only @a pending event remains, so the override
+        should update @a pending with any information from @a event that it
+        needs to preserve. The default implementation simply returns @false,
+        meaning that the events are never merged.
+
+        This is useful when worker threads post many events reporting their
+        progress, for example, as only the last one of them needs to be
+        actually processed:
+        @code
+        class MyFrame : public wxFrame
+        {
+        ...
+        protected:
+            virtual bool CoalescePendingEvent(wxEvent& pending,
+                                              const wxEvent& event)
+            {
+                if ( event.GetEventType() != wxEVT_THREAD )
+                    return wxFrame::CoalescePendingEvent(pending, event);
+
+                // Only keep the last progress value.
+                static_cast<wxThreadEvent&>(pending).SetInt(
+                    static_cast<const wxThreadEvent&>(event).GetInt());
+
+                return true;
+            }
+        };
+        @endcode
+
+        @param pending
+            The last event currently pending for this handler.
+        @param event
+            The newly queued event with the same type and ID as @a pending.
+        @return
+            @true if @a event was merged into @a pending and should be
+            discarded, @false to keep both events.
+
+        @since 3.3.0
+     */
+    virtual bool CoalescePendingEvent(wxEvent& pending, const wxEvent& event);
 };
 
 #endif // wxUSE_BASE
@@ -788,6 +788,26 @@ public:
     virtual void DrawLines(size_t n, const wxPoint2DDouble* points,
                            wxPolygonFillMode fillStyle = wxODDEVEN_RULE);
 
+    /**
+        Draws the same marker at each of the given points.
+
+        The @a marker path is defined relatively to the origin and is drawn
+        translated to each of the points, e.g. a path containing a circle of
+        radius 2 centered at (0, 0) can be used to draw a scatter plot.
+
+        This is much faster than drawing each marker individually but the
+        markers are combined into a single shape, which is filled with the
+        current brush, using wxWINDING_RULE, and then stroked with the current
+        pen. Hence, where the markers overlap, the result is different from
+        calling DrawPath() for each of them: the interior of the overlapping
+        area is only painted once and all the outlines are drawn over all the
+        interiors.
+
+        @since 3.3.0
+    */
+    virtual void DrawMarkers(size_t n, const wxPoint2DDouble* points,
+                             const wxGraphicsPath& marker);
+
     /**
         Draws the path by first filling and then stroking.
     */
@@ -868,6 +888,18 @@ public:
     virtual void FillPath(const wxGraphicsPath& path,
                           wxPolygonFillMode fillStyle = wxODDEVEN_RULE) = 0;
 
+    /**
+        Fills all the given rectangles with the current brush.
+
+        This is equivalent to filling a single path containing all the
+        rectangles using wxWINDING_RULE, but may be implemented more
+        efficiently than creating such path. Notably, this is much faster than
+        calling DrawRectangle() for each rectangle.
+
+        @since 3.3.0
+    */
+    virtual void FillRectangles(size_t n, const wxRect2DDouble* rects);
+
     /**
         Strokes a single line.
     */
@@ -1226,6 +1258,143 @@ public:
     */
 };
 
+/**
+    @class wxGraphicsDisplayList
+
+    A display list records the drawing commands issued on a special graphics
+    context and allows to replay them later on any other context.
+
+    This is useful for drawing complex but rarely changing content, such as
+    the static layers of a chart, as the paths, pens, brushes and bitmaps used
+    by it are created only once, when recording, and replaying the list just
+    reissues the already prepared commands, e.g.
+    @code
+    // Record the list once.
+    wxGraphicsDisplayList grid;
+    {
+        std::unique_ptr<wxGraphicsContext> gc(grid.CreateRecordingContext());
+        gc->SetPen(*wxLIGHT_GREY_PEN);
+        for ( int x = 0; x < 1000; x += 10 )
+            gc->StrokeLine(x, 0, x, 1000);
+    }
+
+    // And replay it in every wxEVT_PAINT handler.
+    void MyCanvas::OnPaint(wxPaintEvent&)
+    {
+        wxPaintDC dc(this);
+        std::unique_ptr<wxGraphicsContext> gc(wxGraphicsContext::Create(dc));
+        grid.Replay(*gc);
+        ... draw the dynamic part ...
+    }
+    @endcode
+
+    The objects stored in the list belong to the renderer used for recording
+    it, so the list can only be replayed on the contexts using the same
+    renderer.
+
+    @library{wxcore}
+    @category{gdi}
+
+    @since 3.3.0
+*/
+class wxGraphicsDisplayList
+{
+public:
+    /**
+        Creates an empty display list.
+    */
+    wxGraphicsDisplayList();
+
+    /**
+        Destroys the list and all the objects stored in it.
+    */
+    ~wxGraphicsDisplayList();
+
+    /**
+        Creates a context appending all commands issued on it to this list.
+
+        The returned context doesn't draw anything itself: drawing commands,
+        changes to the current pen, brush, font, transformation, clipping
+        region and other state are recorded instead of being performed. Text
+        extents are measured using the measuring context of the same renderer.
+
+        The commands are appended to the existing contents of the list, if
+        any, which must have been recorded using the same renderer.
+
+        The caller is responsible for deleting the returned context, which
+        must be done before destroying this list.
+
+        @param width
+            Width of the recording area, only used for GetSize() and
+            GetClipBox() of the returned context.
+        @param height
+            Height of the recording area.
+        @param renderer
+            The renderer to use for creating the objects stored in the list or
+            @NULL to use the default renderer.
+        @return
+            The new context or @NULL if it couldn't be created.
+    */
+    wxGraphicsContext* CreateRecordingContext(wxDouble width = 0,
+                                              wxDouble height = 0,
+                                              wxGraphicsRenderer* renderer = NULL);
+
+    /**
+        Replays all the recorded commands on the given context.
+
+        The commands are executed relatively to the current transformation
+        matrix of @a gc, so the recorded drawing may be moved, scaled or
+        rotated by changing it before calling this function. Absolute
+        transformations set by wxGraphicsContext::SetTransform() when
+        recording are also applied relatively to this matrix.
+
+        The state of @a gc, i.e. its transformation, clipping region, pen,
+        brush, font, antialiasing, interpolation and composition modes, is
+        restored when this function returns.
+    */
+    void Replay(wxGraphicsContext& gc) const;
+
+    /**
+        Replays only the commands affecting the given area.
+
+        This overload skips the drawing commands whose bounding box, computed
+        when recording, doesn't intersect @a area, which is expressed in the
+        coordinates used when recording the list. The commands changing the
+        state of the context are always executed, as are the drawing commands
+        whose extent couldn't be determined, e.g. stroking a path with a pen
+        not created by the recording context itself or drawing text when the
+        renderer can't create a context for measuring it.
+
+        This is typically used to only redraw the update region of a window.
+    */
+    void Replay(wxGraphicsContext& gc, const wxRect2DDouble& area) const;
+
+    /**
+        Removes all commands from the list.
+    */
+    void Clear();
+
+    /**
+        Returns @true if no commands have been recorded.
+    */
+    bool IsEmpty() const;
+
+    /**
+        Returns the number of recorded commands.
+    */
+    size_t GetCount() const;
+
+    /**
+        Returns the rectangle containing everything drawn by this list.
+
+        The rectangle is expressed in the coordinates used when recording and
+        may be slightly bigger than the area actually affected. It doesn't
+        take into account the drawing commands whose extent couldn't be
+        determined and is empty if there are no other drawing commands.
+    */
+    wxRect2DDouble GetBoundingBox() const;
+};
+
 /**
     Represents a single gradient stop in a collection of gradient stops as
     represented by wxGraphicsGradientStops.
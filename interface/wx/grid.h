@@ -1782,6 +1782,31 @@ public:
     /// Set attribute for the specified column.
     virtual void SetColAttr(wxGridCellAttr *attr, int col);
 
+    /**
+        Set attribute for all rows in the specified range.
+
+        This is equivalent to calling SetRowAttr() for all rows from
+        @a topRow to @a bottomRow, inclusive, but is much more efficient, as
+        the range is stored as a single element, whatever its size is, and
+        finding the attribute of any row only takes logarithmic time in the
+        number of such elements.
+
+        If any rows inside the range are inserted later, they don't have any
+        attribute, while the remaining rows keep it.
+
+        @since 3.3.0
+     */
+    virtual void SetRowRangeAttr(wxGridCellAttr *attr, int topRow, int bottomRow);
+
+    /**
+        Set attribute for all columns in the specified range.
+
+        This is the same as SetRowRangeAttr() but for the columns.
+
+        @since 3.3.0
+     */
+    virtual void SetColRangeAttr(wxGridCellAttr *attr, int leftCol, int rightCol);
+
     ///@}
 
     /**
@@ -1943,6 +1968,150 @@ public:
     wxString GetCornerLabelValue() const;
 };
 
+/**
+    Type of the values stored in a wxGridColumnarTable column.
+
+    @since 3.3.0
+ */
+enum wxGridColumnType
+{
+    /// Strings, interned in a pool shared by all string columns.
+    wxGRID_COLUMN_STRING,
+
+    /// Integer numbers stored as @c long.
+    wxGRID_COLUMN_LONG,
+
+    /// Floating point numbers stored as @c double.
+    wxGRID_COLUMN_DOUBLE
+};
+
+/**
+    Data table for big grids storing the values column by column.
+
+    Each column of this table has a type, specified when it is added using
+    AppendColumn() or InsertColumn(), and all its values are kept in a single
+    contiguous buffer of this type. Numeric columns store the numbers directly,
+    without converting them to strings, and implement GetValueAsLong() and
+    GetValueAsDouble(), so that wxGrid default renderers for numeric cells can
+    show them without creating any strings, while string columns only store
+    an index into a pool of distinct strings, making the columns with many
+    repeated values very compact.
+
+    This makes this table much more suitable than wxGridStringTable for grids
+    with a big number of rows, e.g.
+    @code
+    wxGridColumnarTable* table = new wxGridColumnarTable();
+    table->AppendColumn(wxGRID_COLUMN_STRING, "Name");
+    table->AppendColumn(wxGRID_COLUMN_DOUBLE, "Value");
+    table->AppendRows(1000000);
+
+    for ( int row = 0; row < 1000000; row++ )
+        table->SetValueAsDouble(row, 1, GetValue(row));
+
+    grid->AssignTable(table);
+    @endcode
+
+    Empty cells of numeric columns are tracked separately from their values,
+    so that any value, including @c LONG_MIN and NaN, can be stored in them.
+    CanGetValueAs() returns @false for the empty cells for all types except
+    ::wxGRID_VALUE_STRING, so that they are shown as empty by the standard
+    renderers. When a @c double value is retrieved as @c long, it is clamped
+    to the range of @c long and NaN is returned as 0, while storing NaN in a
+    @c long column using SetValueAsDouble() makes the cell empty. The strings
+    stored in the string columns are never removed from the pool, except when
+    Clear() is called.
+
+    Columns added by wxGrid::AppendCols() or wxGrid::InsertCols() have
+    ::wxGRID_COLUMN_STRING type.
+
+    @since 3.3.0
+ */
+class wxGridColumnarTable : public wxGridTableBase
+{
+public:
+    /**
+        Default constructor creates an empty table.
+     */
+    wxGridColumnarTable();
+
+    /**
+        Constructor taking the number of rows.
+
+        The table doesn't have any columns initially, use AppendColumn() to
+        add them.
+     */
+    explicit wxGridColumnarTable( int numRows );
+
+    /**
+        Add a new column of the given type at the end of the table.
+
+        All cells of the new column are empty.
+
+        @param type
+            The type of the values stored in this column.
+        @param label
+            The column label, if empty, the default label is used.
+     */
+    bool AppendColumn( wxGridColumnType type,
+                       const wxString& label = wxString() );
+
+    /**
+        Insert a new column of the given type at the given position.
+
+        If @a pos is greater or equal to the number of columns, this function
+        is the same as AppendColumn().
+     */
+    bool InsertColumn( size_t pos,
+                       wxGridColumnType type,
+                       const wxString& label = wxString() );
+
+    /**
+        Return the type of the given column.
+     */
+    wxGridColumnType GetColumnType( int col ) const;
+
+    /**
+        Preallocate memory for the given total number of rows.
+
+        Calling this function before adding many rows is not necessary, but
+        avoids reallocating the columns storage when doing it.
+     */
+    void ReserveRows( size_t numRows );
+
+    /**
+        Return the number of distinct non-empty strings stored in the string
+        columns of this table.
+     */
+    size_t GetStringPoolSize() const;
+
+    virtual int GetNumberRows();
+    virtual int GetNumberCols();
+    virtual wxString GetValue( int row, int col );
+    virtual void SetValue( int row, int col, const wxString& s );
+
+    bool IsEmptyCell( int row, int col );
+
+    wxString GetTypeName( int row, int col );
+    bool CanGetValueAs( int row, int col, const wxString& typeName );
+    long GetValueAsLong( int row, int col );
+    double GetValueAsDouble( int row, int col );
+    void SetValueAsLong( int row, int col, long value );
+    void SetValueAsDouble( int row, int col, double value );
+
+    void Clear();
+    bool InsertRows( size_t pos = 0, size_t numRows = 1 );
+    bool AppendRows( size_t numRows = 1 );
+    bool DeleteRows( size_t pos = 0, size_t numRows = 1 );
+    bool InsertCols( size_t pos = 0, size_t numCols = 1 );
+    bool AppendCols( size_t numCols = 1 );
+    bool DeleteCols( size_t pos = 0, size_t numCols = 1 );
+
+    void SetColLabelValue( int col, const wxString& );
+    void SetCornerLabelValue( const wxString& );
+    wxString GetColLabelValue( int col );
+    wxString GetCornerLabelValue() const;
+};
+
 /**
     Represents coordinates of a grid cell.
 
@@ -255,6 +255,21 @@ public:
     */
     virtual void DrawInvisible(wxDC& dc, int x , int y, wxHtmlRenderingInfo& info);
 
+    /**
+        Returns true if DrawInvisible() must be called for this cell.
+
+        The default implementation returns @true, which is always safe.
+        Cells which don't override DrawInvisible() may override this method
+        to return @false, allowing the containers with many children to skip
+        over them entirely when drawing only a part of a long page. Note that
+        if a class overriding this function to return @false has a derived
+        class which overrides DrawInvisible(), the derived class must override
+        this function to return @true again.
+
+        @since 3.3.0
+    */
+    virtual bool NeedsDrawInvisible() const;
+
     /**
         Returns pointer to itself if this cell matches condition (or if any of the
         cells following in the list matches), @NULL otherwise.
@@ -523,6 +538,10 @@ public:
 
         Note that the container takes ownership of the cell and will delete it
         when it itself is destroyed.
+
+        Inserting (or detaching) a cell invalidates the layout of this
+        container and all of its parents, so that the next call to Layout() on
+        the root cell lays out only these containers again.
     */
     void InsertCell(wxHtmlCell* cell);
 
@@ -766,6 +785,78 @@ public:
 
 
 
+/**
+    @class wxHtmlTextExtentCache
+
+    Cache of the text extents used when creating wxHtmlWordCell objects.
+
+    The same words typically occur many times in the same document, so
+    remembering their extents avoids measuring them using the DC again. The
+    extents are cached separately for each font, with at most the number of
+    strings specified in the constructor remembered for any font: when it is
+    exceeded, the least recently used string is forgotten.
+
+    wxHtmlWinParser uses this class for all the words it creates, see
+    wxHtmlWinParser::GetTextExtentCache().
+
+    @library{wxhtml}
+    @category{html}
+
+    @since 3.3.0
+*/
+class wxHtmlTextExtentCache
+{
+public:
+    /**
+        Create the cache remembering at most @a maxPerFont strings per font.
+    */
+    explicit wxHtmlTextExtentCache(size_t maxPerFont = 4096);
+
+    /**
+        Notify the cache about the DC which is going to be used with it.
+
+        If the text measured with this DC could have a different extent than
+        with the previously used one, e.g. because it has a different
+        resolution or scale, the cache is cleared.
+    */
+    void UseDC(const wxDC& dc);
+
+    /**
+        Get the extent of the given text in the current font of the DC.
+
+        This is the same as wxDC::GetTextExtent() but only calls it if the
+        extent of this text in this font is not cached yet.
+    */
+    void GetTextExtent(const wxDC& dc,
+                       const wxString& text,
+                       wxCoord *width,
+                       wxCoord *height,
+                       wxCoord *descent = NULL);
+
+    /**
+        Forget all the cached extents.
+
+        Hit and miss counters are not affected by this function.
+    */
+    void Clear();
+
+    /**
+        Return the number of GetTextExtent() calls which used the cached value.
+    */
+    size_t GetHitCount() const;
+
+    /**
+        Return the number of GetTextExtent() calls which had to measure text.
+    */
+    size_t GetMissCount() const;
+
+    /**
+        Reset the values returned by GetHitCount() and GetMissCount() to 0.
+    */
+    void ResetCounters();
+};
+
+
 /**
     @class wxHtmlWordCell
 
@@ -777,7 +868,14 @@ public:
 class wxHtmlWordCell : public wxHtmlCell
 {
 public:
-    wxHtmlWordCell(const wxString& word, const wxDC& dc);
+    /**
+        Constructor measures the word using the given DC.
+
+        If @a cache is non-@NULL, it is used instead of measuring the word
+        directly (this parameter is new since wxWidgets 3.3.0).
+    */
+    wxHtmlWordCell(const wxString& word, const wxDC& dc,
+                   wxHtmlTextExtentCache *cache = NULL);
 };
 
 
@@ -796,7 +894,8 @@ public:
     wxHtmlWordWithTabsCell(const wxString& word,
                            const wxString& wordOrig,
                            size_t linepos,
-                           const wxDC& dc);
+                           const wxDC& dc,
+                           wxHtmlTextExtentCache *cache = NULL);
 };
 
 
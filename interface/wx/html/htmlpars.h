@@ -248,6 +248,73 @@ public:
     */
     wxObject* Parse(const wxString& source);
 
+    /**
+        Starts parsing a document which will be passed to the parser in
+        several chunks.
+
+        After calling this function, call ParseChunk() for every chunk of the
+        document, in order, and EndIncrementalParsing() once the entire
+        document has been received.
+
+        This is useful for showing the beginning of a big document while the
+        rest of it is still being read, e.g. from the network.
+
+        @since 3.3.0
+    */
+    void BeginIncrementalParsing();
+
+    /**
+        Adds another chunk of the document to parse.
+
+        This function may only be called after BeginIncrementalParsing().
+
+        From time to time, this function parses the part of the document
+        received so far, up to the end of the last complete tag in it which is
+        not inside a comment or a @c script or @c style element, as if it were
+        the entire document and returns the result, as Parse() would.
+        As this requires parsing the document from its beginning, it is only
+        done when the amount of new text is at least as big as the already
+        parsed part, so that the total time spent on parsing the partial
+        documents doesn't exceed the time needed to parse the full one.
+
+        @param chunk
+            The next part of the document. It doesn't have to end at a tag
+            boundary.
+        @return
+            The result of parsing the document received so far or @NULL if it
+            wasn't parsed by this call. If it is non-null, the caller is
+            responsible for deleting it.
+
+        @since 3.3.0
+    */
+    wxObject* ParseChunk(const wxString& chunk);
+
+    /**
+        Finishes parsing the document passed to ParseChunk().
+
+        @return
+            The result of parsing the full document, which is the same as
+            Parse() would have returned for it. The caller is responsible for
+            deleting it.
+
+        @since 3.3.0
+    */
+    wxObject* EndIncrementalParsing();
+
+    /**
+        Stops incremental parsing without parsing the document.
+
+        This function may be called instead of EndIncrementalParsing() if the
+        result of parsing the full document is not needed, e.g. because it
+        will be parsed in some other way.
+
+        @return
+            The entire document passed to ParseChunk().
+
+        @since 3.3.0
+    */
+    wxString CancelIncrementalParsing();
+
     /**
         Restores parser's state before last call to PushTagHandler().
     */
@@ -76,6 +76,16 @@ public:
     /// Returns the window used for rendering (may be NULL).
     virtual wxWindow* GetHTMLWindow() = 0;
 
+    /**
+        Returns the content scale factor of the window used for rendering.
+
+        The default implementation uses the window returned by GetHTMLWindow()
+        or the main application window if there is none.
+
+        @since 3.3.0
+     */
+    virtual double GetHTMLContentScaleFactor();
+
     /// Returns background colour to use by default.
     virtual wxColour GetHTMLBackgroundColour() const = 0;
 
@@ -85,6 +95,18 @@ public:
     /// Sets window's background to given bitmap.
     virtual void SetHTMLBackgroundImage(const wxBitmapBundle& bmpBg) = 0;
 
+    /**
+        Sets window's background to given image.
+
+        This is used by the parser, which may run in a worker thread when
+        using wxHtmlWindow::SetPageAsync(), instead of SetHTMLBackgroundImage()
+        to avoid creating the bitmap in it. The default implementation simply
+        calls SetHTMLBackgroundImage().
+
+        @since 3.3.0
+     */
+    virtual void SetHTMLBackgroundFromImage(const wxImage& image);
+
     /// Sets status bar text.
     virtual void SetHTMLStatusText(const wxString& text) = 0;
 
@@ -144,6 +166,10 @@ public:
         The mouse passed over a wxHtmlCell.
     @event{EVT_HTML_LINK_CLICKED(id, func)}
         A wxHtmlCell which contains a hyperlink was clicked.
+    @event{EVT_HTML_PAGE_LOADED(id, func)}
+        The page set by SetPageAsync() is shown in the window. This event is
+        of wxCommandEvent type. This event is available since wxWidgets
+        3.3.0.
     @endEventTable
 
     @library{wxhtml}
@@ -194,6 +220,26 @@ public:
     */
     bool AppendToPage(const wxString& source);
 
+    /**
+        Enables or disables showing HTML documents while they're being loaded.
+
+        If enabled, LoadPage() parses HTML documents while they're being read
+        and shows the beginning of a big document before all of it has been
+        loaded. This is not done if any wxHtmlProcessor needs to be applied to
+        the document or if it is read using a custom wxHtmlFilter.
+
+        Notice that the partially loaded document is shown directly, without
+        calling SetPage(), which is still called with the full document once
+        it has been read, as usual.
+
+        Incremental loading is disabled by default.
+
+        @see IsIncrementalLoadingEnabled()
+
+        @since 3.3.0
+    */
+    void EnableIncrementalLoading(bool enable = true);
+
     /**
         Returns pointer to the top-level container.
 
@@ -260,6 +306,23 @@ public:
     */
     bool HistoryForward();
 
+    /**
+        Returns @true if incremental loading of HTML documents is enabled.
+
+        @see EnableIncrementalLoading()
+
+        @since 3.3.0
+    */
+    bool IsIncrementalLoadingEnabled() const;
+
+    /**
+        Returns @true if the page set by SetPageAsync() is still being
+        prepared in the background.
+
+        @since 3.3.0
+    */
+    bool IsLoadingPageAsync() const;
+
     /**
         Loads an HTML page from a file and displays it.
 
@@ -273,6 +336,10 @@ public:
         Unlike SetPage() this function first loads the HTML page from @a location
         and then displays it.
 
+        After the page is loaded, this function calls SetPage() to display
+        it. If EnableIncrementalLoading() was called, the beginning of the
+        page may be shown before all of it has been loaded.
+
         @param location
             The address of the document.
             See the @ref overview_fs for details on the address format
@@ -421,6 +488,46 @@ public:
     */
     virtual bool SetPage(const wxString& source);
 
+    /**
+        Sets the source of a page and displays it once it is ready.
+
+        This function does the same thing as SetPage(), but parses the page
+        and lays it out in a background thread, which can be useful for very
+        big pages. The current page remains shown until the new one is ready,
+        at which moment it is replaced with it and @c wxEVT_HTML_PAGE_LOADED
+        event is sent.
+
+        Text is still measured in the main thread, as it can't be done from
+        the other ones with all ports, but the results are cached for each
+        font, so this needs to be done only once for each different word.
+        The calls to OnOpeningURL() are also done in the main thread.
+
+        Notice that the page is parsed by a separate parser in the background
+        thread, which means that only the tag handlers registered using
+        wxHtmlWinParser::AddModule() are used and that they must not use the
+        GUI, except via wxHtmlWindowInterface. The standard
+        handlers satisfy this requirement, but the custom ones creating
+        windows for wxHtmlWidgetCell can't be used with this function. Also
+        note that wxHtmlProcessor objects, if any, are still applied to
+        the page in the main thread before this function returns.
+
+        Loading the page is cancelled if the page is changed in any other
+        way before it is ready, e.g. by calling SetPage() or LoadPage(), or
+        if the window is destroyed. This may be done from OnOpeningURL()
+        called while loading the page too.
+
+        If the threads are not supported, this function simply calls
+        SetPage() and sends the event immediately.
+
+        @param source
+            The HTML to be displayed.
+
+        @return @false if an error occurred, @true otherwise.
+
+        @since 3.3.0
+    */
+    bool SetPageAsync(const wxString& source);
+
     /**
         Sets the frame in which page title will be displayed.
         @a format is the format of the frame title, e.g. "HtmlHelp : %s".
@@ -546,6 +653,7 @@ protected:
 wxEventType wxEVT_HTML_CELL_CLICKED;
 wxEventType wxEVT_HTML_CELL_HOVER;
 wxEventType wxEVT_HTML_LINK_CLICKED;
+wxEventType wxEVT_HTML_PAGE_LOADED;
 
 
 /**
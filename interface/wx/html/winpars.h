@@ -160,6 +160,16 @@ public:
     */
     wxDC* GetDC();
 
+    /**
+        Returns the cache used for measuring the words during parsing.
+
+        Tag handlers creating wxHtmlWordCell objects should pass this cache
+        to them. It can also be used to check the cache hit rate.
+
+        @since 3.3.0
+    */
+    wxHtmlTextExtentCache& GetTextExtentCache();
+
     /**
         Returns wxEncodingConverter class used to do conversion between the
         @ref GetInputEncoding() "input encoding" and the
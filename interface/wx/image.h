@@ -792,7 +792,9 @@ public:
         specified pixel @a blurRadius. This should not be used when using
         a single mask colour for transparency.
 
-        @see BlurHorizontal(), BlurVertical()
+        The time taken by this function doesn't depend on the blur radius.
+
+        @see BlurHorizontal(), BlurVertical(), GaussianBlur()
     */
     wxImage Blur(int blurRadius) const;
 
@@ -812,6 +814,28 @@ public:
     */
     wxImage BlurVertical(int blurRadius) const;
 
+    /**
+        Blurs the image using Gaussian blur with the given standard deviation.
+
+        The Gaussian blur is approximated by applying the box blur, as done by
+        Blur(), several times with the appropriately chosen radii. This gives
+        a much smoother result than a single box blur, e.g. for the shadow
+        effects, while still taking time independent of @a sigma.
+
+        Both the RGB data and the alpha channel, if any, are blurred. As with
+        Blur(), this should not be used when using a single mask colour for
+        transparency.
+
+        @param sigma
+            The standard deviation of the Gaussian in pixels, must be
+            non-negative. Using 0 returns an unchanged copy of the image.
+
+        @since 3.3.0
+
+        @see Blur()
+    */
+    wxImage GaussianBlur(double sigma) const;
+
     /**
         Returns a mirrored copy of the image.
         The parameter @a horizontally indicates the orientation.
@@ -961,6 +985,15 @@ public:
         image and will therefore remove the mask partially. Using the alpha channel
         will work.
 
+        Resampling big images using any quality other than the default one can
+        be done using multiple threads by setting @c image.resample-threads
+        system option, see wxSystemOptions, e.g.
+        @code
+        wxSystemOptions::SetOption("image.resample-threads", -1);
+        @endcode
+        would use as many threads as there are CPUs. This doesn't change the
+        results in any way, but can be much faster for big images.
+
         Example:
         @code
         // get the bitmap from somewhere
@@ -54,6 +54,25 @@ enum
     */
     wxRE_NEWLINE  = 16,
 
+    /**
+        Use JIT compilation to make matching faster.
+
+        Compiling the regex takes longer when this flag is used, so it only
+        makes sense for the regular expressions used for matching many times,
+        e.g. when iterating over all matches using wxRegEx::GetMatchAll().
+
+        If JIT compilation is not supported on the current platform, this flag
+        is silently ignored and the matching works exactly as without it. Note
+        that this is also the case when using the version of PCRE2 bundled with
+        wxWidgets, which is built without JIT support, so this flag only has
+        any effect when using the system PCRE2 library built with it, i.e.
+        when wxWidgets is configured with @c --with-regex=sys or @c
+        wxUSE_REGEX=sys in CMake.
+
+        @since 3.3.0
+     */
+    wxRE_JIT      = 256,
+
     /** Default flags.*/
     wxRE_DEFAULT  = wxRE_EXTENDED
 };
@@ -267,6 +286,46 @@ public:
     */
     size_t GetMatchCount() const;
 
+    /**
+        Returns the object allowing to iterate over all matches in the given
+        text.
+
+        The matches don't overlap and are found in the order of their
+        appearance in the text. Unlike calling Matches() in a loop, this
+        function doesn't copy the text at all and the preceding text is
+        correctly taken into account when checking for the subsequent matches,
+        e.g. @c "^" only matches at the start of @a text and lookbehind
+        assertions work as expected.
+
+        Example of using it:
+        @code
+        wxRegEx re("[0-9]+", wxRE_JIT);
+        wxRegExMatchIterator it = re.GetMatchAll(text);
+        while ( it.Next() )
+        {
+            wxLogMessage("Found number %s", it.GetMatch());
+        }
+        @endcode
+
+        Note that both this object and @a text must remain alive while the
+        returned iterator is used and that the iterator uses the match data
+        of this object, i.e. calling Matches() while iterating invalidates it.
+        Because of this, this function can't be called with a temporary
+        string, the overload taking an rvalue reference is deleted to prevent
+        this from compiling.
+
+        May only be called after successful call to Compile() and only if
+        @c wxRE_NOSUB was @b not used.
+
+        @param text
+            The text to search, it is not copied.
+        @param flags
+            Combination of @ref wxRE_NOT_FLAGS used for all the matches.
+
+        @since 3.3.0
+    */
+    wxRegExMatchIterator GetMatchAll(const wxString& text, int flags = 0) const;
+
     /**
         Return @true if this is a valid compiled regular expression, @false
         otherwise.
@@ -308,6 +367,34 @@ public:
     */
     bool Matches(const wxString& text, int flags = 0) const;
 
+    /**
+        Matches the precompiled regular expression against the UTF-8 text.
+
+        This function is similar to Matches(), but takes a buffer containing
+        the text in UTF-8 encoding, which doesn't need to be NUL-terminated,
+        and its length in bytes. The offsets returned by GetMatch() after a
+        successful call to this function are in bytes too, which makes it
+        possible to use them with the same buffer.
+
+        When wxWidgets is built with @c wxUSE_UNICODE_UTF8, the regex library
+        uses UTF-8 internally and the text is not copied at all, otherwise it
+        is converted to the wide characters, making this function less
+        efficient than Matches().
+
+        Note that GetMatch() overload taking the text must not be used after
+        this function.
+
+        @param text
+            Valid UTF-8 text, may be @NULL only if @a len is 0.
+        @param len
+            The length of the text in bytes.
+        @param flags
+            Combination of @ref wxRE_NOT_FLAGS.
+
+        @since 3.3.0
+    */
+    bool MatchesUTF8(const char* text, size_t len, int flags = 0) const;
+
     /**
         Replaces the current regular expression in the string pointed to by
         @a text, with the text in @a replacement and return number of matches
@@ -387,3 +474,151 @@ public:
     static wxVersionInfo GetLibraryVersionInfo();
 };
 
+/**
+    @class wxRegExMatchIterator
+
+    Iterator over all matches of a regular expression in a string.
+
+    Objects of this class can only be created by wxRegEx::GetMatchAll(), see
+    its documentation for more details and an example of using it.
+
+    @library{wxbase}
+    @category{data}
+
+    @since 3.3.0
+*/
+class wxRegExMatchIterator
+{
+public:
+    /**
+        Finds the next match.
+
+        This function must be called before retrieving the first match too.
+
+        @return @true if another match was found or @false if there are no
+            more matches.
+    */
+    bool Next();
+
+    /**
+        Get the start index and the length of the current match (if @a index
+        is 0) or of a bracketed subexpression of it.
+
+        The returned @a start is relative to the beginning of the entire text
+        passed to wxRegEx::GetMatchAll().
+
+        May only be called after Next() returned @true.
+    */
+    bool GetMatch(size_t* start, size_t* len, size_t index = 0) const;
+
+    /**
+        Returns the part of the text corresponding to the current match or
+        its bracketed subexpression.
+
+        May only be called after Next() returned @true.
+    */
+    wxString GetMatch(size_t index = 0) const;
+};
+
+/**
+    @class wxRegExSet
+
+    A set of regular expressions which can be matched against the same text
+    at once.
+
+    This class is useful when the same text needs to be checked against many
+    different regular expressions, e.g. for filtering log messages. Instead of
+    scanning the text once for every expression, as would be the case when
+    using separate wxRegEx objects, the expressions are combined and matched
+    in a single pass and the indices of all expressions that matched are
+    returned.
+
+    Example:
+    @code
+    wxRegExSet filters;
+    filters.Add("error [0-9]+", wxRE_JIT);
+    filters.Add("warning", wxRE_ICASE | wxRE_JIT);
+
+    wxArrayInt indices;
+    if ( filters.Matches(line, &indices) )
+    {
+        for ( size_t n = 0; n < indices.size(); ++n )
+            wxLogMessage("Line matches filter #%d", indices[n]);
+    }
+    @endcode
+
+    Note that the expressions using back references, named groups or
+    recursion, as well as some other rarely used PCRE constructs, can't be
+    combined with the other ones, so they're matched separately, i.e. still
+    work, but don't benefit from using this class.
+
+    @library{wxbase}
+    @category{data}
+
+    @since 3.3.0
+*/
+class wxRegExSet
+{
+public:
+    /**
+        Default constructor creates an empty set.
+    */
+    wxRegExSet();
+
+    /**
+        Destructor. It's not virtual, don't derive from this class.
+    */
+    ~wxRegExSet();
+
+    /**
+        Adds a new regular expression to the set.
+
+        The expression is compiled immediately and an error is logged if it
+        is invalid, as with wxRegEx::Compile().
+
+        @param pattern
+            The regular expression.
+        @param flags
+            Compilation flags, see @ref wxRE_FLAGS. ::wxRE_JIT can be used to
+            speed up matching and is used for all expressions in the set if
+            it is specified for any of them, while ::wxRE_NOSUB is implied.
+
+        @return The index of the new expression in the set, which is equal to
+            the number of expressions previously added to it, or ::wxNOT_FOUND
+            if it couldn't be compiled.
+    */
+    int Add(const wxString& pattern, int flags = wxRE_DEFAULT);
+
+    /**
+        Returns the number of expressions in the set.
+    */
+    size_t GetCount() const;
+
+    /**
+        Removes all expressions from the set.
+    */
+    void Clear();
+
+    /**
+        Checks whether any of the expressions in the set match the given text.
+
+        If @a indices is @NULL, this function stops as soon as any match is
+        found, which is faster than finding all of them.
+
+        Just as wxRegEx::Matches(), this function is not thread-safe, i.e. the
+        same set can't be used for matching from multiple threads at once.
+
+        @param text
+            The text to match.
+        @param indices
+            If non-@NULL, filled with the indices of all expressions that
+            matched, in increasing order.
+        @param flags
+            Combination of @ref wxRE_NOT_FLAGS.
+
+        @return @true if any of the expressions matched.
+    */
+    bool Matches(const wxString& text,
+                 wxArrayInt* indices = NULL,
+                 int flags = 0) const;
+};
@@ -30,6 +30,15 @@
     @section sysopt_all All platforms
 
     @beginFlagTable
+    @flag{autosize.max-rows}
+        If set to a positive value, the generic wxListCtrl and wxDataViewCtrl
+        measure at most this number of rows, plus the currently visible ones,
+        when computing the best width of a column, instead of measuring as
+        many rows as possible in a limited time. If the control has more
+        rows, the first and last quarter of this number of them are measured
+        and the remaining ones are sampled uniformly from the rest of the
+        control. This is mostly useful for huge virtual controls, for which
+        retrieving the items values can be slow. Default: 0 (@since 3.3.0).
     @flag{exit-on-assert}
         If set to non-zero value, abort the program if an assertion fails. The
         default behaviour in case of assertion failure depends on the build mode
@@ -37,6 +46,26 @@
         this option allows changing it without modifying the program code and
         also applies to asserts which may happen before the wxApp object
         creation or after its destruction.
+    @flag{image.resample-threads}
+        If set to a value greater than 1, wxImage::Scale() and Rescale() use up
+        to this number of threads for resampling big images with
+        ::wxIMAGE_QUALITY_BILINEAR, ::wxIMAGE_QUALITY_BICUBIC or
+        ::wxIMAGE_QUALITY_BOX_AVERAGE quality, by splitting the resulting
+        image in bands of rows processed in parallel. If set to -1, the number
+        of threads is the number of CPUs in the system. The results are the
+        same as when using a single thread. Default: 0, i.e. no threads are
+        used (@since 3.3.0).
+    @flag{intl.lazy-catalogs}
+        If set to non-zero value, the message catalogs loaded by wxTranslations
+        are not converted to the hash map of all their strings when they are
+        loaded, but are memory-mapped and the translations are looked up in
+        them, and converted to wxString, only when they are requested for the
+        first time. This makes loading big catalogs much faster and reduces
+        the memory consumption if only a small part of their strings are
+        used, at the price of making the first lookup of each string slower.
+        Note that the catalog files must not be modified while they're being
+        used when this option is on. It is only used in Unicode builds and
+        must be set before loading the catalogs. Default: 0 (@since 3.3.0).
     @endFlagTable
 
     @section sysopt_win Windows
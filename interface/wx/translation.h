@@ -478,6 +478,45 @@ public:
  */
 #define wxGETTEXT_IN_CONTEXT_PLURAL(context, string, plural, n)
 
+/**
+    Similar to _() but can only be used with string literals and caches the
+    translation after looking it up for the first time.
+
+    Unlike _(), which looks up the string in all the loaded message catalogs
+    every time it is called, this macro only does it once per thread and then
+    returns the same translation, without allocating any memory, until the
+    translations change, e.g. because a new catalog is loaded. This makes it
+    much faster when the same string is translated repeatedly, e.g. in a
+    paint event handler.
+
+    As the string literal is identified by its address, this macro can't be
+    used with anything but a literal (this is checked at compile-time).
+
+    Notice that @c xgettext must be invoked with
+    @c --keyword="wxGETTEXT_CACHED" option to extract the strings using it.
+
+    @see wxGETTEXT_IN_CONTEXT_CACHED(), wxGetCachedTranslation()
+
+    @header{wx/intl.h}
+
+    @since 3.3.0
+ */
+#define wxGETTEXT_CACHED(string)
+
+/**
+    Similar to wxGETTEXT_IN_CONTEXT() but caches the translation in the same
+    way as wxGETTEXT_CACHED().
+
+    Both @a context and @a string must be string literals and @c xgettext must
+    be invoked with @c --keyword="wxGETTEXT_IN_CONTEXT_CACHED:1c,2" option to
+    extract the strings using this macro.
+
+    @header{wx/intl.h}
+
+    @since 3.3.0
+ */
+#define wxGETTEXT_IN_CONTEXT_CACHED(context, string)
+
 /**
     This macro doesn't do anything in the program code -- it simply expands to
     the value of its argument.
@@ -603,6 +642,25 @@ const wxString& wxGetTranslation(const wxString& string,
                                  const wxString& domain = wxEmptyString,
                                  const wxString& context = wxEmptyString);
 
+/**
+    Returns the translation of a string literal, using the cached value if
+    possible.
+
+    This function is used by wxGETTEXT_CACHED() and
+    wxGETTEXT_IN_CONTEXT_CACHED() macros and shouldn't be called directly, as
+    both @a string and @a context, if non-@NULL, must be string literals, or
+    at least pointers to strings which never change and remain valid until
+    the end of the program.
+
+    This function is thread-safe.
+
+    @header{wx/intl.h}
+
+    @since 3.3.0
+*/
+const wxString& wxGetCachedTranslation(const char* string,
+                                       const char* context = NULL);
+
 /**
     Macro to be used around all literal strings that should be translated.
 
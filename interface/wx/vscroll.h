@@ -223,6 +223,30 @@ public:
     */
     wxVarVScrollHelper(wxWindow* winToScroll);
 
+    /**
+        Enables or disables keeping an index of the heights of all rows.
+
+        By default, only the heights of the rows which are needed for the
+        display are retrieved and the total height of all rows is estimated,
+        see EstimateTotalHeight(). This is efficient when the number of rows
+        is very big, but computing the position of the rows far from the
+        beginning takes time proportional to their index and the scrollbar
+        thumb position and size only correspond to the number of rows and
+        not to their real heights.
+
+        When the index is enabled, OnGetRowHeight() is called for all rows
+        whenever their number changes, or RefreshAll() is called, and then
+        the position of any row can be found in logarithmic time and the
+        scrollbar reflects the real heights of all rows. Note that in this
+        case RefreshRow() or RefreshRows() must be called when the height of
+        some rows changes, for it to be taken into account. If the total
+        height of all rows doesn't fit into @c int, the scrollbar still uses
+        rows, as it does when the index is disabled.
+
+        @since 3.3.0
+    */
+    void EnableRowHeightsIndex(bool enable = true);
+
     /**
         Returns the number of rows the target window contains.
 
@@ -359,6 +383,20 @@ public:
     */
     wxVarHScrollHelper(wxWindow* winToScroll);
 
+    /**
+        Enables or disables keeping an index of the widths of all columns.
+
+        This is the same as wxVarVScrollHelper::EnableRowHeightsIndex(), but
+        for the columns: when it is enabled, OnGetColumnWidth() is called for
+        all columns whenever their number changes and the positions of the
+        columns can be found in logarithmic time. RefreshColumn() or
+        RefreshColumns() must be called when the width of some columns
+        changes in this case.
+
+        @since 3.3.0
+    */
+    void EnableColumnWidthsIndex(bool enable = true);
+
     /**
         Returns the number of columns the target window contains.
 
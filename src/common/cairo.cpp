@@ -185,6 +185,8 @@
        (cairo_t* cr, cairo_font_options_t* options), (cr, options) ) \
     m( cairo_user_to_device_distance, \
        (cairo_t* cr, double *dx, double* dy), (cr, dx, dy) ) \
+    m( cairo_device_to_user_distance, \
+       (cairo_t* cr, double *dx, double* dy), (cr, dx, dy) ) \
     m( cairo_surface_mark_dirty, \
        (cairo_surface_t* surface), (surface))
 
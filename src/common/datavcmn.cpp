@@ -138,6 +138,7 @@ bool wxDataViewModelNotifier::ItemsChanged( const wxDataViewItemArray &items )
 
 wxDataViewModel::wxDataViewModel()
 {
+    m_batchDepth = 0;
 }
 
 wxDataViewModel::~wxDataViewModel()
@@ -299,6 +300,34 @@ bool wxDataViewModel::AfterReset()
     return ret;
 }
 
+void wxDataViewModel::BeginBatch()
+{
+    if ( m_batchDepth++ )
+        return;
+
+    wxDataViewModelNotifiers::iterator iter;
+    for (iter = m_notifiers.begin(); iter != m_notifiers.end(); ++iter)
+    {
+        wxDataViewModelNotifier* notifier = *iter;
+        notifier->BeginBatch();
+    }
+}
+
+void wxDataViewModel::EndBatch()
+{
+    wxCHECK_RET( m_batchDepth, "EndBatch() without matching BeginBatch()" );
+
+    if ( --m_batchDepth )
+        return;
+
+    wxDataViewModelNotifiers::iterator iter;
+    for (iter = m_notifiers.begin(); iter != m_notifiers.end(); ++iter)
+    {
+        wxDataViewModelNotifier* notifier = *iter;
+        notifier->EndBatch();
+    }
+}
+
 void wxDataViewModel::Resort()
 {
     wxDataViewModelNotifiers::iterator iter;
@@ -313,6 +342,10 @@ void wxDataViewModel::AddNotifier( wxDataViewModelNotifier *notifier )
 {
     m_notifiers.push_back( notifier );
     notifier->SetOwner( this );
+
+    // Keep the notifier batch state consistent with ours.
+    if ( m_batchDepth )
+        notifier->BeginBatch();
 }
 
 void wxDataViewModel::RemoveNotifier( wxDataViewModelNotifier *notifier )
@@ -423,6 +456,70 @@ int wxDataViewModel::Compare( const wxDataViewItem &item1, const wxDataViewItem
     return ascending ? id1 - id2 : id2 - id1;
 }
 
+bool
+wxDataViewModel::GetSortKeysFromValues(const wxDataViewItemArray& items,
+                                       unsigned int column,
+                                       wxVector<wxDataViewSortKey>& keys) const
+{
+    const size_t count = items.size();
+
+    keys.clear();
+    keys.resize(count);
+
+    wxVariant value;
+    for ( size_t n = 0; n < count; n++ )
+    {
+        const wxDataViewItem& item = items[n];
+        if ( !HasValue(item, column) )
+            continue;
+
+        GetValue(value, item, column);
+
+        // This must be kept in sync with the types handled by Compare().
+        wxDataViewSortKey& key = keys[n];
+        const wxString type = value.GetType();
+        if ( type == wxS("string") )
+        {
+            key.SetString(value.GetString());
+        }
+        else if ( type == wxS("long") )
+        {
+            key.SetInteger(value.GetLong());
+        }
+        else if ( type == wxS("double") )
+        {
+            key.SetDouble(value.GetDouble());
+        }
+#if wxUSE_DATETIME
+        else if ( type == wxS("datetime") )
+        {
+            const wxDateTime dt = value.GetDateTime();
+            if ( dt.IsValid() )
+                key.SetInteger(dt.GetValue().GetValue());
+        }
+#endif // wxUSE_DATETIME
+        else if ( type == wxS("bool") )
+        {
+            key.SetInteger(value.GetBool());
+        }
+        else if ( type == wxS("wxDataViewIconText") )
+        {
+            wxDataViewIconText iconText;
+            iconText << value;
+
+            key.SetString(iconText.GetText());
+        }
+        else if ( !value.IsNull() )
+        {
+            // Values of this type can only be compared by DoCompareValues().
+            keys.clear();
+            return false;
+        }
+    }
+
+    return true;
+}
+
 // ---------------------------------------------------------
 // wxDataViewIndexListModel
 // ---------------------------------------------------------
@@ -43,6 +43,7 @@
 #endif
 
 #include "wx/thread.h"
+#include "wx/hashmap.h"
 
 #if wxUSE_BASE
     #include "wx/scopedptr.h"
@@ -55,6 +56,8 @@
     #include "wx/private/rescale.h"
 #endif
 
+#include <atomic>
+
 // ----------------------------------------------------------------------------
 // wxWin macros
 // ----------------------------------------------------------------------------
@@ -1149,16 +1152,166 @@ void wxEventHashTable::GrowEventTypeTable()
     delete[] oldEventTypeTable;
 }
 
+// ----------------------------------------------------------------------------
+// wxDynamicEventIndex
+// ----------------------------------------------------------------------------
+
+WX_DECLARE_HASH_MAP(wxEventType, wxVector<size_t>,
+                    wxIntegerHash, wxIntegerEqual,
+                    wxDynamicEventPositions);
+
+// Maps event types to the positions of the entries for them in the vector of
+// dynamic event handlers, in the same order as they appear in it.
+class wxDynamicEventIndex
+{
+public:
+    // Searching linearly is faster than using the index for small tables.
+    enum { MIN_ENTRIES = 16 };
+
+    wxDynamicEventIndex() : m_numUnbound(0) { }
+
+    void Add(wxEventType eventType, size_t pos)
+    {
+        m_positions[eventType].push_back(pos);
+    }
+
+    // Remove the given position if it's the last one for this event type.
+    void RemoveLast(wxEventType eventType, size_t pos)
+    {
+        const wxDynamicEventPositions::iterator it = m_positions.find(eventType);
+        if ( it != m_positions.end() &&
+                !it->second.empty() && it->second.back() == pos )
+        {
+            it->second.pop_back();
+        }
+    }
+
+    // Must be called when an entry is unbound but left in the vector as NULL.
+    void OnEntryUnbound() { m_numUnbound++; }
+
+    // Return true if the unbound entries should be pruned even if there are
+    // none of them for the event being processed, to prevent the vector from
+    // growing indefinitely if the event types they used are never processed.
+    bool HasTooManyUnbound(size_t numEntries) const
+    {
+        return m_numUnbound > numEntries / 2;
+    }
+
+    void Rebuild(const wxVector<wxDynamicEventTableEntry*>& entries)
+    {
+        // Don't remove the existing elements from the map as pointers to
+        // them may be still used by SearchDynamicEventTable() if we're called
+        // from a nested event handler.
+        for ( wxDynamicEventPositions::iterator it = m_positions.begin();
+              it != m_positions.end();
+              ++it )
+        {
+            it->second.clear();
+        }
+
+        m_numUnbound = 0;
+        for ( size_t n = 0; n < entries.size(); n++ )
+        {
+            if ( entries[n] )
+                Add(entries[n]->m_eventType, n);
+            else
+                m_numUnbound++;
+        }
+    }
+
+    // Return the positions of the entries for the given event type or NULL.
+    const wxVector<size_t>* Find(wxEventType eventType) const
+    {
+        const wxDynamicEventPositions::const_iterator
+            it = m_positions.find(eventType);
+
+        return it == m_positions.end() ? NULL : &it->second;
+    }
+
+private:
+    wxDynamicEventPositions m_positions;
+
+    // number of NULL entries in the vector
+    size_t m_numUnbound;
+};
+
+// ----------------------------------------------------------------------------
+// wxQueuedEventStack
+// ----------------------------------------------------------------------------
+
+// Element of the lock-free stack of events queued by wxEvtHandler::QueueEvent().
+struct wxQueuedEventNode
+{
+    explicit wxQueuedEventNode(wxEvent* event) : m_event(event), m_next(NULL) { }
+
+    wxEvent* const m_event;
+    wxQueuedEventNode* m_next;
+};
+
+// The stack itself, storing the events in the reverse order of their addition.
+class wxQueuedEventStack
+{
+public:
+    wxQueuedEventStack() : m_head(NULL) { }
+
+    // Add the node to the stack and return true if it was empty before.
+    bool Push(wxQueuedEventNode* node)
+    {
+        node->m_next = m_head.load(std::memory_order_relaxed);
+        while ( !m_head.compare_exchange_weak(node->m_next, node,
+                                              std::memory_order_release,
+                                              std::memory_order_relaxed) )
+            ;
+
+        return node->m_next == NULL;
+    }
+
+    // Add the node to the stack only if it's not empty, return false and
+    // don't do anything if it is.
+    bool PushIfNotEmpty(wxQueuedEventNode* node)
+    {
+        node->m_next = m_head.load(std::memory_order_relaxed);
+        do
+        {
+            if ( !node->m_next )
+                return false;
+        }
+        while ( !m_head.compare_exchange_weak(node->m_next, node,
+                                              std::memory_order_release,
+                                              std::memory_order_relaxed) );
+
+        return true;
+    }
+
+    // Remove all nodes from the stack and return the last added one.
+    wxQueuedEventNode* TakeAll()
+    {
+        return m_head.exchange(NULL, std::memory_order_acquire);
+    }
+
+    bool IsEmpty() const
+    {
+        return m_head.load() == NULL;
+    }
+
+private:
+    std::atomic<wxQueuedEventNode*> m_head;
+
+    wxDECLARE_NO_COPY_CLASS(wxQueuedEventStack);
+};
+
 // ----------------------------------------------------------------------------
 // wxEvtHandler
 // ----------------------------------------------------------------------------
 
 wxEvtHandler::wxEvtHandler()
+    : m_queuedEvents(new wxQueuedEventStack)
 {
     m_nextHandler = NULL;
     m_previousHandler = NULL;
     m_enabled = true;
     m_dynamicEvents = NULL;
+    m_dynamicEventIndex = NULL;
     m_pendingEvents = NULL;
 
     // no client data (yet)
@@ -1195,6 +1348,7 @@ wxEvtHandler::~wxEvtHandler()
             delete entry;
         }
         delete m_dynamicEvents;
+        delete m_dynamicEventIndex;
     }
 
     // Remove us from the list of the pending events if necessary.
@@ -1202,6 +1356,7 @@ wxEvtHandler::~wxEvtHandler()
         wxTheApp->RemovePendingEventHandler(this);
 
     DeletePendingEvents();
+    delete m_queuedEvents;
 
     // we only delete object data, not untyped
     if ( m_clientDataType == wxClientData_Object )
@@ -1298,34 +1453,107 @@ void wxEvtHandler::QueueEvent(wxEvent *event)
         return;
     }
 
-    // 1) Add this event to our list of pending events
+    wxQueuedEventNode* const node = new wxQueuedEventNode(event);
+
+    // 1) Add this event to the stack of the queued events. If it already
+    //    contains some events, this handler had been already added to the
+    //    list of handlers with pending events and the event loop had been
+    //    woken up when the first of them was queued, so there is nothing else
+    //    to do and this doesn't require any locking, which is what makes
+    //    posting many events, possibly from many threads, cheap.
+    if ( m_queuedEvents->PushIfNotEmpty(node) )
+        return;
+
+    // 2) Otherwise add this event and this event handler to the list of event
+    //    handlers that have pending events while holding m_pendingEventsLock,
+    //    as the queued events are only taken by the main thread while holding
+    //    it too. Otherwise there would be a race condition as described in
+    //    the ticket #9093: the event could be processed, and this handler
+    //    even destroyed as a result, before we had time to append this pointer
+    //    to wxHandlersWithPendingEvents list.
     wxENTER_CRIT_SECT( m_pendingEventsLock );
 
+    // Notice that another thread could have queued the first event since we
+    // checked for it above, in which case it has already added this handler.
+    const bool first = m_queuedEvents->Push(node);
+    if ( first )
+        wxTheApp->AppendPendingEventHandler(this);
+
+    wxLEAVE_CRIT_SECT( m_pendingEventsLock );
+
+    // 3) Inform the system that new pending events are somewhere,
+    //    and that these should be processed in idle time.
+    if ( first )
+        wxWakeUpIdle();
+}
+
+void wxEvtHandler::MoveQueuedEventsToPending()
+{
+    wxQueuedEventNode* node = m_queuedEvents->TakeAll();
+    if ( !node )
+        return;
+
+    // The events are stored in the reverse order, restore the original one.
+    wxQueuedEventNode* first = NULL;
+    while ( node )
+    {
+        wxQueuedEventNode* const next = node->m_next;
+        node->m_next = first;
+        first = node;
+        node = next;
+    }
+
     if ( !m_pendingEvents )
         m_pendingEvents = new wxList;
 
-    m_pendingEvents->Append(event);
+    for ( node = first; node; )
+    {
+        wxEvent* const event = node->m_event;
+
+        wxQueuedEventNode* const next = node->m_next;
+        delete node;
+        node = next;
 
-    // 2) Add this event handler to list of event handlers that
-    //    have pending events.
+        // Give the handler a chance to merge this event into the last pending
+        // one if they're of the same kind.
+        wxList::compatibility_iterator last = m_pendingEvents->GetLast();
+        if ( last )
+        {
+            wxEvent* const pending = static_cast<wxEvent *>(last->GetData());
+            if ( pending->GetEventType() == event->GetEventType() &&
+                    pending->GetId() == event->GetId() &&
+                        CoalescePendingEvent(*pending, *event) )
+            {
+                delete event;
+                continue;
+            }
+        }
 
-    wxTheApp->AppendPendingEventHandler(this);
+        m_pendingEvents->Append(event);
+    }
+}
 
-    // only release m_pendingEventsLock now because otherwise there is a race
-    // condition as described in the ticket #9093: we could process the event
-    // just added to m_pendingEvents in our ProcessPendingEvents() below before
-    // we had time to append this pointer to wxHandlersWithPendingEvents list; thus
-    // breaking the invariant that a handler should be in the list iff it has
-    // any pending events to process
-    wxLEAVE_CRIT_SECT( m_pendingEventsLock );
+void wxEvtHandler::RemoveFromPendingEventHandlers()
+{
+    wxTheApp->RemovePendingEventHandler(this);
 
-    // 3) Inform the system that new pending events are somewhere,
-    //    and that these should be processed in idle time.
-    wxWakeUpIdle();
+    // If another thread queued an event after we had moved all of them to
+    // m_pendingEvents, it could have found that we were still in the list of
+    // handlers with pending events and not appended us to it, so do it now.
+    if ( !m_queuedEvents->IsEmpty() )
+        wxTheApp->AppendPendingEventHandler(this);
 }
 
 void wxEvtHandler::DeletePendingEvents()
 {
+    for ( wxQueuedEventNode* node = m_queuedEvents->TakeAll(); node; )
+    {
+        wxQueuedEventNode* const next = node->m_next;
+        delete node->m_event;
+        delete node;
+        node = next;
+    }
+
     if (m_pendingEvents)
         m_pendingEvents->DeleteContents(true);
     wxDELETE(m_pendingEvents);
@@ -1347,10 +1575,19 @@ void wxEvtHandler::ProcessPendingEvents()
 
     wxENTER_CRIT_SECT( m_pendingEventsLock );
 
-    // this method is only called by wxApp if this handler does have
-    // pending events
-    wxCHECK_RET( m_pendingEvents && !m_pendingEvents->IsEmpty(),
-                 "should have pending events if called" );
+    MoveQueuedEventsToPending();
+
+    // this method is normally only called by wxApp if this handler does have
+    // pending events, but QueueEvent() may add it to the list of handlers
+    // with pending events after its event had been already processed
+    if ( !m_pendingEvents || m_pendingEvents->IsEmpty() )
+    {
+        RemoveFromPendingEventHandlers();
+
+        wxLEAVE_CRIT_SECT( m_pendingEventsLock );
+
+        return;
+    }
 
     wxList::compatibility_iterator node = m_pendingEvents->GetFirst();
     wxEvent* pEvent = static_cast<wxEvent *>(node->GetData());
@@ -1390,7 +1627,7 @@ void wxEvtHandler::ProcessPendingEvents()
     {
         // if there are no more pending events left, we don't need to
         // stay in this list
-        wxTheApp->RemovePendingEventHandler(this);
+        RemoveFromPendingEventHandlers();
     }
 
     wxLEAVE_CRIT_SECT( m_pendingEventsLock );
@@ -1768,6 +2005,16 @@ void wxEvtHandler::DoBind(int id,
     // than inserting the element at the front.
     m_dynamicEvents->push_back(entry);
 
+    if ( m_dynamicEventIndex )
+    {
+        m_dynamicEventIndex->Add(entry->m_eventType, m_dynamicEvents->size() - 1);
+    }
+    else if ( m_dynamicEvents->size() >= wxDynamicEventIndex::MIN_ENTRIES )
+    {
+        m_dynamicEventIndex = new wxDynamicEventIndex;
+        m_dynamicEventIndex->Rebuild(*m_dynamicEvents);
+    }
+
     // Make sure we get to know when a sink is destroyed
     wxEvtHandler *eventSink = func->GetEvtHandler();
     if ( eventSink && eventSink != this )
@@ -1813,14 +2060,29 @@ wxEvtHandler::DoUnbind(int id,
             delete entry->m_callbackUserData;
 
             // We can't delete the entry from the vector if we're currently
-            // iterating over it. As we don't know whether we're or not, just
-            // null it for now and we will really erase it when we do finish
-            // iterating over it the next time.
+            // iterating over it, unless it's the last one, as this doesn't
+            // change the positions of the other entries. As we don't know
+            // whether we're or not, just null the others for now and we will
+            // really erase them when we do finish iterating over it the next
+            // time.
             //
             // Notice that we rely on "cookie" being just the index into the
             // vector, which is not guaranteed by our API, but here we can use
             // this implementation detail.
-            (*m_dynamicEvents)[cookie] = NULL;
+            if ( cookie == m_dynamicEvents->size() - 1 )
+            {
+                m_dynamicEvents->pop_back();
+
+                if ( m_dynamicEventIndex )
+                    m_dynamicEventIndex->RemoveLast(entry->m_eventType, cookie);
+            }
+            else
+            {
+                (*m_dynamicEvents)[cookie] = NULL;
+
+                if ( m_dynamicEventIndex )
+                    m_dynamicEventIndex->OnEntryUnbound();
+            }
 
             delete entry;
             return true;
@@ -1863,6 +2125,21 @@ bool wxEvtHandler::SearchDynamicEventTable( wxEvent& event )
                  wxT("caller should check that we have dynamic events") );
 
     DynamicEvents& dynamicEvents = *m_dynamicEvents;
+    const wxEventType eventType = event.GetEventType();
+
+    // If we have an index, only look at the entries for this event type,
+    // otherwise we have to check all of them.
+    const wxVector<size_t>* positions = NULL;
+    size_t count;
+    if ( m_dynamicEventIndex )
+    {
+        positions = m_dynamicEventIndex->Find(eventType);
+        count = positions ? positions->size() : 0;
+    }
+    else
+    {
+        count = dynamicEvents.size();
+    }
 
     bool needToPruneDeleted = false;
 
@@ -1870,9 +2147,24 @@ bool wxEvtHandler::SearchDynamicEventTable( wxEvent& event )
     // but not yet pruned entries from the caller, but here we do want to know
     // about them, so iterate directly. Remember to do it in the reverse order
     // to honour the order of handlers connection.
-    for ( size_t n = dynamicEvents.size(); n; n-- )
+    for ( size_t n = count; n; n-- )
     {
-        wxDynamicEventTableEntry* const entry = dynamicEvents[n - 1];
+        // The handlers called below may bind or unbind other handlers and
+        // even prune the entries in a nested call, so check that the entry
+        // still exists every time.
+        size_t pos = n - 1;
+        if ( positions )
+        {
+            if ( pos >= positions->size() )
+                continue;
+
+            pos = (*positions)[pos];
+        }
+
+        if ( pos >= dynamicEvents.size() )
+            continue;
+
+        wxDynamicEventTableEntry* const entry = dynamicEvents[pos];
 
         if ( !entry )
         {
@@ -1883,7 +2175,7 @@ bool wxEvtHandler::SearchDynamicEventTable( wxEvent& event )
             continue;
         }
 
-        if ( event.GetEventType() == entry->m_eventType )
+        if ( eventType == entry->m_eventType )
         {
             wxEvtHandler *handler = entry->m_fn->GetEvtHandler();
             if ( !handler )
@@ -1908,6 +2200,12 @@ bool wxEvtHandler::SearchDynamicEventTable( wxEvent& event )
         }
     }
 
+    // When using the index, we only see the unbound entries for this event
+    // type above, so also prune all of them if there are too many.
+    if ( m_dynamicEventIndex &&
+            m_dynamicEventIndex->HasTooManyUnbound(dynamicEvents.size()) )
+        needToPruneDeleted = true;
+
     if ( needToPruneDeleted )
     {
         size_t nNew = 0;
@@ -1919,6 +2217,10 @@ bool wxEvtHandler::SearchDynamicEventTable( wxEvent& event )
 
         wxASSERT( nNew != dynamicEvents.size() );
         dynamicEvents.resize(nNew);
+
+        // The positions of the remaining entries have changed.
+        if ( m_dynamicEventIndex )
+            m_dynamicEventIndex->Rebuild(dynamicEvents);
     }
 
     return false;
@@ -2000,6 +2302,9 @@ void wxEvtHandler::OnSinkDestroyed( wxEvtHandler *sink )
             // Just as in DoUnbind(), we use our knowledge of
             // GetNextDynamicEntry() implementation here.
             (*m_dynamicEvents)[cookie] = NULL;
+
+            if ( m_dynamicEventIndex )
+                m_dynamicEventIndex->OnEntryUnbound();
         }
     }
 }
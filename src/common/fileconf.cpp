@@ -37,6 +37,7 @@
 #include  "wx/config.h"
 #include  "wx/fileconf.h"
 #include  "wx/filefn.h"
+#include  "wx/vector.h"
 
 #include "wx/base64.h"
 
@@ -88,6 +89,56 @@ static wxString FilterOutEntryName(const wxString& str);
     WX_DEFINE_SORTED_ARRAY(wxFileConfigGroup *, ArrayGroups);
 #endif
 
+// ----------------------------------------------------------------------------
+// hash maps for finding entries and groups by name
+// ----------------------------------------------------------------------------
+
+// The names are compared case-insensitively by default, so the hash function
+// must ignore the case too.
+struct wxFileConfigNameHash
+{
+    size_t operator()(const wxString& name) const
+    {
+#if wxCONFIG_CASE_SENSITIVE
+        return wxStringHash()(name);
+#else
+        size_t hash = 0;
+        for ( wxString::const_iterator i = name.begin(); i != name.end(); ++i )
+            hash = hash * 31 + static_cast<wxChar>(wxTolower(*i));
+
+        return hash;
+#endif
+    }
+};
+
+struct wxFileConfigNameEqual
+{
+    bool operator()(const wxString& name1, const wxString& name2) const
+    {
+#if wxCONFIG_CASE_SENSITIVE
+        return name1 == name2;
+#else
+        return name1.CmpNoCase(name2) == 0;
+#endif
+    }
+};
+
+WX_DECLARE_HASH_MAP(wxString, wxFileConfigEntry *,
+                    wxFileConfigNameHash, wxFileConfigNameEqual,
+                    wxFileConfigEntriesMap);
+WX_DECLARE_HASH_MAP(wxString, wxFileConfigGroup *,
+                    wxFileConfigNameHash, wxFileConfigNameEqual,
+                    wxFileConfigGroupsMap);
+
+// The lines of the local file containing the entries of a group which haven't
+// been parsed yet: they start at the given line and continue until the next
+// group header.
+struct wxFileConfigPendingLines
+{
+    wxFileConfigLineList *pLine;        // the first line
+    size_t                nLine;        // its index in the file
+};
+
 // ----------------------------------------------------------------------------
 // wxFileConfigLineList
 // ----------------------------------------------------------------------------
@@ -172,17 +223,32 @@ private:
   wxFileConfigGroup  *m_pParent;    // parent group (NULL for root group)
   ArrayEntries  m_aEntries;         // entries in this group
   ArrayGroups   m_aSubgroups;       // subgroups
+  wxFileConfigEntriesMap m_mapEntries;  // the same entries and subgroups
+  wxFileConfigGroupsMap  m_mapSubgroups;// indexed by their names
   wxString      m_strName;          // group's name
   wxFileConfigLineList *m_pLine;    // pointer to our line in the linked list
   wxFileConfigEntry *m_pLastEntry;  // last entry/subgroup of this group in the
   wxFileConfigGroup *m_pLastGroup;  // local file (we insert new ones after it)
 
+  // the lines of the local file with our entries which were not parsed yet
+  wxVector<wxFileConfigPendingLines> m_aPendingLines;
+
   // DeleteSubgroupByName helper
   bool DeleteSubgroup(wxFileConfigGroup *pGroup);
 
   // used by Rename()
   void UpdateGroupAndSubgroupsLines();
 
+  // parse the pending lines, creating the entries defined in them
+  void ParsePendingLines();
+
+  // must be called before accessing m_aEntries or m_pLastEntry
+  void EnsureParsed() const
+  {
+    if ( !m_aPendingLines.empty() )
+      const_cast<wxFileConfigGroup *>(this)->ParsePendingLines();
+  }
+
 public:
   // ctor
   wxFileConfigGroup(wxFileConfigGroup *pParent, const wxString& strName, wxFileConfig *);
@@ -195,7 +261,7 @@ public:
   wxFileConfigGroup    *Parent()  const { return m_pParent; }
   wxFileConfig   *Config()  const { return m_pConfig; }
 
-  const ArrayEntries& Entries() const { return m_aEntries;   }
+  const ArrayEntries& Entries() const { EnsureParsed(); return m_aEntries; }
   const ArrayGroups&  Groups()  const { return m_aSubgroups; }
   bool  IsEmpty() const { return Entries().IsEmpty() && Groups().IsEmpty(); }
 
@@ -213,6 +279,10 @@ public:
 
   void SetLine(wxFileConfigLineList *pLine);
 
+  // remember that our entries start at the given line of the local file, but
+  // don't parse them until they're needed
+  void AddPendingLines(wxFileConfigLineList *pLine, size_t nLine);
+
   // rename: no checks are done to ensure that the name is unique!
   void Rename(const wxString& newName);
 
@@ -500,155 +570,205 @@ wxFileConfig::~wxFileConfig()
 
 void wxFileConfig::Parse(const wxTextBuffer& buffer, bool bLocal)
 {
+  // the entries of the local file are only parsed when the group containing
+  // them is accessed, this is the group whose entries start at the next line
+  wxFileConfigGroup *pGroupToParse = bLocal ? m_pRootGroup : NULL;
 
   size_t nLineCount = buffer.GetLineCount();
 
   for ( size_t n = 0; n < nLineCount; n++ )
   {
-    wxString strLine = buffer[n];
-    // FIXME-UTF8: rewrite using iterators, without this buffer
-    wxWxCharBuffer buf(strLine.c_str());
-    const wxChar *pStart;
-    const wxChar *pEnd;
+    const wxString& strLine = buffer[n];
 
-    // add the line to linked list
+    // add the line to linked list: don't use LineListAppend() as logging
+    // every line makes parsing big files too slow
     if ( bLocal )
-      LineListAppend(strLine);
-
+      DoLineListAppend(strLine);
 
     // skip leading spaces
-    for ( pStart = buf; wxIsspace(*pStart); pStart++ )
+    wxString::const_iterator pFirst;
+    for ( pFirst = strLine.begin();
+          pFirst != strLine.end() && wxIsspace(*pFirst);
+          ++pFirst )
       ;
 
-    // skip blank/comment lines
-    if ( *pStart == wxT('\0')|| *pStart == wxT(';') || *pStart == wxT('#') )
+    if ( pFirst == strLine.end() || *pFirst != wxT('[') ) {
+      if ( pGroupToParse ) {
+        pGroupToParse->AddPendingLines(m_linesTail, n);
+        pGroupToParse = NULL;
+      }
+
+      // skip blank/comment lines
+      if ( pFirst == strLine.end() || *pFirst == wxT(';') || *pFirst == wxT('#') )
+        continue;
+
+      // parse the keys of the global file immediately
+      if ( !bLocal )
+        ParseEntryLine(m_pCurrentGroup, strLine, n, NULL);
+
       continue;
+    }
 
-    if ( *pStart == wxT('[') ) {          // a new group
-      pEnd = pStart;
+    // a new group
 
-      while ( *++pEnd != wxT(']') ) {
-        if ( *pEnd == wxT('\\') ) {
-            // the next char is escaped, so skip it even if it is ']'
-            pEnd++;
-        }
+    // FIXME-UTF8: rewrite using iterators, without this buffer
+    wxWxCharBuffer buf(strLine.c_str());
+    const wxChar *pStart;
+    const wxChar *pEnd;
 
-        if ( *pEnd == wxT('\n') || *pEnd == wxT('\0') ) {
-            // we reached the end of line, break out of the loop
-            break;
-        }
-      }
+    // skip leading spaces
+    for ( pStart = buf; wxIsspace(*pStart); pStart++ )
+      ;
+
+    pEnd = pStart;
 
-      if ( *pEnd != wxT(']') ) {
-        wxLogError(_("file '%s': unexpected character %c at line %zu."),
-                   buffer.GetName(), *pEnd, n + 1);
-        continue; // skip this line
+    while ( *++pEnd != wxT(']') ) {
+      if ( *pEnd == wxT('\\') ) {
+          // the next char is escaped, so skip it even if it is ']'
+          pEnd++;
       }
 
-      // group name here is always considered as abs path
-      wxString strGroup;
-      pStart++;
-      strGroup << wxCONFIG_PATH_SEPARATOR
-               << FilterInEntryName(wxString(pStart, pEnd - pStart));
+      if ( *pEnd == wxT('\n') || *pEnd == wxT('\0') ) {
+          // we reached the end of line, break out of the loop
+          break;
+      }
+    }
 
-      // will create it if doesn't yet exist
-      SetPath(strGroup);
+    if ( *pEnd != wxT(']') ) {
+      wxLogError(_("file '%s': unexpected character %c at line %zu."),
+                 buffer.GetName(), *pEnd, n + 1);
 
+      // the entries of the current group continue after this line
       if ( bLocal )
-      {
-        if ( m_pCurrentGroup->Parent() )
-          m_pCurrentGroup->Parent()->SetLastGroup(m_pCurrentGroup);
-        m_pCurrentGroup->SetLine(m_linesTail);
-      }
+        pGroupToParse = m_pCurrentGroup;
 
-      // check that there is nothing except comments left on this line
-      bool bCont = true;
-      while ( *++pEnd != wxT('\0') && bCont ) {
-        switch ( *pEnd ) {
-          case wxT('#'):
-          case wxT(';'):
-            bCont = false;
-            break;
+      continue; // skip this line
+    }
 
-          case wxT(' '):
-          case wxT('\t'):
-            // ignore whitespace ('\n' impossible here)
-            break;
+    // group name here is always considered as abs path
+    wxString strGroup;
+    pStart++;
+    strGroup << wxCONFIG_PATH_SEPARATOR
+             << FilterInEntryName(wxString(pStart, pEnd - pStart));
 
-          default:
-            wxLogWarning(_("file '%s', line %zu: '%s' ignored after group header."),
-                         buffer.GetName(), n + 1, pEnd);
-            bCont = false;
-        }
-      }
+    // will create it if doesn't yet exist
+    SetPath(strGroup);
+
+    if ( bLocal )
+    {
+      if ( m_pCurrentGroup->Parent() )
+        m_pCurrentGroup->Parent()->SetLastGroup(m_pCurrentGroup);
+      m_pCurrentGroup->SetLine(m_linesTail);
+
+      pGroupToParse = m_pCurrentGroup;
     }
-    else {                        // a key
-      pEnd = pStart;
-      while ( *pEnd && *pEnd != wxT('=') /* && !wxIsspace(*pEnd)*/ ) {
-        if ( *pEnd == wxT('\\') ) {
-          // next character may be space or not - still take it because it's
-          // quoted (unless there is nothing)
-          pEnd++;
-          if ( !*pEnd ) {
-            // the error message will be given below anyhow
-            break;
-          }
-        }
 
-        pEnd++;
-      }
+    // check that there is nothing except comments left on this line
+    bool bCont = true;
+    while ( *++pEnd != wxT('\0') && bCont ) {
+      switch ( *pEnd ) {
+        case wxT('#'):
+        case wxT(';'):
+          bCont = false;
+          break;
 
-      wxString strKey(FilterInEntryName(wxString(pStart, pEnd).Trim()));
+        case wxT(' '):
+        case wxT('\t'):
+          // ignore whitespace ('\n' impossible here)
+          break;
 
-      // skip whitespace
-      while ( wxIsspace(*pEnd) )
-        pEnd++;
+        default:
+          wxLogWarning(_("file '%s', line %zu: '%s' ignored after group header."),
+                       buffer.GetName(), n + 1, pEnd);
+          bCont = false;
+      }
+    }
+  }
+}
 
-      if ( *pEnd++ != wxT('=') ) {
-        wxLogError(_("file '%s', line %zu: '=' expected."),
-                   buffer.GetName(), n + 1);
+void wxFileConfig::ParseEntryLine(wxFileConfigGroup *pGroup,
+                                  const wxString& strLine,
+                                  size_t n,
+                                  wxFileConfigLineList *pLine)
+{
+  // the line is in the local file if we have it in the linked list
+  const bool bLocal = pLine != NULL;
+  const wxString filename = bLocal ? m_fnLocalFile.GetFullPath()
+                                   : m_fnGlobalFile.GetFullPath();
+
+  // FIXME-UTF8: rewrite using iterators, without this buffer
+  wxWxCharBuffer buf(strLine.c_str());
+  const wxChar *pStart;
+  const wxChar *pEnd;
+
+  // skip leading spaces
+  for ( pStart = buf; wxIsspace(*pStart); pStart++ )
+    ;
+
+  pEnd = pStart;
+  while ( *pEnd && *pEnd != wxT('=') /* && !wxIsspace(*pEnd)*/ ) {
+    if ( *pEnd == wxT('\\') ) {
+      // next character may be space or not - still take it because it's
+      // quoted (unless there is nothing)
+      pEnd++;
+      if ( !*pEnd ) {
+        // the error message will be given below anyhow
+        break;
       }
-      else {
-        wxFileConfigEntry *pEntry = m_pCurrentGroup->FindEntry(strKey);
+    }
 
-        if ( pEntry == NULL ) {
-          // new entry
-          pEntry = m_pCurrentGroup->AddEntry(strKey, n);
-        }
-        else {
-          if ( bLocal && pEntry->IsImmutable() ) {
-            // immutable keys can't be changed by user
-            wxLogWarning(_("file '%s', line %zu: value for immutable key '%s' ignored."),
-                         buffer.GetName(), n + 1, strKey);
-            continue;
-          }
-          // the condition below catches the cases (a) and (b) but not (c):
-          //  (a) global key found second time in global file
-          //  (b) key found second (or more) time in local file
-          //  (c) key from global file now found in local one
-          // which is exactly what we want.
-          else if ( !bLocal || pEntry->IsLocal() ) {
-            wxLogWarning(_("file '%s', line %zu: key '%s' was first found at line %d."),
-                         buffer.GetName(), n + 1, strKey, pEntry->Line());
-
-          }
-        }
+    pEnd++;
+  }
 
-        if ( bLocal )
-          pEntry->SetLine(m_linesTail);
+  wxString strKey(FilterInEntryName(wxString(pStart, pEnd).Trim()));
 
-        // skip whitespace
-        while ( wxIsspace(*pEnd) )
-          pEnd++;
+  // skip whitespace
+  while ( wxIsspace(*pEnd) )
+    pEnd++;
 
-        wxString value = pEnd;
-        if ( !(GetStyle() & wxCONFIG_USE_NO_ESCAPE_CHARACTERS) )
-            value = FilterInValue(value);
+  if ( *pEnd++ != wxT('=') ) {
+    wxLogError(_("file '%s', line %zu: '=' expected."),
+               filename, n + 1);
+    return;
+  }
+
+  wxFileConfigEntry *pEntry = pGroup->FindEntry(strKey);
+
+  if ( pEntry == NULL ) {
+    // new entry
+    pEntry = pGroup->AddEntry(strKey, n);
+  }
+  else {
+    if ( bLocal && pEntry->IsImmutable() ) {
+      // immutable keys can't be changed by user
+      wxLogWarning(_("file '%s', line %zu: value for immutable key '%s' ignored."),
+                   filename, n + 1, strKey);
+      return;
+    }
+    // the condition below catches the cases (a) and (b) but not (c):
+    //  (a) global key found second time in global file
+    //  (b) key found second (or more) time in local file
+    //  (c) key from global file now found in local one
+    // which is exactly what we want.
+    else if ( !bLocal || pEntry->IsLocal() ) {
+      wxLogWarning(_("file '%s', line %zu: key '%s' was first found at line %d."),
+                   filename, n + 1, strKey, pEntry->Line());
 
-        pEntry->SetValue(value, false);
-      }
     }
   }
+
+  if ( bLocal )
+    pEntry->SetLine(pLine);
+
+  // skip whitespace
+  while ( wxIsspace(*pEnd) )
+    pEnd++;
+
+  wxString value = pEnd;
+  if ( !(GetStyle() & wxCONFIG_USE_NO_ESCAPE_CHARACTERS) )
+      value = FilterInValue(value);
+
+  pEntry->SetValue(value, false);
 }
 
 // ----------------------------------------------------------------------------
@@ -987,12 +1107,24 @@ bool wxFileConfig::Flush(bool /* bCurrentOnly */)
     return false;
   }
 
-  // write all strings to file
+  // write all strings to file, computing the total size first to avoid
+  // reallocating the buffer many times for big files
+  const wxChar* const eol = wxTextFile::GetEOL();
+  const size_t lenEOL = wxStrlen(eol);
+
+  size_t len = 0;
+  wxFileConfigLineList *p;
+  for ( p = m_linesHead; p != NULL; p = p->Next() )
+  {
+    len += p->Text().length() + lenEOL;
+  }
+
   wxString filetext;
-  filetext.reserve(4096);
-  for ( wxFileConfigLineList *p = m_linesHead; p != NULL; p = p->Next() )
+  filetext.reserve(len);
+  for ( p = m_linesHead; p != NULL; p = p->Next() )
   {
-    filetext << p->Text() << wxTextFile::GetEOL();
+    filetext += p->Text();
+    filetext += eol;
   }
 
   if ( !file.Write(filetext, *m_conv) )
@@ -1155,20 +1287,8 @@ bool wxFileConfig::DeleteAll()
 
     // append a new line to the end of the list
 
-wxFileConfigLineList *wxFileConfig::LineListAppend(const wxString& str)
+void wxFileConfig::DoLineListAppend(const wxString& str)
 {
-    wxLogTrace( FILECONF_TRACE_MASK,
-                wxT("    ** Adding Line '%s'"),
-                str );
-    wxLogTrace( FILECONF_TRACE_MASK,
-                wxT("        head: %s"),
-                ((m_linesHead) ? m_linesHead->Text()
-                               : wxString()) );
-    wxLogTrace( FILECONF_TRACE_MASK,
-                wxT("        tail: %s"),
-                ((m_linesTail) ? m_linesTail->Text()
-                               : wxString()) );
-
     wxFileConfigLineList *pLine = new wxFileConfigLineList(str);
 
     if ( m_linesTail == NULL )
@@ -1184,6 +1304,23 @@ wxFileConfigLineList *wxFileConfig::LineListAppend(const wxString& str)
     }
 
     m_linesTail = pLine;
+}
+
+wxFileConfigLineList *wxFileConfig::LineListAppend(const wxString& str)
+{
+    wxLogTrace( FILECONF_TRACE_MASK,
+                wxT("    ** Adding Line '%s'"),
+                str );
+    wxLogTrace( FILECONF_TRACE_MASK,
+                wxT("        head: %s"),
+                ((m_linesHead) ? m_linesHead->Text()
+                               : wxString()) );
+    wxLogTrace( FILECONF_TRACE_MASK,
+                wxT("        tail: %s"),
+                ((m_linesTail) ? m_linesTail->Text()
+                               : wxString()) );
+
+    DoLineListAppend(str);
 
     wxLogTrace( FILECONF_TRACE_MASK,
                 wxT("        head: %s"),
@@ -1348,6 +1485,50 @@ void wxFileConfigGroup::SetLine(wxFileConfigLineList *pLine)
     m_pLine = pLine;
 }
 
+void wxFileConfigGroup::AddPendingLines(wxFileConfigLineList *pLine, size_t nLine)
+{
+    wxFileConfigPendingLines lines;
+    lines.pLine = pLine;
+    lines.nLine = nLine;
+
+    m_aPendingLines.push_back(lines);
+}
+
+void wxFileConfigGroup::ParsePendingLines()
+{
+    // Take the pending lines first: parsing them calls our own methods which
+    // would otherwise try to parse them again.
+    wxVector<wxFileConfigPendingLines> aPendingLines;
+    aPendingLines.swap(m_aPendingLines);
+
+    for ( size_t n = 0; n < aPendingLines.size(); n++ )
+    {
+        size_t nLine = aPendingLines[n].nLine;
+        for ( wxFileConfigLineList *pLine = aPendingLines[n].pLine;
+              pLine;
+              pLine = pLine->Next(), nLine++ )
+        {
+            const wxString& strLine = pLine->Text();
+
+            wxString::const_iterator pFirst;
+            for ( pFirst = strLine.begin();
+                  pFirst != strLine.end() && wxIsspace(*pFirst);
+                  ++pFirst )
+                ;
+
+            if ( pFirst == strLine.end() ||
+                    *pFirst == wxT(';') || *pFirst == wxT('#') )
+                continue;
+
+            // our entries end at the next group header
+            if ( *pFirst == wxT('[') )
+                break;
+
+            m_pConfig->ParseEntryLine(this, strLine, nLine, pLine);
+        }
+    }
+}
+
 /*
   This is a bit complicated, so let me explain it in details. All lines that
   were read from the local file (the only one we will ever modify) are stored
@@ -1448,6 +1629,8 @@ wxFileConfigLineList *wxFileConfigGroup::GetLastEntryLine()
                 wxT("  GetLastEntryLine() for Group '%s'"),
                 Name() );
 
+    EnsureParsed();
+
     if ( m_pLastEntry )
     {
         wxFileConfigLineList    *pLine = m_pLastEntry->GetLine();
@@ -1509,10 +1692,12 @@ void wxFileConfigGroup::Rename(const wxString& newName)
     // we need to remove the group from the parent and it back under the new
     // name to keep the parents array of subgroups alphabetically sorted
     m_pParent->m_aSubgroups.Remove(this);
+    m_pParent->m_mapSubgroups.erase(m_strName);
 
     m_strName = newName;
 
     m_pParent->m_aSubgroups.Add(this);
+    m_pParent->m_mapSubgroups[m_strName] = this;
 
     // update the group lines recursively
     UpdateGroupAndSubgroupsLines();
@@ -1531,67 +1716,22 @@ wxString wxFileConfigGroup::GetFullName() const
 // find an item
 // ----------------------------------------------------------------------------
 
-// use binary search because the array is sorted
 wxFileConfigEntry *
 wxFileConfigGroup::FindEntry(const wxString& name) const
 {
-  size_t
-       lo = 0,
-       hi = m_aEntries.GetCount();
-  wxFileConfigEntry *pEntry;
-
-  while ( lo < hi ) {
-    size_t i;
-    i = (lo + hi)/2;
-    pEntry = m_aEntries[i];
-
-    int res;
-    #if wxCONFIG_CASE_SENSITIVE
-      res = pEntry->Name().compare(name);
-    #else
-      res = pEntry->Name().CmpNoCase(name);
-    #endif
-
-    if ( res > 0 )
-      hi = i;
-    else if ( res < 0 )
-      lo = i + 1;
-    else
-      return pEntry;
-  }
+  EnsureParsed();
+
+  const wxFileConfigEntriesMap::const_iterator it = m_mapEntries.find(name);
 
-  return NULL;
+  return it == m_mapEntries.end() ? NULL : it->second;
 }
 
 wxFileConfigGroup *
 wxFileConfigGroup::FindSubgroup(const wxString& name) const
 {
-  size_t
-       lo = 0,
-       hi = m_aSubgroups.GetCount();
-  wxFileConfigGroup *pGroup;
-
-  while ( lo < hi ) {
-    size_t i;
-    i = (lo + hi)/2;
-    pGroup = m_aSubgroups[i];
-
-    int res;
-    #if wxCONFIG_CASE_SENSITIVE
-      res = pGroup->Name().compare(name);
-    #else
-      res = pGroup->Name().CmpNoCase(name);
-    #endif
-
-    if ( res > 0 )
-      hi = i;
-    else if ( res < 0 )
-      lo = i + 1;
-    else
-      return pGroup;
-  }
+  const wxFileConfigGroupsMap::const_iterator it = m_mapSubgroups.find(name);
 
-  return NULL;
+  return it == m_mapSubgroups.end() ? NULL : it->second;
 }
 
 // ----------------------------------------------------------------------------
@@ -1606,6 +1746,7 @@ wxFileConfigEntry *wxFileConfigGroup::AddEntry(const wxString& strName, int nLin
     wxFileConfigEntry   *pEntry = new wxFileConfigEntry(this, strName, nLine);
 
     m_aEntries.Add(pEntry);
+    m_mapEntries[pEntry->Name()] = pEntry;
     return pEntry;
 }
 
@@ -1617,6 +1758,7 @@ wxFileConfigGroup *wxFileConfigGroup::AddSubgroup(const wxString& strName)
     wxFileConfigGroup   *pGroup = new wxFileConfigGroup(this, strName, m_pConfig);
 
     m_aSubgroups.Add(pGroup);
+    m_mapSubgroups[pGroup->Name()] = pGroup;
     return pGroup;
 }
 
@@ -1660,6 +1802,7 @@ bool wxFileConfigGroup::DeleteSubgroup(wxFileConfigGroup *pGroup)
                         : wxString() );
 
     // delete all entries...
+    pGroup->EnsureParsed();
     size_t nCount = pGroup->m_aEntries.GetCount();
 
     wxLogTrace(FILECONF_TRACE_MASK,
@@ -1747,6 +1890,7 @@ bool wxFileConfigGroup::DeleteSubgroup(wxFileConfigGroup *pGroup)
     }
 
     m_aSubgroups.Remove(pGroup);
+    m_mapSubgroups.erase(pGroup->Name());
     delete pGroup;
 
     return true;
@@ -1795,6 +1939,7 @@ bool wxFileConfigGroup::DeleteEntry(const wxString& name)
   }
 
   m_aEntries.Remove(pEntry);
+  m_mapEntries.erase(pEntry->Name());
   delete pEntry;
 
   return true;
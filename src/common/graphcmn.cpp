@@ -37,6 +37,8 @@
 #include "wx/private/rescale.h"
 #include "wx/display.h"
 
+#include <vector>
+
 //-----------------------------------------------------------------------------
 
 //-----------------------------------------------------------------------------
@@ -851,6 +853,29 @@ void wxGraphicsContext::StrokeLines( size_t n, const wxPoint2DDouble *beginPoint
     StrokePath( path );
 }
 
+void wxGraphicsContext::FillRectangles( size_t n, const wxRect2DDouble *rects)
+{
+    wxGraphicsPath path = CreatePath();
+    for ( size_t i = 0; i < n; ++i )
+        path.AddRectangle(rects[i].m_x, rects[i].m_y, rects[i].m_width, rects[i].m_height);
+    FillPath( path, wxWINDING_RULE );
+}
+
+void wxGraphicsContext::DrawMarkers( size_t n, const wxPoint2DDouble *points, const wxGraphicsPath& marker)
+{
+    wxGraphicsPath path = CreatePath();
+    wxGraphicsMatrix matrix = CreateMatrix();
+    for ( size_t i = 0; i < n; ++i )
+    {
+        matrix.Set(1.0, 0.0, 0.0, 1.0, points[i].m_x, points[i].m_y);
+
+        wxGraphicsPath translated = marker;
+        translated.Transform(matrix);
+        path.AddPath(translated);
+    }
+    DrawPath( path, wxWINDING_RULE );
+}
+
 // create a 'native' matrix corresponding to these values
 wxGraphicsMatrix wxGraphicsContext::CreateMatrix( wxDouble a, wxDouble b, wxDouble c, wxDouble d,
     wxDouble tx, wxDouble ty) const
@@ -1064,6 +1089,772 @@ wxGraphicsContext* wxGraphicsContext::Create()
     return wxGraphicsRenderer::GetDefaultRenderer()->CreateMeasuringContext();
 }
 
+//-----------------------------------------------------------------------------
+// wxGraphicsDisplayList
+//-----------------------------------------------------------------------------
+
+namespace
+{
+
+enum DisplayListOp
+{
+    DLOp_PushState,
+    DLOp_PopState,
+    DLOp_ClipRegion,
+    DLOp_ClipRect,
+    DLOp_ResetClip,
+    DLOp_SetAntialiasMode,
+    DLOp_SetInterpolationQuality,
+    DLOp_SetCompositionMode,
+    DLOp_BeginLayer,
+    DLOp_EndLayer,
+    DLOp_Translate,
+    DLOp_Scale,
+    DLOp_Rotate,
+    DLOp_ConcatTransform,
+    DLOp_SetTransform,
+    DLOp_SetPen,
+    DLOp_SetBrush,
+    DLOp_SetFont,
+
+    // All the commands below actually draw something and may be skipped when
+    // replaying only a part of the list.
+    DLOp_StrokePath,
+    DLOp_FillPath,
+    DLOp_ClearRectangle,
+    DLOp_DrawText,
+    DLOp_DrawBitmap,
+    DLOp_DrawIcon
+};
+
+struct DisplayListCommand
+{
+    explicit DisplayListCommand(DisplayListOp op_)
+        : op(op_),
+          param(0),
+          bounded(false)
+    {
+        args[0] =
+        args[1] =
+        args[2] =
+        args[3] = 0;
+    }
+
+    bool IsDrawing() const { return op >= DLOp_StrokePath; }
+
+    DisplayListOp op;
+
+    // Coordinates, sizes, angle or opacity, depending on the command.
+    wxDouble args[4];
+
+    // Mode value, fill style or index into one of the side tables.
+    int param;
+
+    // Path, pen, brush, font, matrix or bitmap used by the command, if any.
+    wxGraphicsObject obj;
+
+    // For the drawing commands only: the area affected by the command in the
+    // list coordinates, if it could be determined.
+    bool bounded;
+    wxRect2DDouble box;
+};
+
+// Return the object stored in the command as the given wxGraphicsObject-derived
+// type.
+template <typename T>
+T GetCommandObject(const DisplayListCommand& cmd)
+{
+    T obj;
+    obj.Ref(cmd.obj);
+    return obj;
+}
+
+} // anonymous namespace
+
+class wxGraphicsDisplayListData
+{
+public:
+    wxGraphicsDisplayListData() : m_renderer(NULL) { }
+
+    void Clear()
+    {
+        m_commands.clear();
+        m_texts.clear();
+        m_regions.clear();
+        m_icons.clear();
+    }
+
+    // The renderer which created all the objects stored in the list.
+    wxGraphicsRenderer* m_renderer;
+
+    std::vector<DisplayListCommand> m_commands;
+
+    // Less frequently used data referenced by DisplayListCommand::param.
+    std::vector<wxString> m_texts;
+    std::vector<wxRegion> m_regions;
+    std::vector<wxIcon> m_icons;
+};
+
+namespace
+{
+
+// The context returned by wxGraphicsDisplayList::CreateRecordingContext():
+// it doesn't draw anything but appends all the commands to the list, keeping
+// track of the current transformation to compute their bounding boxes.
+class wxRecordingGraphicsContext : public wxGraphicsContext
+{
+public:
+    wxRecordingGraphicsContext(wxGraphicsRenderer* renderer,
+                               wxGraphicsDisplayListData* data,
+                               wxDouble width, wxDouble height)
+        : wxGraphicsContext(renderer),
+          m_data(data)
+    {
+        m_width = width;
+        m_height = height;
+        m_layers = 0;
+        m_penExtent = -1;
+        m_measuringContext = NULL;
+    }
+
+    virtual ~wxRecordingGraphicsContext()
+    {
+        delete m_measuringContext;
+    }
+
+    virtual void PushState() override
+    {
+        m_matrixStack.push_back(m_matrix);
+        Add(DLOp_PushState);
+    }
+
+    virtual void PopState() override
+    {
+        wxCHECK_RET( !m_matrixStack.empty(), "No state to pop" );
+
+        m_matrix = m_matrixStack.back();
+        m_matrixStack.pop_back();
+        Add(DLOp_PopState);
+    }
+
+    virtual void Clip(const wxRegion& region) override
+    {
+        Add(DLOp_ClipRegion).param = static_cast<int>(m_data->m_regions.size());
+        m_data->m_regions.push_back(region);
+    }
+
+    virtual void Clip(wxDouble x, wxDouble y, wxDouble w, wxDouble h) override
+    {
+        SetArgs(Add(DLOp_ClipRect), x, y, w, h);
+    }
+
+    virtual void ResetClip() override
+    {
+        Add(DLOp_ResetClip);
+    }
+
+    virtual void GetClipBox(wxDouble* x, wxDouble* y,
+                            wxDouble* w, wxDouble* h) override
+    {
+        // We don't keep track of the clipping region, just return the entire
+        // recording area.
+        if ( x )
+            *x = 0;
+        if ( y )
+            *y = 0;
+        if ( w )
+            *w = m_width;
+        if ( h )
+            *h = m_height;
+    }
+
+    virtual void* GetNativeContext() override
+    {
+        return NULL;
+    }
+
+    virtual bool SetAntialiasMode(wxAntialiasMode antialias) override
+    {
+        m_antialias = antialias;
+        Add(DLOp_SetAntialiasMode).param = antialias;
+        return true;
+    }
+
+    virtual bool SetInterpolationQuality(wxInterpolationQuality interpolation) override
+    {
+        m_interpolation = interpolation;
+        Add(DLOp_SetInterpolationQuality).param = interpolation;
+        return true;
+    }
+
+    virtual bool SetCompositionMode(wxCompositionMode op) override
+    {
+        m_composition = op;
+        Add(DLOp_SetCompositionMode).param = op;
+        return true;
+    }
+
+    virtual void BeginLayer(wxDouble opacity) override
+    {
+        m_layers++;
+        Add(DLOp_BeginLayer).args[0] = opacity;
+    }
+
+    virtual void EndLayer() override
+    {
+        wxCHECK_RET( m_layers > 0, "No layer to end" );
+
+        m_layers--;
+        Add(DLOp_EndLayer);
+    }
+
+    virtual void Translate(wxDouble dx, wxDouble dy) override
+    {
+        m_matrix.Translate(dx, dy);
+        SetArgs(Add(DLOp_Translate), dx, dy);
+    }
+
+    virtual void Scale(wxDouble xScale, wxDouble yScale) override
+    {
+        m_matrix.Scale(xScale, yScale);
+        SetArgs(Add(DLOp_Scale), xScale, yScale);
+    }
+
+    virtual void Rotate(wxDouble angle) override
+    {
+        m_matrix.Rotate(angle);
+        Add(DLOp_Rotate).args[0] = angle;
+    }
+
+    virtual void ConcatTransform(const wxGraphicsMatrix& matrix) override
+    {
+        m_matrix.Concat(ToAffine(matrix));
+        Add(DLOp_ConcatTransform).obj = matrix;
+    }
+
+    virtual void SetTransform(const wxGraphicsMatrix& matrix) override
+    {
+        m_matrix = ToAffine(matrix);
+        Add(DLOp_SetTransform).obj = matrix;
+    }
+
+    virtual wxGraphicsMatrix GetTransform() const override
+    {
+        return CreateMatrix(m_matrix);
+    }
+
+    virtual void SetPen(const wxGraphicsPen& pen) override
+    {
+        wxGraphicsContext::SetPen(pen);
+
+        m_penExtent = -1;
+        for ( size_t n = m_knownPens.size(); n > 0; n-- )
+        {
+            if ( m_knownPens[n - 1].first.GetRefData() == pen.GetRefData() )
+            {
+                m_penExtent = m_knownPens[n - 1].second;
+                break;
+            }
+        }
+
+        Add(DLOp_SetPen).obj = pen;
+    }
+
+    virtual void SetBrush(const wxGraphicsBrush& brush) override
+    {
+        wxGraphicsContext::SetBrush(brush);
+        Add(DLOp_SetBrush).obj = brush;
+    }
+
+    virtual void SetFont(const wxGraphicsFont& font) override
+    {
+        wxGraphicsContext::SetFont(font);
+        if ( m_measuringContext )
+            m_measuringContext->SetFont(font);
+        Add(DLOp_SetFont).obj = font;
+    }
+
+    virtual void StrokePath(const wxGraphicsPath& path) override
+    {
+        // Stroking with a null pen doesn't do anything, so don't record it.
+        if ( m_pen.IsNull() )
+            return;
+
+        DisplayListCommand& cmd = Add(DLOp_StrokePath);
+        cmd.obj = path;
+
+        // We can only know how far the stroke extends if the pen was created
+        // by this context.
+        if ( m_penExtent >= 0 )
+            SetBox(cmd, path.GetBox(), m_penExtent, m_penExtent);
+    }
+
+    virtual void FillPath(const wxGraphicsPath& path,
+                          wxPolygonFillMode fillStyle = wxODDEVEN_RULE) override
+    {
+        if ( m_brush.IsNull() )
+            return;
+
+        DisplayListCommand& cmd = Add(DLOp_FillPath);
+        cmd.obj = path;
+        cmd.param = fillStyle;
+        SetBox(cmd, path.GetBox());
+    }
+
+    virtual void ClearRectangle(wxDouble x, wxDouble y,
+                                wxDouble w, wxDouble h) override
+    {
+        DisplayListCommand& cmd = Add(DLOp_ClearRectangle);
+        SetArgs(cmd, x, y, w, h);
+        SetBox(cmd, wxRect2DDouble(x, y, w, h));
+    }
+
+    virtual void GetTextExtent(const wxString& text,
+                               wxDouble* width, wxDouble* height,
+                               wxDouble* descent = NULL,
+                               wxDouble* externalLeading = NULL) const override
+    {
+        if ( wxGraphicsContext* const gc = GetMeasuringContext() )
+        {
+            gc->GetTextExtent(text, width, height, descent, externalLeading);
+            return;
+        }
+
+        if ( width )
+            *width = 0;
+        if ( height )
+            *height = 0;
+        if ( descent )
+            *descent = 0;
+        if ( externalLeading )
+            *externalLeading = 0;
+    }
+
+    virtual void GetPartialTextExtents(const wxString& text,
+                                       wxArrayDouble& widths) const override
+    {
+        if ( wxGraphicsContext* const gc = GetMeasuringContext() )
+            gc->GetPartialTextExtents(text, widths);
+        else
+            widths.assign(text.length(), 0);
+    }
+
+    virtual void DrawBitmap(const wxGraphicsBitmap& bmp,
+                            wxDouble x, wxDouble y,
+                            wxDouble w, wxDouble h) override
+    {
+        DisplayListCommand& cmd = Add(DLOp_DrawBitmap);
+        cmd.obj = bmp;
+        SetArgs(cmd, x, y, w, h);
+        SetBox(cmd, wxRect2DDouble(x, y, w, h));
+    }
+
+    virtual void DrawBitmap(const wxBitmap& bmp,
+                            wxDouble x, wxDouble y,
+                            wxDouble w, wxDouble h) override
+    {
+        wxCHECK_RET( bmp.IsOk(), "Invalid bitmap" );
+
+        // Convert the bitmap just once, when recording, and not every time
+        // the list is replayed.
+        DrawBitmap(CreateBitmap(bmp), x, y, w, h);
+    }
+
+    virtual void DrawIcon(const wxIcon& icon,
+                          wxDouble x, wxDouble y,
+                          wxDouble w, wxDouble h) override
+    {
+        DisplayListCommand& cmd = Add(DLOp_DrawIcon);
+        cmd.param = static_cast<int>(m_data->m_icons.size());
+        m_data->m_icons.push_back(icon);
+        SetArgs(cmd, x, y, w, h);
+        SetBox(cmd, wxRect2DDouble(x, y, w, h));
+    }
+
+#ifdef __WXMSW__
+    virtual WXHDC GetNativeHDC() override { return NULL; }
+    virtual void ReleaseNativeHDC(WXHDC WXUNUSED(hdc)) override { }
+#endif
+
+protected:
+    virtual wxGraphicsPen DoCreatePen(const wxGraphicsPenInfo& info) const override
+    {
+        const wxGraphicsPen pen = wxGraphicsContext::DoCreatePen(info);
+
+        // Remember how far the stroke can extend beyond the path, taking into
+        // account that zero width pens are still drawn 1 pixel wide and the
+        // miter joins may protrude much further than the pen width (Cairo
+        // default miter limit is 10).
+        wxDouble extent = wxMax(info.GetWidth(), 1.0) / 2;
+        if ( info.GetJoin() == wxJOIN_MITER )
+            extent *= 10;
+        m_knownPens.push_back(std::make_pair(pen, extent));
+
+        return pen;
+    }
+
+    virtual void DoDrawText(const wxString& str, wxDouble x, wxDouble y) override
+    {
+        wxCHECK_RET( !m_font.IsNull(),
+                     "wxGraphicsContext::DrawText - no valid font set" );
+
+        DisplayListCommand& cmd = Add(DLOp_DrawText);
+        cmd.param = static_cast<int>(m_data->m_texts.size());
+        m_data->m_texts.push_back(str);
+        SetArgs(cmd, x, y);
+
+        // Without a measuring context the text extent is unknown, so leave
+        // the command unbounded to ensure that it is never skipped.
+        wxGraphicsContext* const gc = GetMeasuringContext();
+        if ( !gc )
+            return;
+
+        wxDouble w, h;
+        gc->GetTextExtent(str, &w, &h);
+        if ( w <= 0 || h <= 0 )
+            return;
+
+        // Allow for the glyphs slightly overhanging their advance width, as
+        // happens with italic fonts.
+        SetBox(cmd, wxRect2DDouble(x, y, w, h), h / 4, 0);
+    }
+
+private:
+    DisplayListCommand& Add(DisplayListOp op)
+    {
+        m_data->m_commands.push_back(DisplayListCommand(op));
+        return m_data->m_commands.back();
+    }
+
+    static void SetArgs(DisplayListCommand& cmd,
+                        wxDouble a0, wxDouble a1,
+                        wxDouble a2 = 0, wxDouble a3 = 0)
+    {
+        cmd.args[0] = a0;
+        cmd.args[1] = a1;
+        cmd.args[2] = a2;
+        cmd.args[3] = a3;
+    }
+
+    // Set the command bounding box to the given rectangle in the current user
+    // coordinates, inflated by the given amounts, converted to the list
+    // coordinates.
+    void SetBox(DisplayListCommand& cmd, const wxRect2DDouble& rect,
+                wxDouble dx = 0, wxDouble dy = 0) const
+    {
+        const wxPoint2DDouble corners[] =
+        {
+            wxPoint2DDouble(rect.m_x - dx, rect.m_y - dy),
+            wxPoint2DDouble(rect.m_x + rect.m_width + dx, rect.m_y - dy),
+            wxPoint2DDouble(rect.m_x - dx, rect.m_y + rect.m_height + dy),
+            wxPoint2DDouble(rect.m_x + rect.m_width + dx, rect.m_y + rect.m_height + dy),
+        };
+
+        wxPoint2DDouble pt = m_matrix.TransformPoint(corners[0]);
+        wxDouble left = pt.m_x,
+                 right = pt.m_x,
+                 top = pt.m_y,
+                 bottom = pt.m_y;
+        for ( size_t n = 1; n < WXSIZEOF(corners); n++ )
+        {
+            pt = m_matrix.TransformPoint(corners[n]);
+            left = wxMin(left, pt.m_x);
+            right = wxMax(right, pt.m_x);
+            top = wxMin(top, pt.m_y);
+            bottom = wxMax(bottom, pt.m_y);
+        }
+
+        // Round outwards to whole pixels to account for antialiasing.
+        cmd.box = wxRect2DDouble(floor(left) - 1, floor(top) - 1,
+                                 ceil(right) - floor(left) + 2,
+                                 ceil(bottom) - floor(top) + 2);
+        cmd.bounded = true;
+    }
+
+    static wxAffineMatrix2D ToAffine(const wxGraphicsMatrix& matrix)
+    {
+        wxDouble a, b, c, d, tx, ty;
+        matrix.Get(&a, &b, &c, &d, &tx, &ty);
+
+        wxAffineMatrix2D m;
+        m.Set(wxMatrix2D(a, b, c, d), wxPoint2DDouble(tx, ty));
+        return m;
+    }
+
+    wxGraphicsContext* GetMeasuringContext() const
+    {
+        if ( m_font.IsNull() )
+            return NULL;
+
+        if ( !m_measuringContext )
+        {
+            m_measuringContext = GetRenderer()->CreateMeasuringContext();
+            if ( m_measuringContext )
+                m_measuringContext->SetFont(m_font);
+        }
+
+        return m_measuringContext;
+    }
+
+    wxGraphicsDisplayListData* const m_data;
+
+    // The current transformation and the ones saved by PushState().
+    wxAffineMatrix2D m_matrix;
+    std::vector<wxAffineMatrix2D> m_matrixStack;
+
+    // Number of currently open layers.
+    int m_layers;
+
+    // Pens created by this context and their stroke extents, used to find the
+    // extent of the current pen, which is -1 if unknown.
+    mutable std::vector< std::pair<wxGraphicsPen, wxDouble> > m_knownPens;
+    wxDouble m_penExtent;
+
+    mutable wxGraphicsContext* m_measuringContext;
+};
+
+} // anonymous namespace
+
+wxGraphicsDisplayList::wxGraphicsDisplayList()
+    : m_data(new wxGraphicsDisplayListData())
+{
+}
+
+wxGraphicsDisplayList::~wxGraphicsDisplayList()
+{
+    delete m_data;
+}
+
+wxGraphicsContext*
+wxGraphicsDisplayList::CreateRecordingContext(wxDouble width,
+                                              wxDouble height,
+                                              wxGraphicsRenderer* renderer)
+{
+    if ( !renderer )
+        renderer = wxGraphicsRenderer::GetDefaultRenderer();
+
+    wxCHECK_MSG( renderer, NULL, "No graphics renderer" );
+    wxCHECK_MSG( m_data->m_commands.empty() || renderer == m_data->m_renderer,
+                 NULL, "All commands must use the same renderer" );
+
+    m_data->m_renderer = renderer;
+
+    return new wxRecordingGraphicsContext(renderer, m_data, width, height);
+}
+
+void wxGraphicsDisplayList::Clear()
+{
+    m_data->Clear();
+}
+
+size_t wxGraphicsDisplayList::GetCount() const
+{
+    return m_data->m_commands.size();
+}
+
+wxRect2DDouble wxGraphicsDisplayList::GetBoundingBox() const
+{
+    bool found = false;
+    wxDouble left = 0,
+             right = 0,
+             top = 0,
+             bottom = 0;
+    for ( size_t n = 0; n < m_data->m_commands.size(); n++ )
+    {
+        const DisplayListCommand& cmd = m_data->m_commands[n];
+        if ( !cmd.bounded )
+            continue;
+
+        if ( !found )
+        {
+            left = cmd.box.GetLeft();
+            right = cmd.box.GetRight();
+            top = cmd.box.GetTop();
+            bottom = cmd.box.GetBottom();
+            found = true;
+            continue;
+        }
+
+        left = wxMin(left, cmd.box.GetLeft());
+        right = wxMax(right, cmd.box.GetRight());
+        top = wxMin(top, cmd.box.GetTop());
+        bottom = wxMax(bottom, cmd.box.GetBottom());
+    }
+
+    return wxRect2DDouble(left, top, right - left, bottom - top);
+}
+
+void wxGraphicsDisplayList::Replay(wxGraphicsContext& gc) const
+{
+    DoReplay(gc, NULL);
+}
+
+void wxGraphicsDisplayList::Replay(wxGraphicsContext& gc,
+                                   const wxRect2DDouble& area) const
+{
+    DoReplay(gc, &area);
+}
+
+void wxGraphicsDisplayList::DoReplay(wxGraphicsContext& gc,
+                                     const wxRect2DDouble* area) const
+{
+    if ( m_data->m_commands.empty() )
+        return;
+
+    wxCHECK_RET( gc.GetRenderer() == m_data->m_renderer,
+                 "Display list must be replayed using the same renderer" );
+
+    // Save everything that the recorded commands may change to restore it
+    // when we're done.
+    const wxGraphicsPen pen = gc.m_pen;
+    const wxGraphicsBrush brush = gc.m_brush;
+    const wxGraphicsFont font = gc.m_font;
+    const wxAntialiasMode antialias = gc.GetAntialiasMode();
+    const wxInterpolationQuality interpolation = gc.GetInterpolationQuality();
+    const wxCompositionMode composition = gc.GetCompositionMode();
+
+    gc.PushState();
+
+    // Absolute transformations in the list are relative to this one.
+    const wxGraphicsMatrix base = gc.GetTransform();
+
+    int states = 0,
+        layers = 0;
+
+    const std::vector<DisplayListCommand>& commands = m_data->m_commands;
+    for ( size_t n = 0; n < commands.size(); n++ )
+    {
+        const DisplayListCommand& cmd = commands[n];
+        if ( area && cmd.bounded && !cmd.box.Intersects(*area) )
+            continue;
+
+        const wxDouble* const args = cmd.args;
+        switch ( cmd.op )
+        {
+            case DLOp_PushState:
+                gc.PushState();
+                states++;
+                break;
+
+            case DLOp_PopState:
+                gc.PopState();
+                states--;
+                break;
+
+            case DLOp_ClipRegion:
+                gc.Clip(m_data->m_regions[cmd.param]);
+                break;
+
+            case DLOp_ClipRect:
+                gc.Clip(args[0], args[1], args[2], args[3]);
+                break;
+
+            case DLOp_ResetClip:
+                gc.ResetClip();
+                break;
+
+            case DLOp_SetAntialiasMode:
+                gc.SetAntialiasMode(static_cast<wxAntialiasMode>(cmd.param));
+                break;
+
+            case DLOp_SetInterpolationQuality:
+                gc.SetInterpolationQuality(
+                    static_cast<wxInterpolationQuality>(cmd.param));
+                break;
+
+            case DLOp_SetCompositionMode:
+                gc.SetCompositionMode(static_cast<wxCompositionMode>(cmd.param));
+                break;
+
+            case DLOp_BeginLayer:
+                gc.BeginLayer(args[0]);
+                layers++;
+                break;
+
+            case DLOp_EndLayer:
+                gc.EndLayer();
+                layers--;
+                break;
+
+            case DLOp_Translate:
+                gc.Translate(args[0], args[1]);
+                break;
+
+            case DLOp_Scale:
+                gc.Scale(args[0], args[1]);
+                break;
+
+            case DLOp_Rotate:
+                gc.Rotate(args[0]);
+                break;
+
+            case DLOp_ConcatTransform:
+                gc.ConcatTransform(GetCommandObject<wxGraphicsMatrix>(cmd));
+                break;
+
+            case DLOp_SetTransform:
+                gc.SetTransform(base);
+                gc.ConcatTransform(GetCommandObject<wxGraphicsMatrix>(cmd));
+                break;
+
+            case DLOp_SetPen:
+                gc.SetPen(GetCommandObject<wxGraphicsPen>(cmd));
+                break;
+
+            case DLOp_SetBrush:
+                gc.SetBrush(GetCommandObject<wxGraphicsBrush>(cmd));
+                break;
+
+            case DLOp_SetFont:
+                gc.SetFont(GetCommandObject<wxGraphicsFont>(cmd));
+                break;
+
+            case DLOp_StrokePath:
+                gc.StrokePath(GetCommandObject<wxGraphicsPath>(cmd));
+                break;
+
+            case DLOp_FillPath:
+                gc.FillPath(GetCommandObject<wxGraphicsPath>(cmd),
+                            static_cast<wxPolygonFillMode>(cmd.param));
+                break;
+
+            case DLOp_ClearRectangle:
+                gc.ClearRectangle(args[0], args[1], args[2], args[3]);
+                break;
+
+            case DLOp_DrawText:
+                gc.DrawText(m_data->m_texts[cmd.param], args[0], args[1]);
+                break;
+
+            case DLOp_DrawBitmap:
+                gc.DrawBitmap(GetCommandObject<wxGraphicsBitmap>(cmd),
+                              args[0], args[1], args[2], args[3]);
+                break;
+
+            case DLOp_DrawIcon:
+                gc.DrawIcon(m_data->m_icons[cmd.param],
+                            args[0], args[1], args[2], args[3]);
+                break;
+        }
+    }
+
+    // The list may have been recorded while the recording context was still
+    // in use, so close anything left open.
+    while ( layers-- > 0 )
+        gc.EndLayer();
+    while ( states-- > 0 )
+        gc.PopState();
+
+    gc.PopState();
+
+    gc.SetPen(pen);
+    gc.SetBrush(brush);
+    gc.SetFont(font);
+    gc.SetAntialiasMode(antialias);
+    gc.SetInterpolationQuality(interpolation);
+    gc.SetCompositionMode(composition);
+}
+
 //-----------------------------------------------------------------------------
 // wxGraphicsRenderer
 //-----------------------------------------------------------------------------
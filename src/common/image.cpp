@@ -27,10 +27,19 @@
 
 #include "wx/wfstream.h"
 #include "wx/xpmdecod.h"
+#include "wx/sysopt.h"
+
+#if wxUSE_THREADS
+    #include "wx/thread.h"
+
+    #include <memory>
+#endif // wxUSE_THREADS
 
 // For memcpy
 #include <string.h>
 
+#include <vector>
+
 // make the code compile with either wxFile*Stream or wxFFile*Stream:
 #define HAS_FILE_STREAMS (wxUSE_STREAMS && (wxUSE_FILE || wxUSE_FFILE))
 
@@ -506,6 +515,118 @@ wxImage::Scale( int width, int height, wxImageResizeQuality quality ) const
     return image;
 }
 
+namespace
+{
+
+// Return the number of threads which should be used for resampling an image
+// to the given size.
+int GetResampleThreadsCount(int width, int height)
+{
+#if wxUSE_THREADS
+    // Don't bother with threads for small images, the overhead of creating
+    // them would be greater than any gain.
+    static const int MIN_PIXELS_PER_THREAD = 64*1024;
+
+    int numThreads = wxSystemOptions::GetOptionInt("image.resample-threads");
+    if ( numThreads == -1 )
+        numThreads = wxThread::GetCPUCount();
+
+    const int maxThreads = wxMax(1, width*height / MIN_PIXELS_PER_THREAD);
+    if ( numThreads > maxThreads )
+        numThreads = maxThreads;
+
+    if ( numThreads > height )
+        numThreads = height;
+
+    return numThreads;
+#else // !wxUSE_THREADS
+    wxUnusedVar(width);
+    wxUnusedVar(height);
+
+    return 1;
+#endif // wxUSE_THREADS/!wxUSE_THREADS
+}
+
+#if wxUSE_THREADS
+
+// Thread calling the given function for a band of the destination rows.
+template <typename F>
+class ResampleBandThread : public wxThread
+{
+public:
+    ResampleBandThread(const F& func, int yStart, int yEnd)
+        : wxThread(wxTHREAD_JOINABLE),
+          m_func(func),
+          m_yStart(yStart),
+          m_yEnd(yEnd)
+    {
+    }
+
+protected:
+    virtual ExitCode Entry() override
+    {
+        m_func(m_yStart, m_yEnd);
+
+        return 0;
+    }
+
+private:
+    const F& m_func;
+    const int m_yStart,
+              m_yEnd;
+
+    wxDECLARE_NO_COPY_TEMPLATE_CLASS(ResampleBandThread, F);
+};
+
+#endif // wxUSE_THREADS
+
+// Call the given function, taking the start and the end (not included) of the
+// range of destination rows, for all the rows of the image of the given size.
+//
+// The rows are split in bands processed by different threads in parallel if
+// this is enabled by "image.resample-threads" system option, so the function
+// must compute each row independently of all the other ones.
+template <typename F>
+void ResampleRowBands(int width, int height, const F& func)
+{
+#if wxUSE_THREADS
+    const int numThreads = GetResampleThreadsCount(width, height);
+    if ( numThreads > 1 )
+    {
+        typedef ResampleBandThread<F> BandThread;
+        std::vector< std::unique_ptr<BandThread> > threads;
+
+        // The first band is processed by the current thread after launching
+        // all the others.
+        const int firstEnd = height / numThreads;
+        for ( int n = 1; n < numThreads; n++ )
+        {
+            const int yStart = (height * n) / numThreads;
+            const int yEnd = (height * (n + 1)) / numThreads;
+
+            std::unique_ptr<BandThread> thread(new BandThread(func, yStart, yEnd));
+            if ( thread->Run() == wxTHREAD_NO_ERROR )
+                threads.push_back(std::move(thread));
+            else // Just do it ourselves if we failed to create the thread.
+                func(yStart, yEnd);
+        }
+
+        func(0, firstEnd);
+
+        for ( size_t n = 0; n < threads.size(); n++ )
+            threads[n]->Wait();
+
+        return;
+    }
+#else // !wxUSE_THREADS
+    wxUnusedVar(width);
+#endif // wxUSE_THREADS/!wxUSE_THREADS
+
+    func(0, height);
+}
+
+} // anonymous namespace
+
 wxImage wxImage::ResampleNearest(int width, int height) const
 {
     wxImage image;
@@ -659,73 +780,84 @@ wxImage wxImage::ResampleBox(int width, int height) const
         dst_alpha = ret_image.GetAlpha();
     }
 
-    int averaged_pixels, src_pixel_index;
-    double sum_r, sum_g, sum_b, sum_a;
+    const int src_width = M_IMGDATA->m_width;
 
-    for ( int y = 0; y < height; y++ )         // Destination image - Y direction
+    const auto resampleRows = [&](int yStart, int yEnd)
     {
-        // Source pixel in the Y direction
-        const BoxPrecalc& vPrecalc = vPrecalcs[y];
+        unsigned char* dst = dst_data + static_cast<size_t>(yStart) * width * 3;
+        unsigned char* dst_a = dst_alpha ? dst_alpha + static_cast<size_t>(yStart) * width
+                                         : NULL;
 
-        for ( int x = 0; x < width; x++ )      // Destination image - X direction
-        {
-            // Source pixel in the X direction
-            const BoxPrecalc& hPrecalc = hPrecalcs[x];
+        int averaged_pixels, src_pixel_index;
+        double sum_r, sum_g, sum_b, sum_a;
 
-            // Box of pixels to average
-            averaged_pixels = (vPrecalc.boxEnd - vPrecalc.boxStart + 1)
-                                * (hPrecalc.boxEnd - hPrecalc.boxStart + 1);
-            sum_r = sum_g = sum_b = sum_a = 0.0;
+        for ( int y = yStart; y < yEnd; y++ )      // Destination image - Y direction
+        {
+            // Source pixel in the Y direction
+            const BoxPrecalc& vPrecalc = vPrecalcs[y];
 
-            for ( int j = vPrecalc.boxStart; j <= vPrecalc.boxEnd; ++j )
+            for ( int x = 0; x < width; x++ )      // Destination image - X direction
             {
-                for ( int i = hPrecalc.boxStart; i <= hPrecalc.boxEnd; ++i )
+                // Source pixel in the X direction
+                const BoxPrecalc& hPrecalc = hPrecalcs[x];
+
+                // Box of pixels to average
+                averaged_pixels = (vPrecalc.boxEnd - vPrecalc.boxStart + 1)
+                                    * (hPrecalc.boxEnd - hPrecalc.boxStart + 1);
+                sum_r = sum_g = sum_b = sum_a = 0.0;
+
+                for ( int j = vPrecalc.boxStart; j <= vPrecalc.boxEnd; ++j )
                 {
-                    // Calculate the actual index in our source pixels
-                    src_pixel_index = j * M_IMGDATA->m_width + i;
+                    for ( int i = hPrecalc.boxStart; i <= hPrecalc.boxEnd; ++i )
+                    {
+                        // Calculate the actual index in our source pixels
+                        src_pixel_index = j * src_width + i;
+
+                        if (src_alpha)
+                        {
+                            sum_r += src_data[src_pixel_index * 3 + 0] * src_alpha[src_pixel_index];
+                            sum_g += src_data[src_pixel_index * 3 + 1] * src_alpha[src_pixel_index];
+                            sum_b += src_data[src_pixel_index * 3 + 2] * src_alpha[src_pixel_index];
+                            sum_a += src_alpha[src_pixel_index];
+                        }
+                        else
+                        {
+                            sum_r += src_data[src_pixel_index * 3 + 0];
+                            sum_g += src_data[src_pixel_index * 3 + 1];
+                            sum_b += src_data[src_pixel_index * 3 + 2];
+                        }
+                    }
+                }
 
-                    if (src_alpha)
+                // Calculate the average from the sum and number of averaged pixels
+                if (src_alpha)
+                {
+                    if (sum_a != 0)
                     {
-                        sum_r += src_data[src_pixel_index * 3 + 0] * src_alpha[src_pixel_index];
-                        sum_g += src_data[src_pixel_index * 3 + 1] * src_alpha[src_pixel_index];
-                        sum_b += src_data[src_pixel_index * 3 + 2] * src_alpha[src_pixel_index];
-                        sum_a += src_alpha[src_pixel_index];
+                        dst[0] = (unsigned char)(sum_r / sum_a);
+                        dst[1] = (unsigned char)(sum_g / sum_a);
+                        dst[2] = (unsigned char)(sum_b / sum_a);
                     }
                     else
                     {
-                        sum_r += src_data[src_pixel_index * 3 + 0];
-                        sum_g += src_data[src_pixel_index * 3 + 1];
-                        sum_b += src_data[src_pixel_index * 3 + 2];
+                        dst[0] = 0;
+                        dst[1] = 0;
+                        dst[2] = 0;
                     }
-                }
-            }
-
-            // Calculate the average from the sum and number of averaged pixels
-            if (src_alpha)
-            {
-                if (sum_a != 0)
-                {
-                    dst_data[0] = (unsigned char)(sum_r / sum_a);
-                    dst_data[1] = (unsigned char)(sum_g / sum_a);
-                    dst_data[2] = (unsigned char)(sum_b / sum_a);
+                    *dst_a++ = (unsigned char)(sum_a / averaged_pixels);
                 }
                 else
                 {
-                    dst_data[0] = 0;
-                    dst_data[1] = 0;
-                    dst_data[2] = 0;
+                    dst[0] = (unsigned char)(sum_r / averaged_pixels);
+                    dst[1] = (unsigned char)(sum_g / averaged_pixels);
+                    dst[2] = (unsigned char)(sum_b / averaged_pixels);
                 }
-                *dst_alpha++ = (unsigned char)(sum_a / averaged_pixels);
-            }
-            else
-            {
-                dst_data[0] = (unsigned char)(sum_r / averaged_pixels);
-                dst_data[1] = (unsigned char)(sum_g / averaged_pixels);
-                dst_data[2] = (unsigned char)(sum_b / averaged_pixels);
+                dst += 3;
             }
-            dst_data += 3;
         }
-    }
+    };
+
+    ResampleRowBands(width, height, resampleRows);
 
     return ret_image;
 }
@@ -812,61 +944,72 @@ wxImage wxImage::ResampleBilinear(int width, int height) const
     ResampleBilinearPrecalc(vPrecalcs, M_IMGDATA->m_height);
     ResampleBilinearPrecalc(hPrecalcs, M_IMGDATA->m_width);
 
-    // initialize alpha values to avoid g++ warnings about possibly
-    // uninitialized variables
-    double r1, g1, b1, a1 = 0;
-    double r2, g2, b2, a2 = 0;
+    const int src_width = M_IMGDATA->m_width;
 
-    for ( int dsty = 0; dsty < height; dsty++ )
+    const auto resampleRows = [&](int yStart, int yEnd)
     {
-        // We need to calculate the source pixel to interpolate from - Y-axis
-        const BilinearPrecalc& vPrecalc = vPrecalcs[dsty];
-        const int y_offset1 = vPrecalc.offset1;
-        const int y_offset2 = vPrecalc.offset2;
-        const double dy = vPrecalc.dd;
-        const double dy1 = vPrecalc.dd1;
+        unsigned char* dst = dst_data + static_cast<size_t>(yStart) * width * 3;
+        unsigned char* dst_a = dst_alpha ? dst_alpha + static_cast<size_t>(yStart) * width
+                                         : NULL;
 
+        // initialize alpha values to avoid g++ warnings about possibly
+        // uninitialized variables
+        double r1, g1, b1, a1 = 0;
+        double r2, g2, b2, a2 = 0;
 
-        for ( int dstx = 0; dstx < width; dstx++ )
+        for ( int dsty = yStart; dsty < yEnd; dsty++ )
         {
-            // X-axis of pixel to interpolate from
-            const BilinearPrecalc& hPrecalc = hPrecalcs[dstx];
-
-            const int x_offset1 = hPrecalc.offset1;
-            const int x_offset2 = hPrecalc.offset2;
-            const double dx = hPrecalc.dd;
-            const double dx1 = hPrecalc.dd1;
-
-            int src_pixel_index00 = y_offset1 * M_IMGDATA->m_width + x_offset1;
-            int src_pixel_index01 = y_offset1 * M_IMGDATA->m_width + x_offset2;
-            int src_pixel_index10 = y_offset2 * M_IMGDATA->m_width + x_offset1;
-            int src_pixel_index11 = y_offset2 * M_IMGDATA->m_width + x_offset2;
-
-            // first line
-            r1 = src_data[src_pixel_index00 * 3 + 0] * dx1 + src_data[src_pixel_index01 * 3 + 0] * dx;
-            g1 = src_data[src_pixel_index00 * 3 + 1] * dx1 + src_data[src_pixel_index01 * 3 + 1] * dx;
-            b1 = src_data[src_pixel_index00 * 3 + 2] * dx1 + src_data[src_pixel_index01 * 3 + 2] * dx;
-            if ( src_alpha )
-                a1 = src_alpha[src_pixel_index00] * dx1 + src_alpha[src_pixel_index01] * dx;
-
-            // second line
-            r2 = src_data[src_pixel_index10 * 3 + 0] * dx1 + src_data[src_pixel_index11 * 3 + 0] * dx;
-            g2 = src_data[src_pixel_index10 * 3 + 1] * dx1 + src_data[src_pixel_index11 * 3 + 1] * dx;
-            b2 = src_data[src_pixel_index10 * 3 + 2] * dx1 + src_data[src_pixel_index11 * 3 + 2] * dx;
-            if ( src_alpha )
-                a2 = src_alpha[src_pixel_index10] * dx1 + src_alpha[src_pixel_index11] * dx;
-
-            // result lines
+            // We need to calculate the source pixel to interpolate from - Y-axis
+            const BilinearPrecalc& vPrecalc = vPrecalcs[dsty];
+            const int y_offset1 = vPrecalc.offset1;
+            const int y_offset2 = vPrecalc.offset2;
+            const double dy = vPrecalc.dd;
+            const double dy1 = vPrecalc.dd1;
 
-            dst_data[0] = static_cast<unsigned char>(r1 * dy1 + r2 * dy + .5);
-            dst_data[1] = static_cast<unsigned char>(g1 * dy1 + g2 * dy + .5);
-            dst_data[2] = static_cast<unsigned char>(b1 * dy1 + b2 * dy + .5);
-            dst_data += 3;
 
-            if ( src_alpha )
-                *dst_alpha++ = static_cast<unsigned char>(a1 * dy1 + a2 * dy +.5);
+            for ( int dstx = 0; dstx < width; dstx++ )
+            {
+                // X-axis of pixel to interpolate from
+                const BilinearPrecalc& hPrecalc = hPrecalcs[dstx];
+
+                const int x_offset1 = hPrecalc.offset1;
+                const int x_offset2 = hPrecalc.offset2;
+                const double dx = hPrecalc.dd;
+                const double dx1 = hPrecalc.dd1;
+
+                int src_pixel_index00 = y_offset1 * src_width + x_offset1;
+                int src_pixel_index01 = y_offset1 * src_width + x_offset2;
+                int src_pixel_index10 = y_offset2 * src_width + x_offset1;
+                int src_pixel_index11 = y_offset2 * src_width + x_offset2;
+
+                // first line
+                r1 = src_data[src_pixel_index00 * 3 + 0] * dx1 + src_data[src_pixel_index01 * 3 + 0] * dx;
+                g1 = src_data[src_pixel_index00 * 3 + 1] * dx1 + src_data[src_pixel_index01 * 3 + 1] * dx;
+                b1 = src_data[src_pixel_index00 * 3 + 2] * dx1 + src_data[src_pixel_index01 * 3 + 2] * dx;
+                if ( src_alpha )
+                    a1 = src_alpha[src_pixel_index00] * dx1 + src_alpha[src_pixel_index01] * dx;
+
+                // second line
+                r2 = src_data[src_pixel_index10 * 3 + 0] * dx1 + src_data[src_pixel_index11 * 3 + 0] * dx;
+                g2 = src_data[src_pixel_index10 * 3 + 1] * dx1 + src_data[src_pixel_index11 * 3 + 1] * dx;
+                b2 = src_data[src_pixel_index10 * 3 + 2] * dx1 + src_data[src_pixel_index11 * 3 + 2] * dx;
+                if ( src_alpha )
+                    a2 = src_alpha[src_pixel_index10] * dx1 + src_alpha[src_pixel_index11] * dx;
+
+                // result lines
+
+                dst[0] = static_cast<unsigned char>(r1 * dy1 + r2 * dy + .5);
+                dst[1] = static_cast<unsigned char>(g1 * dy1 + g2 * dy + .5);
+                dst[2] = static_cast<unsigned char>(b1 * dy1 + b2 * dy + .5);
+                dst += 3;
+
+                if ( src_alpha )
+                    *dst_a++ = static_cast<unsigned char>(a1 * dy1 + a2 * dy +.5);
+            }
         }
-    }
+    };
+
+    ResampleRowBands(width, height, resampleRows);
 
     return ret_image;
 }
@@ -995,91 +1138,248 @@ wxImage wxImage::ResampleBicubic(int width, int height) const
     ResampleBicubicPrecalc(vPrecalcs, M_IMGDATA->m_height);
     ResampleBicubicPrecalc(hPrecalcs, M_IMGDATA->m_width);
 
-    for ( int dsty = 0; dsty < height; dsty++ )
+    const int src_width = M_IMGDATA->m_width;
+
+    const auto resampleRows = [&](int yStart, int yEnd)
     {
-        // We need to calculate the source pixel to interpolate from - Y-axis
-        const BicubicPrecalc& vPrecalc = vPrecalcs[dsty];
+        unsigned char* dst = dst_data + static_cast<size_t>(yStart) * width * 3;
+        unsigned char* dst_a = dst_alpha ? dst_alpha + static_cast<size_t>(yStart) * width
+                                         : NULL;
 
-        for ( int dstx = 0; dstx < width; dstx++ )
+        for ( int dsty = yStart; dsty < yEnd; dsty++ )
         {
-            // X-axis of pixel to interpolate from
-            const BicubicPrecalc& hPrecalc = hPrecalcs[dstx];
-
-            // Sums for each color channel
-            double sum_r = 0, sum_g = 0, sum_b = 0, sum_a = 0;
+            // We need to calculate the source pixel to interpolate from - Y-axis
+            const BicubicPrecalc& vPrecalc = vPrecalcs[dsty];
 
-            // Here we actually determine the RGBA values for the destination pixel
-            for ( int k = -1; k <= 2; k++ )
+            for ( int dstx = 0; dstx < width; dstx++ )
             {
-                // Y offset
-                const int y_offset = vPrecalc.offset[k + 1];
+                // X-axis of pixel to interpolate from
+                const BicubicPrecalc& hPrecalc = hPrecalcs[dstx];
+
+                // Sums for each color channel
+                double sum_r = 0, sum_g = 0, sum_b = 0, sum_a = 0;
 
-                // Loop across the X axis
-                for ( int i = -1; i <= 2; i++ )
+                // Here we actually determine the RGBA values for the destination pixel
+                for ( int k = -1; k <= 2; k++ )
                 {
-                    // X offset
-                    const int x_offset = hPrecalc.offset[i + 1];
-
-                    // Calculate the exact position where the source data
-                    // should be pulled from based on the x_offset and y_offset
-                    int src_pixel_index = y_offset*M_IMGDATA->m_width + x_offset;
-
-                    // Calculate the weight for the specified pixel according
-                    // to the bicubic b-spline kernel we're using for
-                    // interpolation
-                    const double
-                        pixel_weight = vPrecalc.weight[k + 1] * hPrecalc.weight[i + 1];
-
-                    // Create a sum of all velues for each color channel
-                    // adjusted for the pixel's calculated weight
-                    if ( src_alpha )
-                    {
-                        const unsigned char a = src_alpha[src_pixel_index];
-                        sum_r += src_data[src_pixel_index * 3 + 0] * pixel_weight * a;
-                        sum_g += src_data[src_pixel_index * 3 + 1] * pixel_weight * a;
-                        sum_b += src_data[src_pixel_index * 3 + 2] * pixel_weight * a;
-                        sum_a += a * pixel_weight;
-                    }
-                    else
+                    // Y offset
+                    const int y_offset = vPrecalc.offset[k + 1];
+
+                    // Loop across the X axis
+                    for ( int i = -1; i <= 2; i++ )
                     {
-                        sum_r += src_data[src_pixel_index * 3 + 0] * pixel_weight;
-                        sum_g += src_data[src_pixel_index * 3 + 1] * pixel_weight;
-                        sum_b += src_data[src_pixel_index * 3 + 2] * pixel_weight;
+                        // X offset
+                        const int x_offset = hPrecalc.offset[i + 1];
+
+                        // Calculate the exact position where the source data
+                        // should be pulled from based on the x_offset and y_offset
+                        int src_pixel_index = y_offset*src_width + x_offset;
+
+                        // Calculate the weight for the specified pixel according
+                        // to the bicubic b-spline kernel we're using for
+                        // interpolation
+                        const double
+                            pixel_weight = vPrecalc.weight[k + 1] * hPrecalc.weight[i + 1];
+
+                        // Create a sum of all velues for each color channel
+                        // adjusted for the pixel's calculated weight
+                        if ( src_alpha )
+                        {
+                            const unsigned char a = src_alpha[src_pixel_index];
+                            sum_r += src_data[src_pixel_index * 3 + 0] * pixel_weight * a;
+                            sum_g += src_data[src_pixel_index * 3 + 1] * pixel_weight * a;
+                            sum_b += src_data[src_pixel_index * 3 + 2] * pixel_weight * a;
+                            sum_a += a * pixel_weight;
+                        }
+                        else
+                        {
+                            sum_r += src_data[src_pixel_index * 3 + 0] * pixel_weight;
+                            sum_g += src_data[src_pixel_index * 3 + 1] * pixel_weight;
+                            sum_b += src_data[src_pixel_index * 3 + 2] * pixel_weight;
+                        }
                     }
                 }
-            }
 
-            // Put the data into the destination image.  The summed values are
-            // of double data type and are rounded here for accuracy
-            if ( src_alpha )
-            {
-                if (sum_a != 0)
+                // Put the data into the destination image.  The summed values are
+                // of double data type and are rounded here for accuracy
+                if ( src_alpha )
                 {
-                     dst_data[0] = (unsigned char)(sum_r / sum_a + 0.5);
-                     dst_data[1] = (unsigned char)(sum_g / sum_a + 0.5);
-                     dst_data[2] = (unsigned char)(sum_b / sum_a + 0.5);
+                    if (sum_a != 0)
+                    {
+                         dst[0] = (unsigned char)(sum_r / sum_a + 0.5);
+                         dst[1] = (unsigned char)(sum_g / sum_a + 0.5);
+                         dst[2] = (unsigned char)(sum_b / sum_a + 0.5);
+                    }
+                    else
+                    {
+                        dst[0] = 0;
+                        dst[1] = 0;
+                        dst[2] = 0;
+                    }
+                    *dst_a++ = (unsigned char)sum_a;
                 }
                 else
                 {
-                    dst_data[0] = 0;
-                    dst_data[1] = 0;
-                    dst_data[2] = 0;
+                    dst[0] = (unsigned char)(sum_r + 0.5);
+                    dst[1] = (unsigned char)(sum_g + 0.5);
+                    dst[2] = (unsigned char)(sum_b + 0.5);
                 }
-                *dst_alpha++ = (unsigned char)sum_a;
+                dst += 3;
             }
-            else
+        }
+    };
+
+    ResampleRowBands(width, height, resampleRows);
+
+    return ret_image;
+}
+
+namespace
+{
+
+// Helper computing the average of blurArea channel values from their sum: it
+// multiplies by the reciprocal of the area instead of dividing by it, which is
+// much faster and gives exactly the same results as long as the area is not
+// too big (see the comment in the ctor), and falls back to division otherwise.
+class BlurAverager
+{
+public:
+    explicit BlurAverager(int blurArea)
+        : m_area(blurArea)
+    {
+        // With m = ceil(2^32/area), (sum*m) >> 32 is equal to sum/area if
+        // sum*(m*area - 2^32) < 2^32, which is the case for all sums of at
+        // most 255*area if 255*area*(area - 1) < 2^32, i.e. area <= 4104.
+        m_mult = blurArea <= 4096
+                    ? ((wxULL(1) << 32) + blurArea - 1) / blurArea
+                    : 0;
+    }
+
+    unsigned char operator()(long sum) const
+    {
+        if ( m_mult )
+            return (unsigned char)((static_cast<wxUint64>(sum) * m_mult) >> 32);
+
+        return (unsigned char)(sum / m_area);
+    }
+
+private:
+    const long m_area;
+    wxUint64 m_mult;
+};
+
+// Return the sum of the values in the box of the given radius centred on the
+// first element of the line of len values separated by step, duplicating the
+// edge values for the positions outside of the line.
+//
+// Note that this takes time proportional to the line length and not to the
+// radius, so that even huge radii are handled in constant time per pixel.
+long GetInitialBoxSum(const unsigned char* values, size_t step, int len, int radius)
+{
+    const int last = wxMin(radius, len - 1);
+
+    long sum = static_cast<long>(radius + 1) * values[0];
+    for ( int n = 1; n <= last; n++ )
+        sum += values[n*step];
+    sum += static_cast<long>(radius - last) * values[(len - 1)*step];
+
+    return sum;
+}
+
+// Box blur all rows of the image data with the given number of interleaved
+// channels. The source and destination may be the same, i.e. this function
+// can work in place. If round is true, the averages are rounded to the
+// nearest value instead of being truncated.
+void BoxBlurRows(const unsigned char* src, unsigned char* dst,
+                 int width, int height, int channels,
+                 int radius, bool round)
+{
+    const BlurAverager average(radius*2 + 1);
+    const long bias = round ? radius : 0;
+
+    const size_t row_len = static_cast<size_t>(width) * channels;
+
+    // Copy of the current source row, as the destination may overwrite it.
+    std::vector<unsigned char> row(row_len);
+
+    for ( int y = 0; y < height; y++, src += row_len, dst += row_len )
+    {
+        memcpy(&row[0], src, row_len);
+
+        for ( int c = 0; c < channels; c++ )
+        {
+            const unsigned char* const values = &row[c];
+
+            long sum = GetInitialBoxSum(values, channels, width, radius) + bias;
+            dst[c] = average(sum);
+
+            // Move the box along the row by subtracting the value at its left
+            // side and adding the value at its right side.
+            for ( int x = 1; x < width; x++ )
             {
-                dst_data[0] = (unsigned char)(sum_r + 0.5);
-                dst_data[1] = (unsigned char)(sum_g + 0.5);
-                dst_data[2] = (unsigned char)(sum_b + 0.5);
+                const int x_in = wxMin(x + radius, width - 1);
+                const int x_out = wxMax(x - radius - 1, 0);
+
+                sum += values[x_in*channels] - values[x_out*channels];
+                dst[x*channels + c] = average(sum);
             }
-            dst_data += 3;
         }
     }
+}
 
-    return ret_image;
+// Box blur all columns of the image data, see BoxBlurRows().
+void BoxBlurColumns(const unsigned char* src, unsigned char* dst,
+                    int width, int height, int channels,
+                    int radius, bool round)
+{
+    const BlurAverager average(radius*2 + 1);
+    const long bias = round ? radius : 0;
+
+    const size_t row_len = static_cast<size_t>(width) * channels;
+
+    // Process the columns in narrow vertical strips: this is much more
+    // cache-friendly than going down each column separately, as all values
+    // of the strip in the same row are contiguous, and the strip copy keeps
+    // the source values overwritten in the destination.
+    enum { STRIP_LEN = 64 };
+    std::vector<unsigned char> strip(STRIP_LEN * static_cast<size_t>(height));
+    long sums[STRIP_LEN];
+
+    for ( size_t start = 0; start < row_len; start += STRIP_LEN )
+    {
+        const size_t strip_len = wxMin(static_cast<size_t>(STRIP_LEN),
+                                       row_len - start);
+
+        for ( int y = 0; y < height; y++ )
+            memcpy(&strip[y*strip_len], src + y*row_len + start, strip_len);
+
+        for ( size_t n = 0; n < strip_len; n++ )
+            sums[n] = GetInitialBoxSum(&strip[n], strip_len, height, radius) + bias;
+
+        for ( int y = 0; y < height; y++ )
+        {
+            if ( y > 0 )
+            {
+                // Move the box down by subtracting the values of the row at
+                // its top and adding the values of the row at its bottom.
+                const unsigned char* const
+                    in = &strip[wxMin(y + radius, height - 1)*strip_len];
+                const unsigned char* const
+                    out = &strip[wxMax(y - radius - 1, 0)*strip_len];
+
+                for ( size_t n = 0; n < strip_len; n++ )
+                    sums[n] += in[n] - out[n];
+            }
+
+            unsigned char* const row = dst + y*row_len + start;
+            for ( size_t n = 0; n < strip_len; n++ )
+                row[n] = average(sums[n]);
+        }
+    }
 }
 
+} // anonymous namespace
+
 // Blur in the horizontal direction
 wxImage wxImage::BlurHorizontal(int blurRadius) const
 {
@@ -1087,97 +1387,17 @@ wxImage wxImage::BlurHorizontal(int blurRadius) const
 
     wxCHECK( ret_image.IsOk(), ret_image );
 
-    const unsigned char* src_data = M_IMGDATA->m_data;
-    unsigned char* dst_data = ret_image.GetData();
-    const unsigned char* src_alpha = M_IMGDATA->m_alpha;
-    unsigned char* dst_alpha = ret_image.GetAlpha();
-
-    // number of pixels we average over
-    const int blurArea = blurRadius*2 + 1;
-
     // Horizontal blurring algorithm - average all pixels in the specified blur
     // radius in the X or horizontal direction
-    for ( int y = 0; y < M_IMGDATA->m_height; y++ )
-    {
-        // Variables used in the blurring algorithm
-        long sum_r = 0,
-             sum_g = 0,
-             sum_b = 0,
-             sum_a = 0;
-
-        long pixel_idx;
-        const unsigned char *src;
-        unsigned char *dst;
-
-        // Calculate the average of all pixels in the blur radius for the first
-        // pixel of the row
-        for ( int kernel_x = -blurRadius; kernel_x <= blurRadius; kernel_x++ )
-        {
-            // To deal with the pixels at the start of a row so it's not
-            // grabbing GOK values from memory at negative indices of the
-            // image's data or grabbing from the previous row
-            if ( kernel_x < 0 )
-                pixel_idx = y * M_IMGDATA->m_width;
-            else
-                pixel_idx = kernel_x + y * M_IMGDATA->m_width;
-
-            src = src_data + pixel_idx*3;
-            sum_r += src[0];
-            sum_g += src[1];
-            sum_b += src[2];
-            if ( src_alpha )
-                sum_a += src_alpha[pixel_idx];
-        }
+    BoxBlurRows(M_IMGDATA->m_data, ret_image.GetData(),
+                M_IMGDATA->m_width, M_IMGDATA->m_height, 3,
+                blurRadius, false);
 
-        dst = dst_data + y * M_IMGDATA->m_width*3;
-        dst[0] = (unsigned char)(sum_r / blurArea);
-        dst[1] = (unsigned char)(sum_g / blurArea);
-        dst[2] = (unsigned char)(sum_b / blurArea);
-        if ( src_alpha )
-            dst_alpha[y * M_IMGDATA->m_width] = (unsigned char)(sum_a / blurArea);
-
-        // Now average the values of the rest of the pixels by just moving the
-        // blur radius box along the row
-        for ( int x = 1; x < M_IMGDATA->m_width; x++ )
-        {
-            // Take care of edge pixels on the left edge by essentially
-            // duplicating the edge pixel
-            if ( x - blurRadius - 1 < 0 )
-                pixel_idx = y * M_IMGDATA->m_width;
-            else
-                pixel_idx = (x - blurRadius - 1) + y * M_IMGDATA->m_width;
-
-            // Subtract the value of the pixel at the left side of the blur
-            // radius box
-            src = src_data + pixel_idx*3;
-            sum_r -= src[0];
-            sum_g -= src[1];
-            sum_b -= src[2];
-            if ( src_alpha )
-                sum_a -= src_alpha[pixel_idx];
-
-            // Take care of edge pixels on the right edge
-            if ( x + blurRadius > M_IMGDATA->m_width - 1 )
-                pixel_idx = M_IMGDATA->m_width - 1 + y * M_IMGDATA->m_width;
-            else
-                pixel_idx = x + blurRadius + y * M_IMGDATA->m_width;
-
-            // Add the value of the pixel being added to the end of our box
-            src = src_data + pixel_idx*3;
-            sum_r += src[0];
-            sum_g += src[1];
-            sum_b += src[2];
-            if ( src_alpha )
-                sum_a += src_alpha[pixel_idx];
-
-            // Save off the averaged data
-            dst = dst_data + x*3 + y*M_IMGDATA->m_width*3;
-            dst[0] = (unsigned char)(sum_r / blurArea);
-            dst[1] = (unsigned char)(sum_g / blurArea);
-            dst[2] = (unsigned char)(sum_b / blurArea);
-            if ( src_alpha )
-                dst_alpha[x + y * M_IMGDATA->m_width] = (unsigned char)(sum_a / blurArea);
-        }
+    if ( M_IMGDATA->m_alpha )
+    {
+        BoxBlurRows(M_IMGDATA->m_alpha, ret_image.GetAlpha(),
+                    M_IMGDATA->m_width, M_IMGDATA->m_height, 1,
+                    blurRadius, false);
     }
 
     return ret_image;
@@ -1190,97 +1410,17 @@ wxImage wxImage::BlurVertical(int blurRadius) const
 
     wxCHECK( ret_image.IsOk(), ret_image );
 
-    const unsigned char* src_data = M_IMGDATA->m_data;
-    unsigned char* dst_data = ret_image.GetData();
-    const unsigned char* src_alpha = M_IMGDATA->m_alpha;
-    unsigned char* dst_alpha = ret_image.GetAlpha();
-
-    // number of pixels we average over
-    const int blurArea = blurRadius*2 + 1;
-
     // Vertical blurring algorithm - same as horizontal but switched the
     // opposite direction
-    for ( int x = 0; x < M_IMGDATA->m_width; x++ )
-    {
-        // Variables used in the blurring algorithm
-        long sum_r = 0,
-             sum_g = 0,
-             sum_b = 0,
-             sum_a = 0;
-
-        long pixel_idx;
-        const unsigned char *src;
-        unsigned char *dst;
-
-        // Calculate the average of all pixels in our blur radius box for the
-        // first pixel of the column
-        for ( int kernel_y = -blurRadius; kernel_y <= blurRadius; kernel_y++ )
-        {
-            // To deal with the pixels at the start of a column so it's not
-            // grabbing GOK values from memory at negative indices of the
-            // image's data or grabbing from the previous column
-            if ( kernel_y < 0 )
-                pixel_idx = x;
-            else
-                pixel_idx = x + kernel_y * M_IMGDATA->m_width;
-
-            src = src_data + pixel_idx*3;
-            sum_r += src[0];
-            sum_g += src[1];
-            sum_b += src[2];
-            if ( src_alpha )
-                sum_a += src_alpha[pixel_idx];
-        }
-
-        dst = dst_data + x*3;
-        dst[0] = (unsigned char)(sum_r / blurArea);
-        dst[1] = (unsigned char)(sum_g / blurArea);
-        dst[2] = (unsigned char)(sum_b / blurArea);
-        if ( src_alpha )
-            dst_alpha[x] = (unsigned char)(sum_a / blurArea);
+    BoxBlurColumns(M_IMGDATA->m_data, ret_image.GetData(),
+                   M_IMGDATA->m_width, M_IMGDATA->m_height, 3,
+                   blurRadius, false);
 
-        // Now average the values of the rest of the pixels by just moving the
-        // box along the column from top to bottom
-        for ( int y = 1; y < M_IMGDATA->m_height; y++ )
-        {
-            // Take care of pixels that would be beyond the top edge by
-            // duplicating the top edge pixel for the column
-            if ( y - blurRadius - 1 < 0 )
-                pixel_idx = x;
-            else
-                pixel_idx = x + (y - blurRadius - 1) * M_IMGDATA->m_width;
-
-            // Subtract the value of the pixel at the top of our blur radius box
-            src = src_data + pixel_idx*3;
-            sum_r -= src[0];
-            sum_g -= src[1];
-            sum_b -= src[2];
-            if ( src_alpha )
-                sum_a -= src_alpha[pixel_idx];
-
-            // Take care of the pixels that would be beyond the bottom edge of
-            // the image similar to the top edge
-            if ( y + blurRadius > M_IMGDATA->m_height - 1 )
-                pixel_idx = x + (M_IMGDATA->m_height - 1) * M_IMGDATA->m_width;
-            else
-                pixel_idx = x + (blurRadius + y) * M_IMGDATA->m_width;
-
-            // Add the value of the pixel being added to the end of our box
-            src = src_data + pixel_idx*3;
-            sum_r += src[0];
-            sum_g += src[1];
-            sum_b += src[2];
-            if ( src_alpha )
-                sum_a += src_alpha[pixel_idx];
-
-            // Save off the averaged data
-            dst = dst_data + (x + y * M_IMGDATA->m_width) * 3;
-            dst[0] = (unsigned char)(sum_r / blurArea);
-            dst[1] = (unsigned char)(sum_g / blurArea);
-            dst[2] = (unsigned char)(sum_b / blurArea);
-            if ( src_alpha )
-                dst_alpha[x + y * M_IMGDATA->m_width] = (unsigned char)(sum_a / blurArea);
-        }
+    if ( M_IMGDATA->m_alpha )
+    {
+        BoxBlurColumns(M_IMGDATA->m_alpha, ret_image.GetAlpha(),
+                       M_IMGDATA->m_width, M_IMGDATA->m_height, 1,
+                       blurRadius, false);
     }
 
     return ret_image;
@@ -1289,12 +1429,85 @@ wxImage wxImage::BlurVertical(int blurRadius) const
 // The new blur function
 wxImage wxImage::Blur(int blurRadius) const
 {
-    wxImage ret_image;
-    ret_image.Create(M_IMGDATA->m_width, M_IMGDATA->m_height, false);
+    wxImage ret_image(MakeEmptyClone());
+
+    wxCHECK( ret_image.IsOk(), ret_image );
+
+    // Blur the image in each direction, doing the second pass in place to
+    // avoid allocating an intermediate image
+    BoxBlurRows(M_IMGDATA->m_data, ret_image.GetData(),
+                M_IMGDATA->m_width, M_IMGDATA->m_height, 3,
+                blurRadius, false);
+    BoxBlurColumns(ret_image.GetData(), ret_image.GetData(),
+                   M_IMGDATA->m_width, M_IMGDATA->m_height, 3,
+                   blurRadius, false);
+
+    if ( M_IMGDATA->m_alpha )
+    {
+        BoxBlurRows(M_IMGDATA->m_alpha, ret_image.GetAlpha(),
+                    M_IMGDATA->m_width, M_IMGDATA->m_height, 1,
+                    blurRadius, false);
+        BoxBlurColumns(ret_image.GetAlpha(), ret_image.GetAlpha(),
+                       M_IMGDATA->m_width, M_IMGDATA->m_height, 1,
+                       blurRadius, false);
+    }
+
+    return ret_image;
+}
+
+wxImage wxImage::GaussianBlur(double sigma) const
+{
+    wxCHECK_MSG( sigma >= 0, wxImage(), wxS("invalid standard deviation") );
+
+    wxImage ret_image(MakeEmptyClone());
+
+    wxCHECK( ret_image.IsOk(), ret_image );
+
+    // Approximate the Gaussian blur with successive box blurs: the result of
+    // applying 3 of them is already very close to it. Choose their sizes as
+    // the odd integers wl and wl + 2 closest to the ideal size w, such that
+    // the variance of the result, the sum of (w_i^2 - 1)/12, is as close to
+    // sigma^2 as possible.
+    //
+    // Also limit the standard deviation to keep the box sizes, and the sums
+    // of the values inside the boxes, well inside the range of int: blurring
+    // even more wouldn't change the result anyhow, as such boxes are much
+    // bigger than any image and consist almost only of its edge values.
+    const int passes = 3;
+    const double sigmaMax = wxMin(sigma, 1e6);
+    const double variance = sigmaMax*sigmaMax;
+    int wl = static_cast<int>(sqrt(12*variance/passes + 1));
+    if ( wl % 2 == 0 )
+        wl--;
+    const double w = wl;
+    const int numLower = wxRound((12*variance - passes*w*w - 4*passes*w - 3*passes)
+                                    / (-4*w - 4));
+
+    const int width = M_IMGDATA->m_width;
+    const int height = M_IMGDATA->m_height;
+
+    const unsigned char* src_data = M_IMGDATA->m_data;
+    const unsigned char* src_alpha = M_IMGDATA->m_alpha;
+    unsigned char* const dst_data = ret_image.GetData();
+    unsigned char* const dst_alpha = ret_image.GetAlpha();
 
-    // Blur the image in each direction
-    ret_image = BlurHorizontal(blurRadius);
-    ret_image = ret_image.BlurVertical(blurRadius);
+    // Only the first pass reads from this image, all the subsequent ones work
+    // in place, and the averages are rounded to avoid darkening the image.
+    for ( int n = 0; n < passes; n++ )
+    {
+        const int radius = n < numLower ? (wl - 1) / 2 : (wl + 1) / 2;
+
+        BoxBlurRows(src_data, dst_data, width, height, 3, radius, true);
+        BoxBlurColumns(dst_data, dst_data, width, height, 3, radius, true);
+        src_data = dst_data;
+
+        if ( src_alpha )
+        {
+            BoxBlurRows(src_alpha, dst_alpha, width, height, 1, radius, true);
+            BoxBlurColumns(dst_alpha, dst_alpha, width, height, 1, radius, true);
+            src_alpha = dst_alpha;
+        }
+    }
 
     return ret_image;
 }
@@ -1850,42 +2063,121 @@ wxImage wxImage::ConvertToGreyscale() const
 namespace
 {
 
-// red, green and blue are doubles in the range [0.0..1.0], they are used
-// internally by DoMakeGrey() only.
-class WeightValue
+// Lookup table mapping each channel value to the transformed one: this is
+// used by the transformations which apply the same function to each channel
+// independently and is much cheaper than calling this function for every
+// pixel.
+class ChannelTable
 {
 public:
-    WeightValue(double r = 0.0, double g = 0.0, double b = 0.0)
-        : red(r), green(g), blue(b) {}
-    double red;
-    double green;
-    double blue;
+    // The function must take and return an unsigned char.
+    template <typename F>
+    explicit ChannelTable(const F& func)
+    {
+        for ( int n = 0; n < 256; n++ )
+            m_values[n] = func(static_cast<unsigned char>(n));
+    }
+
+    void operator()(unsigned char *rgb) const
+    {
+        rgb[0] = m_values[rgb[0]];
+        rgb[1] = m_values[rgb[1]];
+        rgb[2] = m_values[rgb[2]];
+    }
+
+private:
+    unsigned char m_values[256];
 };
 
-} // anonymous namespace
+// Luma of each possible channel value multiplied by its weight: adding the
+// three values gives exactly the same result as wxColour::MakeGrey(), but
+// avoids the floating point multiplications for every pixel.
+class GreyTable
+{
+public:
+    GreyTable(double weight_r, double weight_g, double weight_b)
+    {
+        for ( int n = 0; n < 256; n++ )
+        {
+            m_red[n] = n * weight_r;
+            m_green[n] = n * weight_g;
+            m_blue[n] = n * weight_b;
+        }
+    }
+
+    void operator()(unsigned char *rgb) const
+    {
+        const double luma = m_red[rgb[0]] + m_green[rgb[1]] + m_blue[rgb[2]];
+        rgb[0] =
+        rgb[1] =
+        rgb[2] = (wxByte)wxRound(luma);
+    }
+
+private:
+    double m_red[256];
+    double m_green[256];
+    double m_blue[256];
+};
+
+// Wrapper for the expensive filters, such as those going via HSV colour
+// space, reusing the result for the runs of pixels of the same colour, which
+// are very common in the real images.
+template <typename F>
+class CachingPixelFilter
+{
+public:
+    explicit CachingPixelFilter(const F& filter)
+        : m_filter(filter),
+          m_valid(false)
+    {
+    }
+
+    void operator()(unsigned char *rgb) const
+    {
+        if ( m_valid &&
+                rgb[0] == m_in[0] && rgb[1] == m_in[1] && rgb[2] == m_in[2] )
+        {
+            rgb[0] = m_out[0];
+            rgb[1] = m_out[1];
+            rgb[2] = m_out[2];
+            return;
+        }
 
-// TODO-C++11: Replace with a lambda function.
-static void DoMakeGrey(wxImage *image, unsigned char *rgb, WeightValue weight)
+        m_in[0] = rgb[0];
+        m_in[1] = rgb[1];
+        m_in[2] = rgb[2];
+
+        m_filter(rgb);
+
+        m_out[0] = rgb[0];
+        m_out[1] = rgb[1];
+        m_out[2] = rgb[2];
+        m_valid = true;
+    }
+
+private:
+    const F m_filter;
+
+    mutable unsigned char m_in[3];
+    mutable unsigned char m_out[3];
+    mutable bool m_valid;
+};
+
+template <typename F>
+inline CachingPixelFilter<F> MakeCachingPixelFilter(const F& filter)
 {
-    if ( !image->HasMask() || rgb[0] != image->GetMaskRed() ||
-         rgb[1] != image->GetMaskGreen() || rgb[2] != image->GetMaskBlue() )
-        wxColour::MakeGrey(rgb, rgb + 1, rgb + 2, weight.red, weight.green, weight.blue);
+    return CachingPixelFilter<F>(filter);
 }
 
+} // anonymous namespace
+
 wxImage wxImage::ConvertToGreyscale(double weight_r, double weight_g, double weight_b) const
 {
     wxImage image = *this;
-    image.ApplyToAllPixels(&DoMakeGrey, WeightValue(weight_r, weight_g, weight_b));
+    image.ApplyToUnmaskedPixels(GreyTable(weight_r, weight_g, weight_b));
     return image;
 }
 
-// TODO-C++11: Replace with a lambda function.
-static void DoMakeMono(wxImage *WXUNUSED(image), unsigned char *rgb, wxImage::RGBValue rgbValue)
-{
-    const bool on = (rgb[0] == rgbValue.red) && (rgb[1] == rgbValue.green) && (rgb[2] == rgbValue.blue);
-    wxColour::MakeMono(rgb, rgb + 1, rgb + 2, on);
-}
-
 wxImage wxImage::ConvertToMono(unsigned char r, unsigned char g, unsigned char b) const
 {
     wxImage image = *this;
@@ -1898,38 +2190,36 @@ wxImage wxImage::ConvertToMono(unsigned char r, unsigned char g, unsigned char b
             image.SetMaskColour(0, 0, 0);
     }
 
-    image.ApplyToAllPixels(&DoMakeMono, RGBValue(r, g, b));
+    image.ApplyToAllPixels([r, g, b](unsigned char *rgb)
+        {
+            const bool on = (rgb[0] == r) && (rgb[1] == g) && (rgb[2] == b);
+            wxColour::MakeMono(rgb, rgb + 1, rgb + 2, on);
+        });
     return image;
 }
 
-// TODO-C++11: Replace with a lambda function.
-static void DoMakeDisabled(wxImage *image, unsigned char *rgb, unsigned char brightness)
-{
-    if ( !image->HasMask() || rgb[0] != image->GetMaskRed() ||
-         rgb[1] != image->GetMaskGreen() || rgb[2] != image->GetMaskBlue() )
-        wxColour::MakeDisabled(rgb, rgb + 1, rgb + 2, brightness);
-}
-
 wxImage wxImage::ConvertToDisabled(unsigned char brightness) const
 {
     wxImage image = *this;
-    image.ApplyToAllPixels(&DoMakeDisabled, brightness);
+    image.ApplyToUnmaskedPixels(ChannelTable([brightness](unsigned char c)
+        {
+            unsigned char r = c, g = c, b = c;
+            wxColour::MakeDisabled(&r, &g, &b, brightness);
+            return r;
+        }));
     return image;
 }
 
-// TODO-C++11: Replace with a lambda function.
-static void DoChangeLightness(wxImage *image, unsigned char *rgb, int alpha)
-{
-    if ( !image->HasMask() || rgb[0] != image->GetMaskRed() ||
-         rgb[1] != image->GetMaskGreen() || rgb[2] != image->GetMaskBlue() )
-        wxColour::ChangeLightness(rgb, rgb + 1, rgb + 2, alpha);
-}
-
 wxImage wxImage::ChangeLightness(int alpha) const
 {
     wxASSERT(alpha >= 0 && alpha <= 200);
     wxImage image = *this;
-    image.ApplyToAllPixels(&DoChangeLightness, alpha);
+    image.ApplyToUnmaskedPixels(ChannelTable([alpha](unsigned char c)
+        {
+            unsigned char r = c, g = c, b = c;
+            wxColour::ChangeLightness(&r, &g, &b, alpha);
+            return r;
+        }));
     return image;
 }
 
@@ -3313,8 +3603,7 @@ wxImage::RGBValue wxImage::HSVtoRGB(const HSVValue& hsv)
                     (unsigned char)wxRound(blue * 255.0));
 }
 
-// TODO-C++11: Replace with a lambda function.
-static void DoRotateHue(wxImage *WXUNUSED(image), unsigned char *rgb, double angle)
+static void DoRotateHue(unsigned char *rgb, double angle)
 {
     wxImage::RGBValue rgbValue(rgb[0], rgb[1], rgb[2]);
     wxImage::HSVValue hsvValue = wxImage::RGBtoHSV(rgbValue);
@@ -3341,11 +3630,13 @@ void wxImage::RotateHue(double angle)
         return;
 
     wxASSERT(angle >= -1.0 && angle <= 1.0);
-    ApplyToAllPixels(&DoRotateHue, angle);
+    ApplyToAllPixels(MakeCachingPixelFilter([angle](unsigned char *rgb)
+        {
+            DoRotateHue(rgb, angle);
+        }));
 }
 
-// TODO-C++11: Replace with a lambda function.
-static void DoChangeSaturation(wxImage *WXUNUSED(image), unsigned char *rgb, double factor)
+static void DoChangeSaturation(unsigned char *rgb, double factor)
 {
     wxImage::RGBValue rgbValue(rgb[0], rgb[1], rgb[2]);
     wxImage::HSVValue hsvValue = wxImage::RGBtoHSV(rgbValue);
@@ -3372,11 +3663,13 @@ void wxImage::ChangeSaturation(double factor)
         return;
 
     wxASSERT(factor >= -1.0 && factor <= 1.0);
-    ApplyToAllPixels(&DoChangeSaturation, factor);
+    ApplyToAllPixels(MakeCachingPixelFilter([factor](unsigned char *rgb)
+        {
+            DoChangeSaturation(rgb, factor);
+        }));
 }
 
-// TODO-C++11: Replace with a lambda function.
-static void DoChangeBrightness(wxImage *WXUNUSED(image), unsigned char *rgb, double factor)
+static void DoChangeBrightness(unsigned char *rgb, double factor)
 {
     wxImage::RGBValue rgbValue(rgb[0], rgb[1], rgb[2]);
     wxImage::HSVValue hsvValue = wxImage::RGBtoHSV(rgbValue);
@@ -3403,20 +3696,22 @@ void wxImage::ChangeBrightness(double factor)
         return;
 
     wxASSERT(factor >= -1.0 && factor <= 1.0);
-    ApplyToAllPixels(&DoChangeBrightness, factor);
+    ApplyToAllPixels(MakeCachingPixelFilter([factor](unsigned char *rgb)
+        {
+            DoChangeBrightness(rgb, factor);
+        }));
 }
 
-// TODO-C++11: Replace with a lambda function.
-static void DoChangeHSV(wxImage *image, unsigned char *rgb, wxImage::HSVValue hsvValue)
+static void DoChangeHSV(unsigned char *rgb, const wxImage::HSVValue& hsvValue)
 {
     if ( !wxIsNullDouble(hsvValue.hue) )
-        DoRotateHue(image, rgb, hsvValue.hue);
+        DoRotateHue(rgb, hsvValue.hue);
 
     if ( !wxIsNullDouble(hsvValue.saturation) )
-        DoChangeSaturation(image, rgb, hsvValue.saturation);
+        DoChangeSaturation(rgb, hsvValue.saturation);
 
     if ( !wxIsNullDouble(hsvValue.value) )
-        DoChangeBrightness(image, rgb, hsvValue.value);
+        DoChangeBrightness(rgb, hsvValue.value);
 }
 
 // Changes the hue, the saturation and the brightness (value) of each pixel in
@@ -3432,7 +3727,11 @@ void wxImage::ChangeHSV(double angleH, double factorS, double factorV)
 
     wxASSERT(angleH >= -1.0 && angleH <= 1.0 && factorS >= -1.0 &&
              factorS <= 1.0 && factorV >= -1.0 && factorV <= 1.0);
-    ApplyToAllPixels(&DoChangeHSV, HSVValue(angleH, factorS, factorV));
+    const HSVValue hsvValue(angleH, factorS, factorV);
+    ApplyToAllPixels(MakeCachingPixelFilter([&hsvValue](unsigned char *rgb)
+        {
+            DoChangeHSV(rgb, hsvValue);
+        }));
 }
 
 //-----------------------------------------------------------------------------
@@ -3894,9 +4193,9 @@ wxImage wxImage::Rotate(double angle,
     return rotated;
 }
 
-// Helper function used internally by wxImage class only.
-template <typename T>
-void wxImage::ApplyToAllPixels(void (*filter)(wxImage *, unsigned char *, T), T value)
+// Helper functions used internally by wxImage class only.
+template <typename F>
+void wxImage::ApplyToAllPixels(const F& filter)
 {
     AllocExclusive();
 
@@ -3905,10 +4204,30 @@ void wxImage::ApplyToAllPixels(void (*filter)(wxImage *, unsigned char *, T), T
 
     for ( size_t i = 0; i < size; i++, data += 3 )
     {
-        (*filter)(this, data, value);
+        filter(data);
     }
 }
 
+template <typename F>
+void wxImage::ApplyToUnmaskedPixels(const F& filter)
+{
+    if ( !HasMask() )
+    {
+        ApplyToAllPixels(filter);
+        return;
+    }
+
+    const unsigned char maskRed = GetMaskRed(),
+                        maskGreen = GetMaskGreen(),
+                        maskBlue = GetMaskBlue();
+
+    ApplyToAllPixels([&](unsigned char *rgb)
+        {
+            if ( rgb[0] != maskRed || rgb[1] != maskGreen || rgb[2] != maskBlue )
+                filter(rgb);
+        });
+}
+
 // A module to allow wxImage initialization/cleanup
 // without calling these functions from app.cpp or from
 // the user's application.
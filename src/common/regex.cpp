@@ -37,6 +37,8 @@
 #   include <sys/types.h>
 #endif
 
+#include <algorithm>
+
 // Currently this is not an option as there is no simple way to switch between
 // PCRE and the old regex library implementation at makefile level, so we just
 // always use PCRE and the old code is only kept temporarily in case we decide
@@ -47,6 +49,8 @@
 // WXREGEX_USING_RE_SEARCH  defined when using re_search in the GNU regex lib
 // WXREGEX_CONVERT_TO_MB    defined when the regex lib is using chars and
 //                          wxChar is wide, so conversion to UTF-8 must be done
+// WXREGEX_USING_WCHAR      defined when the regex lib is using wide chars, so
+//                          UTF-8 text must be converted to wxChar
 // wxRegChar                the character type used by the regular expression engine
 //
 
@@ -58,9 +62,11 @@
 #   elif wxUSE_UNICODE_UTF16
 #       define PCRE2_CODE_UNIT_WIDTH 16
         typedef wchar_t wxRegChar;
+#       define WXREGEX_USING_WCHAR
 #   else
 #       define PCRE2_CODE_UNIT_WIDTH 32
         typedef wchar_t wxRegChar;
+#       define WXREGEX_USING_WCHAR
 #   endif
     typedef wxRegChar wxRegErrorChar;
 
@@ -99,6 +105,11 @@ namespace
 #define REG_NOSUB     0x0020    // Don't return matches.
 #define REG_NOTEMPTY  0x0100    // Same as PCRE2_NOTEMPTY.
 
+// Non-standard flags used only internally.
+#define REG_JIT                 0x1000  // Use JIT compilation if available.
+#define REG_NOTEMPTY_ATSTART    0x2000  // Same as PCRE2_NOTEMPTY_ATSTART.
+#define REG_NOUTFCHECK          0x4000  // Same as PCRE2_NO_UTF_CHECK.
+
 enum
 {
     REG_NOERROR = 0,    // Must be 0.
@@ -168,14 +179,25 @@ int wx_regcomp(regex_t* preg, const wxRegChar* pattern, int cflags)
         return REG_BADPAT;
     }
 
+    // JIT compilation is relatively expensive, so it's only done if asked
+    // for. Notice that it's not an error if it fails, e.g. because JIT
+    // support is not available on this platform, as pcre2_match() will just
+    // fall back to the interpreter then.
+    if ( cflags & REG_JIT )
+        pcre2_jit_compile(preg->code, PCRE2_JIT_COMPLETE);
+
     preg->match_data = pcre2_match_data_create_from_pattern(preg->code, NULL);
 
     return REG_NOERROR;
 }
 
+// Note that, unlike the standard regexec(), this function takes the offset at
+// which to start matching: this is not the same as passing "string + start"
+// to it, as the characters before the start are still taken into account
+// for the lookbehind assertions and "^" and "\b" matching.
 int
 wx_regexec(const regex_t* preg, const wxRegChar* string, size_t len,
-           size_t nmatch, regmatch_t* pmatch, int eflags)
+           size_t start, size_t nmatch, regmatch_t* pmatch, int eflags)
 {
     int options = 0;
 
@@ -185,17 +207,37 @@ wx_regexec(const regex_t* preg, const wxRegChar* string, size_t len,
         options |= PCRE2_NOTEOL;
     if ( eflags & REG_NOTEMPTY )
         options |= PCRE2_NOTEMPTY;
-
-    const int rc = pcre2_match
-                   (
-                        preg->code,
-                        (PCRE2_SPTR)string,
-                        len,
-                        0,                      // start offset
-                        options,
-                        preg->match_data,
-                        NULL                    // use default context
-                   );
+    if ( eflags & REG_NOTEMPTY_ATSTART )
+        options |= PCRE2_NOTEMPTY_ATSTART;
+    if ( eflags & REG_NOUTFCHECK )
+        options |= PCRE2_NO_UTF_CHECK;
+
+    int rc = pcre2_match
+             (
+                preg->code,
+                (PCRE2_SPTR)string,
+                len,
+                start,
+                options,
+                preg->match_data,
+                NULL                    // use default context
+             );
+
+    // JIT-compiled code uses a small fixed size stack by default, which may
+    // be insufficient for some patterns: just use the interpreter for them.
+    if ( rc == PCRE2_ERROR_JIT_STACKLIMIT )
+    {
+        rc = pcre2_match
+             (
+                preg->code,
+                (PCRE2_SPTR)string,
+                len,
+                start,
+                options | PCRE2_NO_JIT,
+                preg->match_data,
+                NULL
+             );
+    }
 
     if ( rc == PCRE2_ERROR_NOMATCH )
         return REG_NOMATCH;
@@ -265,6 +307,7 @@ void wx_regfree(regex_t* preg)
 typedef char wxRegErrorChar;
 #ifdef __REG_NOFRONT
 #   define WXREGEX_USING_BUILTIN
+#   define WXREGEX_USING_WCHAR
     typedef wxChar wxRegChar;
 #else
     typedef char wxRegChar;
@@ -319,6 +362,12 @@ public:
         return wx_truncate_cast(size_t, m_matches[n].rm_eo);
     }
 
+    void Set(size_t n, size_t start, size_t end)
+    {
+        m_matches[n].rm_so = start;
+        m_matches[n].rm_eo = end;
+    }
+
     regmatch_t *get() const         { return m_matches; }
 
 private:
@@ -376,6 +425,23 @@ public:
     int Replace(wxString *pattern, const wxString& replacement,
                 size_t maxMatches = 0) const;
 
+    // lower level version of Matches() taking the already translated regexec()
+    // flags and the offset at which the matching should start: unlike just
+    // passing "str + start" to Matches(), this allows the lookbehind and
+    // anchors to take the preceding text into account and returns the
+    // offsets relative to the start of str
+    bool DoMatch(const wxRegChar *str, size_t len, size_t start,
+                 int flagsRE) const;
+
+#ifdef WXREGEX_USING_WCHAR
+    // convert the offsets of the last match from wxRegChar units to the
+    // bytes of the UTF-8 representation of the given string
+    void ConvertMatchesToUTF8(const wxRegChar *str) const;
+#endif // WXREGEX_USING_WCHAR
+
+    // return the regexec() flags corresponding to wxRE_XXX matching flags
+    static int GetExecFlags(int flags);
+
 private:
     // return the string containing the error message for the given err code
     wxString GetErrorMsg(int errorcode) const;
@@ -1038,7 +1104,8 @@ bool wxRegExImpl::Compile(wxString expr, int flags)
     wxASSERT_MSG( (flags & FLAVORS) != FLAVORS,
                   wxT("incompatible flags in wxRegEx::Compile") );
 #endif
-    wxASSERT_MSG( !(flags & ~(FLAVORS | wxRE_ICASE | wxRE_NOSUB | wxRE_NEWLINE)),
+    wxASSERT_MSG( !(flags & ~(FLAVORS | wxRE_ICASE | wxRE_NOSUB | wxRE_NEWLINE |
+                              wxRE_JIT)),
                   wxT("unrecognized flags in wxRegEx::Compile") );
 
 #if wxUSE_PCRE
@@ -1075,6 +1142,10 @@ bool wxRegExImpl::Compile(wxString expr, int flags)
         flagsRE |= REG_NOSUB;
     if ( flags & wxRE_NEWLINE )
         flagsRE |= REG_NEWLINE;
+#if wxUSE_PCRE
+    if ( flags & wxRE_JIT )
+        flagsRE |= REG_JIT;
+#endif // wxUSE_PCRE
 
 #ifndef WXREGEX_CONVERT_TO_MB
     const wxChar *exprstr = expr.c_str();
@@ -1175,12 +1246,9 @@ static int ReSearch(const regex_t *preg,
 
 #endif // WXREGEX_USING_RE_SEARCH
 
-bool wxRegExImpl::Matches(const wxRegChar *str,
-                          int flags,
-                          size_t len) const
+/* static */
+int wxRegExImpl::GetExecFlags(int flags)
 {
-    wxCHECK_MSG( IsValid(), false, wxT("must successfully Compile() first") );
-
     // translate our flags to regexec() ones
     wxASSERT_MSG( !(flags & ~(wxRE_NOTBOL | wxRE_NOTEOL | wxRE_NOTEMPTY)),
                   wxT("unrecognized flags in wxRegEx::Matches") );
@@ -1195,6 +1263,28 @@ bool wxRegExImpl::Matches(const wxRegChar *str,
         flagsRE |= REG_NOTEMPTY;
 #endif // wxUSE_PCRE
 
+    return flagsRE;
+}
+
+bool wxRegExImpl::Matches(const wxRegChar *str,
+                          int flags,
+                          size_t len) const
+{
+    wxCHECK_MSG( IsValid(), false, wxT("must successfully Compile() first") );
+
+    return DoMatch(str, len, 0, GetExecFlags(flags));
+}
+
+bool wxRegExImpl::DoMatch(const wxRegChar *str,
+                          size_t len,
+                          size_t start,
+                          int flagsRE) const
+{
+#if !wxUSE_PCRE
+    wxCHECK_MSG( start == 0, false,
+                 wxT("matching at an offset is only supported with PCRE") );
+#endif // !wxUSE_PCRE
+
     // allocate matches array if needed
     wxRegExImpl *self = wxConstCast(this, wxRegExImpl);
     if ( !m_Matches && m_nMatches )
@@ -1209,6 +1299,9 @@ bool wxRegExImpl::Matches(const wxRegChar *str,
     int rc = wx_re_exec(&self->m_RegEx, str, len, NULL, m_nMatches, matches, flagsRE);
 #elif defined WXREGEX_USING_RE_SEARCH
     int rc = ReSearch(&self->m_RegEx, str, len, matches, flagsRE);
+#elif wxUSE_PCRE
+    int rc = wx_regexec(&self->m_RegEx, str, len, start,
+                        m_nMatches, matches, flagsRE);
 #else
     int rc = wx_regexec(&self->m_RegEx, str, len, m_nMatches, matches, flagsRE);
 #endif
@@ -1246,6 +1339,67 @@ bool wxRegExImpl::GetMatch(size_t *start, size_t *len, size_t index) const
     return true;
 }
 
+#ifdef WXREGEX_USING_WCHAR
+
+namespace
+{
+
+// Return the length of the UTF-8 representation of the given wide string.
+size_t GetUTF8Length(const wxRegChar *str, size_t len)
+{
+    size_t lenUTF8 = 0;
+    for ( const wxRegChar* const end = str + len; str != end; ++str )
+    {
+        const wxUint32 ch = static_cast<wxUint32>(*str);
+        if ( ch < 0x80 )
+            lenUTF8 += 1;
+        else if ( ch < 0x800 )
+            lenUTF8 += 2;
+        else if ( ch >= 0xd800 && ch < 0xe000 )
+            lenUTF8 += 2; // Half of the 4 bytes used by the surrogate pair.
+        else if ( ch < 0x10000 )
+            lenUTF8 += 3;
+        else
+            lenUTF8 += 4;
+    }
+
+    return lenUTF8;
+}
+
+} // anonymous namespace
+
+void wxRegExImpl::ConvertMatchesToUTF8(const wxRegChar *str) const
+{
+    if ( !m_Matches )
+        return;
+
+    // The matches are typically all close to each other, so convert the
+    // start of the entire match first and then the other offsets relatively
+    // to it to avoid iterating over the beginning of the string many times.
+    const size_t start0 = m_Matches->Start(0);
+    const size_t start0UTF8 = GetUTF8Length(str, start0);
+
+    for ( size_t n = 0; n < m_nMatches; ++n )
+    {
+        const size_t start = m_Matches->Start(n);
+        if ( start == static_cast<size_t>(-1) )
+            continue;
+
+        const size_t end = m_Matches->End(n);
+
+        size_t startUTF8;
+        if ( start >= start0 )
+            startUTF8 = start0UTF8 + GetUTF8Length(str + start0, start - start0);
+        else // Possible when using lookbehind assertions.
+            startUTF8 = GetUTF8Length(str, start);
+
+        m_Matches->Set(n, startUTF8,
+                       startUTF8 + GetUTF8Length(str + start, end - start));
+    }
+}
+
+#endif // WXREGEX_USING_WCHAR
+
 size_t wxRegExImpl::GetMatchCount() const
 {
     wxCHECK_MSG( IsValid(), 0, wxT("must successfully Compile() first") );
@@ -1433,6 +1587,42 @@ bool wxRegEx::Matches(const wxString& str, int flags) const
     return m_impl->Matches(textstr, flags, textlen);
 }
 
+bool wxRegEx::Matches(const wxChar *text, int flags, size_t len) const
+{
+    wxCHECK_MSG( IsValid(), false, wxT("must successfully Compile() first") );
+
+#ifndef WXREGEX_CONVERT_TO_MB
+    // There is no need to create a temporary string in this case.
+    return m_impl->Matches(text, flags, len);
+#else
+    return Matches(wxString(text, len), flags);
+#endif
+}
+
+bool wxRegEx::MatchesUTF8(const char *text, size_t len, int flags) const
+{
+    wxCHECK_MSG( IsValid(), false, wxT("must successfully Compile() first") );
+    wxCHECK_MSG( text || !len, false, wxT("NULL text in wxRegEx::MatchesUTF8") );
+
+#ifndef WXREGEX_USING_WCHAR
+    return m_impl->Matches(text, flags, len);
+#else
+    // We have no choice but to convert the text when the regex library uses
+    // wide characters, but still return the offsets in bytes, for consistency.
+    size_t lenW;
+    const wxWCharBuffer buf = wxConvUTF8.cMB2WC(text, len, &lenW);
+    if ( !buf )
+        return false;
+
+    if ( !m_impl->Matches(buf.data(), flags, lenW) )
+        return false;
+
+    m_impl->ConvertMatchesToUTF8(buf.data());
+
+    return true;
+#endif
+}
+
 bool wxRegEx::GetMatch(size_t *start, size_t *len, size_t index) const
 {
     wxCHECK_MSG( IsValid(), false, wxT("must successfully Compile() first") );
@@ -1460,6 +1650,72 @@ size_t wxRegEx::GetMatchCount() const
     return m_impl->GetMatchCount();
 }
 
+wxRegExMatchIterator wxRegEx::GetMatchAll(const wxString& text, int flags) const
+{
+    wxASSERT_MSG( IsValid(), wxT("must successfully Compile() first") );
+
+    return wxRegExMatchIterator(*this, text, flags);
+}
+
+// ----------------------------------------------------------------------------
+// wxRegExMatchIterator
+// ----------------------------------------------------------------------------
+
+bool wxRegExMatchIterator::Next()
+{
+    wxCHECK_MSG( m_regex.IsValid(), false,
+                 wxT("must successfully Compile() first") );
+
+    if ( m_pos == wxString::npos )
+        return false;
+
+    wxRegExImpl* const impl = m_regex.m_impl;
+    wxCHECK_MSG( impl->GetMatchCount(), false,
+                 wxT("can't use with wxRE_NOSUB") );
+
+#ifndef WXREGEX_CONVERT_TO_MB
+    const wxChar* const textstr = m_text.c_str();
+    const size_t textlen = m_text.length();
+#else
+    // This doesn't copy the string as it's already stored in UTF-8.
+    const wxScopedCharBuffer textbuf = m_text.utf8_str();
+    const char* const textstr = textbuf.data();
+    const size_t textlen = textbuf.length();
+#endif
+
+    int flagsRE = wxRegExImpl::GetExecFlags(m_flags);
+
+#if wxUSE_PCRE
+    // Searching from the current position, instead of just passing the text
+    // starting at it, ensures that "^" doesn't match there and that the
+    // preceding text is taken into account by the lookbehind assertions.
+    //
+    // Also, the entire text was already checked for validity during the
+    // first call, so don't waste time on doing it again for every match.
+    if ( m_pos || m_lastWasEmpty )
+        flagsRE |= REG_NOUTFCHECK;
+
+    // Avoid finding the same empty match again, but allow a non-empty match
+    // at the same position, as well as an empty match at a later one.
+    if ( m_lastWasEmpty )
+        flagsRE |= REG_NOTEMPTY_ATSTART;
+#endif // wxUSE_PCRE
+
+    size_t start,
+           len;
+    if ( !impl->DoMatch(textstr, textlen, m_pos, flagsRE) ||
+            !impl->GetMatch(&start, &len) )
+    {
+        m_pos = wxString::npos;
+        return false;
+    }
+
+    m_pos = start + len;
+    m_lastWasEmpty = len == 0;
+
+    return true;
+}
+
 int wxRegEx::Replace(wxString *pattern,
                      const wxString& replacement,
                      size_t maxMatches) const
@@ -1503,4 +1759,850 @@ wxVersionInfo wxRegEx::GetLibraryVersionInfo()
     return wxVersionInfo("PCRE2", PCRE2_MAJOR, PCRE2_MINOR, 0, buf);
 }
 
+// ----------------------------------------------------------------------------
+// wxRegExSet
+// ----------------------------------------------------------------------------
+
+// The patterns in the set are combined into a single PCRE pattern of the form
+//
+//      (?opts:pattern1)(?C1)|(?opts:pattern2)(?C1)|...
+//
+// where the callout at the end of each alternative records that the pattern
+// matched and then makes the match fail, so that PCRE goes on trying all the
+// remaining alternatives at all positions in the text.
+//
+// This loses some of the optimizations PCRE uses when matching a single
+// pattern, without which matching patterns such as "a.*z" or ".*foo" at every
+// position could take quadratic time, so we emulate them:
+//
+//  - Patterns which can only match at the start of the text or of a line,
+//    e.g. because they start with ".*", are prefixed with an assertion.
+//  - Patterns with a literal character which must occur in the text for them
+//    to match or which can match long strings are preceded by another callout
+//    (?C2) which makes them fail if this character doesn't occur after the
+//    current position or if the pattern had already matched. This callout is
+//    itself preceded by a lookahead for the first character of the pattern,
+//    if it's known, to avoid calling it at the positions where the pattern
+//    can't match anyhow, as it isn't used for all patterns because calling
+//    it is relatively expensive, especially when using JIT.
+//
+// Some patterns can't be combined in this way, e.g. because they use back
+// references, which would refer to the wrong groups in the combined pattern,
+// so they are matched separately.
+
+namespace
+{
+
+// Return true if the given (PCRE syntax) pattern can be used as part of the
+// combined pattern, see above.
+bool CanCombinePattern(const wxString& expr)
+{
+    const wxWX2WCbuf buf = expr.wc_str();
+    for ( const wchar_t* p = buf; *p; ++p )
+    {
+        if ( *p == '\\' )
+        {
+            ++p;
+
+            // Back references to the numbered or named groups.
+            if ( (*p >= '1' && *p <= '9') || *p == 'g' || *p == 'k' )
+                return false;
+
+            if ( !*p )
+                break;
+
+            continue;
+        }
+
+        if ( *p != '(' )
+            continue;
+
+        // Backtracking control verbs, such as "(*ACCEPT)" or "(*SKIP)", would
+        // affect the other alternatives too.
+        if ( p[1] == '*' )
+            return false;
+
+        if ( p[1] != '?' )
+            continue;
+
+        p += 2;
+
+        if ( *p == '<' )
+        {
+            // Lookbehind assertions are fine, named groups are not because
+            // different patterns could use the same name.
+            if ( p[1] != '=' && p[1] != '!' )
+                return false;
+
+            continue;
+        }
+
+        // Named groups in other syntaxes, recursion, subroutine calls and
+        // conditional groups referring to other groups.
+        if ( *p == '\'' || *p == 'P' || *p == 'R' || *p == '&' || *p == '(' ||
+                *p == '+' || (*p >= '0' && *p <= '9') )
+            return false;
+
+        // Callouts would be handled by our own callout used for finding the
+        // matching alternative, which would consider that it matched even if
+        // the rest of the pattern doesn't.
+        if ( *p == 'C' )
+            return false;
+
+        // Embedded options: using extended syntax would turn the rest of the
+        // combined pattern into a comment after a "#" in the pattern.
+        for ( ; *p == '-' || *p == '^' || (*p >= 'a' && *p <= 'z'); ++p )
+        {
+            if ( *p == 'x' )
+                return false;
+
+            // Relative group references.
+            if ( *p == '-' && p[1] >= '0' && p[1] <= '9' )
+                return false;
+        }
+
+        if ( !*p )
+            break;
+    }
+
+    return true;
+}
+
+// Return true if the pattern may contain case-insensitive parts.
+bool MayBeCaseless(const wxString& expr, int flags)
+{
+    if ( flags & wxRE_ICASE )
+        return true;
+
+    // Check for the embedded "i" option, this may give false positives but
+    // it doesn't matter, as this is only used for optimization purposes.
+    for ( size_t pos = expr.find("(?");
+          pos != wxString::npos;
+          pos = expr.find("(?", pos + 2) )
+    {
+        for ( wxString::const_iterator it = expr.begin() + pos + 2;
+              it != expr.end();
+              ++it )
+        {
+            const wxUniChar ch = *it;
+            if ( ch == 'i' )
+                return true;
+
+            if ( ch != '-' && ch != '^' && (ch < 'a' || ch > 'z') )
+                break;
+        }
+    }
+
+    return false;
+}
+
+// Return true if the pattern contains a "wildcard", i.e. an item matching
+// almost any character, repeated unlimited number of times, such as ".*".
+// This doesn't need to be exact as it's only used for optimization purposes.
+bool HasUnboundedWildcard(const wxString& expr)
+{
+    const wxWX2WCbuf buf = expr.wc_str();
+    for ( const wchar_t* p = buf; *p; ++p )
+    {
+        bool wildcard = false;
+        switch ( *p )
+        {
+            case '.':
+                wildcard = true;
+                break;
+
+            case '\\':
+                switch ( *++p )
+                {
+                    case '\0':
+                        return false;
+
+                    case 'Q':
+                        // Skip the quoted literal part.
+                        for ( ++p; *p && (p[0] != '\\' || p[1] != 'E'); ++p )
+                            ;
+                        if ( !*p )
+                            return false;
+                        ++p;
+                        break;
+
+                    // Negated character types.
+                    case 'C':
+                    case 'D':
+                    case 'H':
+                    case 'N':
+                    case 'R':
+                    case 'S':
+                    case 'V':
+                    case 'W':
+                    case 'X':
+                        wildcard = true;
+                        break;
+                }
+                break;
+
+            case '[':
+                // Treat all negated character classes as wildcards and skip
+                // over the class, notice that "]" is literal if it comes first.
+                wildcard = p[1] == '^';
+                p += wildcard ? 2 : 1;
+                if ( *p == ']' )
+                    ++p;
+                for ( ; *p && *p != ']'; ++p )
+                {
+                    if ( *p == '\\' && p[1] )
+                        ++p;
+                }
+                if ( !*p )
+                    return false;
+                break;
+        }
+
+        if ( !wildcard )
+            continue;
+
+        switch ( p[1] )
+        {
+            case '*':
+            case '+':
+                return true;
+
+            case '{':
+                // Check for "{n,}" form.
+                for ( const wchar_t* q = p + 2; *q >= '0' && *q <= '9'; ++q )
+                {
+                    if ( q[1] == ',' && q[2] == '}' )
+                        return true;
+                }
+                break;
+        }
+    }
+
+    return false;
+}
+
+// Return the pattern in the form used in the combined pattern, but without
+// the callouts.
+wxString MakeSetAlternative(const wxString& expr, int flags)
+{
+    // Use the options corresponding to this pattern flags, see wx_regcomp(),
+    // for this alternative only.
+    wxString s = "(?";
+    if ( flags & wxRE_ICASE )
+        s += 'i';
+    s += flags & wxRE_NEWLINE ? "m-s:" : "s-m:";
+
+    s += expr;
+
+    // Terminate "\Q" if it's not terminated in the pattern itself, as is the
+    // case when using "***=" director, for example.
+    if ( expr.find("\\Q") != wxString::npos )
+        s += "\\E";
+
+    s += ')';
+
+    return s;
+}
+
+// Return the length of the string in wxRegChar units.
+inline size_t GetRegCharLength(const wxString& s)
+{
+#ifndef WXREGEX_CONVERT_TO_MB
+    return s.length();
+#else
+    return s.utf8_length();
+#endif
+}
+
+// The numbers of the callouts used in the combined pattern.
+enum
+{
+    RegExSetCallout_End = 1,
+    RegExSetCallout_Start = 2
+};
+
+int RegExSetCallout(pcre2_callout_block* block, void* data);
+
+} // anonymous namespace
+
+class wxRegExSetImpl
+{
+public:
+    wxRegExSetImpl()
+    {
+        m_code = NULL;
+        m_matchData = NULL;
+        m_matchContext = NULL;
+        m_needsCompile = false;
+        m_useJIT = false;
+        m_findAll = false;
+        m_notEmpty = false;
+        m_numFound = 0;
+        m_numPossible = 0;
+    }
+
+    ~wxRegExSetImpl()
+    {
+        Free();
+
+        for ( size_t n = 0; n < m_regexes.size(); ++n )
+            delete m_regexes[n];
+    }
+
+    int Add(const wxString& pattern, int flags);
+
+    size_t GetCount() const { return m_regexes.size(); }
+
+    bool Matches(const wxString& text, wxArrayInt *indices, int flags);
+
+    // called from the PCRE callout during matching
+    int OnCallout(const pcre2_callout_block& block);
+
+private:
+    // free the combined pattern
+    void Free();
+
+    // compile the combined pattern if necessary, return false if there is
+    // nothing to match using it
+    bool UpdateCombined();
+
+    // find the positions of the required characters of all alternatives in
+    // the given text and return the number of those which can match it
+    size_t FindRequired(const wxRegChar* text, size_t len);
+
+    // all patterns compiled individually, used for matching the patterns
+    // which can't be combined
+    wxVector<wxRegEx*> m_regexes;
+
+    // the patterns included into the combined pattern
+    struct Alternative
+    {
+        Alternative(size_t index_, const wxString& expr_, int flags_)
+            : index(index_), expr(expr_), flags(flags_),
+              startCallout(false)
+        {
+        }
+
+        // determine the values of the fields below
+        void Analyze();
+
+        // index of the pattern in m_regexes
+        size_t index;
+
+        // expression in PCRE syntax
+        wxString expr;
+
+        // compilation flags
+        int flags;
+
+        // the part of the combined pattern preceding this alternative and
+        // whether the start callout is used for it, see the comment above
+        wxString prefix;
+        bool startCallout;
+
+        // the code units one of which must occur in the text after the match
+        // start for the pattern to match, empty if there are none
+        wxVector<wxUint32> required;
+    };
+    wxVector<Alternative> m_alternatives;
+
+    // indices of the patterns which must be matched separately
+    wxVector<size_t> m_separate;
+
+    // the combined pattern and the associated data, only valid if
+    // m_alternatives is not empty and m_needsCompile is false
+    pcre2_code* m_code;
+    pcre2_match_data* m_matchData;
+    pcre2_match_context* m_matchContext;
+    bool m_needsCompile;
+
+    // true if any of the patterns used wxRE_JIT
+    bool m_useJIT;
+
+    // offsets of the alternatives in the combined pattern, in wxRegChar units
+    wxVector<size_t> m_offsets;
+
+    // the state of the current match: the alternatives found so far, the
+    // positions after the last occurrence of their required characters (0 if
+    // they don't occur at all), the number of alternatives which can still be
+    // found and the matching options
+    wxVector<bool> m_found;
+    wxVector<size_t> m_requiredEnd;
+    size_t m_numFound;
+    size_t m_numPossible;
+    bool m_findAll;
+    bool m_notEmpty;
+};
+
+namespace
+{
+
+int RegExSetCallout(pcre2_callout_block* block, void* data)
+{
+    return static_cast<wxRegExSetImpl*>(data)->OnCallout(*block);
+}
+
+} // anonymous namespace
+
+void wxRegExSetImpl::Free()
+{
+    pcre2_match_context_free(m_matchContext);
+    pcre2_match_data_free(m_matchData);
+    pcre2_code_free(m_code);
+
+    m_matchContext = NULL;
+    m_matchData = NULL;
+    m_code = NULL;
+}
+
+int wxRegExSetImpl::Add(const wxString& pattern, int flags)
+{
+    // Compiling the pattern on its own allows to check that it is valid and
+    // give the usual error message if it isn't.
+    wxRegEx* const re = new wxRegEx();
+    if ( !re->Compile(pattern, flags | wxRE_NOSUB) )
+    {
+        delete re;
+        return wxNOT_FOUND;
+    }
+
+    const size_t index = m_regexes.size();
+    m_regexes.push_back(re);
+
+    // Do the same conversions as wxRegExImpl::Compile() to get the pattern
+    // in PCRE syntax.
+    wxString expr = ConvertMetasyntax(pattern, flags);
+    if ( flags & wxRE_BASIC )
+        expr = wxRegEx::ConvertFromBasic(expr);
+    else if ( flags & wxRE_ADVANCED )
+        expr = ConvertWordBoundaries(expr);
+
+    if ( CanCombinePattern(expr) )
+    {
+        m_alternatives.push_back(Alternative(index, expr, flags));
+        m_alternatives.back().Analyze();
+        m_needsCompile = true;
+
+        if ( flags & wxRE_JIT )
+            m_useJIT = true;
+    }
+    else
+    {
+        m_separate.push_back(index);
+    }
+
+    return static_cast<int>(index);
+}
+
+bool wxRegExSetImpl::UpdateCombined()
+{
+    if ( m_alternatives.empty() )
+        return false;
+
+    if ( !m_needsCompile )
+        return true;
+
+    m_needsCompile = false;
+
+    Free();
+
+    wxString combined;
+    m_offsets.clear();
+    m_offsets.reserve(m_alternatives.size());
+
+    size_t offset = 0;
+    for ( size_t n = 0; n < m_alternatives.size(); ++n )
+    {
+        const Alternative& alt = m_alternatives[n];
+
+        wxString s;
+        if ( n )
+            s += '|';
+
+        m_offsets.push_back(offset + (n ? 1 : 0));
+
+        s += alt.prefix;
+        if ( alt.startCallout )
+            s += wxString::Format("(?C%d)", RegExSetCallout_Start);
+        s += MakeSetAlternative(alt.expr, alt.flags);
+        s += wxString::Format("(?C%d)", RegExSetCallout_End);
+
+        offset += GetRegCharLength(s);
+        combined += s;
+    }
+
+#ifndef WXREGEX_CONVERT_TO_MB
+    const wxChar *combinedstr = combined.c_str();
+#else
+    const wxScopedCharBuffer combinedbuf = combined.utf8_str();
+    const char* const combinedstr = combinedbuf.data();
+#endif
+
+    int errorcode;
+    PCRE2_SIZE erroroffset;
+    m_code = pcre2_compile
+             (
+                (PCRE2_SPTR)combinedstr,
+                PCRE2_ZERO_TERMINATED,
+                PCRE2_UTF | PCRE2_ALT_BSUX,
+                &errorcode,
+                &erroroffset,
+                NULL                    // use default context
+             );
+
+    if ( !m_code )
+    {
+        // This is not supposed to happen as all the patterns were checked to
+        // be valid individually, but if it somehow does, we can still match
+        // all of them separately.
+        wxLogDebug("Failed to compile combined regex: error %d at %zu",
+                   errorcode, static_cast<size_t>(erroroffset));
+
+        for ( size_t n = 0; n < m_alternatives.size(); ++n )
+            m_separate.push_back(m_alternatives[n].index);
+
+        m_alternatives.clear();
+
+        return false;
+    }
+
+    // Ignore errors here, see wx_regcomp().
+    if ( m_useJIT )
+        pcre2_jit_compile(m_code, PCRE2_JIT_COMPLETE);
+
+    m_matchData = pcre2_match_data_create(1, NULL);
+    m_matchContext = pcre2_match_context_create(NULL);
+    pcre2_set_callout(m_matchContext, RegExSetCallout, this);
+
+    return true;
+}
+
+void wxRegExSetImpl::Alternative::Analyze()
+{
+    // Compile this pattern on its own to get the information about it which
+    // PCRE uses for its own optimizations.
+    const wxString alt = MakeSetAlternative(expr, flags);
+
+#ifndef WXREGEX_CONVERT_TO_MB
+    const wxChar *altstr = alt.c_str();
+#else
+    const wxScopedCharBuffer altbuf = alt.utf8_str();
+    const char* const altstr = altbuf.data();
+#endif
+
+    int errorcode;
+    PCRE2_SIZE erroroffset;
+    pcre2_code* const code = pcre2_compile
+                             (
+                                (PCRE2_SPTR)altstr,
+                                PCRE2_ZERO_TERMINATED,
+                                PCRE2_UTF | PCRE2_ALT_BSUX,
+                                &errorcode,
+                                &erroroffset,
+                                NULL
+                             );
+    if ( !code )
+        return;
+
+    // Prefer using simpler assertions rather than the callout for the
+    // anchored patterns. Notice that we only check for the most common new
+    // line characters, so don't do it with the other newline conventions.
+    uint32_t options = 0,
+             firstType = 0,
+             newline = 0;
+    pcre2_pattern_info(code, PCRE2_INFO_ALLOPTIONS, &options);
+    pcre2_pattern_info(code, PCRE2_INFO_FIRSTCODETYPE, &firstType);
+    pcre2_pattern_info(code, PCRE2_INFO_NEWLINE, &newline);
+    if ( options & PCRE2_ANCHORED )
+    {
+        prefix = "\\A";
+    }
+    else if ( firstType == 2 &&
+                (newline == PCRE2_NEWLINE_LF ||
+                 newline == PCRE2_NEWLINE_CR ||
+                 newline == PCRE2_NEWLINE_CRLF ||
+                 newline == PCRE2_NEWLINE_ANYCRLF) )
+    {
+        prefix = "(?:\\A|(?<=[\\r\\n]))";
+    }
+
+    // PCRE doesn't tell us whether the literal code units are matched case-
+    // insensitively, so assume they are if they may be.
+    const bool caseless = MayBeCaseless(expr, flags);
+
+    uint32_t first = 0;
+    if ( firstType == 1 )
+        pcre2_pattern_info(code, PCRE2_INFO_FIRSTCODEUNIT, &first);
+
+    // Use the last literal code unit if there is one, as it's more likely to
+    // allow rejecting the match quickly, but fall back on the first one.
+    uint32_t lastType = 0,
+             unit = first;
+    pcre2_pattern_info(code, PCRE2_INFO_LASTCODETYPE, &lastType);
+    if ( lastType == 1 )
+        pcre2_pattern_info(code, PCRE2_INFO_LASTCODEUNIT, &unit);
+
+    if ( lastType == 1 || firstType == 1 )
+    {
+        if ( !caseless )
+        {
+            required.push_back(unit);
+        }
+        else if ( unit < 0x80 )
+        {
+            // Don't use locale-dependent functions for ASCII case mapping and
+            // ignore "k" and "s" which, unlike all the other ASCII letters,
+            // have non-ASCII case variants.
+            const wxUint32 lower = unit | 0x20;
+            if ( lower < 'a' || lower > 'z' )
+            {
+                required.push_back(unit);
+            }
+            else if ( lower != 'k' && lower != 's' )
+            {
+                required.push_back(lower);
+                required.push_back(lower & ~0x20);
+            }
+        }
+    }
+
+    startCallout = !required.empty() || HasUnboundedWildcard(expr);
+
+    // Only check for the first code unit if it's an ASCII one, as otherwise it
+    // could be a part of a multibyte sequence in UTF-8 build.
+    if ( startCallout && firstType == 1 && first < 0x80 )
+    {
+        prefix += wxString::Format("(?=%s\\x%02x)",
+                                   caseless ? "(?i)" : "", first);
+    }
+
+    pcre2_code_free(code);
+}
+
+size_t wxRegExSetImpl::FindRequired(const wxRegChar* text, size_t len)
+{
+    // Find the positions after the last occurrences of all ASCII characters,
+    // which almost all required characters are, in a single pass.
+    size_t endASCII[0x80] = { 0 };
+    for ( size_t i = 0; i < len; ++i )
+    {
+        const PCRE2_UCHAR unit = static_cast<PCRE2_UCHAR>(text[i]);
+        if ( unit < 0x80 )
+            endASCII[unit] = i + 1;
+    }
+
+    m_requiredEnd.resize(m_alternatives.size());
+
+    size_t numPossible = 0;
+    for ( size_t n = 0; n < m_alternatives.size(); ++n )
+    {
+        const wxVector<wxUint32>& required = m_alternatives[n].required;
+
+        // If there is no required character, this alternative can match at
+        // any position, including at the very end of the text.
+        size_t end = required.empty() ? len + 1 : 0;
+        for ( size_t m = 0; m < required.size(); ++m )
+        {
+            const wxUint32 unit = required[m];
+            if ( unit < 0x80 )
+            {
+                end = std::max(end, endASCII[unit]);
+                continue;
+            }
+
+            for ( size_t i = len; i > end; --i )
+            {
+                if ( static_cast<PCRE2_UCHAR>(text[i - 1]) == unit )
+                {
+                    end = i;
+                    break;
+                }
+            }
+        }
+
+        m_requiredEnd[n] = end;
+        if ( end )
+            numPossible++;
+    }
+
+    return numPossible;
+}
+
+int wxRegExSetImpl::OnCallout(const pcre2_callout_block& block)
+{
+    // Find the alternative containing this callout.
+    const wxVector<size_t>::const_iterator
+        it = std::upper_bound(m_offsets.begin(), m_offsets.end(),
+                              static_cast<size_t>(block.pattern_position));
+    const size_t alt = it - m_offsets.begin() - 1;
+
+    // Returning a positive value makes the current match attempt fail.
+    if ( block.callout_number == RegExSetCallout_Start )
+    {
+        if ( m_found[alt] )
+            return 1;
+
+        if ( block.current_position < m_requiredEnd[alt] )
+            return 0;
+
+        // This alternative can't match at any of the next positions neither,
+        // so stop matching if there are no more alternatives which can.
+        if ( m_requiredEnd[alt] )
+        {
+            m_requiredEnd[alt] = 0;
+            if ( --m_numPossible == m_numFound )
+                return PCRE2_ERROR_CALLOUT;
+        }
+
+        return 1;
+    }
+
+    if ( m_notEmpty && block.current_position == block.start_match )
+        return 1;
+
+    if ( !m_found[alt] )
+    {
+        m_found[alt] = true;
+        m_numFound++;
+
+        // Stop matching completely if there is nothing more to find.
+        if ( !m_findAll || m_numFound == m_numPossible )
+            return PCRE2_ERROR_CALLOUT;
+    }
+
+    return 1;
+}
+
+bool wxRegExSetImpl::Matches(const wxString& text, wxArrayInt *indices, int flags)
+{
+    wxASSERT_MSG( !(flags & ~(wxRE_NOTBOL | wxRE_NOTEOL | wxRE_NOTEMPTY)),
+                  wxT("unrecognized flags in wxRegExSet::Matches") );
+
+    wxVector<bool> matched(m_regexes.size(), false);
+    bool found = false;
+
+    if ( UpdateCombined() )
+    {
+#ifndef WXREGEX_CONVERT_TO_MB
+        const wxChar* const textstr = text.c_str();
+        const size_t textlen = text.length();
+#else
+        const wxScopedCharBuffer textbuf = text.utf8_str();
+        const char* const textstr = textbuf.data();
+        const size_t textlen = textbuf.length();
+#endif
+
+        int options = 0;
+        if ( flags & wxRE_NOTBOL )
+            options |= PCRE2_NOTBOL;
+        if ( flags & wxRE_NOTEOL )
+            options |= PCRE2_NOTEOL;
+
+        m_found.assign(m_alternatives.size(), false);
+        m_numFound = 0;
+        m_numPossible = FindRequired(textstr, textlen);
+        m_findAll = indices != NULL;
+        m_notEmpty = (flags & wxRE_NOTEMPTY) != 0;
+
+        // Don't bother matching at all if none of the patterns can match.
+        int rc = PCRE2_ERROR_NOMATCH;
+        if ( m_numPossible )
+        {
+            rc = pcre2_match(m_code, (PCRE2_SPTR)textstr, textlen, 0,
+                             options, m_matchData, m_matchContext);
+        }
+
+        if ( rc == PCRE2_ERROR_JIT_STACKLIMIT )
+        {
+            rc = pcre2_match(m_code, (PCRE2_SPTR)textstr, textlen, 0,
+                             options | PCRE2_NO_JIT, m_matchData, m_matchContext);
+        }
+
+        // As the callouts always make the match fail, we can only get "no
+        // match" or "callout error" if we stopped early.
+        if ( rc < 0 && rc != PCRE2_ERROR_NOMATCH && rc != PCRE2_ERROR_CALLOUT )
+        {
+            wxRegErrorChar buffer[256];
+            if ( pcre2_get_error_message(rc, (PCRE2_UCHAR*)buffer,
+                                         WXSIZEOF(buffer)) < 0 )
+            {
+                wxSnprintf(buffer, WXSIZEOF(buffer), "PCRE error %d", rc);
+            }
+
+            wxLogError(_("Failed to find match for regular expression: %s"),
+                       wxString(buffer));
+        }
+
+        for ( size_t n = 0; n < m_alternatives.size(); ++n )
+        {
+            if ( m_found[n] )
+            {
+                matched[m_alternatives[n].index] = true;
+                found = true;
+            }
+        }
+    }
+
+    for ( size_t n = 0; n < m_separate.size(); ++n )
+    {
+        if ( found && !indices )
+            break;
+
+        const size_t index = m_separate[n];
+        if ( m_regexes[index]->Matches(text, flags) )
+        {
+            matched[index] = true;
+            found = true;
+        }
+    }
+
+    if ( indices )
+    {
+        indices->clear();
+        for ( size_t n = 0; n < matched.size(); ++n )
+        {
+            if ( matched[n] )
+                indices->push_back(n);
+        }
+    }
+
+    return found;
+}
+
+wxRegExSet::~wxRegExSet()
+{
+    delete m_impl;
+}
+
+int wxRegExSet::Add(const wxString& pattern, int flags)
+{
+    if ( !m_impl )
+        m_impl = new wxRegExSetImpl;
+
+    return m_impl->Add(pattern, flags);
+}
+
+size_t wxRegExSet::GetCount() const
+{
+    return m_impl ? m_impl->GetCount() : 0;
+}
+
+void wxRegExSet::Clear()
+{
+    wxDELETE(m_impl);
+}
+
+bool wxRegExSet::Matches(const wxString& text, wxArrayInt *indices, int flags) const
+{
+    if ( !m_impl )
+    {
+        if ( indices )
+            indices->clear();
+
+        return false;
+    }
+
+    return m_impl->Matches(text, indices, flags);
+}
+
 #endif // wxUSE_REGEX
@@ -38,6 +38,7 @@
 #include <stdlib.h>
 
 #include "wx/arrstr.h"
+#include "wx/atomic.h"
 #include "wx/dir.h"
 #include "wx/file.h"
 #include "wx/filename.h"
@@ -45,6 +46,8 @@
 #include "wx/fontmap.h"
 #include "wx/scopedptr.h"
 #include "wx/stdpaths.h"
+#include "wx/sysopt.h"
+#include "wx/thread.h"
 #include "wx/version.h"
 #include "wx/private/threadinfo.h"
 #include "wx/uilocale.h"
@@ -56,6 +59,10 @@
     #include "wx/msw/missing.h"
 #endif
 
+#ifdef __UNIX__
+    #include <sys/mman.h>
+#endif
+
 // ----------------------------------------------------------------------------
 // simple types
 // ----------------------------------------------------------------------------
@@ -905,15 +912,27 @@ public:
     wxMsgCatalogFile();
     ~wxMsgCatalogFile();
 
-    // load the catalog from disk
+    // load the catalog from disk, mapping it into memory instead of reading
+    // it if mapFile is true and this is supported
     bool LoadFile(const wxString& filename,
-                  wxPluralFormsCalculatorPtr& rPluralFormsCalculator);
+                  wxPluralFormsCalculatorPtr& rPluralFormsCalculator,
+                  bool mapFile = false);
     bool LoadData(const DataBuffer& data,
                   wxPluralFormsCalculatorPtr& rPluralFormsCalculator);
 
     // fills the hash with string-translation pairs
     bool FillHash(wxStringToStringHashMap& hash, const wxString& domain) const;
 
+    // prepares for using FindString() instead of FillHash(), the object must
+    // be kept alive as long as it is used then
+    bool InitLookup();
+
+    // returns the translation for the given key, which is the msgid, possibly
+    // including context, followed by the plural form index if it's not 0, or
+    // NULL if not found: the strings are looked up in the catalog data and
+    // converted only when this function is called for them for the first time
+    const wxString *FindString(const wxString& key, int index);
+
     // return the charset of the strings in this catalog or empty string if
     // none/unknown
     wxString GetCharset() const { return m_charset; }
@@ -948,9 +967,39 @@ private:
     const
     wxMsgTableEntry  *m_pOrigTable,   // pointer to original   strings
                      *m_pTransTable;  //            translated
+    const size_t32   *m_pHashTable;   // hash table, may be NULL
+    size_t32          m_nHashSize;    // number of entries in the hash table
 
     wxString m_charset;               // from the message catalog header
 
+    // the memory-mapped file data, if any, m_data points to it then
+    void  *m_mappedData;
+    size_t m_mappedSize;
+
+    // conversion used by FindString() and the object deleting it, if needed
+    wxMBConv *m_conv;
+    wxScopedPtr<wxMBConv> m_convPtr;
+
+    // the strings already found by FindString(): notice that the strings
+    // which were not found are stored here too, as empty strings
+    wxStringToStringHashMap m_cache;
+    wxCRIT_SECT_DECLARE_MEMBER(m_csCache);
+
+    // returns the conversion to use for the catalog strings, allocating it
+    // and storing it in convPtr if necessary
+    wxMBConv *CreateInputConv(wxScopedPtr<wxMBConv>& convPtr) const;
+
+    // tries to map the given file into memory, returns empty buffer if failed
+    DataBuffer MapFileData(wxFile& file, size_t size);
+
+    // finds the index of the original string in the catalog, returns false
+    // if it's not present
+    bool FindOrigString(const char *str, size_t len, size_t32 *index) const;
+
+    // returns the translation of the given msgid, as FindString(), but
+    // without using the cache and returning an empty string if not found
+    wxString DoFindString(const wxString& msgid, int index) const;
+
 
     // swap the 2 halves of 32 bit integer if needed
     size_t32 Swap(size_t32 ui) const
@@ -979,21 +1028,87 @@ private:
     wxDECLARE_NO_COPY_CLASS(wxMsgCatalogFile);
 };
 
+wxDEFINE_SCOPED_PTR(wxMsgCatalogFile, wxMsgCatalogFilePtr)
+
 // ----------------------------------------------------------------------------
 // wxMsgCatalogFile class
 // ----------------------------------------------------------------------------
 
 wxMsgCatalogFile::wxMsgCatalogFile()
 {
+    m_pHashTable = NULL;
+    m_nHashSize = 0;
+    m_mappedData = NULL;
+    m_mappedSize = 0;
+    m_conv = NULL;
 }
 
 wxMsgCatalogFile::~wxMsgCatalogFile()
 {
+    if ( m_mappedData )
+    {
+#if defined(__UNIX__)
+        munmap(m_mappedData, m_mappedSize);
+#elif defined(__WINDOWS__)
+        ::UnmapViewOfFile(m_mappedData);
+#endif
+    }
+}
+
+wxMsgCatalogFile::DataBuffer
+wxMsgCatalogFile::MapFileData(wxFile& file, size_t size)
+{
+#if defined(__UNIX__)
+    void* const data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, file.fd(), 0);
+    if ( data == MAP_FAILED )
+    {
+        wxLogTrace(TRACE_I18N, wxS("Failed to map message catalog: %s"),
+                   wxSysErrorMsgStr());
+        return DataBuffer();
+    }
+#elif defined(__WINDOWS__)
+    const HANDLE hMapping = ::CreateFileMapping
+                              (
+                                (HANDLE)_get_osfhandle(file.fd()),
+                                NULL,
+                                PAGE_READONLY,
+                                0, 0,
+                                NULL
+                              );
+    if ( !hMapping )
+    {
+        wxLogTrace(TRACE_I18N, wxS("Failed to map message catalog: %s"),
+                   wxSysErrorMsgStr());
+        return DataBuffer();
+    }
+
+    void* const data = ::MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, size);
+
+    // The view keeps the mapping object alive, so we don't need it any more.
+    ::CloseHandle(hMapping);
+
+    if ( !data )
+        return DataBuffer();
+#endif
+
+#if defined(__UNIX__) || defined(__WINDOWS__)
+    // Notice that the file can be closed now, the mapping remains valid.
+    m_mappedData = data;
+    m_mappedSize = size;
+
+    return DataBuffer::CreateNonOwned(static_cast<char*>(data), size);
+#else
+    wxUnusedVar(file);
+    wxUnusedVar(size);
+
+    return DataBuffer();
+#endif
 }
 
 // open disk file and read in it's contents
 bool wxMsgCatalogFile::LoadFile(const wxString& filename,
-                                wxPluralFormsCalculatorPtr& rPluralFormsCalculator)
+                                wxPluralFormsCalculatorPtr& rPluralFormsCalculator,
+                                bool mapFile)
 {
     wxFile fileMsg(filename);
     if ( !fileMsg.IsOpened() )
@@ -1007,19 +1122,24 @@ bool wxMsgCatalogFile::LoadFile(const wxString& filename,
     size_t nSize = wx_truncate_cast(size_t, lenFile);
     wxASSERT_MSG( nSize == lenFile + size_t(0), wxS("message catalog bigger than 4GB?") );
 
-    wxMemoryBuffer filedata;
+    DataBuffer data;
+    if ( mapFile && nSize )
+        data = MapFileData(fileMsg, nSize);
 
-    // read the whole file in memory
-    if ( fileMsg.Read(filedata.GetWriteBuf(nSize), nSize) != lenFile )
-        return false;
+    if ( !data.data() )
+    {
+        wxMemoryBuffer filedata;
 
-    filedata.UngetWriteBuf(nSize);
+        // read the whole file in memory
+        if ( fileMsg.Read(filedata.GetWriteBuf(nSize), nSize) != lenFile )
+            return false;
 
-    bool ok = LoadData
-              (
-                  DataBuffer::CreateOwned((char*)filedata.release(), nSize),
-                  rPluralFormsCalculator
-              );
+        filedata.UngetWriteBuf(nSize);
+
+        data = DataBuffer::CreateOwned((char*)filedata.release(), nSize);
+    }
+
+    bool ok = LoadData(data, rPluralFormsCalculator);
     if ( !ok )
     {
         wxLogWarning(_("'%s' is not a valid message catalog."), filename);
@@ -1059,6 +1179,9 @@ bool wxMsgCatalogFile::LoadData(const DataBuffer& data,
                     Swap(pHeader->ofsOrigTable));
     m_pTransTable = reinterpret_cast<const wxMsgTableEntry*>(data.data() +
                     Swap(pHeader->ofsTransTable));
+    m_nHashSize   = Swap(pHeader->nHashSize);
+    m_pHashTable  = reinterpret_cast<const size_t32*>(data.data() +
+                    Swap(pHeader->ofsHashTable));
 
     // now parse catalog's header and try to extract catalog charset and
     // plural forms formula from it:
@@ -1120,16 +1243,12 @@ bool wxMsgCatalogFile::LoadData(const DataBuffer& data,
     return true;
 }
 
-bool wxMsgCatalogFile::FillHash(wxStringToStringHashMap& hash,
-                                const wxString& domain) const
+wxMBConv *
+wxMsgCatalogFile::CreateInputConv(wxScopedPtr<wxMBConv>& inputConvPtr) const
 {
-    wxUnusedVar(domain); // silence warning in Unicode build
-
     // conversion to use to convert catalog strings to the GUI encoding
     wxMBConv *inputConv = NULL;
 
-    wxScopedPtr<wxMBConv> inputConvPtr; // just to delete inputConv if needed
-
     if ( !m_charset.empty() )
     {
 #if !wxUSE_UNICODE && wxUSE_FONTMAP
@@ -1154,6 +1273,17 @@ bool wxMsgCatalogFile::FillHash(wxStringToStringHashMap& hash,
 #endif
     }
 
+    return inputConv;
+}
+
+bool wxMsgCatalogFile::FillHash(wxStringToStringHashMap& hash,
+                                const wxString& domain) const
+{
+    wxUnusedVar(domain); // silence warning in Unicode build
+
+    wxScopedPtr<wxMBConv> inputConvPtr; // just to delete inputConv if needed
+    wxMBConv * const inputConv = CreateInputConv(inputConvPtr);
+
 #if !wxUSE_UNICODE
     wxString msgIdCharset = gs_msgIdCharset[domain];
 
@@ -1221,6 +1351,166 @@ bool wxMsgCatalogFile::FillHash(wxStringToStringHashMap& hash,
     return true;
 }
 
+bool wxMsgCatalogFile::InitLookup()
+{
+    // Check that the tables are inside the data, as we're going to access
+    // them on demand and don't want to do it for every lookup.
+    const char* const start = m_data.data();
+    const size_t len = m_data.length();
+
+    const size_t sizeTable = m_numStrings * sizeof(wxMsgTableEntry);
+    const char* const origTable = reinterpret_cast<const char*>(m_pOrigTable);
+    const char* const transTable = reinterpret_cast<const char*>(m_pTransTable);
+    if ( origTable < start || origTable + sizeTable > start + len ||
+            transTable < start || transTable + sizeTable > start + len )
+        return false;
+
+    // The hash table is optional, we can use binary search if it is absent
+    // (GNU gettext only uses it if its size is greater than 2 too).
+    const char* const hashTable = reinterpret_cast<const char*>(m_pHashTable);
+    if ( m_nHashSize <= 2 ||
+            hashTable < start ||
+                hashTable + m_nHashSize * sizeof(size_t32) > start + len )
+    {
+        m_nHashSize = 0;
+        m_pHashTable = NULL;
+    }
+
+    m_conv = CreateInputConv(m_convPtr);
+
+    return m_conv != NULL;
+}
+
+bool
+wxMsgCatalogFile::FindOrigString(const char *str, size_t len, size_t32 *index) const
+{
+    if ( m_pHashTable )
+    {
+        // This is the same hash function as used by GNU gettext.
+        size_t32 hash = 0;
+        for ( size_t n = 0; n < len; n++ )
+        {
+            hash = (hash << 4) + static_cast<unsigned char>(str[n]);
+
+            const size_t32 g = hash & 0xf0000000;
+            if ( g )
+            {
+                hash ^= g >> 24;
+                hash ^= g;
+            }
+        }
+
+        size_t32 idx = hash % m_nHashSize;
+        const size_t32 incr = 1 + (hash % (m_nHashSize - 2));
+
+        // Limit the number of iterations in case of a corrupted hash table.
+        for ( size_t32 n = 0; n < m_nHashSize; n++ )
+        {
+            const size_t32 nstr = Swap(m_pHashTable[idx]);
+            if ( !nstr )
+                break;
+
+            // Notice that the strings with the indices beyond the number of
+            // strings are the system-dependent ones, which we don't support.
+            if ( nstr <= m_numStrings )
+            {
+                const char* const orig = StringAtOfs(m_pOrigTable, nstr - 1);
+                if ( orig &&
+                        wxStrnlen(orig, Swap(m_pOrigTable[nstr - 1].nLen)) == len &&
+                            memcmp(orig, str, len) == 0 )
+                {
+                    *index = nstr - 1;
+                    return true;
+                }
+            }
+
+            if ( idx >= m_nHashSize - incr )
+                idx -= m_nHashSize - incr;
+            else
+                idx += incr;
+        }
+
+        return false;
+    }
+
+    // Without the hash table, use binary search as the original strings are
+    // sorted in the catalog.
+    size_t32 lo = 0,
+             hi = m_numStrings;
+    while ( lo < hi )
+    {
+        const size_t32 mid = lo + (hi - lo) / 2;
+
+        const char* const orig = StringAtOfs(m_pOrigTable, mid);
+        if ( !orig )
+            return false;
+
+        // Only compare the singular form for the plural messages.
+        const size_t lenOrig = wxStrnlen(orig, Swap(m_pOrigTable[mid].nLen));
+
+        int rc = memcmp(str, orig, wxMin(len, lenOrig));
+        if ( !rc )
+            rc = len < lenOrig ? -1 : len > lenOrig ? 1 : 0;
+
+        if ( !rc )
+        {
+            *index = mid;
+            return true;
+        }
+
+        if ( rc < 0 )
+            hi = mid;
+        else
+            lo = mid + 1;
+    }
+
+    return false;
+}
+
+wxString wxMsgCatalogFile::DoFindString(const wxString& msgid, int index) const
+{
+    const wxCharBuffer buf = m_conv->cWC2MB(msgid.wc_str());
+    if ( !buf )
+        return wxString();
+
+    size_t32 n;
+    if ( !FindOrigString(buf.data(), buf.length(), &n) )
+        return wxString();
+
+    const char* const data = StringAtOfs(m_pTransTable, n);
+    if ( !data )
+        return wxString();
+
+    // Skip the translations for the other plural forms, see FillHash().
+    const size_t length = Swap(m_pTransTable[n].nLen);
+    size_t offset = 0;
+    for ( ; index > 0 && offset < length; --index )
+        offset += wxStrnlen(data + offset, length - offset) + 1;
+
+    if ( offset >= length )
+        return wxString();
+
+    const char* const str = data + offset;
+    return wxString(str, *m_conv, wxStrnlen(str, length - offset));
+}
+
+const wxString *wxMsgCatalogFile::FindString(const wxString& key, int index)
+{
+    wxCRIT_SECT_LOCKER(lock, m_csCache);
+
+    wxStringToStringHashMap::const_iterator i = m_cache.find(key);
+    if ( i == m_cache.end() )
+    {
+        wxString& str = m_cache[key];
+        str = DoFindString(index == 0 ? key : key.substr(0, key.length() - 1),
+                           index);
+
+        return str.empty() ? NULL : &str;
+    }
+
+    return i->second.empty() ? NULL : &i->second;
+}
+
 
 // ----------------------------------------------------------------------------
 // wxMsgCatalog class
@@ -1243,20 +1533,48 @@ wxMsgCatalog::~wxMsgCatalog()
 }
 #endif // !wxUSE_UNICODE
 
+namespace
+{
+
+// Return true if the catalogs should be loaded lazily, i.e. without converting
+// all of their strings when loading them.
+bool UseLazyCatalogs()
+{
+#if wxUSE_UNICODE && wxUSE_SYSTEM_OPTIONS
+    return wxSystemOptions::GetOptionInt(wxS("intl.lazy-catalogs")) != 0;
+#else
+    return false;
+#endif
+}
+
+} // anonymous namespace
+
 /* static */
 wxMsgCatalog *wxMsgCatalog::CreateFromFile(const wxString& filename,
                                            const wxString& domain)
 {
     wxScopedPtr<wxMsgCatalog> cat(new wxMsgCatalog(domain));
 
-    wxMsgCatalogFile file;
+    const bool lazy = UseLazyCatalogs();
 
-    if ( !file.LoadFile(filename, cat->m_pluralFormsCalculator) )
-        return NULL;
+    wxMsgCatalogFilePtr file(new wxMsgCatalogFile);
 
-    if ( !file.FillHash(cat->m_messages, domain) )
+    if ( !file->LoadFile(filename, cat->m_pluralFormsCalculator, lazy) )
         return NULL;
 
+    if ( lazy )
+    {
+        if ( !file->InitLookup() )
+            return NULL;
+
+        cat->m_file.swap(file);
+    }
+    else
+    {
+        if ( !file->FillHash(cat->m_messages, domain) )
+            return NULL;
+    }
+
     return cat.release();
 }
 
@@ -1266,14 +1584,41 @@ wxMsgCatalog *wxMsgCatalog::CreateFromData(const wxScopedCharBuffer& data,
 {
     wxScopedPtr<wxMsgCatalog> cat(new wxMsgCatalog(domain));
 
-    wxMsgCatalogFile file;
+    const bool lazy = UseLazyCatalogs();
 
-    if ( !file.LoadData(data, cat->m_pluralFormsCalculator) )
-        return NULL;
+    // When loading lazily, the data must remain valid for as long as the
+    // catalog is used, but a non-owned buffer is only guaranteed to be valid
+    // during this call, so make a copy of it which is kept alive by the file
+    // object. This is still much faster than filling the hash map.
+    wxScopedCharBuffer dataToUse(data);
+    if ( lazy )
+    {
+        wxCharBuffer copy(data.length());
+        if ( !copy.data() )
+            return NULL;
+
+        memcpy(copy.data(), data.data(), data.length());
+        dataToUse = copy;
+    }
 
-    if ( !file.FillHash(cat->m_messages, domain) )
+    wxMsgCatalogFilePtr file(new wxMsgCatalogFile);
+
+    if ( !file->LoadData(dataToUse, cat->m_pluralFormsCalculator) )
         return NULL;
 
+    if ( lazy )
+    {
+        if ( !file->InitLookup() )
+            return NULL;
+
+        cat->m_file.swap(file);
+    }
+    else
+    {
+        if ( !file->FillHash(cat->m_messages, domain) )
+            return NULL;
+    }
+
     return cat.release();
 }
 
@@ -1284,22 +1629,37 @@ const wxString *wxMsgCatalog::GetString(const wxString& str, unsigned n, const w
     {
         index = m_pluralFormsCalculator->evaluate(n);
     }
-    wxStringToStringHashMap::const_iterator i;
-    if (index != 0)
-    {
-        if (context.IsEmpty())
-            i = m_messages.find(wxString(str) + wxChar(index));   // plural, no context
-        else
-            i = m_messages.find(wxString(context) + wxString('\x04') + wxString(str) + wxChar(index));   // plural, context
-    }
-    else
+
+    // The key is just the string itself in the most common case, but if we
+    // need to add the context and/or plural form index to it, do it in the
+    // thread-specific buffer which keeps its memory between the calls, as
+    // this function is called often and allocating new strings for the keys
+    // every time is too slow.
+    const wxString* key = &str;
+    if ( index != 0 || !context.empty() )
     {
-        if (context.IsEmpty())
-            i = m_messages.find(str); // no context
-        else
-            i = m_messages.find(wxString(context) + wxString('\x04') + wxString(str)); // context
+        wxString& buf = wxThreadInfo.translationKey;
+        buf.clear();
+
+        if ( !context.empty() )
+        {
+            buf += context;
+            buf += wxS('\x04');
+        }
+
+        buf += str;
+
+        if ( index != 0 )
+            buf += wxChar(index);
+
+        key = &buf;
     }
 
+    if ( m_file.get() )
+        return m_file->FindString(*key, index);
+
+    const wxStringToStringHashMap::const_iterator i = m_messages.find(*key);
+
     if ( i != m_messages.end() )
     {
         return &i->second;
@@ -1319,6 +1679,15 @@ namespace
 wxTranslations *gs_translations = NULL;
 bool gs_translationsOwned = false;
 
+// This counter is incremented whenever the translations may change, which
+// invalidates the translations cached by wxGetCachedTranslation().
+wxUint32 gs_translationsGeneration = 0;
+
+void InvalidateCachedTranslations()
+{
+    wxAtomicInc(gs_translationsGeneration);
+}
+
 } // anonymous namespace
 
 
@@ -1335,6 +1704,8 @@ void wxTranslations::Set(wxTranslations *t)
         delete gs_translations;
     gs_translations = t;
     gs_translationsOwned = true;
+
+    InvalidateCachedTranslations();
 }
 
 /*static*/
@@ -1344,6 +1715,8 @@ void wxTranslations::SetNonOwned(wxTranslations *t)
         delete gs_translations;
     gs_translations = t;
     gs_translationsOwned = false;
+
+    InvalidateCachedTranslations();
 }
 
 
@@ -1356,6 +1729,9 @@ wxTranslations::wxTranslations()
 
 wxTranslations::~wxTranslations()
 {
+    // The cached translations may point to the strings in our catalogs.
+    InvalidateCachedTranslations();
+
     delete m_loader;
 
     // free catalogs memory
@@ -1502,6 +1878,8 @@ bool wxTranslations::LoadCatalog(const wxString& domain, const wxString& lang, c
         m_pMsgCat = cat;
         m_catalogMap[domain] = cat;
 
+        InvalidateCachedTranslations();
+
         return true;
     }
     else
@@ -1559,6 +1937,41 @@ const wxString& wxTranslations::GetUntranslatedString(const wxString& str)
     return *i;
 }
 
+const wxString& wxGetCachedTranslation(const char *str, const char *context)
+{
+    // As the strings are literals, their addresses identify them uniquely
+    // and we can use them as keys without even looking at the strings
+    // contents. This also means that we don't need to convert them to
+    // wxString unless we need to look up their translations.
+    wxLocaleCachedTranslation&
+        cached = wxThreadInfo.cachedTranslations[wxPtrToUInt(str)];
+
+    if ( cached.translation &&
+            cached.context == context &&
+                cached.generation == gs_translationsGeneration )
+        return *cached.translation;
+
+    const wxMBConv& conv = wxConvWhateverWorks;
+    const wxString s(str, conv);
+
+    const wxString *trans = NULL;
+    if ( wxTranslations* const t = wxTranslations::Get() )
+    {
+        trans = t->GetTranslatedString(s, wxString(),
+                                       context ? wxString(context, conv)
+                                               : wxString());
+    }
+
+    if ( !trans )
+        trans = &wxTranslations::GetUntranslatedString(s);
+
+    cached.context = context;
+    cached.generation = gs_translationsGeneration;
+    cached.translation = trans;
+
+    return *trans;
+}
+
 
 const wxString *wxTranslations::GetTranslatedString(const wxString& origString,
                                                     const wxString& domain,
@@ -55,6 +55,14 @@
 #if wxUSE_ACCESSIBILITY
 #include "wx/private/markupparser.h"
 #endif // wxUSE_ACCESSIBILITY
+#if wxUSE_THREADS
+#include "wx/thread.h"
+#endif // wxUSE_THREADS
+
+#include <algorithm>
+#include <memory>
+#include <unordered_map>
+#include <vector>
 
 //-----------------------------------------------------------------------------
 // classes
@@ -74,7 +82,7 @@ static const int PADDING_RIGHTLEFT = 3;
 namespace
 {
 
-// Flags for Walker() function defined below.
+// Flags for wxDataViewMainWindow::GetRowByItem().
 enum WalkFlags
 {
     Walk_All,               // Visit all items.
@@ -475,9 +483,128 @@ public:
 
 class wxDataViewMainWindow;
 class wxDataViewTreeNode;
+#if wxUSE_THREADS
+class wxDataViewAsyncSortThread;
+#endif // wxUSE_THREADS
 
 typedef wxVector<wxDataViewTreeNode*> wxDataViewTreeNodes;
 
+namespace
+{
+
+// Allocator used for the tree nodes: as there can be millions of them and all
+// of them have the same size, they are allocated in big chunks instead of
+// allocating each of them separately on the heap, which is both much faster
+// and uses less memory.
+//
+// Note that the chunks are only freed when all the nodes are destroyed, but
+// this happens anyhow when the control or its model is destroyed.
+class wxDataViewTreeNodePool
+{
+public:
+    void* Alloc(size_t size)
+    {
+        // All nodes must have the same size.
+        if ( !m_nodeSize )
+        {
+            // Ensure that the nodes are correctly aligned.
+            const size_t align = sizeof(void*);
+            m_nodeSize = (wxMax(size, sizeof(FreeNode)) + align - 1) / align * align;
+        }
+        else
+        {
+            wxASSERT_MSG( size <= m_nodeSize, "unexpected node size" );
+        }
+
+        if ( !m_free )
+            AllocChunk();
+
+        FreeNode* const node = m_free;
+        m_free = node->next;
+        m_used++;
+
+        return node;
+    }
+
+    void Free(void* p)
+    {
+        if ( !p )
+            return;
+
+        FreeNode* const node = static_cast<FreeNode*>(p);
+        node->next = m_free;
+        m_free = node;
+
+        if ( !--m_used )
+        {
+            // Don't keep the memory used by the nodes of the tree which was
+            // just destroyed.
+            for ( size_t n = 0; n < m_chunks.size(); n++ )
+                ::operator delete(m_chunks[n]);
+
+            m_chunks.clear();
+            m_free = NULL;
+        }
+    }
+
+    static wxDataViewTreeNodePool& Get()
+    {
+        static wxDataViewTreeNodePool s_pool;
+        return s_pool;
+    }
+
+private:
+    // The number of nodes allocated at once.
+    enum { NODES_PER_CHUNK = 1024 };
+
+    struct FreeNode
+    {
+        FreeNode* next;
+    };
+
+    wxDataViewTreeNodePool()
+    {
+        m_nodeSize = 0;
+        m_free = NULL;
+        m_used = 0;
+    }
+
+    ~wxDataViewTreeNodePool()
+    {
+        // If any nodes are still in use, we can't free their memory, so just
+        // leak it.
+        if ( !m_used )
+        {
+            for ( size_t n = 0; n < m_chunks.size(); n++ )
+                ::operator delete(m_chunks[n]);
+        }
+    }
+
+    void AllocChunk()
+    {
+        char* const chunk =
+            static_cast<char*>(::operator new(m_nodeSize*NODES_PER_CHUNK));
+        m_chunks.push_back(chunk);
+
+        for ( size_t n = NODES_PER_CHUNK; n > 0; n-- )
+        {
+            FreeNode* const
+                node = reinterpret_cast<FreeNode*>(chunk + (n - 1)*m_nodeSize);
+            node->next = m_free;
+            m_free = node;
+        }
+    }
+
+    size_t m_nodeSize;
+    wxVector<char*> m_chunks;
+    FreeNode* m_free;
+    size_t m_used;
+
+    wxDECLARE_NO_COPY_CLASS(wxDataViewTreeNodePool);
+};
+
+} // anonymous namespace
+
 // Note: this class is not used at all for virtual list models, so all code
 // using it, i.e. any functions taking or returning objects of this type,
 // including wxDataViewMainWindow::m_root, can only be called after checking
@@ -489,7 +616,8 @@ public:
     wxDataViewTreeNode(wxDataViewTreeNode *parent, const wxDataViewItem& item)
         : m_parent(parent),
           m_item(item),
-          m_branchData(NULL)
+          m_branchData(NULL),
+          m_indexInParent(INVALID_INDEX)
     {
     }
 
@@ -509,6 +637,16 @@ public:
         }
     }
 
+    static void* operator new(size_t size)
+    {
+        return wxDataViewTreeNodePool::Get().Alloc(size);
+    }
+
+    static void operator delete(void* p)
+    {
+        wxDataViewTreeNodePool::Get().Free(p);
+    }
+
     static wxDataViewTreeNode* CreateRootNode()
     {
         wxDataViewTreeNode *n = new wxDataViewTreeNode(NULL, wxDataViewItem());
@@ -527,6 +665,13 @@ public:
     void InsertChild(wxDataViewMainWindow* window,
                      wxDataViewTreeNode *node, unsigned index);
 
+    // Add all the children of a node which doesn't have any yet at once,
+    // this is much faster than calling InsertChild() for each of them.
+    //
+    // The contents of the provided vector is taken by this function.
+    void SetChildren(wxDataViewMainWindow* window,
+                     wxDataViewTreeNodes& nodes);
+
     void RemoveChild(unsigned index)
     {
         wxCHECK_RET( m_branchData != NULL, "leaf node doesn't have children" );
@@ -539,18 +684,49 @@ public:
         if ( !m_branchData )
             return wxNOT_FOUND;
 
-        const wxDataViewTreeNodes& nodes = m_branchData->children;
-        const int len = nodes.size();
-        for ( int i = 0; i < len; i++ )
-        {
-            if ( nodes[i]->m_item == item )
-                return i;
-        }
-        return wxNOT_FOUND;
+        return m_branchData->FindChildByItem(item);
+    }
+
+    // returns the position of the given child node in children list
+    int GetChildIndex(const wxDataViewTreeNode* child) const
+    {
+        wxCHECK_MSG( m_branchData, wxNOT_FOUND, "leaf node doesn't have children" );
+
+        m_branchData->UpdateIndex();
+
+        wxCHECK_MSG( child->m_parent == this, wxNOT_FOUND, "not our child" );
+
+        return child->m_indexInParent;
+    }
+
+    // returns the child node containing the given row, counting from 0 for
+    // the first child of this node, and adjusts the row to be relative to the
+    // returned child, i.e. 0 if it is the row of the child itself
+    wxDataViewTreeNode* GetChildByRow(int& row) const
+    {
+        if ( !m_branchData )
+            return NULL;
+
+        return m_branchData->GetChildByRow(row);
+    }
+
+    // returns the number of rows before the given child
+    int GetRowsBeforeChild(unsigned index) const
+    {
+        wxCHECK_MSG( m_branchData, 0, "leaf node doesn't have children" );
+
+        return m_branchData->GetRowsBefore(index);
     }
 
     const wxDataViewItem & GetItem() const { return m_item; }
-    void SetItem( const wxDataViewItem & item ) { m_item = item; }
+    void SetItem( const wxDataViewItem & item )
+    {
+        m_item = item;
+
+        // The parent can't find us by the old item any more.
+        if ( m_parent )
+            m_parent->m_branchData->ResetItemIndex();
+    }
 
     int GetIndentLevel() const
     {
@@ -578,12 +754,7 @@ public:
 
         wxCHECK_RET( m_branchData != NULL, "can't open leaf node" );
 
-        int sum = 0;
-
-        const wxDataViewTreeNodes& nodes = m_branchData->children;
-        const int len = nodes.size();
-        for ( int i = 0;i < len; i ++)
-            sum += 1 + nodes[i]->GetSubTreeCount();
+        const int sum = m_branchData->GetRowsBefore(m_branchData->children.size());
 
         if (m_branchData->open)
         {
@@ -639,11 +810,24 @@ public:
         wxASSERT( m_branchData->subTreeCount >= 0 );
 
         if( m_parent )
+        {
+            m_parent->m_branchData->OnChildRowsChanged(m_indexInParent, num);
             m_parent->ChangeSubTreeCount(num);
+        }
     }
 
     void Resort(wxDataViewMainWindow* window);
 
+    // Add this node and all its open descendants which need to be resorted
+    // for using the given sort order to the provided vector.
+    void GetNodesToSort(const SortOrder& sortOrder,
+                        wxVector<wxDataViewTreeNode*>& nodes);
+
+    // Reorder the children as specified by the given indices, which must
+    // have been computed by sorting them in the given order.
+    void SetChildrenOrder(const std::vector<unsigned>& order,
+                          const SortOrder& sortOrder);
+
     // Should be called after changing the item value to update its position in
     // the control if necessary.
     void PutInSortOrder(wxDataViewMainWindow* window)
@@ -661,6 +845,9 @@ private:
     void PutChildInSortOrder(wxDataViewMainWindow* window,
                              wxDataViewTreeNode* childNode);
 
+    // Return the number of rows taken by this node and its visible children.
+    int GetRowCount() const { return 1 + GetSubTreeCount(); }
+
     wxDataViewTreeNode  *m_parent;
 
     // Corresponding model item.
@@ -671,7 +858,9 @@ private:
     struct BranchNodeData
     {
         BranchNodeData()
-            : open(false),
+            : indexedCount(0),
+              hasItemIndex(false),
+              open(false),
               subTreeCount(0)
         {
         }
@@ -679,17 +868,166 @@ private:
         void InsertChild(wxDataViewTreeNode* node, unsigned index)
         {
             children.insert(children.begin() + index, node);
+
+            InvalidateIndexFrom(index);
         }
 
         void RemoveChild(unsigned index)
         {
+            if ( hasItemIndex )
+                itemIndex.erase(children[index]->m_item.GetID());
+
             children.erase(children.begin() + index);
+
+            InvalidateIndexFrom(index);
+        }
+
+        // Must be called after changing the order of children.
+        void InvalidateIndexFrom(unsigned index)
+        {
+            if ( index < indexedCount )
+                indexedCount = index;
+        }
+
+        void ResetItemIndex()
+        {
+            itemIndex.clear();
+            hasItemIndex = false;
+        }
+
+        // Update rowCounts, itemIndex, if used, and m_indexInParent of all
+        // children which are not indexed yet.
+        void UpdateIndex()
+        {
+            const unsigned count = children.size();
+            if ( indexedCount == count )
+                return;
+
+            rowCounts.resize(count);
+
+            for ( unsigned n = indexedCount; n < count; n++ )
+            {
+                wxDataViewTreeNode* const child = children[n];
+                child->m_indexInParent = n;
+
+                if ( hasItemIndex )
+                    itemIndex[child->m_item.GetID()] = n;
+
+                // Fenwick tree element i (using 1-based indices) is the sum of
+                // the row counts of the children in (i - lowbit(i), i] range,
+                // which is the row count of the child i itself plus the sum of
+                // the elements i - 1, i - 2, i - 4, ... i - lowbit(i)/2.
+                const unsigned i = n + 1;
+                int rows = child->GetRowCount();
+                for ( unsigned step = 1; step < (i & -i); step <<= 1 )
+                    rows += rowCounts[i - step - 1];
+                rowCounts[n] = rows;
+            }
+
+            indexedCount = count;
+        }
+
+        // Called when the number of rows of the child with the given index
+        // changes.
+        void OnChildRowsChanged(unsigned index, int num)
+        {
+            // If the child is not indexed yet, its row count will be taken
+            // into account when it is, so there is nothing to do.
+            if ( index >= indexedCount )
+                return;
+
+            for ( unsigned i = index + 1; i <= indexedCount; i += i & -i )
+                rowCounts[i - 1] += num;
+        }
+
+        int GetRowsBefore(unsigned index)
+        {
+            UpdateIndex();
+
+            int rows = 0;
+            for ( unsigned i = index; i > 0; i -= i & -i )
+                rows += rowCounts[i - 1];
+
+            return rows;
+        }
+
+        wxDataViewTreeNode* GetChildByRow(int& row)
+        {
+            UpdateIndex();
+
+            // Find the last child starting at or before the given row by
+            // descending the Fenwick tree.
+            const unsigned count = children.size();
+            unsigned step = 1;
+            while ( step <= count / 2 )
+                step <<= 1;
+
+            unsigned pos = 0;
+            for ( ; step; step >>= 1 )
+            {
+                if ( pos + step <= count && rowCounts[pos + step - 1] <= row )
+                {
+                    pos += step;
+                    row -= rowCounts[pos - 1];
+                }
+            }
+
+            return pos < count ? children[pos] : NULL;
+        }
+
+        int FindChildByItem(const wxDataViewItem& item)
+        {
+            const unsigned count = children.size();
+
+            // Searching a few children is faster than using the index.
+            if ( count < MIN_CHILDREN_FOR_ITEM_INDEX )
+            {
+                for ( unsigned n = 0; n < count; n++ )
+                {
+                    if ( children[n]->m_item == item )
+                        return n;
+                }
+
+                return wxNOT_FOUND;
+            }
+
+            if ( !hasItemIndex )
+            {
+                // Build the index for all the children when it's used for
+                // the first time.
+                itemIndex.reserve(count);
+                for ( unsigned n = 0; n < indexedCount; n++ )
+                    itemIndex[children[n]->m_item.GetID()] = n;
+
+                hasItemIndex = true;
+            }
+
+            UpdateIndex();
+
+            const ItemIndex::const_iterator it = itemIndex.find(item.GetID());
+            return it == itemIndex.end() ? wxNOT_FOUND : static_cast<int>(it->second);
         }
 
         // Child nodes. Note that this may be empty even if m_hasChildren in
         // case this branch of the tree wasn't expanded and realized yet.
         wxDataViewTreeNodes  children;
 
+        // Fenwick tree (binary indexed tree) of the number of rows taken by
+        // each child, allowing to find the child by row and compute the row of
+        // the child in logarithmic time.
+        //
+        // Only the first indexedCount elements are valid, the rest of them,
+        // just as m_indexInParent of the corresponding children, are updated
+        // by UpdateIndex().
+        wxVector<int>        rowCounts;
+        unsigned             indexedCount;
+
+        // Map of the children items to their indices, only used for the
+        // nodes with many children and only created on demand.
+        typedef std::unordered_map<void*, unsigned> ItemIndex;
+        ItemIndex            itemIndex;
+        bool                 hasItemIndex;
+
         // Order in which children are sorted (possibly none).
         SortOrder            sortOrder;
 
@@ -703,7 +1041,18 @@ private:
         int                  subTreeCount;
     };
 
+    // The minimal number of children for which BranchNodeData::itemIndex is
+    // used.
+    enum { MIN_CHILDREN_FOR_ITEM_INDEX = 32 };
+
+    // Used for m_indexInParent of the nodes which were not indexed yet.
+    enum { INVALID_INDEX = 0x7fffffff };
+
     BranchNodeData *m_branchData;
+
+    // Index of this node in its parent children, only valid if the parent
+    // m_branchData->indexedCount is greater than it.
+    unsigned m_indexInParent;
 };
 
 
@@ -736,14 +1085,46 @@ public:
     bool Cleared();
     void Resort()
     {
+        FlushBatch();
+
         ClearRowHeightCache();
 
         if (!IsVirtualList())
         {
-            m_root->Resort(this);
+#if wxUSE_THREADS
+            // The results of any previous sort are not needed any more.
+            CancelAsyncSort();
+
+            if ( !m_asyncSortEnabled || !StartAsyncSort() )
+#endif // wxUSE_THREADS
+                m_root->Resort(this);
         }
         UpdateDisplay();
     }
+
+    void EnableAsyncSort(bool enable);
+    bool IsAsyncSortEnabled() const { return m_asyncSortEnabled; }
+
+    // Item changes notified between these calls are applied at once when the
+    // outermost batch ends, see wxDataViewModel::BeginBatch().
+    void BeginBatch() { m_batchDepth++; }
+    void EndBatch();
+
+    // Forget about the batch of the previously used model, if any.
+    void ResetBatch()
+    {
+        m_batchDepth = 0;
+        m_batchChanges.clear();
+        m_batchChangeIndex.clear();
+    }
+
+    const wxDataViewUpdateStats& GetUpdateStats() const { return m_updateStats; }
+    void ResetUpdateStats() { m_updateStats = wxDataViewUpdateStats(); }
+
+#if wxUSE_THREADS
+    // Called in the main thread when the background sort is done.
+    void OnAsyncSortDone(unsigned int id);
+#endif // wxUSE_THREADS
     void ClearRowHeightCache()
     {
         if ( m_rowHeightCache )
@@ -977,6 +1358,9 @@ private:
     // assumes that all columns were modified, otherwise just this one.
     bool DoItemChanged(const wxDataViewItem& item, int view_column);
 
+    // Apply all the item changes accumulated during the current batch.
+    void FlushBatch();
+
     // Return whether the item has at most one column with a value.
     bool IsItemSingleValued(const wxDataViewItem& item) const
     {
@@ -1013,6 +1397,19 @@ private:
     // Helper of public Expand(), must be called with a valid node.
     void DoExpand(wxDataViewTreeNode* node, unsigned int row, bool expandChildren);
 
+#if wxUSE_THREADS
+    // Start sorting the items in a background thread, return false if it's
+    // not worth doing it or if the model doesn't support sort keys.
+    bool StartAsyncSort();
+
+    // Wait until the background sort ends and apply its results. This must be
+    // called before modifying the tree while the sort may be in progress.
+    void FinishAsyncSort();
+
+    // Wait until the background sort ends and discard its results.
+    void CancelAsyncSort();
+#endif // wxUSE_THREADS
+
 private:
     wxDataViewCtrl             *m_owner;
     int                         m_lineHeight;
@@ -1052,6 +1449,29 @@ private:
     wxDataViewTreeNode * m_root;
     int m_count;
 
+    // If true, sort the items in a background thread when possible.
+    bool m_asyncSortEnabled;
+
+#if wxUSE_THREADS
+    // The thread sorting the items or NULL if none.
+    wxDataViewAsyncSortThread* m_asyncSort;
+
+    // Incremented for every new sort thread to identify it.
+    unsigned int m_asyncSortId;
+#endif // wxUSE_THREADS
+
+    // Nesting level of BeginBatch() calls, 0 if not inside a batch.
+    unsigned int m_batchDepth;
+
+    // The items changed during the current batch in the order of the first
+    // notification about them, with the view column which changed or
+    // wxNOT_FOUND if the entire item did, and the index of each item in it.
+    typedef std::pair<wxDataViewItem, int> BatchChange;
+    wxVector<BatchChange> m_batchChanges;
+    std::unordered_map<void*, size_t> m_batchChangeIndex;
+
+    wxDataViewUpdateStats m_updateStats;
+
     // This is the tree node under the cursor
     wxDataViewTreeNode * m_underMouse;
 
@@ -1084,10 +1504,22 @@ public:
         { return m_mainWindow->ItemChanged(item);  }
     virtual bool ValueChanged( const wxDataViewItem & item , unsigned int col ) override
         { return m_mainWindow->ValueChanged( item, col ); }
+    virtual bool ItemsChanged( const wxDataViewItemArray &items ) override
+    {
+        // Refresh the window only once for all the items.
+        m_mainWindow->BeginBatch();
+        const bool ok = wxDataViewModelNotifier::ItemsChanged(items);
+        m_mainWindow->EndBatch();
+        return ok;
+    }
     virtual bool Cleared() override
         { return m_mainWindow->Cleared(); }
     virtual void Resort() override
         { m_mainWindow->Resort(); }
+    virtual void BeginBatch() override
+        { m_mainWindow->BeginBatch(); }
+    virtual void EndBatch() override
+        { m_mainWindow->EndBatch(); }
 
     wxDataViewMainWindow    *m_mainWindow;
 };
@@ -1834,6 +2266,212 @@ private:
     const SortOrder m_sortOrder;
 };
 
+// Data used for sorting the children of a single node using the sort keys
+// returned by wxDataViewModel::GetSortKeys().
+struct wxDataViewSortTask
+{
+    wxDataViewSortTask() : node(NULL) { }
+
+    // Node whose children are being sorted.
+    wxDataViewTreeNode* node;
+
+    // Keys and IDs of the children items, in their current order.
+    wxVector<wxDataViewSortKey> keys;
+    wxVector<wxUIntPtr> ids;
+
+    // The indices of the children in the sorted order, filled by SortTask().
+    std::vector<unsigned> order;
+};
+
+typedef wxVector<wxDataViewSortTask> wxDataViewSortTasks;
+
+// Comparator for the indices of the items in wxDataViewSortTask.
+class wxDataViewSortKeyCmp
+{
+public:
+    wxDataViewSortKeyCmp(const wxDataViewSortTask& task, bool ascending)
+        : m_keys(task.keys),
+          m_ids(task.ids),
+          m_ascending(ascending)
+    {
+    }
+
+    bool operator()(unsigned n1, unsigned n2) const
+    {
+        // Use the same fallback on the item IDs as the default Compare() to
+        // ensure that the items order is always the same.
+        int rc = m_keys[n1].Compare(m_keys[n2]);
+        if ( !rc )
+            rc = m_ids[n1] < m_ids[n2] ? -1 : m_ids[n1] > m_ids[n2];
+
+        return m_ascending ? rc < 0 : rc > 0;
+    }
+
+private:
+    const wxVector<wxDataViewSortKey>& m_keys;
+    const wxVector<wxUIntPtr>& m_ids;
+    const bool m_ascending;
+};
+
+// Get the sort keys for the given nodes, return false if the model doesn't
+// support them.
+bool
+PrepareSortTask(const wxDataViewModel* model,
+                unsigned int column,
+                const wxDataViewTreeNodes& nodes,
+                wxDataViewSortTask& task)
+{
+    const size_t count = nodes.size();
+
+    wxDataViewItemArray items;
+    items.reserve(count);
+    task.ids.clear();
+    task.ids.reserve(count);
+    for ( size_t n = 0; n < count; n++ )
+    {
+        const wxDataViewItem& item = nodes[n]->GetItem();
+        items.push_back(item);
+        task.ids.push_back(wxPtrToUInt(item.GetID()));
+    }
+
+    if ( !model->GetSortKeys(items, column, task.keys) )
+        return false;
+
+    wxCHECK_MSG( task.keys.size() == count, false,
+                 "GetSortKeys() must return a key for each item" );
+
+    return true;
+}
+
+#if wxUSE_THREADS
+
+// Thread sorting a range of indices.
+class wxDataViewSortRangeThread : public wxThread
+{
+public:
+    typedef std::vector<unsigned>::iterator Iterator;
+
+    wxDataViewSortRangeThread(Iterator begin,
+                              Iterator end,
+                              const wxDataViewSortKeyCmp& cmp)
+        : wxThread(wxTHREAD_JOINABLE),
+          m_begin(begin),
+          m_end(end),
+          m_cmp(cmp)
+    {
+    }
+
+protected:
+    virtual ExitCode Entry() override
+    {
+        std::sort(m_begin, m_end, m_cmp);
+
+        return 0;
+    }
+
+private:
+    const Iterator m_begin,
+                   m_end;
+    const wxDataViewSortKeyCmp& m_cmp;
+
+    wxDECLARE_NO_COPY_CLASS(wxDataViewSortRangeThread);
+};
+
+#endif // wxUSE_THREADS
+
+// Fill the order of the given task with the indices of the items in sorted
+// order, using several threads for sorting big arrays.
+void SortTask(wxDataViewSortTask& task, bool ascending)
+{
+    const unsigned count = task.keys.size();
+
+    std::vector<unsigned>& order = task.order;
+    order.resize(count);
+    for ( unsigned n = 0; n < count; n++ )
+        order[n] = n;
+
+    const wxDataViewSortKeyCmp cmp(task, ascending);
+
+#if wxUSE_THREADS
+    // Don't bother with threads for small arrays, the overhead of creating
+    // them would be greater than any gain.
+    static const unsigned MIN_ITEMS_PER_THREAD = 16384;
+
+    const int numCPUs = wxThread::GetCPUCount();
+    const unsigned numRanges = wxMin(numCPUs > 0 ? numCPUs : 1,
+                                     wxMax(1, count / MIN_ITEMS_PER_THREAD));
+    if ( numRanges > 1 )
+    {
+        typedef wxDataViewSortRangeThread::Iterator Iterator;
+
+        std::vector<Iterator> bounds(numRanges + 1);
+        for ( unsigned n = 0; n <= numRanges; n++ )
+            bounds[n] = order.begin() + (static_cast<size_t>(count) * n) / numRanges;
+
+        // Sort all ranges in parallel, with the first one being sorted by the
+        // current thread.
+        std::vector< std::unique_ptr<wxDataViewSortRangeThread> > threads;
+        for ( unsigned n = 1; n < numRanges; n++ )
+        {
+            std::unique_ptr<wxDataViewSortRangeThread>
+                thread(new wxDataViewSortRangeThread(bounds[n], bounds[n + 1], cmp));
+            if ( thread->Run() == wxTHREAD_NO_ERROR )
+                threads.push_back(std::move(thread));
+            else // Just do it ourselves if we failed to create the thread.
+                std::sort(bounds[n], bounds[n + 1], cmp);
+        }
+
+        std::sort(bounds[0], bounds[1], cmp);
+
+        for ( size_t n = 0; n < threads.size(); n++ )
+            threads[n]->Wait();
+
+        // And merge the sorted ranges together.
+        for ( unsigned width = 1; width < numRanges; width *= 2 )
+        {
+            for ( unsigned n = 0; n + width < numRanges; n += 2*width )
+            {
+                std::inplace_merge(bounds[n],
+                                   bounds[n + width],
+                                   bounds[wxMin(n + 2*width, numRanges)],
+                                   cmp);
+            }
+        }
+
+        return;
+    }
+#endif // wxUSE_THREADS
+
+    std::sort(order.begin(), order.end(), cmp);
+}
+
+// Sort the nodes using the sort keys if the model supports them or by calling
+// its Compare() otherwise.
+void
+SortNodes(wxDataViewMainWindow* window,
+          wxDataViewTreeNodes& nodes,
+          const SortOrder& sortOrder)
+{
+    if ( sortOrder.UsesColumn() )
+    {
+        wxDataViewSortTask task;
+        if ( PrepareSortTask(window->GetModel(), sortOrder.GetColumn(),
+                             nodes, task) )
+        {
+            SortTask(task, sortOrder.IsAscending());
+
+            const wxDataViewTreeNodes unsorted(nodes);
+            for ( size_t n = 0; n < nodes.size(); n++ )
+                nodes[n] = unsorted[task.order[n]];
+
+            return;
+        }
+    }
+
+    std::sort(nodes.begin(), nodes.end(),
+              wxGenericTreeModelNodeCmp(window, sortOrder));
+}
+
 } // anonymous namespace
 
 void wxDataViewTreeNode::InsertChild(wxDataViewMainWindow* window,
@@ -1921,6 +2559,33 @@ void wxDataViewTreeNode::InsertChild(wxDataViewMainWindow* window,
     }
 }
 
+void wxDataViewTreeNode::SetChildren(wxDataViewMainWindow* window,
+                                     wxDataViewTreeNodes& nodes)
+{
+    if (!m_branchData)
+        m_branchData = new BranchNodeData;
+
+    wxCHECK_RET( m_branchData->children.empty(),
+                 "node already has children" );
+
+    m_branchData->children.swap(nodes);
+    m_branchData->InvalidateIndexFrom(0);
+
+    // This does the same thing as InsertChild() does when inserting the
+    // children one by one, but sorts all of them at once.
+    const SortOrder sortOrder = window->GetSortOrder();
+    if ( !sortOrder.IsNone() && m_branchData->open )
+    {
+        SortNodes(window, m_branchData->children, sortOrder);
+
+        m_branchData->sortOrder = sortOrder;
+    }
+    else
+    {
+        m_branchData->sortOrder = SortOrder();
+    }
+}
+
 
 void wxDataViewTreeNode::Resort(wxDataViewMainWindow* window)
 {
@@ -1941,10 +2606,9 @@ void wxDataViewTreeNode::Resort(wxDataViewMainWindow* window)
         // using model-specific sort order, which can change at any time.
         if ( m_branchData->sortOrder != sortOrder || !sortOrder.UsesColumn() )
         {
-            std::sort(m_branchData->children.begin(),
-                      m_branchData->children.end(),
-                      wxGenericTreeModelNodeCmp(window, sortOrder));
+            SortNodes(window, m_branchData->children, sortOrder);
 
+            m_branchData->InvalidateIndexFrom(0);
             m_branchData->sortOrder = sortOrder;
         }
 
@@ -1959,6 +2623,48 @@ void wxDataViewTreeNode::Resort(wxDataViewMainWindow* window)
 }
 
 
+void
+wxDataViewTreeNode::GetNodesToSort(const SortOrder& sortOrder,
+                                   wxDataViewTreeNodes& nodes)
+{
+    // This must be kept in sync with Resort() logic.
+    if ( !m_branchData || !m_branchData->open )
+        return;
+
+    if ( m_branchData->sortOrder != sortOrder || !sortOrder.UsesColumn() )
+        nodes.push_back(this);
+
+    const wxDataViewTreeNodes& children = m_branchData->children;
+    for ( size_t n = 0; n < children.size(); n++ )
+    {
+        if ( children[n]->HasChildren() )
+            children[n]->GetNodesToSort(sortOrder, nodes);
+    }
+}
+
+void
+wxDataViewTreeNode::SetChildrenOrder(const std::vector<unsigned>& order,
+                                     const SortOrder& sortOrder)
+{
+    // The node could have been already sorted synchronously while the order
+    // was being computed, e.g. when it was collapsed and expanded again.
+    if ( m_branchData->sortOrder == sortOrder )
+        return;
+
+    wxDataViewTreeNodes& children = m_branchData->children;
+    wxCHECK_RET( order.size() == children.size(), "wrong number of children" );
+
+    wxDataViewTreeNodes sorted;
+    sorted.reserve(children.size());
+    for ( size_t n = 0; n < order.size(); n++ )
+        sorted.push_back(children[order[n]]);
+
+    children.swap(sorted);
+
+    m_branchData->InvalidateIndexFrom(0);
+    m_branchData->sortOrder = sortOrder;
+}
+
 void
 wxDataViewTreeNode::PutChildInSortOrder(wxDataViewMainWindow* window,
                                         wxDataViewTreeNode* childNode)
@@ -1985,15 +2691,7 @@ wxDataViewTreeNode::PutChildInSortOrder(wxDataViewMainWindow* window,
 
     // First find the node in the current child list
     int hi = nodes.size();
-    int oldLocation = wxNOT_FOUND;
-    for ( int index = 0; index < hi; ++index )
-    {
-        if ( nodes[index] == childNode )
-        {
-            oldLocation = index;
-            break;
-        }
-    }
+    const int oldLocation = GetChildIndex(childNode);
     wxCHECK_RET( oldLocation >= 0, "not our child?" );
 
     wxGenericTreeModelNodeCmp cmp(window, m_branchData->sortOrder);
@@ -2039,6 +2737,57 @@ wxDataViewTreeNode::PutChildInSortOrder(wxDataViewMainWindow* window,
     window->UpdateDisplay();
 }
 
+#if wxUSE_THREADS
+
+//-----------------------------------------------------------------------------
+// wxDataViewAsyncSortThread
+//-----------------------------------------------------------------------------
+
+// Thread used for sorting the items without blocking the main thread.
+//
+// Note that the model is never used by this thread, the sort keys are
+// retrieved from it before starting it.
+class wxDataViewAsyncSortThread : public wxThread
+{
+public:
+    wxDataViewAsyncSortThread(wxDataViewMainWindow* window,
+                              unsigned int id,
+                              wxDataViewSortTasks& tasks,
+                              const SortOrder& sortOrder)
+        : wxThread(wxTHREAD_JOINABLE),
+          m_window(window),
+          m_id(id),
+          m_sortOrder(sortOrder)
+    {
+        m_tasks.swap(tasks);
+    }
+
+    // These functions can only be used after the thread termination.
+    wxDataViewSortTasks& GetTasks() { return m_tasks; }
+    const SortOrder& GetSortOrder() const { return m_sortOrder; }
+
+protected:
+    virtual ExitCode Entry() override
+    {
+        for ( size_t n = 0; n < m_tasks.size(); n++ )
+            SortTask(m_tasks[n], m_sortOrder.IsAscending());
+
+        m_window->CallAfter(&wxDataViewMainWindow::OnAsyncSortDone, m_id);
+
+        return 0;
+    }
+
+private:
+    wxDataViewMainWindow* const m_window;
+    const unsigned int m_id;
+    const SortOrder m_sortOrder;
+    wxDataViewSortTasks m_tasks;
+
+    wxDECLARE_NO_COPY_CLASS(wxDataViewAsyncSortThread);
+};
+
+#endif // wxUSE_THREADS
+
 
 //-----------------------------------------------------------------------------
 // wxDataViewMainWindow
@@ -2130,6 +2879,14 @@ wxDataViewMainWindow::wxDataViewMainWindow( wxDataViewCtrl *parent, wxWindowID i
     m_count = -1;
     m_underMouse = NULL;
 
+    m_asyncSortEnabled = false;
+#if wxUSE_THREADS
+    m_asyncSort = NULL;
+    m_asyncSortId = 0;
+#endif // wxUSE_THREADS
+
+    m_batchDepth = 0;
+
     UpdateDisplay();
 }
 
@@ -2506,6 +3263,8 @@ wxBitmap wxDataViewMainWindow::CreateItemBitmap( unsigned int row, int &indent )
 
 void wxDataViewMainWindow::OnPaint( wxPaintEvent &WXUNUSED(event) )
 {
+    m_updateStats.repaints++;
+
     wxDataViewModel *model = GetModel();
     wxAutoBufferedPaintDC dc( this );
 
@@ -3035,71 +3794,17 @@ void wxDataViewMainWindow::FinishEditing()
     }
 }
 
-void wxDataViewHeaderWindow::FinishEditing()
-{
-    wxDataViewMainWindow *win = static_cast<wxDataViewMainWindow*>(GetOwner()->GetMainWindow());
-    win->FinishEditing();
-}
-
-//-----------------------------------------------------------------------------
-// Helper class for do operation on the tree node
-//-----------------------------------------------------------------------------
-
-namespace
-{
-
-class DoJob
-{
-public:
-    DoJob() { }
-    virtual ~DoJob() { }
-
-    // The return value control how the tree-walker tranverse the tree
-    enum
-    {
-        DONE,          // Job done, stop traversing and return
-        SKIP_SUBTREE,  // Ignore the current node's subtree and continue
-        CONTINUE       // Job not done, continue
-    };
-
-    virtual int operator() ( wxDataViewTreeNode * node ) = 0;
-};
-
-bool
-Walker(wxDataViewTreeNode * node, DoJob & func, WalkFlags flags = Walk_All)
-{
-    wxCHECK_MSG( node, false, "can't walk NULL node" );
-
-    switch( func( node ) )
-    {
-        case DoJob::DONE:
-            return true;
-        case DoJob::SKIP_SUBTREE:
-            return false;
-        case DoJob::CONTINUE:
-            break;
-    }
-
-    if ( node->HasChildren() && (flags != Walk_ExpandedOnly || node->IsOpen()) )
-    {
-        const wxDataViewTreeNodes& nodes = node->GetChildNodes();
-
-        for ( wxDataViewTreeNodes::const_iterator i = nodes.begin();
-              i != nodes.end();
-              ++i )
-        {
-            if ( Walker(*i, func, flags) )
-                return true;
-        }
-    }
-
-    return false;
-}
-
-} // anonymous namespace
+void wxDataViewHeaderWindow::FinishEditing()
+{
+    wxDataViewMainWindow *win = static_cast<wxDataViewMainWindow*>(GetOwner()->GetMainWindow());
+    win->FinishEditing();
+}
 
 bool wxDataViewMainWindow::ItemAdded(const wxDataViewItem & parent, const wxDataViewItem & item)
 {
+    // Apply the pending changes while the items are still where they were.
+    FlushBatch();
+
     if (IsVirtualList())
     {
         wxDataViewVirtualListModel *list_model =
@@ -3108,6 +3813,10 @@ bool wxDataViewMainWindow::ItemAdded(const wxDataViewItem & parent, const wxData
     }
     else
     {
+#if wxUSE_THREADS
+        FinishAsyncSort();
+#endif // wxUSE_THREADS
+
         // specific position (row) is unclear, so clear whole height cache
         ClearRowHeightCache();
 
@@ -3216,6 +3925,9 @@ bool wxDataViewMainWindow::ItemAdded(const wxDataViewItem & parent, const wxData
 bool wxDataViewMainWindow::ItemDeleted(const wxDataViewItem& parent,
                                        const wxDataViewItem& item)
 {
+    // Apply the pending changes while the items are still where they were.
+    FlushBatch();
+
     if (IsVirtualList())
     {
         wxDataViewVirtualListModel *list_model =
@@ -3226,6 +3938,10 @@ bool wxDataViewMainWindow::ItemDeleted(const wxDataViewItem& parent,
     }
     else // general case
     {
+#if wxUSE_THREADS
+        FinishAsyncSort();
+#endif // wxUSE_THREADS
+
         const FindNodeResult findResult = FindNode(parent);
         wxDataViewTreeNode *parentNode = findResult.m_node;
 
@@ -3242,24 +3958,15 @@ bool wxDataViewMainWindow::ItemDeleted(const wxDataViewItem& parent,
             return true;
 
         wxCHECK_MSG( parentNode->HasChildren(), false, "parent node doesn't have children?" );
-        const wxDataViewTreeNodes& parentsChildren = parentNode->GetChildNodes();
 
         // We can't use FindNode() to find 'item', because it was already
         // removed from the model by the time ItemDeleted() is called, so we
         // have to do it manually. We keep track of its position as well for
         // later use.
-        int itemPosInNode = 0;
-        wxDataViewTreeNode *itemNode = NULL;
-        for ( wxDataViewTreeNodes::const_iterator i = parentsChildren.begin();
-              i != parentsChildren.end();
-              ++i, ++itemPosInNode )
-        {
-            if( (*i)->GetItem() == item )
-            {
-                itemNode = *i;
-                break;
-            }
-        }
+        const int itemPosInNode = parentNode->FindChildByItem(item);
+        wxDataViewTreeNode *itemNode = itemPosInNode == wxNOT_FOUND
+                                        ? NULL
+                                        : parentNode->GetChildNodes()[itemPosInNode];
 
         // If the parent wasn't expanded, it's possible that we didn't have a
         // node corresponding to 'item' and so there's nothing left to do.
@@ -3338,8 +4045,35 @@ bool wxDataViewMainWindow::ItemDeleted(const wxDataViewItem& parent,
 
 bool wxDataViewMainWindow::DoItemChanged(const wxDataViewItem & item, int view_column)
 {
+    m_updateStats.notifications++;
+
+    if ( m_batchDepth )
+    {
+        // Just remember that this item changed, merging the columns if it had
+        // already changed before.
+        const std::pair<std::unordered_map<void*, size_t>::iterator, bool>
+            ins = m_batchChangeIndex.insert(std::make_pair(item.GetID(),
+                                                           m_batchChanges.size()));
+        if ( ins.second )
+        {
+            m_batchChanges.push_back(BatchChange(item, view_column));
+        }
+        else
+        {
+            int& column = m_batchChanges[ins.first->second].second;
+            if ( column != view_column )
+                column = wxNOT_FOUND;
+        }
+
+        return true;
+    }
+
     if ( !IsVirtualList() )
     {
+#if wxUSE_THREADS
+        FinishAsyncSort();
+#endif // wxUSE_THREADS
+
         if ( m_rowHeightCache )
             m_rowHeightCache->Remove(GetRowByItem(item));
 
@@ -3363,16 +4097,20 @@ bool wxDataViewMainWindow::DoItemChanged(const wxDataViewItem & item, int view_c
     if ( view_column == wxNOT_FOUND )
     {
         column = NULL;
-        GetOwner()->InvalidateColBestWidths();
+
+        const unsigned int columnCount = GetOwner()->GetColumnCount();
+        for ( unsigned int col = 0; col < columnCount; col++ )
+            GetOwner()->UpdateColBestWidth(col, item);
     }
     else
     {
         column = m_owner->GetColumn(view_column);
-        GetOwner()->InvalidateColBestWidth(view_column);
+        GetOwner()->UpdateColBestWidth(view_column, item);
     }
 
     // Update the displayed value(s).
     RefreshRow(GetRowByItem(item));
+    m_updateStats.refreshes++;
 
     // Send event
     wxDataViewEvent le(wxEVT_DATAVIEW_ITEM_VALUE_CHANGED, m_owner, column, item);
@@ -3381,6 +4119,147 @@ bool wxDataViewMainWindow::DoItemChanged(const wxDataViewItem & item, int view_c
     return true;
 }
 
+void wxDataViewMainWindow::EndBatch()
+{
+    wxCHECK_RET( m_batchDepth, "EndBatch() without matching BeginBatch()" );
+
+    if ( !--m_batchDepth )
+        FlushBatch();
+}
+
+void wxDataViewMainWindow::FlushBatch()
+{
+    if ( m_batchChanges.empty() )
+        return;
+
+    wxVector<BatchChange> changes;
+    changes.swap(m_batchChanges);
+    m_batchChangeIndex.clear();
+
+    // This does the same thing as DoItemChanged() for all the items, but
+    // invalidates the cached values and refreshes the window only once.
+    if ( !IsVirtualList() )
+    {
+#if wxUSE_THREADS
+        FinishAsyncSort();
+#endif // wxUSE_THREADS
+
+        ClearRowHeightCache();
+
+        for ( size_t n = 0; n < changes.size(); n++ )
+        {
+            wxDataViewItem& item = changes[n].first;
+
+            const FindNodeResult findResult = FindNode(item);
+            wxDataViewTreeNode* const node = findResult.m_node;
+            if ( findResult.m_subtreeRealized && !node )
+                wxFAIL_MSG( "invalid item" );
+
+            if ( !node )
+            {
+                // Nothing to update for this item.
+                item = wxDataViewItem();
+                continue;
+            }
+
+            node->PutInSortOrder(this);
+        }
+    }
+
+    const unsigned int columnCount = GetOwner()->GetColumnCount();
+    std::vector<bool> columnsChanged(columnCount);
+    bool allColumnsChanged = false;
+
+    // Find the range of the visible rows to refresh.
+    const bool hasRows = GetRowCount() != 0;
+    const unsigned int firstVisible = hasRows ? GetFirstVisibleRow() : 0;
+    const unsigned int lastVisible = hasRows ? GetLastVisibleRow() : 0;
+    unsigned int from = lastVisible + 1,
+                 to = 0;
+
+    for ( size_t n = 0; n < changes.size(); n++ )
+    {
+        const BatchChange& change = changes[n];
+        if ( !change.first.IsOk() )
+            continue;
+
+        if ( change.second == wxNOT_FOUND )
+            allColumnsChanged = true;
+        else if ( static_cast<unsigned>(change.second) < columnCount )
+            columnsChanged[change.second] = true;
+
+        if ( !hasRows )
+            continue;
+
+        const int row = GetRowByItem(change.first, Walk_ExpandedOnly);
+        if ( row < 0 )
+            continue;
+
+        const unsigned int urow = static_cast<unsigned>(row);
+        if ( urow >= firstVisible && urow <= lastVisible )
+        {
+            from = wxMin(from, urow);
+            to = wxMax(to, urow);
+        }
+    }
+
+    // Measuring many items is not faster than recomputing the column widths,
+    // which only measures as many of them as it can in a limited time.
+    static const size_t MAX_ITEMS_TO_MEASURE = 100;
+
+    if ( changes.size() <= MAX_ITEMS_TO_MEASURE )
+    {
+        for ( size_t n = 0; n < changes.size(); n++ )
+        {
+            const BatchChange& change = changes[n];
+            if ( !change.first.IsOk() )
+                continue;
+
+            if ( change.second != wxNOT_FOUND )
+            {
+                GetOwner()->UpdateColBestWidth(change.second, change.first);
+                continue;
+            }
+
+            for ( unsigned int col = 0; col < columnCount; col++ )
+                GetOwner()->UpdateColBestWidth(col, change.first);
+        }
+    }
+    else if ( allColumnsChanged )
+    {
+        GetOwner()->InvalidateColBestWidths();
+    }
+    else
+    {
+        for ( unsigned int col = 0; col < columnCount; col++ )
+        {
+            if ( columnsChanged[col] )
+                GetOwner()->InvalidateColBestWidth(col);
+        }
+    }
+
+    if ( from <= to )
+    {
+        RefreshRows(from, to);
+        m_updateStats.refreshes++;
+    }
+
+    for ( size_t n = 0; n < changes.size(); n++ )
+    {
+        const BatchChange& change = changes[n];
+        if ( !change.first.IsOk() )
+            continue;
+
+        wxDataViewColumn* const column = change.second == wxNOT_FOUND
+                                            ? NULL
+                                            : m_owner->GetColumn(change.second);
+
+        wxDataViewEvent le(wxEVT_DATAVIEW_ITEM_VALUE_CHANGED, m_owner,
+                           column, change.first);
+        m_owner->ProcessWindowEvent(le);
+    }
+}
+
 bool wxDataViewMainWindow::ValueChanged( const wxDataViewItem & item, unsigned int model_column )
 {
     int view_column = m_owner->GetModelColumnIndex(model_column);
@@ -3413,6 +4292,98 @@ bool wxDataViewMainWindow::Cleared()
     return true;
 }
 
+void wxDataViewMainWindow::EnableAsyncSort(bool enable)
+{
+#if wxUSE_THREADS
+    if ( !enable )
+        FinishAsyncSort();
+#endif // wxUSE_THREADS
+
+    m_asyncSortEnabled = enable;
+}
+
+#if wxUSE_THREADS
+
+bool wxDataViewMainWindow::StartAsyncSort()
+{
+    // Sorting fewer items than this is fast enough to do it synchronously.
+    static const size_t MIN_ITEMS_FOR_ASYNC_SORT = 10000;
+
+    // Only sorting by column values can use the sort keys.
+    const SortOrder sortOrder = GetSortOrder();
+    if ( !sortOrder.UsesColumn() )
+        return false;
+
+    wxDataViewTreeNodes nodes;
+    m_root->GetNodesToSort(sortOrder, nodes);
+
+    size_t count = 0;
+    for ( size_t n = 0; n < nodes.size(); n++ )
+        count += nodes[n]->GetChildNodes().size();
+
+    if ( count < MIN_ITEMS_FOR_ASYNC_SORT )
+        return false;
+
+    wxDataViewSortTasks tasks(nodes.size());
+    for ( size_t n = 0; n < nodes.size(); n++ )
+    {
+        if ( !PrepareSortTask(GetModel(), sortOrder.GetColumn(),
+                              nodes[n]->GetChildNodes(), tasks[n]) )
+            return false;
+
+        tasks[n].node = nodes[n];
+    }
+
+    m_asyncSort = new wxDataViewAsyncSortThread(this, ++m_asyncSortId,
+                                                tasks, sortOrder);
+    if ( m_asyncSort->Run() != wxTHREAD_NO_ERROR )
+    {
+        wxDELETE(m_asyncSort);
+        return false;
+    }
+
+    return true;
+}
+
+void wxDataViewMainWindow::FinishAsyncSort()
+{
+    if ( !m_asyncSort )
+        return;
+
+    m_asyncSort->Wait();
+
+    // Apply the new order to all the nodes at once.
+    const SortOrder& sortOrder = m_asyncSort->GetSortOrder();
+    const wxDataViewSortTasks& tasks = m_asyncSort->GetTasks();
+    for ( size_t n = 0; n < tasks.size(); n++ )
+        tasks[n].node->SetChildrenOrder(tasks[n].order, sortOrder);
+
+    wxDELETE(m_asyncSort);
+
+    ClearRowHeightCache();
+    UpdateDisplay();
+}
+
+void wxDataViewMainWindow::CancelAsyncSort()
+{
+    if ( !m_asyncSort )
+        return;
+
+    m_asyncSort->Wait();
+
+    wxDELETE(m_asyncSort);
+}
+
+void wxDataViewMainWindow::OnAsyncSortDone(unsigned int id)
+{
+    // Check that the sort wasn't already finished or cancelled and another
+    // one started since then.
+    if ( m_asyncSort && id == m_asyncSortId )
+        FinishAsyncSort();
+}
+
+#endif // wxUSE_THREADS
+
 void wxDataViewMainWindow::UpdateDisplay()
 {
     m_dirty = true;
@@ -3854,63 +4825,6 @@ int wxDataViewMainWindow::QueryAndCacheLineHeight(unsigned int row, wxDataViewIt
 }
 
 
-namespace
-{
-
-class RowToTreeNodeJob: public DoJob
-{
-public:
-    // Note that we initialize m_current to -1 because the first node passed to
-    // our operator() will be the root node, which doesn't appear in the window
-    // and so doesn't count as a real row.
-    explicit RowToTreeNodeJob(int row)
-        : m_row(row), m_current(-1), m_ret(NULL)
-    {
-    }
-
-    virtual int operator() ( wxDataViewTreeNode * node ) override
-    {
-        if( m_current == m_row)
-        {
-            m_ret = node;
-            return DoJob::DONE;
-        }
-
-        if( node->GetSubTreeCount() + m_current < m_row )
-        {
-            m_current += node->GetSubTreeCount() + 1;
-            return  DoJob::SKIP_SUBTREE;
-        }
-        else
-        {
-            // If the current node has only leaf children, we can find the
-            // desired node directly. This can speed up finding the node
-            // in some cases, and will have a very good effect for list views.
-            if ( node->HasChildren() &&
-                 (int)node->GetChildNodes().size() == node->GetSubTreeCount() )
-            {
-                const int index = m_row - m_current - 1;
-                m_ret = node->GetChildNodes()[index];
-                return DoJob::DONE;
-            }
-
-            m_current++;
-
-            return DoJob::CONTINUE;
-        }
-    }
-
-    wxDataViewTreeNode * GetResult() const
-        { return m_ret; }
-
-private:
-    const int m_row;
-    int m_current;
-    wxDataViewTreeNode* m_ret;
-};
-
-} // anonymous namespace
-  //
 wxDataViewTreeNode * wxDataViewMainWindow::GetTreeNodeByRow(unsigned int row) const
 {
     wxASSERT( !IsVirtualList() );
@@ -3918,9 +4832,20 @@ wxDataViewTreeNode * wxDataViewMainWindow::GetTreeNodeByRow(unsigned int row) co
     if ( row == (unsigned)-1 )
         return NULL;
 
-    RowToTreeNodeJob job(static_cast<int>(row));
-    Walker( m_root , job );
-    return job.GetResult();
+    // Descend into the tree, finding the child containing the row at each
+    // level using the index of the row counts of the children.
+    int rowInNode = static_cast<int>(row);
+    for ( wxDataViewTreeNode* node = m_root; ; )
+    {
+        wxDataViewTreeNode* const child = node->GetChildByRow(rowInNode);
+        if ( !child || !rowInNode )
+            return child;
+
+        // The row is inside the subtree of this child, skip the row of the
+        // child itself.
+        rowInNode--;
+        node = child;
+    }
 }
 
 wxDataViewItem wxDataViewMainWindow::GetItemByRow(unsigned int row) const
@@ -4168,27 +5093,18 @@ wxDataViewMainWindow::FindNode( const wxDataViewItem & item )
                 return result;
             }
 
-            const wxDataViewTreeNodes& nodes = node->GetChildNodes();
-            bool found = false;
+            const int index = node->FindChildByItem(parentChain[iter]);
+            if ( index == wxNOT_FOUND )
+                return result;
 
-            for (unsigned i = 0; i < nodes.size(); ++i)
+            wxDataViewTreeNode* const currentNode = node->GetChildNodes()[index];
+            if ( currentNode->GetItem() == item )
             {
-                wxDataViewTreeNode* currentNode = nodes[i];
-                if (currentNode->GetItem() == parentChain[iter])
-                {
-                    if (currentNode->GetItem() == item)
-                    {
-                        result.m_node = currentNode;
-                        return result;
-                    }
-
-                    node = currentNode;
-                    found = true;
-                    break;
-                }
-            }
-            if (!found)
+                result.m_node = currentNode;
                 return result;
+            }
+
+            node = currentNode;
         }
         else
             return result;
@@ -4314,60 +5230,6 @@ int wxDataViewMainWindow::RecalculateCount() const
     }
 }
 
-namespace
-{
-
-class ItemToRowJob : public DoJob
-{
-public:
-    // As with RowToTreeNodeJob above, we initialize m_current to -1 because
-    // the first node passed to our operator() is the root node which is not
-    // visible on screen and so we should return 0 for its first child node and
-    // not for the root itself.
-    ItemToRowJob(const wxDataViewItem& item, wxVector<wxDataViewItem>::reverse_iterator iter)
-        : m_item(item), m_iter(iter), m_current(-1)
-    {
-    }
-
-    // Maybe binary search will help to speed up this process
-    virtual int operator() ( wxDataViewTreeNode * node) override
-    {
-        if( node->GetItem() == m_item )
-        {
-            return DoJob::DONE;
-        }
-
-        // Is this node the next (grand)parent of the item we're looking for?
-        if( node->GetItem() == *m_iter )
-        {
-            // Search for the next (grand)parent now and skip this item itself.
-            ++m_iter;
-            ++m_current;
-            return DoJob::CONTINUE;
-        }
-        else
-        {
-            // Skip this node and all its currently visible children.
-            m_current += node->GetSubTreeCount() + 1;
-            return DoJob::SKIP_SUBTREE;
-        }
-
-    }
-
-    int GetResult() const
-        { return m_current; }
-
-private:
-    const wxDataViewItem m_item;
-    wxVector<wxDataViewItem>::reverse_iterator m_iter;
-
-    // The row corresponding to the last node seen in our operator().
-    int m_current;
-
-};
-
-} // anonymous namespace
-
 int
 wxDataViewMainWindow::GetRowByItem(const wxDataViewItem & item,
                                    WalkFlags flags) const
@@ -4394,16 +5256,29 @@ wxDataViewMainWindow::GetRowByItem(const wxDataViewItem & item,
             it = model->GetParent(it);
         }
 
-        // add an 'invalid' item to represent our 'invisible' root node
-        parentChain.push_back(wxDataViewItem());
-
         // the parent chain was created by adding the deepest parent first.
         // so if we want to start at the root node, we have to iterate backwards through the vector
-        ItemToRowJob job( item, parentChain.rbegin() );
-        if ( !Walker( m_root, job, flags ) )
-            return -1;
+        int row = -1;
+        const wxDataViewTreeNode* node = m_root;
+        for ( wxVector<wxDataViewItem>::reverse_iterator iter = parentChain.rbegin();
+              iter != parentChain.rend();
+              ++iter )
+        {
+            // Note that the root node is always open.
+            if ( flags == Walk_ExpandedOnly && !node->IsOpen() )
+                return -1;
+
+            const int index = node->FindChildByItem(*iter);
+            if ( index == wxNOT_FOUND )
+                return -1;
+
+            // Skip all the rows before this child and the row of its parent.
+            row += node->GetRowsBeforeChild(index) + 1;
 
-        return job.GetResult();
+            node = node->GetChildNodes()[index];
+        }
+
+        return row;
     }
 }
 
@@ -4416,6 +5291,8 @@ static void BuildTreeHelper( wxDataViewMainWindow *window, const wxDataViewModel
     wxDataViewItemArray children;
     unsigned int num = model->GetChildren( item, children);
 
+    wxDataViewTreeNodes nodes;
+    nodes.reserve(num);
     for ( unsigned int index = 0; index < num; index++ )
     {
         wxDataViewTreeNode *n = new wxDataViewTreeNode(node, children[index]);
@@ -4423,9 +5300,11 @@ static void BuildTreeHelper( wxDataViewMainWindow *window, const wxDataViewModel
         if( model->IsContainer(children[index]) )
             n->SetHasChildren( true );
 
-        node->InsertChild(window, n, index);
+        nodes.push_back(n);
     }
 
+    node->SetChildren(window, nodes);
+
     if ( node->IsOpen() )
         node->ChangeSubTreeCount(+num);
 }
@@ -4450,6 +5329,14 @@ void wxDataViewMainWindow::BuildTree(wxDataViewModel * model)
 
 void wxDataViewMainWindow::DestroyTree()
 {
+#if wxUSE_THREADS
+    CancelAsyncSort();
+#endif // wxUSE_THREADS
+
+    // The items changed during the current batch may not exist any more.
+    m_batchChanges.clear();
+    m_batchChangeIndex.clear();
+
     if (!IsVirtualList())
     {
         wxDELETE(m_root);
@@ -5681,6 +6568,34 @@ wxHeaderCtrl* wxDataViewCtrl::GenericGetHeader() const
     return m_headerArea;
 }
 
+bool wxDataViewCtrl::EnableAsyncSort(bool enable)
+{
+#if wxUSE_THREADS
+    m_clientArea->EnableAsyncSort(enable);
+
+    return true;
+#else // !wxUSE_THREADS
+    wxUnusedVar(enable);
+
+    return false;
+#endif // wxUSE_THREADS/!wxUSE_THREADS
+}
+
+bool wxDataViewCtrl::IsAsyncSortEnabled() const
+{
+    return m_clientArea->IsAsyncSortEnabled();
+}
+
+const wxDataViewUpdateStats& wxDataViewCtrl::GetUpdateStats() const
+{
+    return m_clientArea->GetUpdateStats();
+}
+
+void wxDataViewCtrl::ResetUpdateStats()
+{
+    m_clientArea->ResetUpdateStats();
+}
+
 #ifdef __WXMSW__
 WXLRESULT wxDataViewCtrl::MSWWindowProc(WXUINT nMsg,
                                         WXWPARAM wParam,
@@ -5865,6 +6780,8 @@ bool wxDataViewCtrl::AssociateModel( wxDataViewModel *model )
     if (!wxDataViewCtrlBase::AssociateModel( model ))
         return false;
 
+    m_clientArea->ResetBatch();
+
     if (model)
     {
         m_notifier = new wxGenericDataViewModelNotifier( m_clientArea );
@@ -6092,7 +7009,7 @@ public:
                 width += m_renderer->GetSize().x;
         }
 
-        UpdateWithWidth(width);
+        UpdateWithWidth(width, wxPtrToUInt(item.GetID()));
     }
 
 private:
@@ -6133,10 +7050,50 @@ unsigned int wxDataViewCtrl::GetBestColumnWidth(int idx) const
     if ( max_width > 0 )
         max_width += 2 * PADDING_RIGHTLEFT;
 
-    const_cast<wxDataViewCtrl*>(this)->m_colsBestWidths[idx].width = max_width;
+    CachedColWidthInfo& info = const_cast<wxDataViewCtrl*>(this)->m_colsBestWidths[idx];
+    info.width = max_width;
+    info.widest = calculator.GetWidestKey();
     return max_width;
 }
 
+void wxDataViewCtrl::UpdateColBestWidth(int idx, const wxDataViewItem& item)
+{
+    CachedColWidthInfo& info = m_colsBestWidths[idx];
+
+    // Nothing to do if the width is going to be recomputed anyhow.
+    if ( info.width == 0 )
+        return;
+
+    // Only the visible items are taken into account by GetBestColumnWidth().
+    const int row = m_clientArea->GetRowByItem(item, Walk_ExpandedOnly);
+    if ( row < 0 )
+        return;
+
+    wxDataViewColumn *column = GetColumn(idx);
+    wxDataViewMaxWidthCalculator calculator(this, m_clientArea,
+                                            column->GetRenderer(),
+                                            GetModel(), column->GetModelColumn(),
+                                            m_clientArea->GetRowHeight());
+    calculator.UpdateWithRow(row);
+
+    int width = calculator.GetMaxWidth();
+    if ( width > 0 )
+        width += 2 * PADDING_RIGHTLEFT;
+
+    const int oldWidth = info.width;
+    if ( !wxMaxWidthCalculatorBase::UpdateMaxWidth(info.width, info.widest,
+                                                   wxPtrToUInt(item.GetID()),
+                                                   width) )
+    {
+        InvalidateColBestWidth(idx);
+    }
+    else if ( info.width != oldWidth )
+    {
+        info.dirty = true;
+        m_colsDirty = true;
+    }
+}
+
 void wxDataViewCtrl::ColumnMoved(wxDataViewColumn *col, unsigned int new_pos)
 {
     // do _not_ reorder m_cols elements here, they should always be in the
@@ -188,8 +188,18 @@ public :
 
     virtual bool Contains( wxDouble x, wxDouble y, wxPolygonFillMode fillStyle = wxWINDING_RULE) const override;
 
+    // gets the corners of the bounding box, this is cached and so is much
+    // cheaper than computing it every time for big paths
+    void GetExtents(double* x1, double* y1, double* x2, double* y2) const;
+
 private :
+    // must be called whenever the path changes
+    void InvalidateExtents() { m_extentsValid = false; }
+
     cairo_t* m_pathContext;
+
+    mutable double m_extents[4];
+    mutable bool m_extentsValid;
 };
 
 class WXDLLIMPEXP_CORE wxCairoMatrixData : public wxGraphicsMatrixData
@@ -308,6 +318,20 @@ public:
     virtual void Apply( wxGraphicsContext* context ) override;
     wxDouble GetWidth() { return m_width; }
 
+    // Returns the maximal distance from the path to the points covered by
+    // the stroke, in user space units. This doesn't take into account the
+    // width of hairline pens which is expressed in device units.
+    double GetStrokeExtent() const
+    {
+        const double halfWidth = wxMax(m_width, 0.0) / 2;
+
+        // Miter joins can extend up to the miter limit times the half width
+        // from the path, the default Cairo miter limit which we use is 10.
+        // Otherwise the stroke can extend by at most half width times the
+        // square root of 2 for the square caps, round it up to 2.
+        return m_join == CAIRO_LINE_JOIN_MITER ? 10*halfWidth : 2*halfWidth;
+    }
+
 private :
     double m_width;
 
@@ -492,6 +516,10 @@ public:
     virtual void FillPath( const wxGraphicsPath& p , wxPolygonFillMode fillStyle = wxWINDING_RULE ) override;
     virtual void ClearRectangle( wxDouble x, wxDouble y, wxDouble w, wxDouble h ) override;
     virtual void DrawRectangle( wxDouble x, wxDouble y, wxDouble w, wxDouble h) override;
+    virtual void StrokeLines( size_t n, const wxPoint2DDouble *points) override;
+    virtual void StrokeLines( size_t n, const wxPoint2DDouble *beginPoints, const wxPoint2DDouble *endPoints) override;
+    virtual void FillRectangles( size_t n, const wxRect2DDouble *rects) override;
+    virtual void DrawMarkers( size_t n, const wxPoint2DDouble *points, const wxGraphicsPath& marker) override;
 
     virtual void Translate( wxDouble dx , wxDouble dy ) override;
     virtual void Scale( wxDouble xScale , wxDouble yScale ) override;
@@ -529,6 +557,21 @@ protected:
 
     void Init(cairo_t *context);
 
+    // Returns true if nothing would be drawn when drawing inside the given
+    // rectangle in user space coordinates extended by the given margin, in
+    // user space units, and by a couple of device pixels, to account for the
+    // pixel offset and anti-aliasing, because it lies entirely outside of the
+    // clipping region. This allows to avoid rasterizing the primitives which
+    // are not visible at all, e.g. when repainting only a small part of a big
+    // window, as the clipping region includes the update region.
+    bool IsOutsideClip(double x1, double y1, double x2, double y2,
+                       double margin = 0) const;
+
+    // Get the area, in user space coordinates, outside of which nothing can be
+    // drawn, including the margin for the pixel offset and anti-aliasing.
+    // Returns false if there is no such area and nothing can be skipped.
+    bool GetCullingArea(double* x1, double* y1, double* x2, double* y2) const;
+
     enum ApplyTransformMode { Apply_directly, Apply_scaled_dev_origin };
     void ApplyTransformFromDC(const wxDC& dc, ApplyTransformMode mode = Apply_directly);
 
@@ -1243,6 +1286,8 @@ void wxCairoFontData::Apply( wxGraphicsContext* context )
 wxCairoPathData::wxCairoPathData( wxGraphicsRenderer* renderer, cairo_t* pathcontext)
     : wxGraphicsPathData(renderer)
 {
+    m_extentsValid = false;
+
     if (pathcontext)
     {
         m_pathContext = pathcontext;
@@ -1289,16 +1334,19 @@ void wxCairoPathData::UnGetNativePath(void *p) const
 
 void wxCairoPathData::MoveToPoint( wxDouble x , wxDouble y )
 {
+    InvalidateExtents();
     cairo_move_to(m_pathContext,x,y);
 }
 
 void wxCairoPathData::AddLineToPoint( wxDouble x , wxDouble y )
 {
+    InvalidateExtents();
     cairo_line_to(m_pathContext,x,y);
 }
 
 void wxCairoPathData::AddPath( const wxGraphicsPathData* path )
 {
+    InvalidateExtents();
     cairo_path_t* p = (cairo_path_t*)path->GetNativePath();
     cairo_append_path(m_pathContext, p);
     UnGetNativePath(p);
@@ -1306,11 +1354,13 @@ void wxCairoPathData::AddPath( const wxGraphicsPathData* path )
 
 void wxCairoPathData::CloseSubpath()
 {
+    InvalidateExtents();
     cairo_close_path(m_pathContext);
 }
 
 void wxCairoPathData::AddCurveToPoint( wxDouble cx1, wxDouble cy1, wxDouble cx2, wxDouble cy2, wxDouble x, wxDouble y )
 {
+    InvalidateExtents();
     cairo_curve_to(m_pathContext,cx1,cy1,cx2,cy2,x,y);
 }
 
@@ -1327,6 +1377,8 @@ void wxCairoPathData::GetCurrentPoint( wxDouble* x, wxDouble* y) const
 
 void wxCairoPathData::AddArc( wxDouble x, wxDouble y, wxDouble r, double startAngle, double endAngle, bool clockwise )
 {
+    InvalidateExtents();
+
     // as clockwise means positive in our system (y pointing downwards)
     // TODO make this interpretation dependent of the
     // real device trans
@@ -1339,6 +1391,8 @@ void wxCairoPathData::AddArc( wxDouble x, wxDouble y, wxDouble r, double startAn
 // transforms each point of this path by the matrix
 void wxCairoPathData::Transform( const wxGraphicsMatrixData* matrix )
 {
+    InvalidateExtents();
+
     // as we don't have a true path object, we have to apply the inverse
     // matrix to the context
     cairo_matrix_t m = *((cairo_matrix_t*) matrix->GetNativeMatrix());
@@ -1347,21 +1401,37 @@ void wxCairoPathData::Transform( const wxGraphicsMatrixData* matrix )
 }
 
 // gets the bounding box enclosing all points (possibly including control points)
-void wxCairoPathData::GetBox(wxDouble *x, wxDouble *y, wxDouble *w, wxDouble *h) const
+void wxCairoPathData::GetExtents(double* x1, double* y1, double* x2, double* y2) const
 {
-    double x1,y1,x2,y2;
-
-#if CAIRO_VERSION >= CAIRO_VERSION_ENCODE(1, 6, 0)
-    if ( cairo_version() >= CAIRO_VERSION_ENCODE(1, 6, 0) )
+    if ( !m_extentsValid )
     {
-        cairo_path_extents(m_pathContext, &x1, &y1, &x2, &y2);
-    }
-    else
+#if CAIRO_VERSION >= CAIRO_VERSION_ENCODE(1, 6, 0)
+        if ( cairo_version() >= CAIRO_VERSION_ENCODE(1, 6, 0) )
+        {
+            cairo_path_extents(m_pathContext, &m_extents[0], &m_extents[1],
+                                              &m_extents[2], &m_extents[3]);
+        }
+        else
 #endif
-    {
-        cairo_stroke_extents(m_pathContext, &x1, &y1, &x2, &y2);
+        {
+            cairo_stroke_extents(m_pathContext, &m_extents[0], &m_extents[1],
+                                                &m_extents[2], &m_extents[3]);
+        }
+
+        m_extentsValid = true;
     }
 
+    *x1 = m_extents[0];
+    *y1 = m_extents[1];
+    *x2 = m_extents[2];
+    *y2 = m_extents[3];
+}
+
+void wxCairoPathData::GetBox(wxDouble *x, wxDouble *y, wxDouble *w, wxDouble *h) const
+{
+    double x1,y1,x2,y2;
+    GetExtents(&x1, &y1, &x2, &y2);
+
     if ( x2 < x1 )
     {
         *x = x2;
@@ -1395,11 +1465,13 @@ bool wxCairoPathData::Contains( wxDouble x, wxDouble y, wxPolygonFillMode fillSt
 
 void wxCairoPathData::AddRectangle(wxDouble x, wxDouble y, wxDouble w, wxDouble h)
 {
+    InvalidateExtents();
     cairo_rectangle(m_pathContext, x, y, w, h);
 }
 
 void wxCairoPathData::AddCircle(wxDouble x, wxDouble y, wxDouble r)
 {
+    InvalidateExtents();
     cairo_move_to(m_pathContext, x+r, y);
     cairo_arc(m_pathContext, x, y, r, 0.0, 2*M_PI);
     cairo_close_path(m_pathContext);
@@ -1410,6 +1482,8 @@ void wxCairoPathData::AddEllipse(wxDouble x, wxDouble y, wxDouble w, wxDouble h)
     if (w <= 0 || h <= 0)
         return;
 
+    InvalidateExtents();
+
     cairo_move_to(m_pathContext, x+w, y+h/2.0);
     w /= 2.0;
     h /= 2.0;
@@ -2643,10 +2717,80 @@ void wxCairoContext::GetClipBox(wxDouble* x, wxDouble* y, wxDouble* w, wxDouble*
         *h = y2 - y1;
 }
 
+bool wxCairoContext::GetCullingArea(double* x1, double* y1,
+                                    double* x2, double* y2) const
+{
+    // Unbounded operators affect the destination outside of the shape being
+    // drawn too, so we can't skip drawing anything when using them.
+    switch ( m_composition )
+    {
+        case wxCOMPOSITION_IN:
+        case wxCOMPOSITION_OUT:
+        case wxCOMPOSITION_DEST_IN:
+        case wxCOMPOSITION_DEST_ATOP:
+            return false;
+
+        default:
+            break;
+    }
+
+#if CAIRO_VERSION >= CAIRO_VERSION_ENCODE(1, 4, 0)
+    if ( cairo_version() >= CAIRO_VERSION_ENCODE(1, 4, 0) )
+    {
+        cairo_clip_extents(m_context, x1, y1, x2, y2);
+
+        // Get the upper bound of the size of a device pixel in user space.
+        double dx1 = 1.0, dy1 = 0.0,
+               dx2 = 0.0, dy2 = 1.0;
+        cairo_device_to_user_distance(m_context, &dx1, &dy1);
+        cairo_device_to_user_distance(m_context, &dx2, &dy2);
+        const double margin = 2*(fabs(dx1) + fabs(dy1) + fabs(dx2) + fabs(dy2));
+
+        *x1 -= margin;
+        *y1 -= margin;
+        *x2 += margin;
+        *y2 += margin;
+
+        return true;
+    }
+#endif // Cairo >= 1.4
+
+    wxUnusedVar(x1);
+    wxUnusedVar(y1);
+    wxUnusedVar(x2);
+    wxUnusedVar(y2);
+
+    return false;
+}
+
+bool wxCairoContext::IsOutsideClip(double x1, double y1, double x2, double y2,
+                                   double margin) const
+{
+    double clipX1, clipY1, clipX2, clipY2;
+    if ( !GetCullingArea(&clipX1, &clipY1, &clipX2, &clipY2) )
+        return false;
+
+    if ( x2 < x1 )
+        wxSwap(x1, x2);
+    if ( y2 < y1 )
+        wxSwap(y1, y2);
+
+    return x2 + margin < clipX1 || x1 - margin > clipX2 ||
+           y2 + margin < clipY1 || y1 - margin > clipY2;
+}
+
 void wxCairoContext::StrokePath( const wxGraphicsPath& path )
 {
     if ( !m_pen.IsNull() )
     {
+        const wxCairoPathData* const
+            pathData = static_cast<const wxCairoPathData*>(path.GetPathData());
+        double x1, y1, x2, y2;
+        pathData->GetExtents(&x1, &y1, &x2, &y2);
+        if ( IsOutsideClip(x1, y1, x2, y2,
+                           ((wxCairoPenData*)m_pen.GetRefData())->GetStrokeExtent()) )
+            return;
+
         wxCairoOffsetHelper helper(m_context, GetContentScaleFactor(), ShouldOffset());
         cairo_path_t* cp = (cairo_path_t*) path.GetNativePath() ;
         cairo_append_path(m_context,cp);
@@ -2660,6 +2804,13 @@ void wxCairoContext::FillPath( const wxGraphicsPath& path , wxPolygonFillMode fi
 {
     if ( !m_brush.IsNull() )
     {
+        const wxCairoPathData* const
+            pathData = static_cast<const wxCairoPathData*>(path.GetPathData());
+        double x1, y1, x2, y2;
+        pathData->GetExtents(&x1, &y1, &x2, &y2);
+        if ( IsOutsideClip(x1, y1, x2, y2) )
+            return;
+
         wxCairoOffsetHelper helper(m_context, GetContentScaleFactor(), ShouldOffset());
         cairo_path_t* cp = (cairo_path_t*) path.GetNativePath() ;
         cairo_append_path(m_context,cp);
@@ -2681,6 +2832,12 @@ void wxCairoContext::ClearRectangle( wxDouble x, wxDouble y, wxDouble w, wxDoubl
 
 void wxCairoContext::DrawRectangle( wxDouble x, wxDouble y, wxDouble w, wxDouble h )
 {
+    const double penExtent = m_pen.IsNull()
+        ? 0.0
+        : ((wxCairoPenData*)m_pen.GetRefData())->GetStrokeExtent();
+    if ( IsOutsideClip(x, y, x + w, y + h, penExtent) )
+        return;
+
     if ( !m_brush.IsNull() )
     {
         ((wxCairoBrushData*)m_brush.GetRefData())->Apply(this);
@@ -2696,6 +2853,193 @@ void wxCairoContext::DrawRectangle( wxDouble x, wxDouble y, wxDouble w, wxDouble
     }
 }
 
+void wxCairoContext::StrokeLines( size_t n, const wxPoint2DDouble *points)
+{
+    wxASSERT(n > 1);
+
+    if ( m_pen.IsNull() )
+        return;
+
+    double x1 = points[0].m_x, y1 = points[0].m_y,
+           x2 = x1, y2 = y1;
+    for ( size_t i = 1; i < n; ++i )
+    {
+        x1 = wxMin(x1, points[i].m_x);
+        y1 = wxMin(y1, points[i].m_y);
+        x2 = wxMax(x2, points[i].m_x);
+        y2 = wxMax(y2, points[i].m_y);
+    }
+
+    wxCairoPenData* const penData = (wxCairoPenData*)m_pen.GetRefData();
+    if ( IsOutsideClip(x1, y1, x2, y2, penData->GetStrokeExtent()) )
+        return;
+
+    // Build the path directly in this context instead of creating a
+    // wxGraphicsPath, which requires a separate Cairo context, and copying it.
+    wxCairoOffsetHelper helper(m_context, GetContentScaleFactor(), ShouldOffset());
+    cairo_new_path(m_context);
+    cairo_move_to(m_context, points[0].m_x, points[0].m_y);
+    for ( size_t i = 1; i < n; ++i )
+        cairo_line_to(m_context, points[i].m_x, points[i].m_y);
+    penData->Apply(this);
+    cairo_stroke(m_context);
+}
+
+void wxCairoContext::StrokeLines( size_t n, const wxPoint2DDouble *beginPoints, const wxPoint2DDouble *endPoints)
+{
+    wxASSERT(n > 0);
+
+    if ( m_pen.IsNull() )
+        return;
+
+    wxCairoPenData* const penData = (wxCairoPenData*)m_pen.GetRefData();
+    const double margin = penData->GetStrokeExtent();
+
+    // As the lines are not connected, we can skip the invisible ones.
+    double clipX1, clipY1, clipX2, clipY2;
+    const bool cull = GetCullingArea(&clipX1, &clipY1, &clipX2, &clipY2);
+
+    wxCairoOffsetHelper helper(m_context, GetContentScaleFactor(), ShouldOffset());
+    cairo_new_path(m_context);
+    bool any = false;
+    for ( size_t i = 0; i < n; ++i )
+    {
+        const wxPoint2DDouble& p1 = beginPoints[i];
+        const wxPoint2DDouble& p2 = endPoints[i];
+        if ( cull &&
+                (wxMax(p1.m_x, p2.m_x) + margin < clipX1 ||
+                 wxMin(p1.m_x, p2.m_x) - margin > clipX2 ||
+                 wxMax(p1.m_y, p2.m_y) + margin < clipY1 ||
+                 wxMin(p1.m_y, p2.m_y) - margin > clipY2) )
+            continue;
+
+        cairo_move_to(m_context, p1.m_x, p1.m_y);
+        cairo_line_to(m_context, p2.m_x, p2.m_y);
+        any = true;
+    }
+
+    if ( any )
+    {
+        penData->Apply(this);
+        cairo_stroke(m_context);
+    }
+    else
+    {
+        cairo_new_path(m_context);
+    }
+}
+
+void wxCairoContext::FillRectangles( size_t n, const wxRect2DDouble *rects)
+{
+    if ( m_brush.IsNull() )
+        return;
+
+    double clipX1, clipY1, clipX2, clipY2;
+    const bool cull = GetCullingArea(&clipX1, &clipY1, &clipX2, &clipY2);
+
+    wxCairoOffsetHelper helper(m_context, GetContentScaleFactor(), ShouldOffset());
+    cairo_new_path(m_context);
+    bool any = false;
+    for ( size_t i = 0; i < n; ++i )
+    {
+        const wxRect2DDouble& r = rects[i];
+        if ( cull &&
+                (wxMax(r.m_x, r.m_x + r.m_width) < clipX1 ||
+                 wxMin(r.m_x, r.m_x + r.m_width) > clipX2 ||
+                 wxMax(r.m_y, r.m_y + r.m_height) < clipY1 ||
+                 wxMin(r.m_y, r.m_y + r.m_height) > clipY2) )
+            continue;
+
+        cairo_rectangle(m_context, r.m_x, r.m_y, r.m_width, r.m_height);
+        any = true;
+    }
+
+    if ( any )
+    {
+        ((wxCairoBrushData*)m_brush.GetRefData())->Apply(this);
+        cairo_set_fill_rule(m_context, CAIRO_FILL_RULE_WINDING);
+        cairo_fill(m_context);
+    }
+    else
+    {
+        cairo_new_path(m_context);
+    }
+}
+
+void wxCairoContext::DrawMarkers( size_t n, const wxPoint2DDouble *points, const wxGraphicsPath& marker)
+{
+    if ( m_brush.IsNull() && m_pen.IsNull() )
+        return;
+
+    // Compute the extent of the marker around its origin once.
+    const wxCairoPathData* const
+        markerData = static_cast<const wxCairoPathData*>(marker.GetPathData());
+    double mx1, my1, mx2, my2;
+    markerData->GetExtents(&mx1, &my1, &mx2, &my2);
+    if ( !m_pen.IsNull() )
+    {
+        const double margin = ((wxCairoPenData*)m_pen.GetRefData())->GetStrokeExtent();
+        mx1 -= margin;
+        my1 -= margin;
+        mx2 += margin;
+        my2 += margin;
+    }
+
+    double clipX1, clipY1, clipX2, clipY2;
+    const bool cull = GetCullingArea(&clipX1, &clipY1, &clipX2, &clipY2);
+
+    wxCairoOffsetHelper helper(m_context, GetContentScaleFactor(), ShouldOffset());
+
+    // Append the marker path once for each point, using the transformation
+    // to move it there, as the path is converted to device coordinates when
+    // it's appended.
+    cairo_matrix_t matrix;
+    cairo_get_matrix(m_context, &matrix);
+
+    cairo_path_t* cp = (cairo_path_t*) marker.GetNativePath();
+    cairo_new_path(m_context);
+    bool any = false;
+    for ( size_t i = 0; i < n; ++i )
+    {
+        const double x = points[i].m_x,
+                     y = points[i].m_y;
+        if ( cull &&
+                (x + mx2 < clipX1 || x + mx1 > clipX2 ||
+                 y + my2 < clipY1 || y + my1 > clipY2) )
+            continue;
+
+        cairo_matrix_t translated = matrix;
+        cairo_matrix_translate(&translated, x, y);
+        cairo_set_matrix(m_context, &translated);
+        cairo_append_path(m_context, cp);
+        any = true;
+    }
+    cairo_set_matrix(m_context, &matrix);
+    marker.UnGetNativePath(cp);
+
+    if ( !any )
+    {
+        cairo_new_path(m_context);
+        return;
+    }
+
+    if ( !m_brush.IsNull() )
+    {
+        ((wxCairoBrushData*)m_brush.GetRefData())->Apply(this);
+        cairo_set_fill_rule(m_context, CAIRO_FILL_RULE_WINDING);
+        if ( m_pen.IsNull() )
+        {
+            cairo_fill(m_context);
+            return;
+        }
+
+        cairo_fill_preserve(m_context);
+    }
+
+    ((wxCairoPenData*)m_pen.GetRefData())->Apply(this);
+    cairo_stroke(m_context);
+}
+
 void wxCairoContext::Rotate( wxDouble angle )
 {
     cairo_rotate(m_context,angle);
@@ -2790,6 +3134,9 @@ void wxCairoContext::DrawBitmap( const wxBitmap &bmp, wxDouble x, wxDouble y, wx
 
 void wxCairoContext::DrawBitmap(const wxGraphicsBitmap &bmp, wxDouble x, wxDouble y, wxDouble w, wxDouble h )
 {
+    if ( IsOutsideClip(x, y, x + w, y + h) )
+        return;
+
     PushState();
 
     // In case we're scaling the image by using a width and height different
@@ -59,6 +59,9 @@ const char wxGridNameStr[] = "grid";
 // Required for wxIs... functions
 #include <ctype.h>
 
+#include <algorithm>
+#include <limits>
+
 WX_DECLARE_HASH_SET_WITH_DECL_PTR(int, wxIntegerHash, wxIntegerEqual,
                                   wxGridFixedIndicesSet, class WXDLLIMPEXP_ADV);
 
@@ -1072,91 +1075,151 @@ wxGridCellAttrData::FindIndex(int row, int col) const
 
 wxGridRowOrColAttrData::~wxGridRowOrColAttrData()
 {
-    size_t count = m_attrs.GetCount();
-    for ( size_t n = 0; n < count; n++ )
+    for ( Ranges::const_iterator it = m_ranges.begin();
+          it != m_ranges.end();
+          ++it )
     {
-        m_attrs[n]->DecRef();
+        it->attr->DecRef();
     }
 }
 
+size_t wxGridRowOrColAttrData::FindRange(int rowOrCol) const
+{
+    const Ranges::const_iterator it = std::lower_bound
+        (
+            m_ranges.begin(),
+            m_ranges.end(),
+            rowOrCol,
+            [](const Range& range, int n) { return range.last < n; }
+        );
+
+    return it - m_ranges.begin();
+}
+
+size_t wxGridRowOrColAttrData::SplitRange(size_t n, int rowOrCol)
+{
+    Range& range = m_ranges[n];
+
+    wxASSERT( range.first < rowOrCol && rowOrCol <= range.last );
+
+    // both parts of the range use the same attribute, so it needs an extra
+    // reference
+    range.attr->IncRef();
+
+    const Range second(rowOrCol, range.last, range.attr);
+    range.last = rowOrCol - 1;
+
+    m_ranges.insert(m_ranges.begin() + n + 1, second);
+
+    return n + 1;
+}
+
+size_t wxGridRowOrColAttrData::ClearRange(int first, int last)
+{
+    size_t n = FindRange(first);
+    if ( n == m_ranges.size() )
+        return n;
+
+    // if the first range starts before the cleared part, keep its beginning
+    if ( m_ranges[n].first < first )
+        n = SplitRange(n, first);
+
+    // find all the ranges entirely inside the cleared part
+    size_t end = n;
+    while ( end < m_ranges.size() && m_ranges[end].last <= last )
+        end++;
+
+    // and cut the beginning of the last range if it starts inside it
+    if ( end < m_ranges.size() && m_ranges[end].first <= last )
+        m_ranges[end].first = last + 1;
+
+    for ( size_t i = n; i < end; i++ )
+        m_ranges[i].attr->DecRef();
+
+    m_ranges.erase(m_ranges.begin() + n, m_ranges.begin() + end);
+
+    return n;
+}
+
 wxGridCellAttr *wxGridRowOrColAttrData::GetAttr(int rowOrCol) const
 {
-    wxGridCellAttr *attr = NULL;
+    const size_t n = FindRange(rowOrCol);
+    if ( n == m_ranges.size() || m_ranges[n].first > rowOrCol )
+        return NULL;
 
-    int n = m_rowsOrCols.Index(rowOrCol);
-    if ( n != wxNOT_FOUND )
-    {
-        attr = m_attrs[(size_t)n];
-        attr->IncRef();
-    }
+    wxGridCellAttr * const attr = m_ranges[n].attr;
+    attr->IncRef();
 
     return attr;
 }
 
-void wxGridRowOrColAttrData::SetAttr(wxGridCellAttr *attr, int rowOrCol)
+void wxGridRowOrColAttrData::SetRangeAttr(wxGridCellAttr *attr,
+                                          int first, int last)
 {
-    int i = m_rowsOrCols.Index(rowOrCol);
-    if ( i == wxNOT_FOUND )
+    if ( first < 0 || first > last )
     {
-        if ( attr )
-        {
-            // store the new attribute, taking its ownership
-            m_rowsOrCols.Add(rowOrCol);
-            m_attrs.Add(attr);
-        }
-        // nothing to remove
+        wxFAIL_MSG( "invalid row or column range" );
+
+        // we still own the attribute and must free it
+        wxSafeDecRef(attr);
+        return;
     }
-    else // we have an attribute for this row or column
-    {
-        size_t n = (size_t)i;
 
-        // notice that this code works correctly even when the old attribute is
-        // the same as the new one: as we own of it, we must call DecRef() on
-        // it in any case and this won't result in destruction of the new
-        // attribute if it's the same as old one because it must have ref count
-        // of at least 2 to be passed to us while we keep a reference to it too
-        m_attrs[n]->DecRef();
+    // notice that this code works correctly even when the old attribute is
+    // the same as the new one: as we own of it, we must call DecRef() on
+    // it in any case and this won't result in destruction of the new
+    // attribute if it's the same as old one because it must have ref count
+    // of at least 2 to be passed to us while we keep a reference to it too
+    const size_t n = ClearRange(first, last);
 
-        if ( attr )
-        {
-            // replace the attribute with the new one
-            m_attrs[n] = attr;
-        }
-        else // remove the attribute
-        {
-            m_rowsOrCols.RemoveAt(n);
-            m_attrs.RemoveAt(n);
-        }
+    if ( attr )
+    {
+        // store the new attribute, taking its ownership
+        m_ranges.insert(m_ranges.begin() + n, Range(first, last, attr));
     }
 }
 
 void wxGridRowOrColAttrData::UpdateAttrRowsOrCols( size_t pos, int numRowsOrCols )
 {
-    size_t count = m_attrs.GetCount();
-    for ( size_t n = 0; n < count; n++ )
+    const int first = static_cast<int>(pos);
+
+    size_t n;
+    if ( numRowsOrCols > 0 )
+    {
+        // If rows or cols inserted, the new ones don't have any attributes,
+        // so split the range containing them, if any, in two.
+        n = FindRange(first);
+        if ( n < m_ranges.size() && m_ranges[n].first < first )
+            n = SplitRange(n, first);
+    }
+    else if ( numRowsOrCols < 0 )
+    {
+        // If rows/cols deleted, remove their attributes.
+        n = ClearRange(first, first - numRowsOrCols - 1);
+    }
+    else
+    {
+        return;
+    }
+
+    // In either case, shift all the ranges after the changed position.
+    for ( size_t i = n; i < m_ranges.size(); i++ )
     {
-        int & rowOrCol = m_rowsOrCols[n];
-        if ( (size_t)rowOrCol >= pos )
+        m_ranges[i].first += numRowsOrCols;
+        m_ranges[i].last += numRowsOrCols;
+    }
+
+    // After deleting the middle of a range, its parts become adjacent again,
+    // so merge them back.
+    if ( numRowsOrCols < 0 && n > 0 && n < m_ranges.size() )
+    {
+        Range& prev = m_ranges[n - 1];
+        const Range& next = m_ranges[n];
+        if ( prev.attr == next.attr && prev.last + 1 == next.first )
         {
-            if ( numRowsOrCols > 0 )
-            {
-                // If rows or cols inserted, increment row/col counter where necessary
-                rowOrCol += numRowsOrCols;
-            }
-            else if ( numRowsOrCols < 0)
-            {
-                // If rows/cols deleted, either decrement row/col counter (if row/col still exists)
-                if ((size_t)rowOrCol >= pos - numRowsOrCols)
-                    rowOrCol += numRowsOrCols;
-                else
-                {
-                    m_rowsOrCols.RemoveAt(n);
-                    m_attrs[n]->DecRef();
-                    m_attrs.RemoveAt(n);
-                    n--;
-                    count--;
-                }
-            }
+            prev.last = next.last;
+            next.attr->DecRef();
+            m_ranges.erase(m_ranges.begin() + n);
         }
     }
 }
@@ -1296,6 +1359,24 @@ void wxGridCellAttrProvider::SetColAttr(wxGridCellAttr *attr, int col)
     m_data->m_colAttrs.SetAttr(attr, col);
 }
 
+void wxGridCellAttrProvider::SetRowRangeAttr(wxGridCellAttr *attr,
+                                             int topRow, int bottomRow)
+{
+    if ( !m_data )
+        InitData();
+
+    m_data->m_rowAttrs.SetRangeAttr(attr, topRow, bottomRow);
+}
+
+void wxGridCellAttrProvider::SetColRangeAttr(wxGridCellAttr *attr,
+                                             int leftCol, int rightCol)
+{
+    if ( !m_data )
+        InitData();
+
+    m_data->m_colAttrs.SetRangeAttr(attr, leftCol, rightCol);
+}
+
 void wxGridCellAttrProvider::UpdateAttrRows( size_t pos, int numRows )
 {
     if ( m_data )
@@ -2143,6 +2224,618 @@ wxString wxGridStringTable::GetCornerLabelValue() const
     return m_cornerLabel;
 }
 
+//////////////////////////////////////////////////////////////////////
+//
+// A grid table storing the data by columns, using a native buffer of
+// numbers for the numeric columns and indices into a shared pool of
+// strings for the string ones.
+//
+
+namespace
+{
+
+// Convert the double value to long: just casting it is undefined behaviour if
+// it's NaN or out of range of long, so return 0 for NaN and clamp the others.
+long GridDoubleToLong(double value)
+{
+    // Notice that the minimal long value is a power of 2 and so is exactly
+    // representable as double, unlike the maximal one.
+    const double min = static_cast<double>(std::numeric_limits<long>::min());
+
+    if ( wxIsNaN(value) )
+        return 0;
+
+    if ( value < min )
+        return std::numeric_limits<long>::min();
+
+    if ( value >= -min )
+        return std::numeric_limits<long>::max();
+
+    return static_cast<long>(value);
+}
+
+} // anonymous namespace
+
+wxIMPLEMENT_DYNAMIC_CLASS(wxGridColumnarTable, wxGridTableBase);
+
+wxGridColumnarTable::wxGridColumnarTable()
+        : wxGridTableBase()
+{
+    m_numRows = 0;
+    m_pool.push_back(wxString());
+}
+
+wxGridColumnarTable::wxGridColumnarTable( int numRows )
+        : wxGridTableBase()
+{
+    wxASSERT_MSG( numRows >= 0, "invalid number of rows" );
+
+    m_numRows = numRows > 0 ? numRows : 0;
+    m_pool.push_back(wxString());
+}
+
+void wxGridColumnarTable::ReserveRows( size_t numRows )
+{
+    for ( size_t col = 0; col < m_columns.size(); col++ )
+    {
+        Column& column = m_columns[col];
+        switch ( column.type )
+        {
+            case wxGRID_COLUMN_STRING:
+                column.strings.reserve(numRows);
+                break;
+
+            case wxGRID_COLUMN_LONG:
+                column.longs.reserve(numRows);
+                column.empty.reserve(numRows);
+                break;
+
+            case wxGRID_COLUMN_DOUBLE:
+                column.doubles.reserve(numRows);
+                column.empty.reserve(numRows);
+                break;
+        }
+    }
+}
+
+void wxGridColumnarTable::ResizeColumn( Column& column )
+{
+    switch ( column.type )
+    {
+        case wxGRID_COLUMN_STRING:
+            column.strings.resize(m_numRows, 0);
+            break;
+
+        case wxGRID_COLUMN_LONG:
+            column.longs.resize(m_numRows, 0);
+            column.empty.resize(m_numRows, true);
+            break;
+
+        case wxGRID_COLUMN_DOUBLE:
+            column.doubles.resize(m_numRows, 0.0);
+            column.empty.resize(m_numRows, true);
+            break;
+    }
+}
+
+unsigned wxGridColumnarTable::InternString( const wxString& s )
+{
+    if ( s.empty() )
+        return 0;
+
+    wxGridStringPoolIndexMap::const_iterator it = m_poolIndices.find(s);
+    if ( it != m_poolIndices.end() )
+        return it->second;
+
+    const unsigned index = m_pool.size();
+    m_pool.push_back(s);
+    m_poolIndices[s] = index;
+
+    return index;
+}
+
+bool wxGridColumnarTable::AppendColumn( wxGridColumnType type,
+                                        const wxString& label )
+{
+    return InsertColumn( m_columns.size(), type, label );
+}
+
+bool wxGridColumnarTable::InsertColumn( size_t pos,
+                                        wxGridColumnType type,
+                                        const wxString& label )
+{
+    const bool append = pos >= m_columns.size();
+    if ( append )
+        pos = m_columns.size();
+
+    Column column;
+    column.type = type;
+    column.label = label;
+    ResizeColumn(column);
+
+    m_columns.insert(m_columns.begin() + pos, column);
+
+    if ( GetView() )
+    {
+        if ( append )
+        {
+            GetView()->ProcessTableMessage( this,
+                                    wxGRIDTABLE_NOTIFY_COLS_APPENDED,
+                                    1 );
+        }
+        else
+        {
+            GetView()->ProcessTableMessage( this,
+                                    wxGRIDTABLE_NOTIFY_COLS_INSERTED,
+                                    pos,
+                                    1 );
+        }
+    }
+
+    return true;
+}
+
+wxGridColumnType wxGridColumnarTable::GetColumnType( int col ) const
+{
+    wxCHECK_MSG( col >= 0 && static_cast<size_t>(col) < m_columns.size(),
+                 wxGRID_COLUMN_STRING,
+                 wxT("invalid column index in wxGridColumnarTable") );
+
+    return m_columns[col].type;
+}
+
+wxString wxGridColumnarTable::GetValue( int row, int col )
+{
+    wxCHECK_MSG( IsValidCell(row, col),
+                 wxEmptyString,
+                 wxT("invalid row or column index in wxGridColumnarTable") );
+
+    const Column& column = m_columns[col];
+    switch ( column.type )
+    {
+        case wxGRID_COLUMN_STRING:
+            return m_pool[column.strings[row]];
+
+        case wxGRID_COLUMN_LONG:
+            if ( !column.empty[row] )
+                return wxString::Format("%ld", column.longs[row]);
+            break;
+
+        case wxGRID_COLUMN_DOUBLE:
+            if ( !column.empty[row] )
+                return wxString::FromDouble(column.doubles[row]);
+            break;
+    }
+
+    return wxString();
+}
+
+void wxGridColumnarTable::SetValue( int row, int col, const wxString& value )
+{
+    wxCHECK_RET( IsValidCell(row, col),
+                 wxT("invalid row or column index in wxGridColumnarTable") );
+
+    Column& column = m_columns[col];
+    switch ( column.type )
+    {
+        case wxGRID_COLUMN_STRING:
+            column.strings[row] = InternString(value);
+            break;
+
+        case wxGRID_COLUMN_LONG:
+            {
+                long l;
+                const bool empty = value.empty() || !value.ToLong(&l);
+                column.longs[row] = empty ? 0 : l;
+                column.empty[row] = empty;
+            }
+            break;
+
+        case wxGRID_COLUMN_DOUBLE:
+            {
+                double d;
+                const bool empty = value.empty() || !value.ToDouble(&d);
+                column.doubles[row] = empty ? 0.0 : d;
+                column.empty[row] = empty;
+            }
+            break;
+    }
+}
+
+bool wxGridColumnarTable::IsEmptyCell( int row, int col )
+{
+    wxCHECK_MSG( IsValidCell(row, col),
+                 true,
+                 wxT("invalid row or column index in wxGridColumnarTable") );
+
+    const Column& column = m_columns[col];
+    switch ( column.type )
+    {
+        case wxGRID_COLUMN_STRING:
+            return column.strings[row] == 0;
+
+        case wxGRID_COLUMN_LONG:
+        case wxGRID_COLUMN_DOUBLE:
+            return column.empty[row];
+    }
+
+    return true;
+}
+
+wxString wxGridColumnarTable::GetTypeName( int WXUNUSED(row), int col )
+{
+    switch ( GetColumnType(col) )
+    {
+        case wxGRID_COLUMN_STRING:
+            break;
+
+        case wxGRID_COLUMN_LONG:
+            return wxGRID_VALUE_NUMBER;
+
+        case wxGRID_COLUMN_DOUBLE:
+            return wxGRID_VALUE_FLOAT;
+    }
+
+    return wxGRID_VALUE_STRING;
+}
+
+bool wxGridColumnarTable::CanGetValueAs( int row, int col,
+                                         const wxString& typeName )
+{
+    if ( typeName == wxGRID_VALUE_STRING )
+        return true;
+
+    // Empty cells don't have any value of their type, the renderers and
+    // editors must use the empty string returned by GetValue() for them.
+    if ( IsEmptyCell(row, col) )
+        return false;
+
+    return typeName == GetTypeName(row, col);
+}
+
+long wxGridColumnarTable::GetValueAsLong( int row, int col )
+{
+    wxCHECK_MSG( IsValidCell(row, col),
+                 0,
+                 wxT("invalid row or column index in wxGridColumnarTable") );
+
+    const Column& column = m_columns[col];
+    switch ( column.type )
+    {
+        case wxGRID_COLUMN_STRING:
+            break;
+
+        case wxGRID_COLUMN_LONG:
+            // Notice that the value stored for the empty cells is 0.
+            return column.longs[row];
+
+        case wxGRID_COLUMN_DOUBLE:
+            return GridDoubleToLong(column.doubles[row]);
+    }
+
+    return 0;
+}
+
+double wxGridColumnarTable::GetValueAsDouble( int row, int col )
+{
+    wxCHECK_MSG( IsValidCell(row, col),
+                 0.0,
+                 wxT("invalid row or column index in wxGridColumnarTable") );
+
+    const Column& column = m_columns[col];
+    switch ( column.type )
+    {
+        case wxGRID_COLUMN_STRING:
+            break;
+
+        case wxGRID_COLUMN_LONG:
+            // As above, the empty cells store 0.
+            return column.longs[row];
+
+        case wxGRID_COLUMN_DOUBLE:
+            return column.doubles[row];
+    }
+
+    return 0.0;
+}
+
+void wxGridColumnarTable::SetValueAsLong( int row, int col, long value )
+{
+    wxCHECK_RET( IsValidCell(row, col),
+                 wxT("invalid row or column index in wxGridColumnarTable") );
+
+    Column& column = m_columns[col];
+    switch ( column.type )
+    {
+        case wxGRID_COLUMN_STRING:
+            column.strings[row] = InternString(wxString::Format("%ld", value));
+            break;
+
+        case wxGRID_COLUMN_LONG:
+            column.longs[row] = value;
+            column.empty[row] = false;
+            break;
+
+        case wxGRID_COLUMN_DOUBLE:
+            column.doubles[row] = value;
+            column.empty[row] = false;
+            break;
+    }
+}
+
+void wxGridColumnarTable::SetValueAsDouble( int row, int col, double value )
+{
+    wxCHECK_RET( IsValidCell(row, col),
+                 wxT("invalid row or column index in wxGridColumnarTable") );
+
+    Column& column = m_columns[col];
+    switch ( column.type )
+    {
+        case wxGRID_COLUMN_STRING:
+            column.strings[row] = InternString(wxString::FromDouble(value));
+            break;
+
+        case wxGRID_COLUMN_LONG:
+            // NaN can't be represented as long, so consider it to be empty.
+            column.longs[row] = GridDoubleToLong(value);
+            column.empty[row] = wxIsNaN(value);
+            break;
+
+        case wxGRID_COLUMN_DOUBLE:
+            column.doubles[row] = value;
+            column.empty[row] = false;
+            break;
+    }
+}
+
+void wxGridColumnarTable::Clear()
+{
+    for ( size_t col = 0; col < m_columns.size(); col++ )
+    {
+        Column& column = m_columns[col];
+        column.strings.clear();
+        column.longs.clear();
+        column.doubles.clear();
+        column.empty.clear();
+        ResizeColumn(column);
+    }
+
+    m_pool.resize(1);
+    m_poolIndices.clear();
+}
+
+bool wxGridColumnarTable::InsertRows( size_t pos, size_t numRows )
+{
+    if ( pos >= m_numRows )
+    {
+        return AppendRows( numRows );
+    }
+
+    for ( size_t col = 0; col < m_columns.size(); col++ )
+    {
+        Column& column = m_columns[col];
+        switch ( column.type )
+        {
+            case wxGRID_COLUMN_STRING:
+                column.strings.insert(column.strings.begin() + pos,
+                                      numRows, 0);
+                break;
+
+            case wxGRID_COLUMN_LONG:
+                column.longs.insert(column.longs.begin() + pos,
+                                    numRows, 0);
+                column.empty.insert(column.empty.begin() + pos,
+                                    numRows, true);
+                break;
+
+            case wxGRID_COLUMN_DOUBLE:
+                column.doubles.insert(column.doubles.begin() + pos,
+                                      numRows, 0.0);
+                column.empty.insert(column.empty.begin() + pos,
+                                    numRows, true);
+                break;
+        }
+    }
+
+    m_numRows += numRows;
+
+    if ( GetView() )
+    {
+        GetView()->ProcessTableMessage( this,
+                                wxGRIDTABLE_NOTIFY_ROWS_INSERTED,
+                                pos,
+                                numRows );
+    }
+
+    return true;
+}
+
+bool wxGridColumnarTable::AppendRows( size_t numRows )
+{
+    m_numRows += numRows;
+
+    for ( size_t col = 0; col < m_columns.size(); col++ )
+    {
+        ResizeColumn(m_columns[col]);
+    }
+
+    if ( GetView() )
+    {
+        GetView()->ProcessTableMessage( this,
+                                wxGRIDTABLE_NOTIFY_ROWS_APPENDED,
+                                numRows );
+    }
+
+    return true;
+}
+
+bool wxGridColumnarTable::DeleteRows( size_t pos, size_t numRows )
+{
+    if ( pos >= m_numRows )
+    {
+        wxFAIL_MSG( wxString::Format
+                    (
+                        wxT("Called wxGridColumnarTable::DeleteRows(pos=%lu, N=%lu)\nPos value is invalid for present table with %lu rows"),
+                        (unsigned long)pos,
+                        (unsigned long)numRows,
+                        (unsigned long)m_numRows
+                    ) );
+
+        return false;
+    }
+
+    if ( numRows > m_numRows - pos )
+    {
+        numRows = m_numRows - pos;
+    }
+
+    for ( size_t col = 0; col < m_columns.size(); col++ )
+    {
+        Column& column = m_columns[col];
+        switch ( column.type )
+        {
+            case wxGRID_COLUMN_STRING:
+                column.strings.erase(column.strings.begin() + pos,
+                                     column.strings.begin() + pos + numRows);
+                break;
+
+            case wxGRID_COLUMN_LONG:
+                column.longs.erase(column.longs.begin() + pos,
+                                   column.longs.begin() + pos + numRows);
+                column.empty.erase(column.empty.begin() + pos,
+                                   column.empty.begin() + pos + numRows);
+                break;
+
+            case wxGRID_COLUMN_DOUBLE:
+                column.doubles.erase(column.doubles.begin() + pos,
+                                     column.doubles.begin() + pos + numRows);
+                column.empty.erase(column.empty.begin() + pos,
+                                   column.empty.begin() + pos + numRows);
+                break;
+        }
+    }
+
+    m_numRows -= numRows;
+
+    if ( GetView() )
+    {
+        GetView()->ProcessTableMessage( this,
+                                wxGRIDTABLE_NOTIFY_ROWS_DELETED,
+                                pos,
+                                numRows );
+    }
+
+    return true;
+}
+
+bool wxGridColumnarTable::InsertCols( size_t pos, size_t numCols )
+{
+    if ( pos >= m_columns.size() )
+    {
+        return AppendCols( numCols );
+    }
+
+    Column column;
+    column.type = wxGRID_COLUMN_STRING;
+    ResizeColumn(column);
+
+    m_columns.insert(m_columns.begin() + pos, numCols, column);
+
+    if ( GetView() )
+    {
+        GetView()->ProcessTableMessage( this,
+                                wxGRIDTABLE_NOTIFY_COLS_INSERTED,
+                                pos,
+                                numCols );
+    }
+
+    return true;
+}
+
+bool wxGridColumnarTable::AppendCols( size_t numCols )
+{
+    Column column;
+    column.type = wxGRID_COLUMN_STRING;
+    ResizeColumn(column);
+
+    m_columns.insert(m_columns.end(), numCols, column);
+
+    if ( GetView() )
+    {
+        GetView()->ProcessTableMessage( this,
+                                wxGRIDTABLE_NOTIFY_COLS_APPENDED,
+                                numCols );
+    }
+
+    return true;
+}
+
+bool wxGridColumnarTable::DeleteCols( size_t pos, size_t numCols )
+{
+    const size_t curNumCols = m_columns.size();
+
+    if ( pos >= curNumCols )
+    {
+        wxFAIL_MSG( wxString::Format
+                    (
+                        wxT("Called wxGridColumnarTable::DeleteCols(pos=%lu, N=%lu)\nPos value is invalid for present table with %lu cols"),
+                        (unsigned long)pos,
+                        (unsigned long)numCols,
+                        (unsigned long)curNumCols
+                    ) );
+        return false;
+    }
+
+    if ( numCols > curNumCols - pos )
+    {
+        numCols = curNumCols - pos;
+    }
+
+    m_columns.erase(m_columns.begin() + pos,
+                    m_columns.begin() + pos + numCols);
+
+    if ( GetView() )
+    {
+        GetView()->ProcessTableMessage( this,
+                                wxGRIDTABLE_NOTIFY_COLS_DELETED,
+                                pos,
+                                numCols );
+    }
+
+    return true;
+}
+
+wxString wxGridColumnarTable::GetColLabelValue( int col )
+{
+    if ( col < 0 || static_cast<size_t>(col) >= m_columns.size() ||
+            m_columns[col].label.empty() )
+    {
+        // using default label
+        //
+        return wxGridTableBase::GetColLabelValue( col );
+    }
+
+    return m_columns[col].label;
+}
+
+void wxGridColumnarTable::SetColLabelValue( int col, const wxString& value )
+{
+    wxCHECK_RET( col >= 0 && static_cast<size_t>(col) < m_columns.size(),
+                 wxT("invalid column index in wxGridColumnarTable") );
+
+    m_columns[col].label = value;
+}
+
+void wxGridColumnarTable::SetCornerLabelValue( const wxString& value )
+{
+    m_cornerLabel = value;
+}
+
+wxString wxGridColumnarTable::GetCornerLabelValue() const
+{
+    return m_cornerLabel;
+}
+
 //////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////
 
@@ -3457,7 +3457,12 @@ public:
         wxListItem item;
         itemData->GetItem(item);
 
-        UpdateWithWidth(m_listmain->GetItemWidthWithImage(&item));
+        // Lines of virtual controls are reused, so identify them by index.
+        const wxUIntPtr key = m_listmain->IsVirtual()
+                                ? static_cast<wxUIntPtr>(row) + 1
+                                : wxPtrToUInt(line);
+
+        UpdateWithWidth(m_listmain->GetItemWidthWithImage(&item), key);
     }
 
 private:
@@ -3503,6 +3508,7 @@ void wxListMainWindow::SetColumnWidth( int col, int width )
             calculator.ComputeBestColumnWidth(GetItemCount(),
                                               first_visible, last_visible);
             pWidthInfo->nMaxWidth = calculator.GetMaxWidth();
+            pWidthInfo->widestKey = calculator.GetWidestKey();
             pWidthInfo->bNeedsUpdate = false;
         }
         else
@@ -3596,12 +3602,7 @@ void wxListMainWindow::SetItem( wxListItem &item )
             //  update the Max Width Cache if needed
             int width = GetItemWidthWithImage(&item);
 
-            wxColWidthInfo* const pWidthInfo = m_aColWidths.Item(item.m_col);
-            if ( width > pWidthInfo->nMaxWidth )
-            {
-                pWidthInfo->nMaxWidth = width;
-                pWidthInfo->bNeedsUpdate = true;
-            }
+            m_aColWidths.Item(item.m_col)->UpdateWithItem(line, width);
         }
     }
 
@@ -4319,23 +4320,21 @@ void wxListMainWindow::DeleteItem( long lindex )
     {
         //  mark the Column Max Width cache as dirty if the items in the line
         //  we're deleting contain the Max Column Width
-        wxListLineData * const line = GetLine(index);
-        wxListItemDataList::compatibility_iterator n;
-        wxListItem      item;
-
-        for (size_t i = 0; i < m_columns.GetCount(); i++)
+        if ( IsVirtual() )
         {
-            n = line->m_items.Item( i );
-            wxListItemData* itemData;
-            itemData = n->GetData();
-            itemData->GetItem(item);
-
-            int itemWidth;
-            itemWidth = GetItemWidthWithImage(&item);
+            for (size_t i = 0; i < m_columns.GetCount(); i++)
+            {
+                m_aColWidths.Item(i)->RemoveVirtualItem(index);
+            }
+        }
+        else
+        {
+            wxListLineData * const line = GetLine(index);
 
-            wxColWidthInfo *pWidthInfo = m_aColWidths.Item(i);
-            if ( itemWidth >= pWidthInfo->nMaxWidth )
-                pWidthInfo->bNeedsUpdate = true;
+            for (size_t i = 0; i < m_columns.GetCount(); i++)
+            {
+                m_aColWidths.Item(i)->RemoveItem(line);
+            }
         }
 
         ResetVisibleLinesRange();
@@ -4608,19 +4607,16 @@ void wxListMainWindow::InsertItem( wxListItem &item )
         const unsigned col = item.GetColumn();
         wxCHECK_RET( col < m_aColWidths.size(), "invalid item column" );
 
-        // calculate the width of the item and adjust the max column width
-        wxColWidthInfo *pWidthInfo = m_aColWidths.Item(col);
-        int width = GetItemWidthWithImage(&item);
-        item.SetWidth(width);
-        if (width > pWidthInfo->nMaxWidth)
-        {
-            pWidthInfo->nMaxWidth = width;
-            pWidthInfo->bNeedsUpdate = true;
-        }
+        // calculate the width of the item, the max column width is adjusted
+        // below, once we have the line
+        item.SetWidth(GetItemWidthWithImage(&item));
     }
 
     wxListLineData *line = new wxListLineData(this);
 
+    if ( InReportView() )
+        m_aColWidths.Item(item.GetColumn())->UpdateWithItem(line, item.GetWidth());
+
     line->SetItem( item.m_col, item );
     if ( item.m_mask & wxLIST_MASK_IMAGE )
     {
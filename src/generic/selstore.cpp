@@ -18,6 +18,9 @@
 
 #include "wx/wxprec.h"
 
+#ifndef WX_PRECOMP
+    #include "wx/utils.h"
+#endif // WX_PRECOMP
 
 #include "wx/selstore.h"
 
@@ -27,159 +30,229 @@
 
 const unsigned wxSelectionStore::NO_SELECTION = static_cast<unsigned>(-1);
 
-// ----------------------------------------------------------------------------
-// tests
-// ----------------------------------------------------------------------------
+namespace
+{
 
-bool wxSelectionStore::IsSelected(unsigned item) const
+// 100 is hardcoded but it shouldn't matter much: the important thing is
+// that we don't refresh everything when really few (e.g. 1 or 2) items
+// change state
+const unsigned MANY_ITEMS = 100;
+
+// Add the items in the given inclusive range to the array of changed items,
+// unless there are too many of them, in which case stop counting them.
+void AddChangedItems(wxArrayInt **itemsChanged, unsigned itemFrom, unsigned itemTo)
 {
-    bool isSel = m_itemsSel.Index(item) != wxNOT_FOUND;
+    if ( !itemsChanged || !*itemsChanged )
+        return;
+
+    wxArrayInt* const items = *itemsChanged;
+    if ( itemTo - itemFrom >= MANY_ITEMS - items->GetCount() )
+    {
+        // stop counting them, we'll just eat gobs of memory for nothing at
+        // all - faster to refresh everything in this case
+        *itemsChanged = NULL;
+        return;
+    }
 
-    // if the default state is to be selected, being in m_itemsSel means that
-    // the item is not selected, so we have to inverse the logic
-    return m_defaultState ? !isSel : isSel;
+    for ( unsigned item = itemFrom; ; item++ )
+    {
+        items->Add(item);
+
+        if ( item == itemTo )
+            break;
+    }
 }
 
+} // anonymous namespace
+
 // ----------------------------------------------------------------------------
-// Select*()
+// ranges helpers
 // ----------------------------------------------------------------------------
 
-bool wxSelectionStore::SelectItem(unsigned item, bool select)
+wxSelectionStore::Ranges::iterator wxSelectionStore::FindRange(unsigned item)
 {
-    // search for the item ourselves as like this we get the index where to
-    // insert it later if needed, so we do only one search in the array instead
-    // of two (adding item to a sorted array requires a search)
-    size_t index = m_itemsSel.IndexForInsert(item);
-    bool isSel = index < m_itemsSel.GetCount() && m_itemsSel[index] == item;
+    Ranges::iterator it = m_ranges.upper_bound(item);
+    if ( it != m_ranges.begin() )
+    {
+        Ranges::iterator prev = it;
+        --prev;
+        if ( prev->second >= item )
+            return prev;
+    }
 
-    if ( select != m_defaultState )
+    return it;
+}
+
+wxSelectionStore::Ranges::const_iterator
+wxSelectionStore::FindRange(unsigned item) const
+{
+    Ranges::const_iterator it = m_ranges.upper_bound(item);
+    if ( it != m_ranges.begin() )
     {
-        if ( !isSel )
-        {
-            m_itemsSel.AddAt(item, index);
+        Ranges::const_iterator prev = it;
+        --prev;
+        if ( prev->second >= item )
+            return prev;
+    }
 
-            return true;
-        }
+    return it;
+}
+
+unsigned wxSelectionStore::AddRange(unsigned itemFrom, unsigned itemTo,
+                                    wxArrayInt **itemsChanged)
+{
+    // NO_SELECTION can't be selected, this also ensures that itemTo + 1
+    // doesn't overflow below.
+    if ( itemTo == NO_SELECTION )
+    {
+        if ( itemFrom == NO_SELECTION )
+            return 0;
+
+        itemTo--;
+    }
+
+    // Find the first range overlapping or adjacent to the new one.
+    Ranges::iterator it = FindRange(itemFrom);
+    if ( itemFrom > 0 && it != m_ranges.begin() )
+    {
+        Ranges::iterator prev = it;
+        --prev;
+        if ( prev->second == itemFrom - 1 )
+            it = prev;
     }
-    else // reset to default state
+
+    unsigned first = itemFrom,
+             last = itemTo,
+             next = itemFrom,
+             added = 0;
+
+    // Merge all the ranges overlapping or adjacent to the new one with it,
+    // the gaps between them are the newly selected items.
+    while ( it != m_ranges.end() && it->first <= itemTo + 1 )
     {
-        if ( isSel )
+        if ( it->first > next )
         {
-            m_itemsSel.RemoveAt(index);
-            return true;
+            added += it->first - next;
+            AddChangedItems(itemsChanged, next, it->first - 1);
         }
+
+        if ( it->second >= next )
+            next = it->second + 1;
+
+        first = wxMin(first, it->first);
+        last = wxMax(last, it->second);
+
+        m_ranges.erase(it++);
+    }
+
+    if ( next <= itemTo )
+    {
+        added += itemTo - next + 1;
+        AddChangedItems(itemsChanged, next, itemTo);
     }
 
-    return false;
+    m_ranges[first] = last;
+    m_selectedCount += added;
+
+    return added;
 }
 
-bool wxSelectionStore::SelectRange(unsigned itemFrom, unsigned itemTo,
-                                   bool select,
-                                   wxArrayInt *itemsChanged)
+unsigned wxSelectionStore::RemoveRange(unsigned itemFrom, unsigned itemTo,
+                                       wxArrayInt **itemsChanged)
 {
-    // 100 is hardcoded but it shouldn't matter much: the important thing is
-    // that we don't refresh everything when really few (e.g. 1 or 2) items
-    // change state
-    static const unsigned MANY_ITEMS = 100;
-
-    wxASSERT_MSG( itemFrom <= itemTo, wxT("should be in order") );
+    unsigned removed = 0;
 
-    // are we going to have more [un]selected items than the other ones?
-    if ( itemTo - itemFrom > m_count/2 )
+    Ranges::iterator it = FindRange(itemFrom);
+    while ( it != m_ranges.end() && it->first <= itemTo )
     {
-        if ( select != m_defaultState )
-        {
-            // the default state now becomes the same as 'select'
-            m_defaultState = select;
+        const unsigned first = it->first,
+                       last = it->second;
 
-            // so all the old selections (which had state select) shouldn't be
-            // selected any more, but all the other ones should
-            wxSelectedIndices selOld = m_itemsSel;
-            m_itemsSel.Empty();
+        const unsigned from = wxMax(first, itemFrom),
+                       to = wxMin(last, itemTo);
+        removed += to - from + 1;
+        AddChangedItems(itemsChanged, from, to);
 
-            // TODO: it should be possible to optimize the searches a bit
-            //       knowing the possible range
+        m_ranges.erase(it++);
 
-            unsigned item;
-            for ( item = 0; item < itemFrom; item++ )
-            {
-                if ( selOld.Index(item) == wxNOT_FOUND )
-                    m_itemsSel.Add(item);
-            }
+        // Keep the parts of this range outside of the removed one.
+        if ( first < itemFrom )
+            m_ranges[first] = itemFrom - 1;
+        if ( last > itemTo )
+            it = m_ranges.insert(it, Ranges::value_type(itemTo + 1, last));
+    }
 
-            for ( item = itemTo + 1; item < m_count; item++ )
-            {
-                if ( selOld.Index(item) == wxNOT_FOUND )
-                    m_itemsSel.Add(item);
-            }
+    m_selectedCount -= removed;
 
-            // many items (> half) changed state
-            itemsChanged = NULL;
-        }
-        else // select == m_defaultState
-        {
-            // get the inclusive range of items between itemFrom and itemTo
-            size_t count = m_itemsSel.GetCount(),
-                   start = m_itemsSel.IndexForInsert(itemFrom),
-                   end = m_itemsSel.IndexForInsert(itemTo);
+    return removed;
+}
 
-            if ( start == count || m_itemsSel[start] < itemFrom )
-            {
-                start++;
-            }
+void wxSelectionStore::ShiftRanges(unsigned item, int delta)
+{
+    Ranges::iterator it = m_ranges.lower_bound(item);
+    if ( it == m_ranges.end() )
+        return;
 
-            if ( end == count || m_itemsSel[end] > itemTo )
-            {
-                end--;
-            }
+    // The keys of the map can't be modified, so we have to reinsert all the
+    // ranges that need to be shifted.
+    Ranges tail(it, m_ranges.end());
+    m_ranges.erase(it, m_ranges.end());
 
-            if ( start <= end )
-            {
-                // delete all of them (from end to avoid changing indices)
-                for ( int i = end; i >= (int)start; i-- )
-                {
-                    if ( itemsChanged )
-                    {
-                        if ( itemsChanged->GetCount() > MANY_ITEMS )
-                        {
-                            // stop counting (see comment below)
-                            itemsChanged = NULL;
-                        }
-                        else
-                        {
-                            itemsChanged->Add(m_itemsSel[i]);
-                        }
-                    }
-
-                    m_itemsSel.RemoveAt(i);
-                }
-            }
-        }
-    }
-    else // "few" items change state
+    for ( it = tail.begin(); it != tail.end(); ++it )
     {
-        if ( itemsChanged )
-        {
-            itemsChanged->Empty();
-        }
+        const unsigned first = it->first + delta,
+                       last = it->second + delta;
 
-        // just add the items to the selection
-        for ( unsigned item = itemFrom; item <= itemTo; item++ )
+        // After deleting items, a range can become adjacent to the previous
+        // one, merge them in this case.
+        if ( !m_ranges.empty() && first > 0 )
         {
-            if ( SelectItem(item, select) && itemsChanged )
+            Ranges::iterator prev = m_ranges.end();
+            --prev;
+            if ( prev->second == first - 1 )
             {
-                itemsChanged->Add(item);
-
-                if ( itemsChanged->GetCount() > MANY_ITEMS )
-                {
-                    // stop counting them, we'll just eat gobs of memory
-                    // for nothing at all - faster to refresh everything in
-                    // this case
-                    itemsChanged = NULL;
-                }
+                prev->second = last;
+                continue;
             }
         }
+
+        m_ranges.insert(m_ranges.end(), Ranges::value_type(first, last));
     }
+}
+
+// ----------------------------------------------------------------------------
+// tests
+// ----------------------------------------------------------------------------
+
+bool wxSelectionStore::IsSelected(unsigned item) const
+{
+    Ranges::const_iterator it = FindRange(item);
+
+    return it != m_ranges.end() && it->first <= item;
+}
+
+// ----------------------------------------------------------------------------
+// Select*()
+// ----------------------------------------------------------------------------
+
+bool wxSelectionStore::SelectItem(unsigned item, bool select)
+{
+    return (select ? AddRange(item, item) : RemoveRange(item, item)) != 0;
+}
+
+bool wxSelectionStore::SelectRange(unsigned itemFrom, unsigned itemTo,
+                                   bool select,
+                                   wxArrayInt *itemsChanged)
+{
+    wxASSERT_MSG( itemFrom <= itemTo, wxT("should be in order") );
+
+    if ( itemsChanged )
+        itemsChanged->Empty();
+
+    if ( select )
+        AddRange(itemFrom, itemTo, &itemsChanged);
+    else
+        RemoveRange(itemFrom, itemTo, &itemsChanged);
 
     // we set it to NULL if there are many items changing state
     return itemsChanged != NULL;
@@ -191,85 +264,38 @@ bool wxSelectionStore::SelectRange(unsigned itemFrom, unsigned itemTo,
 
 void wxSelectionStore::OnItemsInserted(unsigned item, unsigned numItems)
 {
-    const size_t count = m_itemsSel.GetCount();
-
-    size_t idx = m_itemsSel.IndexForInsert(item);
-
-    for ( size_t i = idx; i < count; i++ )
+    // Newly inserted items are never selected, so split the range containing
+    // the insertion point, if any.
+    Ranges::iterator it = FindRange(item);
+    if ( it != m_ranges.end() && it->first < item )
     {
-        m_itemsSel[i] += numItems;
+        const unsigned last = it->second;
+        it->second = item - 1;
+        m_ranges[item] = last;
     }
 
-    if ( m_defaultState )
-    {
-        // All newly inserted items are not selected, so if the default state
-        // is to be selected, we need to manually add them to the deselected
-        // items indices.
-        for ( unsigned n = item; n < item + numItems; n++ )
-        {
-            m_itemsSel.AddAt(n, idx++);
-        }
-    }
+    ShiftRanges(item, numItems);
 
     m_count += numItems;
 }
 
 void wxSelectionStore::OnItemDelete(unsigned item)
 {
-    size_t count = m_itemsSel.GetCount(),
-           i = m_itemsSel.IndexForInsert(item);
-
-    if ( i < count && m_itemsSel[i] == item )
-    {
-        // this item itself was in m_itemsSel, remove it from there
-        m_itemsSel.RemoveAt(i);
-
-        count--;
-    }
-
-    // and adjust the index of all which follow it
-    while ( i < count )
-    {
-        // all following elements must be greater than the one we deleted
-        wxASSERT_MSG( m_itemsSel[i] > item, wxT("logic error") );
-
-        m_itemsSel[i++]--;
-    }
-
-    m_count--;
+    OnItemsDeleted(item, 1);
 }
 
 bool wxSelectionStore::OnItemsDeleted(unsigned item, unsigned numItems)
 {
-    bool anyDeletedInSelItems = false,
-         allDeletedInSelItems = true;
-
-    size_t i = m_itemsSel.IndexForInsert(item);
-
-    const unsigned firstAfterDeleted = item + numItems;
-    while ( i < m_itemsSel.size() )
-    {
-        if ( m_itemsSel[i] < firstAfterDeleted )
-        {
-            // This item is going to be deleted, so remove it from the
-            // selected indices entirely. Notice that we do not update i here
-            // as it now refers to the next element.
-            m_itemsSel.RemoveAt(i);
+    if ( !numItems )
+        return false;
 
-            anyDeletedInSelItems = true;
-        }
-        else
-        {
-            // This item remains, just update its index.
-            m_itemsSel[i++] -= numItems;
+    const bool anyDeletedSelected = RemoveRange(item, item + numItems - 1) != 0;
 
-            allDeletedInSelItems = false;
-        }
-    }
+    ShiftRanges(item + numItems, -static_cast<int>(numItems));
 
     m_count -= numItems;
 
-    return m_defaultState ? allDeletedInSelItems : anyDeletedInSelItems;
+    return anyDeletedSelected;
 }
 
 
@@ -278,13 +304,7 @@ void wxSelectionStore::SetItemCount(unsigned count)
     // forget about all items whose indices are now invalid if the size
     // decreased
     if ( count < m_count )
-    {
-        for ( size_t i = m_itemsSel.GetCount(); i > 0; i-- )
-        {
-            if ( m_itemsSel[i - 1] >= count )
-                m_itemsSel.RemoveAt(i - 1);
-        }
-    }
+        RemoveRange(count, NO_SELECTION);
 
     // remember the new number of items
     m_count = count;
@@ -303,28 +323,18 @@ unsigned wxSelectionStore::GetFirstSelectedItem(IterationState& cookie) const
 
 unsigned wxSelectionStore::GetNextSelectedItem(IterationState& cookie) const
 {
-    if ( m_defaultState )
-    {
-        // We have no choice but to iterate over all items in this case. It
-        // shouldn't be that bad in practice because (almost) all items are
-        // supposed to be selected if m_defaultState == true anyhow.
-        for ( unsigned item = cookie; ; item++ )
-        {
-            if ( item >= m_count )
-                return NO_SELECTION;
+    // The cookie is the first item which hasn't been checked yet.
+    if ( cookie >= NO_SELECTION )
+        return NO_SELECTION;
 
-            if ( IsSelected(item) )
-            {
-                cookie = item + 1;
-                return item;
-            }
-        }
-    }
-    else // Simple case when we directly have the selected items.
-    {
-        if ( cookie >= m_itemsSel.size() )
-            return NO_SELECTION;
+    const unsigned next = static_cast<unsigned>(cookie);
 
-        return m_itemsSel[cookie++];
-    }
+    Ranges::const_iterator it = FindRange(next);
+    if ( it == m_ranges.end() )
+        return NO_SELECTION;
+
+    const unsigned item = wxMax(it->first, next);
+    cookie = static_cast<IterationState>(item) + 1;
+
+    return item;
 }
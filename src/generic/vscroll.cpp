@@ -28,6 +28,9 @@
 
 #include "wx/utils.h"   // For wxMin/wxMax().
 
+#include <limits>
+#include <vector>
+
 // ============================================================================
 // wxVarScrollHelperEvtHandler declaration
 // ============================================================================
@@ -53,6 +56,130 @@ private:
     wxDECLARE_NO_COPY_CLASS(wxVarScrollHelperEvtHandler);
 };
 
+// ============================================================================
+// wxVarScrollSizeIndex declaration
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// wxVarScrollSizeIndex: Fenwick tree of the units sizes, allowing to find the
+// total size of the units before the given one, the unit at the given position
+// and to update the size of a single unit in O(log(N)) time.
+//
+// The sizes are summed up using 64 bit integers as the total size of many
+// units may not fit into wxCoord.
+// ----------------------------------------------------------------------------
+
+class wxVarScrollSizeIndex
+{
+public:
+    wxVarScrollSizeIndex() : m_tree(1, 0) { }
+
+    // Reinitialize the index for the given number of units: SetInitialSize()
+    // must be called for all of them and then FinishInit() must be called.
+    void StartInit(size_t count)
+    {
+        m_tree.assign(count + 1, 0);
+    }
+
+    void SetInitialSize(size_t unit, wxCoord size)
+    {
+        m_tree[unit + 1] = size;
+    }
+
+    void FinishInit()
+    {
+        // Build the tree from the sizes stored in its leaves in linear time.
+        const size_t count = GetCount();
+        for ( size_t n = 1; n <= count; n++ )
+        {
+            const size_t parent = n + LowestBit(n);
+            if ( parent <= count )
+                m_tree[parent] += m_tree[n];
+        }
+    }
+
+    size_t GetCount() const { return m_tree.size() - 1; }
+
+    // Return the total size of the first count units.
+    wxInt64 GetSizeBefore(size_t count) const
+    {
+        wxInt64 size = 0;
+        for ( size_t n = count; n; n -= LowestBit(n) )
+            size += m_tree[n];
+
+        return size;
+    }
+
+    wxInt64 GetTotalSize() const { return GetSizeBefore(GetCount()); }
+
+    wxCoord GetSize(size_t unit) const
+    {
+        return static_cast<wxCoord>(GetSizeBefore(unit + 1) -
+                                    GetSizeBefore(unit));
+    }
+
+    void ChangeSize(size_t unit, wxCoord delta)
+    {
+        const size_t count = GetCount();
+        for ( size_t n = unit + 1; n <= count; n += LowestBit(n) )
+            m_tree[n] += delta;
+    }
+
+    // Return the unit containing the given position or GetCount() if it is
+    // beyond the last unit.
+    size_t FindUnitAt(wxInt64 pos) const
+    {
+        const size_t count = GetCount();
+
+        size_t step = 1;
+        while ( step <= count / 2 )
+            step *= 2;
+
+        // Find the biggest number of units whose total size is not greater
+        // than pos, the index of the next unit is the same number.
+        size_t unit = 0;
+        for ( ; step; step /= 2 )
+        {
+            const size_t next = unit + step;
+            if ( next <= count && m_tree[next] <= pos )
+            {
+                unit = next;
+                pos -= m_tree[next];
+            }
+        }
+
+        return unit;
+    }
+
+private:
+    static size_t LowestBit(size_t n) { return n & (~n + 1); }
+
+    // The element n of this vector contains the total size of the units in
+    // (n - LowestBit(n), n] range, using 1-based units indices, and the
+    // element 0 is unused.
+    std::vector<wxInt64> m_tree;
+};
+
+// Return the given size clamped to the range of wxCoord.
+static wxCoord ClampToCoord(wxInt64 size)
+{
+    if ( size > std::numeric_limits<wxCoord>::max() )
+        return std::numeric_limits<wxCoord>::max();
+
+    if ( size < std::numeric_limits<wxCoord>::min() )
+        return std::numeric_limits<wxCoord>::min();
+
+    return static_cast<wxCoord>(size);
+}
+
+// Return true if the scrollbar position and range are expressed in pixels,
+// which is only possible if we know the total size and it fits into int.
+static bool UsePixelScrollbar(const wxVarScrollSizeIndex* sizeIndex)
+{
+    return sizeIndex &&
+            sizeIndex->GetTotalSize() <= std::numeric_limits<int>::max();
+}
+
 // ============================================================================
 // wxVarScrollHelperEvtHandler implementation
 // ============================================================================
@@ -193,6 +320,7 @@ wxVarScrollHelperBase::wxVarScrollHelperBase(wxWindow *win)
 
     m_physicalScrolling = true;
     m_handler = NULL;
+    m_sizeIndex = NULL;
 
     // by default, the associated window is also the target window
     DoSetTargetWindow(win);
@@ -201,6 +329,8 @@ wxVarScrollHelperBase::wxVarScrollHelperBase(wxWindow *win)
 wxVarScrollHelperBase::~wxVarScrollHelperBase()
 {
     DeleteEvtHandler();
+
+    delete m_sizeIndex;
 }
 
 // ----------------------------------------------------------------------------
@@ -275,6 +405,12 @@ wxCoord wxVarScrollHelperBase::GetUnitsSize(size_t unitMin, size_t unitMax) cons
         return -GetUnitsSize(unitMax, unitMin);
     //else: unitMin < unitMax
 
+    if ( m_sizeIndex )
+    {
+        return ClampToCoord(m_sizeIndex->GetSizeBefore(unitMax) -
+                                m_sizeIndex->GetSizeBefore(unitMin));
+    }
+
     // let the user code know that we're going to need all these units
     OnGetUnitsSizeHint(unitMin, unitMax);
 
@@ -288,6 +424,60 @@ wxCoord wxVarScrollHelperBase::GetUnitsSize(size_t unitMin, size_t unitMax) cons
     return size;
 }
 
+void wxVarScrollHelperBase::EnableUnitsSizeIndex(bool enable)
+{
+    if ( enable == (m_sizeIndex != NULL) )
+        return;
+
+    if ( enable )
+    {
+        m_sizeIndex = new wxVarScrollSizeIndex;
+        BuildSizeIndex();
+    }
+    else
+    {
+        wxDELETE(m_sizeIndex);
+        m_sizeTotal = EstimateTotalSize();
+    }
+
+    // the scrollbar uses different units depending on whether we have the
+    // index or not
+    if ( m_unitMax )
+        UpdateScrollbar();
+}
+
+void wxVarScrollHelperBase::BuildSizeIndex()
+{
+    m_sizeIndex->StartInit(m_unitMax);
+
+    if ( m_unitMax )
+    {
+        OnGetUnitsSizeHint(0, m_unitMax);
+
+        for ( size_t unit = 0; unit < m_unitMax; ++unit )
+            m_sizeIndex->SetInitialSize(unit, OnGetUnitSize(unit));
+    }
+
+    m_sizeIndex->FinishInit();
+
+    m_sizeTotal = ClampToCoord(m_sizeIndex->GetTotalSize());
+}
+
+bool wxVarScrollHelperBase::UpdateIndexedUnitSize(size_t unit)
+{
+    if ( unit >= m_unitMax )
+        return false;
+
+    const wxCoord delta = OnGetUnitSize(unit) - m_sizeIndex->GetSize(unit);
+    if ( !delta )
+        return false;
+
+    m_sizeIndex->ChangeSize(unit, delta);
+    m_sizeTotal = ClampToCoord(m_sizeIndex->GetTotalSize());
+
+    return true;
+}
+
 size_t wxVarScrollHelperBase::FindFirstVisibleFromLast(size_t unitLast, bool full) const
 {
     const wxCoord sWindow = GetOrientationTargetSize();
@@ -356,12 +546,14 @@ size_t wxVarScrollHelperBase::GetNewScrollPosition(wxScrollWinEvent& event) cons
         else
             return wxMax(GetVisibleEnd(), m_unitFirst + 1);
     }
-    else if ( evtType == wxEVT_SCROLLWIN_THUMBRELEASE )
-    {
-        return event.GetPosition();
-    }
-    else if ( evtType == wxEVT_SCROLLWIN_THUMBTRACK )
+    else if ( evtType == wxEVT_SCROLLWIN_THUMBRELEASE ||
+              evtType == wxEVT_SCROLLWIN_THUMBTRACK )
     {
+        // when using the index, scrollbar position may be in pixels, see
+        // UpdateScrollbar()
+        if ( UsePixelScrollbar(m_sizeIndex) )
+            return m_sizeIndex->FindUnitAt(event.GetPosition());
+
         return event.GetPosition();
     }
 
@@ -395,6 +587,16 @@ void wxVarScrollHelperBase::UpdateScrollbar()
 
     m_nUnitsVisible = unit - m_unitFirst;
 
+    if ( UsePixelScrollbar(m_sizeIndex) )
+    {
+        // we know the exact sizes of all units, so we can make the scrollbar
+        // thumb position and size correspond to the real scroll position and
+        // the visible part of the window, instead of using the units for it
+        m_win->SetScrollbar(GetOrientation(),
+                            GetScrollOffset(), sWindow, m_sizeTotal);
+        return;
+    }
+
     int unitsPageSize = m_nUnitsVisible;
     if ( s > sWindow )
     {
@@ -470,8 +672,11 @@ void wxVarScrollHelperBase::SetUnitCount(size_t count)
     // save the number of units
     m_unitMax = count;
 
-    // and our estimate for their total height
-    m_sizeTotal = EstimateTotalSize();
+    // and their total height, either exact or estimated
+    if ( m_sizeIndex )
+        BuildSizeIndex();
+    else
+        m_sizeTotal = EstimateTotalSize();
 
     // ScrollToUnit() will update the scrollbar itself if it changes the unit
     // we pass to it because it's out of [new] range
@@ -487,6 +692,12 @@ void wxVarScrollHelperBase::SetUnitCount(size_t count)
 
 void wxVarScrollHelperBase::RefreshUnit(size_t unit)
 {
+    // the size of the unit could have changed, which must be taken into
+    // account even if it's not visible
+    const bool sizeChanged = m_sizeIndex && UpdateIndexedUnitSize(unit);
+    if ( sizeChanged )
+        UpdateScrollbar();
+
     // is this unit visible?
     if ( !IsVisible(unit) )
     {
@@ -504,6 +715,16 @@ void wxVarScrollHelperBase::RefreshUnit(size_t unit)
         IncOrient(rect.x, rect.y, OnGetUnitSize(n));
     }
 
+    if ( sizeChanged )
+    {
+        // all the subsequent units have moved, so refresh them as well
+        wxCoord x, y;
+        AssignOrient(x, y, GetNonOrientationTargetSize(),
+                     GetOrientationTargetSize());
+        rect.SetRight(x);
+        rect.SetBottom(y);
+    }
+
     // do refresh it
     m_targetWindow->RefreshRect(rect);
 }
@@ -512,6 +733,25 @@ void wxVarScrollHelperBase::RefreshUnits(size_t from, size_t to)
 {
     wxASSERT_MSG( from <= to, wxT("RefreshUnits(): empty range") );
 
+    if ( m_sizeIndex )
+    {
+        bool sizeChanged = false;
+        for ( size_t unit = from; unit <= to; ++unit )
+        {
+            if ( UpdateIndexedUnitSize(unit) )
+                sizeChanged = true;
+        }
+
+        if ( sizeChanged )
+        {
+            UpdateScrollbar();
+
+            // all the units after the changed ones need to be refreshed too
+            if ( GetVisibleEnd() > to + 1 )
+                to = GetVisibleEnd() - 1;
+        }
+    }
+
     // clump the range to just the visible units -- it is useless to refresh
     // the other ones
     if ( from < GetVisibleBegin() )
@@ -548,6 +788,9 @@ void wxVarScrollHelperBase::RefreshUnits(size_t from, size_t to)
 
 void wxVarScrollHelperBase::RefreshAll()
 {
+    if ( m_sizeIndex )
+        BuildSizeIndex();
+
     UpdateScrollbar();
 
     m_targetWindow->Refresh();
@@ -23,9 +23,15 @@
 
 #include "wx/html/htmlcell.h"
 #include "wx/html/htmlwin.h"
+#include "wx/hashmap.h"
 
 #include <stdlib.h>
 
+#include <algorithm>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
 //-----------------------------------------------------------------------------
 // Helper classes
 //-----------------------------------------------------------------------------
@@ -308,17 +314,281 @@ wxString wxHtmlCell::Dump(int indent) const
     return s;
 }
 
+//-----------------------------------------------------------------------------
+// wxHtmlTextExtentCache
+//-----------------------------------------------------------------------------
+
+namespace
+{
+
+// The maximal number of fonts for which the extents are cached, the least
+// recently used font is forgotten when it is exceeded.
+const size_t wxHTML_MAX_CACHED_FONTS = 64;
+
+} // anonymous namespace
+
+class wxHtmlTextExtentCacheImpl
+{
+public:
+    struct Extent
+    {
+        wxCoord width,
+                height,
+                descent;
+    };
+
+    // The extents of the strings in a single font.
+    class FontCache
+    {
+    public:
+        FontCache() : lastUsed(0) { }
+
+        // Return the cached extent or NULL, the entry found becomes the most
+        // recently used one.
+        const Extent *Find(const wxString& text)
+        {
+            const Index::iterator it = m_index.find(text);
+            if ( it == m_index.end() )
+                return NULL;
+
+            m_lru.splice(m_lru.begin(), m_lru, it->second.pos);
+            return &it->second.extent;
+        }
+
+        void Add(const wxString& text, const Extent& extent, size_t maxEntries)
+        {
+            const Index::iterator it = m_index.insert(
+                std::make_pair(text, Entry())).first;
+            it->second.extent = extent;
+
+            m_lru.push_front(&it->first);
+            it->second.pos = m_lru.begin();
+
+            if ( m_index.size() > maxEntries )
+            {
+                m_index.erase(m_index.find(*m_lru.back()));
+                m_lru.pop_back();
+            }
+        }
+
+        // We keep a copy of the font to ensure that its ref data, used as the
+        // key in the fonts map, is not reused by another font.
+        wxFont font;
+
+        // The value of the usage counter when this font was used last time.
+        size_t lastUsed;
+
+    private:
+        // The strings in the most recently used order, pointing to the keys
+        // of m_index which are never invalidated.
+        typedef std::list<const wxString*> LRUList;
+
+        struct Entry
+        {
+            Extent extent;
+            LRUList::iterator pos;
+        };
+
+        typedef std::unordered_map<wxString, Entry,
+                                   wxStringHash, wxStringEqual> Index;
+
+        Index m_index;
+        LRUList m_lru;
+    };
+
+    explicit wxHtmlTextExtentCacheImpl(size_t maxPerFont)
+        : m_maxPerFont(maxPerFont)
+    {
+        m_usage = 0;
+        m_lastKey = NULL;
+        m_lastCache = NULL;
+
+        m_dcClass = NULL;
+        m_dcContentScale =
+        m_dcUserScaleX = m_dcUserScaleY =
+        m_dcLogicalScaleX = m_dcLogicalScaleY = 0.0;
+        m_dcMapMode = wxMM_TEXT;
+    }
+
+    // Return true if the cached extents can't be used with this DC.
+    bool UpdateDC(const wxDC& dc)
+    {
+        const wxClassInfo* const dcClass = dc.GetClassInfo();
+        const wxSize dcPPI = dc.GetPPI();
+        const double dcContentScale = dc.GetContentScaleFactor();
+        double dcUserScaleX, dcUserScaleY,
+               dcLogicalScaleX, dcLogicalScaleY;
+        dc.GetUserScale(&dcUserScaleX, &dcUserScaleY);
+        dc.GetLogicalScale(&dcLogicalScaleX, &dcLogicalScaleY);
+        const wxMappingMode dcMapMode = dc.GetMapMode();
+
+        if ( dcClass == m_dcClass &&
+                dcPPI == m_dcPPI &&
+                    dcContentScale == m_dcContentScale &&
+                        dcUserScaleX == m_dcUserScaleX &&
+                            dcUserScaleY == m_dcUserScaleY &&
+                                dcLogicalScaleX == m_dcLogicalScaleX &&
+                                    dcLogicalScaleY == m_dcLogicalScaleY &&
+                                        dcMapMode == m_dcMapMode )
+            return false;
+
+        m_dcClass = dcClass;
+        m_dcPPI = dcPPI;
+        m_dcContentScale = dcContentScale;
+        m_dcUserScaleX = dcUserScaleX;
+        m_dcUserScaleY = dcUserScaleY;
+        m_dcLogicalScaleX = dcLogicalScaleX;
+        m_dcLogicalScaleY = dcLogicalScaleY;
+        m_dcMapMode = dcMapMode;
+
+        return true;
+    }
+
+    FontCache& GetFontCache(const wxFont& font)
+    {
+        const wxObjectRefData* const key = font.GetRefData();
+
+        // Consecutive words typically use the same font, so check for this
+        // first to avoid the hash map lookup.
+        if ( !m_lastCache || key != m_lastKey )
+        {
+            const Fonts::iterator it = m_fonts.find(key);
+            if ( it != m_fonts.end() )
+            {
+                m_lastCache = &it->second;
+            }
+            else
+            {
+                if ( m_fonts.size() >= wxHTML_MAX_CACHED_FONTS )
+                    ForgetLeastRecentlyUsedFont();
+
+                m_lastCache = &m_fonts[key];
+                m_lastCache->font = font;
+            }
+
+            m_lastKey = key;
+        }
+
+        m_lastCache->lastUsed = ++m_usage;
+
+        return *m_lastCache;
+    }
+
+    size_t GetMaxPerFont() const { return m_maxPerFont; }
+
+    void Clear()
+    {
+        m_fonts.clear();
+        m_lastKey = NULL;
+        m_lastCache = NULL;
+    }
+
+private:
+    void ForgetLeastRecentlyUsedFont()
+    {
+        Fonts::iterator itOldest = m_fonts.begin();
+        for ( Fonts::iterator it = m_fonts.begin(); it != m_fonts.end(); ++it )
+        {
+            if ( it->second.lastUsed < itOldest->second.lastUsed )
+                itOldest = it;
+        }
+
+        m_fonts.erase(itOldest);
+        m_lastKey = NULL;
+        m_lastCache = NULL;
+    }
+
+    typedef std::unordered_map<const wxObjectRefData*, FontCache> Fonts;
+
+    const size_t m_maxPerFont;
+
+    Fonts m_fonts;
+
+    // Incremented every time a font is used.
+    size_t m_usage;
+
+    // The font used last time, if m_lastCache is not NULL.
+    const wxObjectRefData* m_lastKey;
+    FontCache* m_lastCache;
+
+    // The properties of the DC last passed to UpdateDC().
+    const wxClassInfo* m_dcClass;
+    wxSize m_dcPPI;
+    double m_dcContentScale,
+           m_dcUserScaleX, m_dcUserScaleY,
+           m_dcLogicalScaleX, m_dcLogicalScaleY;
+    wxMappingMode m_dcMapMode;
+};
+
+wxHtmlTextExtentCache::wxHtmlTextExtentCache(size_t maxPerFont)
+{
+    m_impl = new wxHtmlTextExtentCacheImpl(maxPerFont);
+    m_hits =
+    m_misses = 0;
+}
+
+wxHtmlTextExtentCache::~wxHtmlTextExtentCache()
+{
+    delete m_impl;
+}
+
+void wxHtmlTextExtentCache::UseDC(const wxDC& dc)
+{
+    if ( m_impl->UpdateDC(dc) )
+        m_impl->Clear();
+}
+
+void wxHtmlTextExtentCache::GetTextExtent(const wxDC& dc,
+                                          const wxString& text,
+                                          wxCoord *width,
+                                          wxCoord *height,
+                                          wxCoord *descent)
+{
+    wxHtmlTextExtentCacheImpl::FontCache&
+        fontCache = m_impl->GetFontCache(dc.GetFont());
+
+    wxHtmlTextExtentCacheImpl::Extent extent;
+    if ( const wxHtmlTextExtentCacheImpl::Extent* const
+            cached = fontCache.Find(text) )
+    {
+        m_hits++;
+        extent = *cached;
+    }
+    else
+    {
+        m_misses++;
+        dc.GetTextExtent(text, &extent.width, &extent.height, &extent.descent);
+        fontCache.Add(text, extent, m_impl->GetMaxPerFont());
+    }
+
+    if ( width )
+        *width = extent.width;
+    if ( height )
+        *height = extent.height;
+    if ( descent )
+        *descent = extent.descent;
+}
+
+void wxHtmlTextExtentCache::Clear()
+{
+    m_impl->Clear();
+}
+
 //-----------------------------------------------------------------------------
 // wxHtmlWordCell
 //-----------------------------------------------------------------------------
 
 wxIMPLEMENT_ABSTRACT_CLASS(wxHtmlWordCell, wxHtmlCell);
 
-wxHtmlWordCell::wxHtmlWordCell(const wxString& word, const wxDC& dc) : wxHtmlCell()
+wxHtmlWordCell::wxHtmlWordCell(const wxString& word, const wxDC& dc,
+                               wxHtmlTextExtentCache *cache) : wxHtmlCell()
     , m_Word(word)
 {
     wxCoord w, h, d;
-    dc.GetTextExtent(m_Word, &w, &h, &d);
+    if ( cache )
+        cache->GetTextExtent(dc, m_Word, &w, &h, &d);
+    else
+        dc.GetTextExtent(m_Word, &w, &h, &d);
     m_Width = w;
     m_Height = h;
     m_Descent = d;
@@ -660,6 +930,293 @@ wxString wxHtmlWordCell::GetDescription() const
 }
 
 
+//-----------------------------------------------------------------------------
+// wxHtmlStateChange
+//-----------------------------------------------------------------------------
+
+// Cumulative effect of calling DrawInvisible() on a sequence of cells, i.e. the
+// last cell changing the font, the foreground and the background colours.
+class wxHtmlStateChange
+{
+public:
+    wxHtmlStateChange()
+    {
+        m_font = m_fg = m_bgSolid = m_bgTransparent = NULL;
+        m_transparentLast = false;
+    }
+
+    // Account for the effect of the given cell following all the cells
+    // already added. Returns false if this effect can't be represented, i.e.
+    // DrawInvisible() must really be called for this cell.
+    bool Add(wxHtmlCell *cell);
+
+    // Account for the effect of a sequence of cells following this one.
+    void Add(const wxHtmlStateChange& next);
+
+    // Reproduce the effect of all the cells which haven't been already
+    // accounted for by "done", which must correspond to a prefix of the cells
+    // represented by this object.
+    void Apply(wxDC& dc, wxHtmlRenderingInfo& info,
+               const wxHtmlStateChange& done = wxHtmlStateChange()) const;
+
+private:
+    static void ApplyCell(wxHtmlCell *cell, const wxHtmlCell *cellDone,
+                          wxDC& dc, wxHtmlRenderingInfo& info)
+    {
+        if ( cell && cell != cellDone )
+            cell->DrawInvisible(dc, 0, 0, info);
+    }
+
+    wxHtmlCell *m_font,
+               *m_fg,
+               *m_bgSolid,
+               *m_bgTransparent;
+
+    // true if m_bgTransparent comes after m_bgSolid
+    bool m_transparentLast;
+};
+
+//-----------------------------------------------------------------------------
+// wxHtmlContainerIndex
+//-----------------------------------------------------------------------------
+
+// Index of the children of a container, allowing to quickly find the ones
+// overlapping the given vertical range and to skip all the others.
+class wxHtmlContainerIndex
+{
+public:
+    // Cells are grouped in chunks of this size, and only the containers with
+    // at least twice as many children have any chunks at all.
+    enum { CHUNK_SIZE = 16 };
+
+    struct Chunk
+    {
+        // first cell of this chunk
+        wxHtmlCell *first;
+
+        // bottom-most coordinate of all the cells before this chunk
+        int bottomBefore;
+
+        // top-most coordinate of this and all the following cells
+        int topAfter;
+
+        // effect of all the cells before this chunk on the rendering state
+        wxHtmlStateChange stateBefore;
+
+        // true if there are cells whose effect can't be represented by
+        // wxHtmlStateChange before this chunk or in this or following ones
+        bool needsDrawBefore,
+             needsDrawAfter;
+    };
+
+    explicit wxHtmlContainerIndex(wxHtmlContainerCell *cont);
+
+    // Return the first chunk which may contain cells overlapping the given
+    // coordinate (or below it). If withState is true, all the previous cells
+    // must be representable by wxHtmlStateChange too.
+    size_t FindStart(int y, bool withState) const;
+
+    // Return the first chunk after start containing only the cells below the
+    // given coordinate or the number of chunks if there is no such chunk.
+    size_t FindEnd(size_t start, int y, bool withState) const;
+
+
+    // effect of all the children on the rendering state
+    wxHtmlStateChange m_state;
+
+    // true if m_state doesn't represent the effect of all the children
+    bool m_needsDraw;
+
+    std::vector<Chunk> m_chunks;
+};
+
+bool wxHtmlStateChange::Add(wxHtmlCell *cell)
+{
+    // Only handle the standard cells and not any classes deriving from them,
+    // as they could override DrawInvisible() to do something else.
+    const wxClassInfo * const info = cell->GetClassInfo();
+    if ( info == wxCLASSINFO(wxHtmlFontCell) )
+    {
+        m_font = cell;
+        return true;
+    }
+
+    if ( info == wxCLASSINFO(wxHtmlColourCell) )
+    {
+        switch ( static_cast<wxHtmlColourCell *>(cell)->m_Flags )
+        {
+            case wxHTML_CLR_FOREGROUND:
+                m_fg = cell;
+                return true;
+
+            case wxHTML_CLR_BACKGROUND:
+                m_bgSolid = cell;
+                m_transparentLast = false;
+                return true;
+
+            case wxHTML_CLR_TRANSPARENT_BACKGROUND:
+                m_bgTransparent = cell;
+                m_transparentLast = true;
+                return true;
+        }
+
+        return false;
+    }
+
+    wxHtmlContainerCell * const cont = wxDynamicCast(cell, wxHtmlContainerCell);
+    if ( cont )
+    {
+        if ( cont->m_index )
+        {
+            if ( cont->m_index->m_needsDraw )
+                return false;
+
+            Add(cont->m_index->m_state);
+            return true;
+        }
+
+        // This container is not laid out by wxHtmlContainerCell::Layout()
+        // (e.g. it's a table), so it doesn't have any index of its own.
+        for ( wxHtmlCell *c = cont->GetFirstChild(); c; c = c->GetNext() )
+        {
+            if ( !Add(c) )
+                return false;
+        }
+
+        return true;
+    }
+
+    return !cell->NeedsDrawInvisible();
+}
+
+void wxHtmlStateChange::Add(const wxHtmlStateChange& next)
+{
+    if ( next.m_font )
+        m_font = next.m_font;
+    if ( next.m_fg )
+        m_fg = next.m_fg;
+    if ( next.m_bgSolid )
+        m_bgSolid = next.m_bgSolid;
+    if ( next.m_bgTransparent )
+        m_bgTransparent = next.m_bgTransparent;
+    if ( next.m_bgSolid || next.m_bgTransparent )
+        m_transparentLast = next.m_transparentLast;
+}
+
+void wxHtmlStateChange::Apply(wxDC& dc, wxHtmlRenderingInfo& info,
+                              const wxHtmlStateChange& done) const
+{
+    ApplyCell(m_font, done.m_font, dc, info);
+    ApplyCell(m_fg, done.m_fg, dc, info);
+
+    // Both background cells may need to be applied, as only the solid one
+    // changes the DC background, but they must be applied in the right order.
+    if ( m_transparentLast )
+    {
+        ApplyCell(m_bgSolid, done.m_bgSolid, dc, info);
+        ApplyCell(m_bgTransparent, done.m_bgTransparent, dc, info);
+    }
+    else
+    {
+        ApplyCell(m_bgTransparent, done.m_bgTransparent, dc, info);
+        ApplyCell(m_bgSolid, done.m_bgSolid, dc, info);
+    }
+}
+
+wxHtmlContainerIndex::wxHtmlContainerIndex(wxHtmlContainerCell *cont)
+{
+    m_needsDraw = false;
+
+    size_t count = 0;
+    for ( wxHtmlCell *cell = cont->GetFirstChild(); cell; cell = cell->GetNext() )
+        count++;
+
+    const bool withChunks = count >= 2*CHUNK_SIZE;
+    if ( withChunks )
+        m_chunks.reserve((count + CHUNK_SIZE - 1) / CHUNK_SIZE);
+
+    // Fill in the chunks with the data about the preceding cells and store
+    // the data about the cells of the chunk itself in its "after" fields
+    // before accumulating them in the second loop below.
+    int bottom = INT_MIN;
+    size_t n = 0;
+    for ( wxHtmlCell *cell = cont->GetFirstChild(); cell; cell = cell->GetNext(), n++ )
+    {
+        if ( withChunks && n % CHUNK_SIZE == 0 )
+        {
+            Chunk chunk;
+            chunk.first = cell;
+            chunk.bottomBefore = bottom;
+            chunk.topAfter = INT_MAX;
+            chunk.stateBefore = m_state;
+            chunk.needsDrawBefore = m_needsDraw;
+            chunk.needsDrawAfter = false;
+            m_chunks.push_back(chunk);
+        }
+
+        const int top = cell->GetPosY();
+        bottom = wxMax(bottom, top + cell->GetHeight());
+
+        const bool representable = m_state.Add(cell);
+        if ( !representable )
+            m_needsDraw = true;
+
+        if ( withChunks )
+        {
+            Chunk& chunk = m_chunks.back();
+            chunk.topAfter = wxMin(chunk.topAfter, top);
+            if ( !representable )
+                chunk.needsDrawAfter = true;
+        }
+    }
+
+    for ( size_t i = m_chunks.size(); i > 1; i-- )
+    {
+        const Chunk& next = m_chunks[i - 1];
+        Chunk& chunk = m_chunks[i - 2];
+        chunk.topAfter = wxMin(chunk.topAfter, next.topAfter);
+        if ( next.needsDrawAfter )
+            chunk.needsDrawAfter = true;
+    }
+}
+
+size_t wxHtmlContainerIndex::FindStart(int y, bool withState) const
+{
+    // Both bottomBefore and needsDrawBefore are non-decreasing, so the chunks
+    // which can be skipped entirely form a prefix of the chunks vector, and
+    // we need the last element of this prefix (the first chunk can always be
+    // used, as bottomBefore is INT_MIN for it).
+    const std::vector<Chunk>::const_iterator it = std::partition_point
+        (
+            m_chunks.begin() + 1, m_chunks.end(),
+            [y, withState](const Chunk& chunk)
+            {
+                return chunk.bottomBefore <= y &&
+                        !(withState && chunk.needsDrawBefore);
+            }
+        );
+
+    return it - m_chunks.begin() - 1;
+}
+
+size_t wxHtmlContainerIndex::FindEnd(size_t start, int y, bool withState) const
+{
+    // Similarly, topAfter is non-decreasing and needsDrawAfter is
+    // non-increasing, so we need the first chunk of the suffix satisfying the
+    // condition.
+    const std::vector<Chunk>::const_iterator it = std::partition_point
+        (
+            m_chunks.begin() + start, m_chunks.end(),
+            [y, withState](const Chunk& chunk)
+            {
+                return chunk.topAfter <= y ||
+                        (withState && chunk.needsDrawAfter);
+            }
+        );
+
+    return it - m_chunks.begin();
+}
+
 //-----------------------------------------------------------------------------
 // wxHtmlContainerCell
 //-----------------------------------------------------------------------------
@@ -680,10 +1237,13 @@ wxHtmlContainerCell::wxHtmlContainerCell(wxHtmlContainerCell *parent) : wxHtmlCe
     m_MinHeight = 0;
     m_MinHeightAlign = wxHTML_ALIGN_TOP;
     m_LastLayout = -1;
+    m_index = NULL;
 }
 
 wxHtmlContainerCell::~wxHtmlContainerCell()
 {
+    delete m_index;
+
     wxHtmlCell *cell = m_Cells;
     while ( cell )
     {
@@ -1006,6 +1566,10 @@ void wxHtmlContainerCell::Layout(int w)
     if (curLineWidth > m_MaxTotalWidth)
         m_MaxTotalWidth = curLineWidth;
 
+    // index the final positions of the cells to speed up drawing them:
+    delete m_index;
+    m_index = new wxHtmlContainerIndex(this);
+
     m_MaxTotalWidth += s_indent + ((m_IndentRight < 0) ? (-m_IndentRight * m_Width / 100) : m_IndentRight);
     MaxLineWidth += s_indent + ((m_IndentRight < 0) ? (-m_IndentRight * m_Width / 100) : m_IndentRight);
     if (m_Width < MaxLineWidth) m_Width = MaxLineWidth;
@@ -1124,8 +1688,30 @@ void wxHtmlContainerCell::Draw(wxDC& dc, int x, int y, int view_y1, int view_y2,
     }
     if (m_Cells)
     {
+        wxHtmlCell *cellFirst = m_Cells,
+                   *cellLast = NULL;
+
+        // If we have an index, skip the cells before and after the visible
+        // ones, just reproducing their effect on the rendering state. This
+        // is not done if there is a selection as the state depends on it.
+        size_t chunkEnd = 0;
+        if ( m_index && !m_index->m_chunks.empty() && !info.GetSelection() )
+        {
+            const size_t
+                chunkStart = m_index->FindStart(view_y1 - ylocal, true);
+            chunkEnd = m_index->FindEnd(chunkStart, view_y2 - ylocal, true);
+
+            const wxHtmlContainerIndex::Chunk&
+                chunk = m_index->m_chunks[chunkStart];
+            chunk.stateBefore.Apply(dc, info);
+            cellFirst = chunk.first;
+
+            if ( chunkEnd < m_index->m_chunks.size() )
+                cellLast = m_index->m_chunks[chunkEnd].first;
+        }
+
         // draw container's contents:
-        for (wxHtmlCell *cell = m_Cells; cell; cell = cell->GetNext())
+        for (wxHtmlCell *cell = cellFirst; cell != cellLast; cell = cell->GetNext())
         {
 
             // optimize drawing: don't render off-screen content:
@@ -1146,6 +1732,12 @@ void wxHtmlContainerCell::Draw(wxDC& dc, int x, int y, int view_y1, int view_y2,
                 cell->DrawInvisible(dc, xlocal, ylocal, info);
             }
         }
+
+        if ( cellLast )
+        {
+            m_index->m_state.Apply(dc, info,
+                                   m_index->m_chunks[chunkEnd].stateBefore);
+        }
     }
 }
 
@@ -1154,6 +1746,12 @@ void wxHtmlContainerCell::Draw(wxDC& dc, int x, int y, int view_y1, int view_y2,
 void wxHtmlContainerCell::DrawInvisible(wxDC& dc, int x, int y,
                                         wxHtmlRenderingInfo& info)
 {
+    if ( m_index && !m_index->m_needsDraw && !info.GetSelection() )
+    {
+        m_index->m_state.Apply(dc, info);
+        return;
+    }
+
     if (m_Cells)
     {
         for (wxHtmlCell *cell = m_Cells; cell; cell = cell->GetNext())
@@ -1195,7 +1793,7 @@ void wxHtmlContainerCell::InsertCell(wxHtmlCell *f)
         if (m_LastCell) while (m_LastCell->GetNext()) m_LastCell = m_LastCell->GetNext();
     }
     f->SetParent(this);
-    m_LastLayout = -1;
+    InvalidateLayout();
 }
 
 
@@ -1233,6 +1831,22 @@ void wxHtmlContainerCell::Detach(wxHtmlCell *cell)
 
     cell->SetParent(NULL);
     cell->SetNext(NULL);
+
+    InvalidateLayout();
+}
+
+
+
+void wxHtmlContainerCell::InvalidateLayout()
+{
+    // Changing the children of this container affects the layout of all its
+    // parents too, but nothing else, so only these containers will be laid
+    // out again by the next call to Layout() on the root cell.
+    for ( wxHtmlContainerCell *cont = this; cont; cont = cont->GetParent() )
+    {
+        cont->m_LastLayout = -1;
+        wxDELETE(cont->m_index);
+    }
 }
 
 
@@ -1294,9 +1908,28 @@ const wxHtmlCell* wxHtmlContainerCell::Find(int condition, const void* param) co
 wxHtmlCell *wxHtmlContainerCell::FindCellByPos(wxCoord x, wxCoord y,
                                                unsigned flags) const
 {
+    // Use the index, if we have it, to skip the cells above the given
+    // position (and below it, when looking for the exact match).
+    const bool useIndex = m_index && !m_index->m_chunks.empty();
+    const wxHtmlCell *cellFirst = m_Cells;
+    size_t chunkStart = 0;
+    if ( useIndex )
+    {
+        chunkStart = m_index->FindStart(y, false);
+        cellFirst = m_index->m_chunks[chunkStart].first;
+    }
+
     if ( flags & wxHTML_FIND_EXACT )
     {
-        for ( const wxHtmlCell *cell = m_Cells; cell; cell = cell->GetNext() )
+        const wxHtmlCell *cellLast = NULL;
+        if ( useIndex )
+        {
+            const size_t chunkEnd = m_index->FindEnd(chunkStart, y, false);
+            if ( chunkEnd < m_index->m_chunks.size() )
+                cellLast = m_index->m_chunks[chunkEnd].first;
+        }
+
+        for ( const wxHtmlCell *cell = cellFirst; cell != cellLast; cell = cell->GetNext() )
         {
             int cx = cell->GetPosX(),
                 cy = cell->GetPosY();
@@ -1311,7 +1944,7 @@ wxHtmlCell *wxHtmlContainerCell::FindCellByPos(wxCoord x, wxCoord y,
     else if ( flags & wxHTML_FIND_NEAREST_AFTER )
     {
         wxHtmlCell *c;
-        for ( const wxHtmlCell *cell = m_Cells; cell; cell = cell->GetNext() )
+        for ( const wxHtmlCell *cell = cellFirst; cell; cell = cell->GetNext() )
         {
             if ( cell->IsFormattingCell() )
                 continue;
@@ -79,6 +79,7 @@ wxHtmlParser::wxHtmlParser()
     m_TextPieces = NULL;
     m_CurTextPiece = 0;
     m_SavedStates = NULL;
+    m_incrementalParsedLen = 0;
 }
 
 wxHtmlParser::~wxHtmlParser()
@@ -101,6 +102,136 @@ wxObject* wxHtmlParser::Parse(const wxString& source)
     return result;
 }
 
+// Minimal length of the text which must be received by ParseChunk() before it
+// parses it, in characters.
+static const size_t wxHTML_MIN_INCREMENTAL_LENGTH = 64*1024;
+
+extern bool wxIsCDATAElement(const wxString& tag);
+
+// Return the position after the last tag in the given part of the document
+// which is not inside a comment or a CDATA element, such as <script>, or begin
+// if there is no such tag. The part must not start inside any of them.
+static wxString::const_iterator
+FindLastCompleteTagEnd(const wxString::const_iterator& begin,
+                       const wxString::const_iterator& end)
+{
+    wxString::const_iterator tagEnd = begin;
+    for ( wxString::const_iterator pos = begin; pos < end; ++pos )
+    {
+        if ( *pos != wxT('<') )
+            continue;
+
+        if ( wxHtmlParser::SkipCommentTag(pos, end) )
+        {
+            // SkipCommentTag() only stops at '>' if the comment is complete.
+            if ( *pos != wxT('>') )
+                break;
+
+            tagEnd = pos + 1;
+            continue;
+        }
+
+        wxString name;
+        for ( ++pos; pos < end && *pos != wxT('>') && !wxIsspace(*pos); ++pos )
+            name += (wxChar)wxToupper(*pos);
+
+        while ( pos < end && *pos != wxT('>') )
+            ++pos;
+
+        if ( pos == end )
+            break;
+
+        if ( wxIsCDATAElement(name) )
+        {
+            // Everything until the closing tag belongs to this element, so we
+            // can only stop after it.
+            const wxString closing = wxT("</") + name;
+            bool found = false;
+            while ( !found && ++pos < end )
+            {
+                wxString::const_iterator p = pos;
+                size_t n = 0;
+                while ( p < end && n < closing.length() &&
+                            (wxChar)wxToupper(*p) == closing[n] )
+                {
+                    ++p;
+                    ++n;
+                }
+
+                if ( n < closing.length() )
+                    continue;
+
+                while ( p < end && *p != wxT('>') )
+                    ++p;
+
+                if ( p == end )
+                    break;
+
+                pos = p;
+                found = true;
+            }
+
+            if ( !found )
+                break;
+        }
+
+        tagEnd = pos + 1;
+    }
+
+    return tagEnd;
+}
+
+void wxHtmlParser::BeginIncrementalParsing()
+{
+    m_incrementalSource.clear();
+    m_incrementalParsedLen = 0;
+}
+
+wxObject* wxHtmlParser::ParseChunk(const wxString& chunk)
+{
+    m_incrementalSource += chunk;
+
+    // Tag handlers need to know where each element ends, so we can't really
+    // continue parsing from the place where we stopped the last time and
+    // have to parse everything received so far again. To avoid quadratic
+    // behaviour, only do it when the amount of new text is at least as big
+    // as what we had already parsed: this ensures that the time spent on the
+    // intermediate results is never greater than the time needed to parse
+    // the entire document.
+    const size_t len = m_incrementalSource.length();
+    if ( len - m_incrementalParsedLen <
+            wxMax(m_incrementalParsedLen, wxHTML_MIN_INCREMENTAL_LENGTH) )
+        return NULL;
+
+    // Don't cut the document in the middle of a tag, a word or an entity, nor
+    // inside a comment or a script, which may contain ">" too. Notice that the
+    // part which was already parsed can't end inside any of them.
+    const wxString::const_iterator
+        parsedEnd = m_incrementalSource.begin() + m_incrementalParsedLen;
+    const wxString::const_iterator
+        tagEnd = FindLastCompleteTagEnd(parsedEnd, m_incrementalSource.end());
+    if ( tagEnd == parsedEnd )
+        return NULL;
+
+    m_incrementalParsedLen += tagEnd - parsedEnd;
+
+    return Parse(m_incrementalSource.Left(m_incrementalParsedLen));
+}
+
+wxObject* wxHtmlParser::EndIncrementalParsing()
+{
+    return Parse(CancelIncrementalParsing());
+}
+
+wxString wxHtmlParser::CancelIncrementalParsing()
+{
+    wxString source;
+    source.swap(m_incrementalSource);
+    m_incrementalParsedLen = 0;
+
+    return source;
+}
+
 void wxHtmlParser::InitParser(const wxString& source)
 {
     SetSource(source);
@@ -137,8 +268,6 @@ void wxHtmlParser::CreateDOMTree()
     m_CurTextPiece = 0;
 }
 
-extern bool wxIsCDATAElement(const wxString& tag);
-
 void wxHtmlParser::CreateDOMSubTree(wxHtmlTag *cur,
                                     const wxString::const_iterator& begin_pos,
                                     const wxString::const_iterator& end_pos,
@@ -22,12 +22,24 @@
     #include "wx/settings.h"
     #include "wx/dataobj.h"
     #include "wx/statusbr.h"
+    #include "wx/app.h"
+    #include "wx/image.h"
 #endif
 
 #include "wx/html/htmlwin.h"
 #include "wx/html/htmlproc.h"
 #include "wx/clipbrd.h"
 #include "wx/recguard.h"
+#include "wx/scopedptr.h"
+#include "wx/sstream.h"
+
+#if wxUSE_THREADS
+    #include "wx/hashmap.h"
+    #include "wx/stopwatch.h"
+    #include "wx/thread.h"
+
+    #include <unordered_map>
+#endif // wxUSE_THREADS
 
 #include "wx/arrimpl.cpp"
 #include "wx/listimpl.cpp"
@@ -42,6 +54,26 @@ wxIMPLEMENT_DYNAMIC_CLASS(wxHtmlCellEvent, wxCommandEvent);
 wxDEFINE_EVENT( wxEVT_HTML_CELL_CLICKED, wxHtmlCellEvent );
 wxDEFINE_EVENT( wxEVT_HTML_CELL_HOVER, wxHtmlCellEvent );
 wxDEFINE_EVENT( wxEVT_HTML_LINK_CLICKED, wxHtmlLinkEvent );
+wxDEFINE_EVENT( wxEVT_HTML_PAGE_LOADED, wxCommandEvent );
+
+namespace
+{
+
+// Return the scale factor to use for the pixel sizes in the HTML page shown
+// in the given window.
+double GetHTMLPixelScale(const wxWindow* win)
+{
+    double pixelScale = 1.0;
+#ifndef wxHAS_DPI_INDEPENDENT_PIXELS
+    pixelScale = win->GetDPIScaleFactor();
+#else
+    wxUnusedVar(win);
+#endif
+
+    return pixelScale;
+}
+
+} // anonymous namespace
 
 
 #if wxUSE_CLIPBOARD
@@ -148,6 +180,24 @@ WX_DEFINE_OBJARRAY(wxHtmlHistoryArray)
 WX_DECLARE_LIST(wxHtmlProcessor, wxHtmlProcessorList);
 WX_DEFINE_LIST(wxHtmlProcessorList)
 
+//-----------------------------------------------------------------------------
+// wxHtmlWindowInterface
+//-----------------------------------------------------------------------------
+
+double wxHtmlWindowInterface::GetHTMLContentScaleFactor()
+{
+    wxWindow* win = GetHTMLWindow();
+    if ( !win )
+        win = wxApp::GetMainTopWindow();
+
+    return win ? win->GetContentScaleFactor() : 1.0;
+}
+
+void wxHtmlWindowInterface::SetHTMLBackgroundFromImage(const wxImage& image)
+{
+    SetHTMLBackgroundImage(image);
+}
+
 //-----------------------------------------------------------------------------
 // wxHtmlWindowMouseHelper
 //-----------------------------------------------------------------------------
@@ -274,6 +324,842 @@ void wxHtmlWindowMouseHelper::OnCellMouseHover(wxHtmlCell * cell,
 
 
 
+#if wxUSE_THREADS
+
+// ----------------------------------------------------------------------------
+// wxHtmlAsyncLayout: parses and lays out the page set by SetPageAsync()
+// ----------------------------------------------------------------------------
+
+// This thread runs the parser and lays out the cells created by it. Whatever
+// requires using the GUI, e.g. text measuring, is done in the main thread
+// using CallInMainThread() while this thread waits for it.
+class wxHtmlAsyncLayout : public wxThread
+{
+public:
+    // The effects of the calls to wxHtmlWindowInterface functions made while
+    // parsing the page, which are applied to the window when it's shown.
+    struct WindowState
+    {
+        WindowState()
+            : hasTitle(false),
+              bgColour(0xFF, 0xFF, 0xFF),
+              hasStatusText(false)
+        {
+        }
+
+        wxString title;
+        bool hasTitle;
+        wxColour bgColour;
+
+        // The background image is normally set as wxImage, which is only
+        // converted to the bitmap in the main thread, but can also be set
+        // as bitmap directly, only one of these fields is used.
+        wxImage bgImage;
+        wxBitmapBundle bgBitmap;
+
+        wxString statusText;
+        bool hasStatusText;
+    };
+
+    wxHtmlAsyncLayout(wxHtmlWindow *win,
+                      const wxString& source,
+                      int width,
+                      double pixelScale,
+                      double contentScale,
+                      const wxSize& ppi);
+    virtual ~wxHtmlAsyncLayout();
+
+    wxHtmlWindow *GetWindow() const { return m_win; }
+    wxHtmlWinParser *GetParser() const { return m_parser; }
+    WindowState& GetWindowState() { return m_windowState; }
+    double GetContentScaleFactor() const { return m_contentScale; }
+
+    // Called from the worker thread to execute the given functor in the main
+    // thread, returns false if it wasn't done because we were cancelled.
+    template <typename F>
+    bool CallInMainThread(const F& func)
+    {
+        FuncRequest<F> request(func);
+        return DoCallInMainThread(request);
+    }
+
+    // Called from the main thread to execute the pending requests, returns
+    // false if the layout was cancelled while doing it, in which case the
+    // caller must wait for the thread and delete this object.
+    bool ServeRequests();
+
+    // Return true if ServeRequests() is currently executing, i.e. if we're
+    // called from one of the requests, must be called from the main thread.
+    bool IsServingRequests() const { return m_servingFlag != 0; }
+
+    // Called from the main thread to ask the worker thread to stop as soon as
+    // possible, Wait() must still be called after this.
+    void Cancel();
+
+    // Return true if the worker thread has finished its work.
+    bool IsDone() const;
+
+    // Give the ownership of the laid out page contents to the caller.
+    wxHtmlContainerCell *DetachCell();
+
+    // Give the ownership of the window interface used by the cells returned
+    // by DetachCell() to the caller, it must outlive them.
+    wxHtmlAsyncWindowInterface *DetachWindowInterface();
+
+protected:
+    virtual ExitCode Entry() override;
+
+private:
+    class Request
+    {
+    public:
+        virtual ~Request() { }
+
+        virtual void Run() = 0;
+    };
+
+    template <typename F>
+    class FuncRequest : public Request
+    {
+    public:
+        explicit FuncRequest(const F& func) : m_func(func) { }
+
+        virtual void Run() override { m_func(); }
+
+    private:
+        const F& m_func;
+    };
+
+    bool DoCallInMainThread(Request& request);
+
+    // The maximal time, in ms, spent serving the requests in the main thread
+    // before returning to the event loop.
+    static const long SERVE_TIME_SLICE = 10;
+
+    wxHtmlWindow * const m_win;
+    const wxString m_source;
+    const int m_width;
+    const int m_borders;
+    const double m_contentScale;
+
+    // Only used in the main thread to detect ServeRequests() reentrancy.
+    wxRecursionGuardFlag m_servingFlag;
+
+    wxFileSystem m_fs;
+    wxDC *m_dc;
+    wxHtmlAsyncWindowInterface *m_windowInterface;
+    wxHtmlWinParser *m_parser;
+    wxHtmlContainerCell *m_cell;
+    WindowState m_windowState;
+
+    // All the fields below are protected by this mutex.
+    mutable wxMutex m_mutex;
+    wxCondition m_cond;
+
+    // The request to execute in the main thread, if m_requestDone is false.
+    Request *m_request;
+    bool m_requestDone;
+
+    // True while m_request is being executed: the worker thread must wait
+    // until it finishes even if we're cancelled, as it uses its data.
+    bool m_requestRunning;
+
+    // True if OnAsyncLayoutRequest() is going to be called soon.
+    bool m_servePending;
+
+    bool m_done;
+    bool m_cancelled;
+
+    wxDECLARE_NO_COPY_CLASS(wxHtmlAsyncLayout);
+};
+
+// ----------------------------------------------------------------------------
+// wxHtmlMeasuringDCImpl: DC used by wxHtmlAsyncLayout for measuring text
+// ----------------------------------------------------------------------------
+
+// This DC doesn't draw anything, it only measures text, which is done by a
+// real DC in the main thread, as not all ports allow doing it in the other
+// ones, and so the results are cached for every font.
+class wxHtmlMeasuringDCImpl : public wxDCImpl
+{
+public:
+    wxHtmlMeasuringDCImpl(wxDC *owner,
+                          wxHtmlAsyncLayout *layout,
+                          const wxSize& ppi)
+        : wxDCImpl(owner),
+          m_layout(layout),
+          m_ppi(ppi)
+    {
+        m_fontData = NULL;
+    }
+
+    virtual bool CanDrawBitmap() const override { return false; }
+    virtual bool CanGetTextExtent() const override { return true; }
+
+    virtual void DoGetSize(int *width, int *height) const override
+    {
+        if ( width )
+            *width = 0;
+        if ( height )
+            *height = 0;
+    }
+
+    virtual void DoGetSizeMM(int* width, int* height) const override
+    {
+        DoGetSize(width, height);
+    }
+
+    virtual int GetDepth() const override { return 24; }
+    virtual wxSize GetPPI() const override { return m_ppi; }
+
+    virtual void SetFont(const wxFont& font) override
+    {
+        m_font = font;
+        m_fontData = NULL;
+    }
+
+    virtual void SetPen(const wxPen& pen) override { m_pen = pen; }
+    virtual void SetBrush(const wxBrush& brush) override { m_brush = brush; }
+    virtual void SetBackground(const wxBrush& brush) override
+        { m_backgroundBrush = brush; }
+    virtual void SetBackgroundMode(int mode) override
+        { m_backgroundMode = mode; }
+#if wxUSE_PALETTE
+    virtual void SetPalette(const wxPalette& WXUNUSED(palette)) override { }
+#endif // wxUSE_PALETTE
+    virtual void SetLogicalFunction(wxRasterOperationMode function) override
+        { m_logicalFunction = function; }
+
+    virtual wxCoord GetCharHeight() const override;
+    virtual wxCoord GetCharWidth() const override;
+    virtual void DoGetTextExtent(const wxString& string,
+                                 wxCoord *x, wxCoord *y,
+                                 wxCoord *descent = NULL,
+                                 wxCoord *externalLeading = NULL,
+                                 const wxFont *theFont = NULL) const override;
+
+    // Nothing is ever drawn on this DC.
+    virtual void Clear() override { }
+    virtual void DoSetClippingRegion(wxCoord WXUNUSED(x), wxCoord WXUNUSED(y),
+                                     wxCoord WXUNUSED(w),
+                                     wxCoord WXUNUSED(h)) override { }
+    virtual void
+    DoSetDeviceClippingRegion(const wxRegion& WXUNUSED(region)) override { }
+    virtual bool DoFloodFill(wxCoord WXUNUSED(x), wxCoord WXUNUSED(y),
+                             const wxColour& WXUNUSED(col),
+                             wxFloodFillStyle WXUNUSED(style)) override
+        { return false; }
+    virtual bool DoGetPixel(wxCoord WXUNUSED(x), wxCoord WXUNUSED(y),
+                            wxColour *WXUNUSED(col)) const override
+        { return false; }
+    virtual void DoDrawPoint(wxCoord WXUNUSED(x), wxCoord WXUNUSED(y)) override
+        { }
+    virtual void DoDrawLine(wxCoord WXUNUSED(x1), wxCoord WXUNUSED(y1),
+                            wxCoord WXUNUSED(x2), wxCoord WXUNUSED(y2)) override
+        { }
+    virtual void DoDrawArc(wxCoord WXUNUSED(x1), wxCoord WXUNUSED(y1),
+                           wxCoord WXUNUSED(x2), wxCoord WXUNUSED(y2),
+                           wxCoord WXUNUSED(xc), wxCoord WXUNUSED(yc)) override
+        { }
+    virtual void DoDrawEllipticArc(wxCoord WXUNUSED(x), wxCoord WXUNUSED(y),
+                                   wxCoord WXUNUSED(w), wxCoord WXUNUSED(h),
+                                   double WXUNUSED(sa),
+                                   double WXUNUSED(ea)) override
+        { }
+    virtual void DoDrawRectangle(wxCoord WXUNUSED(x), wxCoord WXUNUSED(y),
+                                 wxCoord WXUNUSED(width),
+                                 wxCoord WXUNUSED(height)) override
+        { }
+    virtual void DoDrawRoundedRectangle(wxCoord WXUNUSED(x),
+                                        wxCoord WXUNUSED(y),
+                                        wxCoord WXUNUSED(width),
+                                        wxCoord WXUNUSED(height),
+                                        double WXUNUSED(radius)) override
+        { }
+    virtual void DoDrawEllipse(wxCoord WXUNUSED(x), wxCoord WXUNUSED(y),
+                               wxCoord WXUNUSED(width),
+                               wxCoord WXUNUSED(height)) override
+        { }
+    virtual void DoCrossHair(wxCoord WXUNUSED(x), wxCoord WXUNUSED(y)) override
+        { }
+    virtual void DoDrawIcon(const wxIcon& WXUNUSED(icon),
+                            wxCoord WXUNUSED(x), wxCoord WXUNUSED(y)) override
+        { }
+    virtual void DoDrawBitmap(const wxBitmap& WXUNUSED(bmp),
+                              wxCoord WXUNUSED(x), wxCoord WXUNUSED(y),
+                              bool WXUNUSED(useMask)) override
+        { }
+    virtual void DoDrawText(const wxString& WXUNUSED(text),
+                            wxCoord WXUNUSED(x), wxCoord WXUNUSED(y)) override
+        { }
+    virtual void DoDrawRotatedText(const wxString& WXUNUSED(text),
+                                   wxCoord WXUNUSED(x), wxCoord WXUNUSED(y),
+                                   double WXUNUSED(angle)) override
+        { }
+    virtual bool DoBlit(wxCoord WXUNUSED(xdest), wxCoord WXUNUSED(ydest),
+                        wxCoord WXUNUSED(width), wxCoord WXUNUSED(height),
+                        wxDC *WXUNUSED(source),
+                        wxCoord WXUNUSED(xsrc), wxCoord WXUNUSED(ysrc),
+                        wxRasterOperationMode WXUNUSED(rop),
+                        bool WXUNUSED(useMask),
+                        wxCoord WXUNUSED(xsrcMask),
+                        wxCoord WXUNUSED(ysrcMask)) override
+        { return false; }
+    virtual void DoDrawLines(int WXUNUSED(n), const wxPoint WXUNUSED(points)[],
+                             wxCoord WXUNUSED(xoffset),
+                             wxCoord WXUNUSED(yoffset)) override
+        { }
+    virtual void DoDrawPolygon(int WXUNUSED(n),
+                               const wxPoint WXUNUSED(points)[],
+                               wxCoord WXUNUSED(xoffset),
+                               wxCoord WXUNUSED(yoffset),
+                               wxPolygonFillMode WXUNUSED(fillStyle)) override
+        { }
+
+private:
+    struct TextExtent
+    {
+        TextExtent() : width(0), height(0), descent(0), externalLeading(0) { }
+
+        wxCoord width,
+                height,
+                descent,
+                externalLeading;
+    };
+
+    typedef std::unordered_map<wxString, TextExtent,
+                               wxStringHash, wxStringEqual> TextExtents;
+
+    // Everything we know about a font.
+    struct FontData
+    {
+        FontData() : charWidth(-1), charHeight(-1) { }
+
+        // We keep a copy of the font to ensure that its ref data, used as the
+        // key in the fonts map, is not reused for another font.
+        wxFont font;
+
+        // These fields are -1 if they're not known yet.
+        wxCoord charWidth,
+                charHeight;
+
+        TextExtents extents;
+    };
+
+    typedef std::unordered_map<const wxObjectRefData*, FontData> Fonts;
+
+    FontData& GetFontData(const wxFont& font) const;
+    FontData& GetCurrentFontData() const;
+
+    wxHtmlAsyncLayout * const m_layout;
+    const wxSize m_ppi;
+
+    mutable Fonts m_fonts;
+
+    // The data for m_font if already looked up, NULL otherwise.
+    mutable FontData *m_fontData;
+
+    wxDECLARE_NO_COPY_CLASS(wxHtmlMeasuringDCImpl);
+};
+
+class wxHtmlMeasuringDC : public wxDC
+{
+public:
+    wxHtmlMeasuringDC(wxHtmlAsyncLayout *layout, const wxSize& ppi)
+        : wxDC(new wxHtmlMeasuringDCImpl(this, layout, ppi))
+    {
+    }
+
+    wxDECLARE_NO_COPY_CLASS(wxHtmlMeasuringDC);
+};
+
+wxHtmlMeasuringDCImpl::FontData&
+wxHtmlMeasuringDCImpl::GetFontData(const wxFont& font) const
+{
+    FontData& data = m_fonts[font.GetRefData()];
+    if ( !data.font.IsSameAs(font) )
+        data.font = font;
+
+    return data;
+}
+
+wxHtmlMeasuringDCImpl::FontData&
+wxHtmlMeasuringDCImpl::GetCurrentFontData() const
+{
+    if ( !m_fontData )
+        m_fontData = &GetFontData(m_font);
+
+    return *m_fontData;
+}
+
+wxCoord wxHtmlMeasuringDCImpl::GetCharHeight() const
+{
+    FontData& data = GetCurrentFontData();
+    if ( data.charHeight == -1 )
+    {
+        wxCoord charWidth = 0,
+                charHeight = 0;
+        const wxFont& font = data.font;
+        if ( m_layout->CallInMainThread([&]()
+                {
+                    wxClientDC dc(m_layout->GetWindow());
+                    if ( font.IsOk() )
+                        dc.SetFont(font);
+                    charWidth = dc.GetCharWidth();
+                    charHeight = dc.GetCharHeight();
+                }) )
+        {
+            data.charWidth = charWidth;
+            data.charHeight = charHeight;
+        }
+
+        return charHeight;
+    }
+
+    return data.charHeight;
+}
+
+wxCoord wxHtmlMeasuringDCImpl::GetCharWidth() const
+{
+    FontData& data = GetCurrentFontData();
+    if ( data.charWidth == -1 )
+    {
+        // This also retrieves the width.
+        GetCharHeight();
+    }
+
+    return data.charWidth == -1 ? 0 : data.charWidth;
+}
+
+void wxHtmlMeasuringDCImpl::DoGetTextExtent(const wxString& string,
+                                            wxCoord *x, wxCoord *y,
+                                            wxCoord *descent,
+                                            wxCoord *externalLeading,
+                                            const wxFont *theFont) const
+{
+    FontData& data = theFont ? GetFontData(*theFont) : GetCurrentFontData();
+
+    TextExtent extent;
+    const TextExtents::const_iterator it = data.extents.find(string);
+    if ( it != data.extents.end() )
+    {
+        extent = it->second;
+    }
+    else
+    {
+        const wxFont& font = data.font;
+        if ( m_layout->CallInMainThread([&]()
+                {
+                    wxClientDC dc(m_layout->GetWindow());
+                    if ( font.IsOk() )
+                        dc.SetFont(font);
+                    dc.GetTextExtent(string, &extent.width, &extent.height,
+                                     &extent.descent, &extent.externalLeading);
+                }) )
+        {
+            data.extents[string] = extent;
+        }
+    }
+
+    if ( x )
+        *x = extent.width;
+    if ( y )
+        *y = extent.height;
+    if ( descent )
+        *descent = extent.descent;
+    if ( externalLeading )
+        *externalLeading = extent.externalLeading;
+}
+
+// ----------------------------------------------------------------------------
+// wxHtmlAsyncWindowInterface: window interface used by wxHtmlAsyncLayout
+// ----------------------------------------------------------------------------
+
+// When used from the main thread, this class simply forwards to the window,
+// which is necessary because the cells created by wxHtmlAsyncLayout keep
+// using it after the page is shown. When used from the worker thread, it
+// either remembers the changes to apply to the window later or executes the
+// calls in the main thread.
+class wxHtmlAsyncWindowInterface : public wxHtmlWindowInterface
+{
+public:
+    wxHtmlAsyncWindowInterface(wxHtmlWindow *win, wxHtmlAsyncLayout *layout)
+        : m_win(win), m_layout(layout)
+    {
+    }
+
+    virtual void SetHTMLWindowTitle(const wxString& title) override
+    {
+        if ( wxHtmlAsyncLayout * const layout = GetLayout() )
+        {
+            wxHtmlAsyncLayout::WindowState& state = layout->GetWindowState();
+            state.title = title;
+            state.hasTitle = true;
+        }
+        else
+        {
+            m_win->SetHTMLWindowTitle(title);
+        }
+    }
+
+    virtual void OnHTMLLinkClicked(const wxHtmlLinkInfo& link) override
+    {
+        if ( wxHtmlAsyncLayout * const layout = GetLayout() )
+            layout->CallInMainThread([&]() { m_win->OnHTMLLinkClicked(link); });
+        else
+            m_win->OnHTMLLinkClicked(link);
+    }
+
+    virtual wxHtmlOpeningStatus OnHTMLOpeningURL(wxHtmlURLType type,
+                                                 const wxString& url,
+                                                 wxString *redirect) const override
+    {
+        wxHtmlAsyncLayout * const layout = GetLayout();
+        if ( !layout )
+            return m_win->OnHTMLOpeningURL(type, url, redirect);
+
+        wxHtmlOpeningStatus status = wxHTML_BLOCK;
+        layout->CallInMainThread([&]()
+            {
+                status = m_win->OnHTMLOpeningURL(type, url, redirect);
+            });
+        return status;
+    }
+
+    virtual wxPoint HTMLCoordsToWindow(wxHtmlCell *cell,
+                                       const wxPoint& pos) const override
+    {
+        wxHtmlAsyncLayout * const layout = GetLayout();
+        if ( !layout )
+            return m_win->HTMLCoordsToWindow(cell, pos);
+
+        wxPoint posWin = pos;
+        layout->CallInMainThread([&]()
+            {
+                posWin = m_win->HTMLCoordsToWindow(cell, pos);
+            });
+        return posWin;
+    }
+
+    virtual wxWindow* GetHTMLWindow() override
+    {
+        // The window can't be used from the worker thread anyhow.
+        return GetLayout() ? NULL : m_win;
+    }
+
+    virtual double GetHTMLContentScaleFactor() override
+    {
+        if ( wxHtmlAsyncLayout * const layout = GetLayout() )
+            return layout->GetContentScaleFactor();
+
+        return m_win->GetContentScaleFactor();
+    }
+
+    virtual wxColour GetHTMLBackgroundColour() const override
+    {
+        if ( wxHtmlAsyncLayout * const layout = GetLayout() )
+            return layout->GetWindowState().bgColour;
+
+        return m_win->GetHTMLBackgroundColour();
+    }
+
+    virtual void SetHTMLBackgroundColour(const wxColour& clr) override
+    {
+        if ( wxHtmlAsyncLayout * const layout = GetLayout() )
+            layout->GetWindowState().bgColour = clr;
+        else
+            m_win->SetHTMLBackgroundColour(clr);
+    }
+
+    virtual void SetHTMLBackgroundImage(const wxBitmapBundle& bmpBg) override
+    {
+        if ( wxHtmlAsyncLayout * const layout = GetLayout() )
+        {
+            wxHtmlAsyncLayout::WindowState& state = layout->GetWindowState();
+            state.bgBitmap = bmpBg;
+            state.bgImage = wxImage();
+        }
+        else
+        {
+            m_win->SetHTMLBackgroundImage(bmpBg);
+        }
+    }
+
+    virtual void SetHTMLBackgroundFromImage(const wxImage& image) override
+    {
+        if ( wxHtmlAsyncLayout * const layout = GetLayout() )
+        {
+            wxHtmlAsyncLayout::WindowState& state = layout->GetWindowState();
+            state.bgImage = image;
+            state.bgBitmap = wxBitmapBundle();
+        }
+        else
+        {
+            m_win->SetHTMLBackgroundImage(image);
+        }
+    }
+
+    virtual void SetHTMLStatusText(const wxString& text) override
+    {
+        if ( wxHtmlAsyncLayout * const layout = GetLayout() )
+        {
+            wxHtmlAsyncLayout::WindowState& state = layout->GetWindowState();
+            state.statusText = text;
+            state.hasStatusText = true;
+        }
+        else
+        {
+            m_win->SetHTMLStatusText(text);
+        }
+    }
+
+    virtual wxCursor GetHTMLCursor(HTMLCursor type) const override
+    {
+        wxHtmlAsyncLayout * const layout = GetLayout();
+        if ( !layout )
+            return m_win->GetHTMLCursor(type);
+
+        wxCursor cursor;
+        layout->CallInMainThread([&]() { cursor = m_win->GetHTMLCursor(type); });
+        return cursor;
+    }
+
+private:
+    // Return the layout calling us from its worker thread or NULL if we're
+    // called from the main thread, we must not be used from any other one.
+    //
+    // Notice that this is the layout which created this object and not the
+    // current one of the window, which may be different if it was cancelled.
+    wxHtmlAsyncLayout *GetLayout() const
+    {
+        if ( wxThread::IsMain() )
+            return NULL;
+
+        wxASSERT_MSG( wxThread::This() == m_layout,
+                      "must be only used from the layout thread" );
+
+        return m_layout;
+    }
+
+    wxHtmlWindow * const m_win;
+    wxHtmlAsyncLayout * const m_layout;
+
+    wxDECLARE_NO_COPY_CLASS(wxHtmlAsyncWindowInterface);
+};
+
+// ----------------------------------------------------------------------------
+// wxHtmlAsyncLayout implementation
+// ----------------------------------------------------------------------------
+
+wxHtmlAsyncLayout::wxHtmlAsyncLayout(wxHtmlWindow *win,
+                                     const wxString& source,
+                                     int width,
+                                     double pixelScale,
+                                     double contentScale,
+                                     const wxSize& ppi)
+    : wxThread(wxTHREAD_JOINABLE),
+      m_win(win),
+      m_source(source),
+      m_width(width),
+      m_borders(win->m_Borders),
+      m_contentScale(contentScale),
+      m_servingFlag(0),
+      m_cond(m_mutex)
+{
+    m_fs.ChangePathTo(win->m_FS->GetPath(), true);
+
+    m_dc = new wxHtmlMeasuringDC(this, ppi);
+
+    m_windowInterface = new wxHtmlAsyncWindowInterface(win, this);
+
+    m_parser = new wxHtmlWinParser(m_windowInterface);
+    m_parser->SetFS(&m_fs);
+    m_parser->SetDC(m_dc, pixelScale, 1.0);
+
+    m_cell = NULL;
+
+    m_request = NULL;
+    m_requestDone = false;
+    m_requestRunning = false;
+    m_servePending = false;
+    m_done = false;
+    m_cancelled = false;
+}
+
+wxHtmlAsyncLayout::~wxHtmlAsyncLayout()
+{
+    delete m_cell;
+    delete m_parser;
+
+    // This must be done after deleting the cells which may still use it.
+    delete m_windowInterface;
+
+    delete m_dc;
+}
+
+wxThread::ExitCode wxHtmlAsyncLayout::Entry()
+{
+    m_cell = static_cast<wxHtmlContainerCell*>(m_parser->Parse(m_source));
+    m_parser->SetDC(NULL);
+
+    bool cancelled;
+    {
+        wxMutexLocker lock(m_mutex);
+        cancelled = m_cancelled;
+    }
+
+    if ( m_cell && !cancelled )
+    {
+        // Do the same thing as wxHtmlWindow::SetPageCell() does, so that the
+        // layout can be reused by it if the window width doesn't change.
+        m_cell->SetIndent(m_borders, wxHTML_INDENT_ALL, wxHTML_UNITS_PIXELS);
+        m_cell->SetAlignHor(wxHTML_ALIGN_CENTER);
+        m_cell->Layout(m_width);
+    }
+
+    {
+        wxMutexLocker lock(m_mutex);
+        m_done = true;
+        m_cond.Broadcast();
+
+        // The window may be already destroyed if we were cancelled while
+        // serving a request, so don't use it at all in this case.
+        if ( m_cancelled )
+            return 0;
+    }
+
+    m_win->CallAfter(&wxHtmlWindow::OnAsyncLayoutDone);
+
+    return 0;
+}
+
+bool wxHtmlAsyncLayout::DoCallInMainThread(Request& request)
+{
+    {
+        wxMutexLocker lock(m_mutex);
+        if ( !m_cancelled )
+        {
+            m_request = &request;
+            m_requestDone = false;
+
+            if ( !m_servePending )
+            {
+                m_servePending = true;
+                m_win->CallAfter(&wxHtmlWindow::OnAsyncLayoutRequest);
+            }
+
+            // Wake up ServeRequests() if it's waiting for the next request.
+            m_cond.Broadcast();
+
+            while ( !m_requestDone && (!m_cancelled || m_requestRunning) )
+                m_cond.Wait();
+
+            m_request = NULL;
+
+            if ( m_requestDone )
+                return true;
+        }
+    }
+
+    // Don't waste time on parsing the rest of the page which won't be shown.
+    m_parser->StopParsing();
+
+    return false;
+}
+
+bool wxHtmlAsyncLayout::ServeRequests()
+{
+    // This can be reentered if a request runs an event loop, e.g. shows a
+    // dialog, but the request can't be executed again while it's running.
+    wxRecursionGuard guard(m_servingFlag);
+    if ( guard.IsInside() )
+        return true;
+
+    wxStopWatch sw;
+
+    m_mutex.Lock();
+
+    while ( m_request && !m_requestDone && !m_cancelled )
+    {
+        Request * const request = m_request;
+        m_requestRunning = true;
+
+        m_mutex.Unlock();
+        request->Run();
+        m_mutex.Lock();
+
+        m_requestRunning = false;
+        m_requestDone = true;
+        m_cond.Broadcast();
+
+        // Wait a bit for the next request instead of returning to the event
+        // loop immediately, as it typically comes very soon and going through
+        // the event loop every time would slow down the layout a lot.
+        for ( ;; )
+        {
+            const long remaining = SERVE_TIME_SLICE - sw.Time();
+            if ( remaining <= 0 || m_done || m_cancelled ||
+                    (m_request && !m_requestDone) )
+                break;
+
+            m_cond.WaitTimeout(remaining);
+        }
+
+        if ( sw.Time() >= SERVE_TIME_SLICE )
+            break;
+    }
+
+    if ( m_request && !m_requestDone && !m_cancelled )
+    {
+        // We didn't have time to serve this one, so return to the event loop
+        // but ensure we're called again: notice that m_servePending remains
+        // true as the worker thread must not do it itself.
+        m_win->CallAfter(&wxHtmlWindow::OnAsyncLayoutRequest);
+    }
+    else
+    {
+        m_servePending = false;
+    }
+
+    const bool cancelled = m_cancelled;
+
+    m_mutex.Unlock();
+
+    return !cancelled;
+}
+
+void wxHtmlAsyncLayout::Cancel()
+{
+    wxMutexLocker lock(m_mutex);
+
+    m_cancelled = true;
+    m_cond.Broadcast();
+}
+
+bool wxHtmlAsyncLayout::IsDone() const
+{
+    wxMutexLocker lock(m_mutex);
+
+    return m_done;
+}
+
+wxHtmlContainerCell *wxHtmlAsyncLayout::DetachCell()
+{
+    wxHtmlContainerCell * const cell = m_cell;
+    m_cell = NULL;
+    return cell;
+}
+
+wxHtmlAsyncWindowInterface *wxHtmlAsyncLayout::DetachWindowInterface()
+{
+    wxHtmlAsyncWindowInterface * const windowInterface = m_windowInterface;
+    m_windowInterface = NULL;
+    return windowInterface;
+}
+
+#endif // wxUSE_THREADS
+
+
 //-----------------------------------------------------------------------------
 // wxHtmlWindow
 //-----------------------------------------------------------------------------
@@ -315,6 +1201,7 @@ void wxHtmlWindow::Init()
     m_Parser->SetFS(m_FS);
     m_HistoryPos = -1;
     m_HistoryOn = true;
+    m_incrementalLoading = false;
     m_History = new wxHtmlHistoryArray;
     m_Processors = NULL;
     SetBorders(10);
@@ -325,6 +1212,10 @@ void wxHtmlWindow::Init()
     m_lastDoubleClick = 0;
 #endif // wxUSE_CLIPBOARD
     m_tmpSelFromCell = NULL;
+#if wxUSE_THREADS
+    m_asyncLayout = NULL;
+    m_asyncWindowInterface = NULL;
+#endif // wxUSE_THREADS
 }
 
 bool wxHtmlWindow::Create(wxWindow *parent, wxWindowID id,
@@ -358,6 +1249,10 @@ bool wxHtmlWindow::Create(wxWindow *parent, wxWindowID id,
 
 wxHtmlWindow::~wxHtmlWindow()
 {
+#if wxUSE_THREADS
+    CancelAsyncLayout();
+#endif // wxUSE_THREADS
+
 #if wxUSE_CLIPBOARD
     StopAutoScrolling();
 #endif // wxUSE_CLIPBOARD
@@ -367,6 +1262,11 @@ wxHtmlWindow::~wxHtmlWindow()
 
     delete m_Cell;
 
+#if wxUSE_THREADS
+    // This must be done after deleting the cells which may still use it.
+    delete m_asyncWindowInterface;
+#endif // wxUSE_THREADS
+
     if ( m_Processors )
     {
         WX_CLEAR_LIST(wxHtmlProcessorList, *m_Processors);
@@ -438,9 +1338,151 @@ bool wxHtmlWindow::SetPage(const wxString& source)
     return DoSetPage(source);
 }
 
+bool wxHtmlWindow::SetPageAsync(const wxString& source)
+{
+#if wxUSE_THREADS
+    CancelAsyncLayout();
+
+    m_OpenedPage.clear();
+    m_OpenedAnchor.clear();
+    m_OpenedPageTitle.clear();
+
+    wxClientDC dc(this);
+    m_asyncLayout = new wxHtmlAsyncLayout(this,
+                                          ApplyProcessors(source),
+                                          GetClientSize().x,
+                                          GetHTMLPixelScale(this),
+                                          GetContentScaleFactor(),
+                                          dc.GetPPI());
+
+    m_asyncLayout->GetParser()->SetFonts(m_Parser->m_FontFaceNormal,
+                                         m_Parser->m_FontFaceFixed,
+                                         m_Parser->m_FontsSizes);
+
+    if ( m_asyncLayout->Run() == wxTHREAD_NO_ERROR )
+        return true;
+
+    wxDELETE(m_asyncLayout);
+#endif // wxUSE_THREADS
+
+    // Fall back to doing everything synchronously.
+    if ( !SetPage(source) )
+        return false;
+
+    SendPageLoadedEvent();
+
+    return true;
+}
+
+bool wxHtmlWindow::IsLoadingPageAsync() const
+{
+#if wxUSE_THREADS
+    return m_asyncLayout != NULL;
+#else // !wxUSE_THREADS
+    return false;
+#endif // wxUSE_THREADS/!wxUSE_THREADS
+}
+
+void wxHtmlWindow::SendPageLoadedEvent()
+{
+    wxCommandEvent event(wxEVT_HTML_PAGE_LOADED, GetId());
+    event.SetEventObject(this);
+    HandleWindowEvent(event);
+}
+
+#if wxUSE_THREADS
+
+void wxHtmlWindow::CancelAsyncLayout()
+{
+    if ( !m_asyncLayout )
+        return;
+
+    m_asyncLayout->Cancel();
+
+    // If we're called from a request executed by ServeRequests(), e.g.
+    // because OnOpeningURL() called SetPage(), we can't wait for the worker
+    // thread, as it waits for this request to complete, nor delete the layout
+    // which is still being used, so let OnAsyncLayoutRequest() do it later.
+    if ( m_asyncLayout->IsServingRequests() )
+    {
+        m_asyncLayout = NULL;
+        return;
+    }
+
+    m_asyncLayout->Wait();
+    wxDELETE(m_asyncLayout);
+}
+
+void wxHtmlWindow::OnAsyncLayoutRequest()
+{
+    // Notice that this may be called for a layout which had been already
+    // cancelled, but it's harmless to serve the requests of the new one.
+    wxHtmlAsyncLayout * const layout = m_asyncLayout;
+    if ( !layout )
+        return;
+
+    // Don't use this window after serving the requests if the layout was
+    // cancelled while doing it, as it could have been destroyed too.
+    if ( !layout->ServeRequests() )
+    {
+        layout->Wait();
+        delete layout;
+    }
+}
+
+void wxHtmlWindow::OnAsyncLayoutDone()
+{
+    // As above, ignore the notifications from the cancelled layouts.
+    if ( !m_asyncLayout || !m_asyncLayout->IsDone() )
+        return;
+
+    m_asyncLayout->Wait();
+
+    wxScopedPtr<wxHtmlAsyncLayout> layout(m_asyncLayout);
+    m_asyncLayout = NULL;
+
+    wxDELETE(m_selection);
+    m_tmpSelFromCell = NULL;
+
+    // Apply the changes which DoSetPage() would have done while parsing.
+    const wxHtmlAsyncLayout::WindowState& state = layout->GetWindowState();
+    SetBackgroundColour(state.bgColour);
+    if ( state.bgImage.IsOk() )
+        SetBackgroundImage(state.bgImage);
+    else
+        SetBackgroundImage(state.bgBitmap);
+    if ( state.hasTitle )
+        SetHTMLWindowTitle(state.title);
+    if ( state.hasStatusText )
+        SetHTMLStatusText(state.statusText);
+
+    // Our parser must return the source of the page currently shown.
+    wxSwap(m_Parser->m_Source, layout->GetParser()->m_Source);
+
+    // Don't use SetPageCell() as it would discard the existing layout, the
+    // cell has been already set up in the same way by the worker thread.
+    delete m_Cell;
+    m_Cell = layout->DetachCell();
+    CreateLayout();
+
+    // The interface used by the previous page cells isn't needed any more,
+    // but the one used by the new cells must be kept while they exist.
+    delete m_asyncWindowInterface;
+    m_asyncWindowInterface = layout->DetachWindowInterface();
+
+    if (m_tmpCanDrawLocks == 0)
+        Refresh();
+
+    SendPageLoadedEvent();
+}
+
+#endif // wxUSE_THREADS
+
 bool wxHtmlWindow::DoSetPage(const wxString& source)
 {
-    wxString newsrc(source);
+#if wxUSE_THREADS
+    CancelAsyncLayout();
+#endif // wxUSE_THREADS
 
     wxDELETE(m_selection);
 
@@ -448,6 +1490,33 @@ bool wxHtmlWindow::DoSetPage(const wxString& source)
     m_tmpSelFromCell = NULL;
 
     // pass HTML through registered processors:
+    const wxString newsrc = ApplyProcessors(source);
+
+    // ...and run the parser on it:
+    wxClientDC dc(this);
+    InitParserDC(dc);
+
+    // notice that it's important to set m_Cell to NULL here before calling
+    // Parse() below, even if it will be overwritten by its return value as
+    // without this we may crash if it's used from inside Parse(), so use
+    // wxDELETE() and not just delete here
+    wxDELETE(m_Cell);
+
+    SetPageCell((wxHtmlContainerCell*) m_Parser->Parse(newsrc));
+
+    // The parser doesn't need the DC any more, so ensure it's not left with a
+    // dangling pointer after the DC object goes out of scope.
+    m_Parser->SetDC(NULL);
+
+    if (m_tmpCanDrawLocks == 0)
+        Refresh();
+    return true;
+}
+
+wxString wxHtmlWindow::ApplyProcessors(const wxString& source) const
+{
+    wxString newsrc(source);
+
     if (m_Processors || m_GlobalProcessors)
     {
         wxHtmlProcessorList::compatibility_iterator nodeL, nodeG;
@@ -482,37 +1551,123 @@ bool wxHtmlWindow::DoSetPage(const wxString& source)
         }
     }
 
-    // ...and run the parser on it:
-    wxClientDC dc(this);
-    dc.SetMapMode(wxMM_TEXT);
-    SetBackgroundColour(wxColour(0xFF, 0xFF, 0xFF));
-    SetBackgroundImage(wxNullBitmap);
+    return newsrc;
+}
 
-    double pixelScale = 1.0;
-#ifndef wxHAS_DPI_INDEPENDENT_PIXELS
-    pixelScale = GetDPIScaleFactor();
-#endif
+wxString wxHtmlWindow::DoReadPageIncrementally(wxInputStream& stream,
+                                               const wxString& mimeType)
+{
+#if wxUSE_THREADS
+    CancelAsyncLayout();
+#endif // wxUSE_THREADS
 
-    m_Parser->SetDC(&dc, pixelScale, 1.0);
+    wxDELETE(m_selection);
+    m_tmpSelFromCell = NULL;
+
+    // Read the page in chunks of this size (in bytes).
+    static const size_t CHUNK_SIZE = 64*1024;
+
+    wxMemoryBuffer buf;
+    stream.Read(buf.GetWriteBuf(CHUNK_SIZE), CHUNK_SIZE);
+    buf.UngetWriteBuf(stream.LastRead());
+
+    // Determine the encoding in the same way as wxHtmlFilterHTML does, but
+    // only look for <meta> tag at the beginning of the document, where it
+    // must be anyhow.
+    wxString charset;
+    const int charsetPos = mimeType.Find(wxT("; charset="));
+    if ( charsetPos != wxNOT_FOUND )
+    {
+        charset = mimeType.Mid(charsetPos + 10);
+    }
+    else
+    {
+        charset = wxHtmlParser::ExtractCharsetInformation(
+                    wxString(static_cast<const char*>(buf.GetData()),
+                             wxConvISO8859_1, buf.GetDataLen()));
+    }
+
+    wxScopedPtr<wxMBConv> conv;
+    if ( charset.empty() )
+        conv.reset(new wxCSConv(wxFONTENCODING_ISO8859_1));
+    else
+        conv.reset(new wxCSConv(charset));
+
+    wxClientDC dc(this);
+    InitParserDC(dc);
 
-    // notice that it's important to set m_Cell to NULL here before calling
-    // Parse() below, even if it will be overwritten by its return value as
-    // without this we may crash if it's used from inside Parse(), so use
-    // wxDELETE() and not just delete here
     wxDELETE(m_Cell);
 
-    m_Cell = (wxHtmlContainerCell*) m_Parser->Parse(newsrc);
+    // The text decoded from the last chunk: notice that wxStringOutputStream
+    // takes care of the multibyte sequences split between the chunks.
+    wxString text;
+    wxStringOutputStream out(&text, *conv);
+
+    m_Parser->BeginIncrementalParsing();
+    while ( buf.GetDataLen() )
+    {
+        out.Write(buf.GetData(), buf.GetDataLen());
+
+        // As in DoSetPage(), don't let m_Cell be used while parsing.
+        wxHtmlContainerCell* const cellShown = m_Cell;
+        m_Cell = NULL;
+        wxHtmlContainerCell* const
+            cellNew = (wxHtmlContainerCell*) m_Parser->ParseChunk(text);
+        m_Cell = cellShown;
+
+        text.clear();
+
+        if ( cellNew )
+        {
+            // Show the beginning of the page while the rest of it is still
+            // being read, even if drawing is otherwise locked while loading.
+            const bool first = m_Cell == NULL;
+            delete m_Cell;
+            SetPageCell(cellNew);
+            if ( first )
+                Scroll(0, 0);
+
+            const int locks = m_tmpCanDrawLocks;
+            m_tmpCanDrawLocks = 0;
+            Refresh();
+            Update();
+            m_tmpCanDrawLocks = locks;
+        }
+
+        if ( stream.Eof() )
+            break;
+
+        stream.Read(buf.GetWriteBuf(CHUNK_SIZE), CHUNK_SIZE);
+        buf.UngetWriteBuf(stream.LastRead());
+    }
 
-    // The parser doesn't need the DC any more, so ensure it's not left with a
-    // dangling pointer after the DC object goes out of scope.
     m_Parser->SetDC(NULL);
 
+    // The caller passes the full page to SetPage(), so don't parse it here.
+    return m_Parser->CancelIncrementalParsing();
+}
+
+void wxHtmlWindow::InitParserDC(wxDC& dc)
+{
+    dc.SetMapMode(wxMM_TEXT);
+    SetBackgroundColour(wxColour(0xFF, 0xFF, 0xFF));
+    SetBackgroundImage(wxNullBitmap);
+
+    m_Parser->SetDC(&dc, GetHTMLPixelScale(this), 1.0);
+}
+
+void wxHtmlWindow::SetPageCell(wxHtmlContainerCell *cell)
+{
+    m_Cell = cell;
     m_Cell->SetIndent(m_Borders, wxHTML_INDENT_ALL, wxHTML_UNITS_PIXELS);
     m_Cell->SetAlignHor(wxHTML_ALIGN_CENTER);
     CreateLayout();
-    if (m_tmpCanDrawLocks == 0)
-        Refresh();
-    return true;
+}
+
+bool wxHtmlWindow::HasProcessors() const
+{
+    return (m_Processors && !m_Processors->empty()) ||
+           (m_GlobalProcessors && !m_GlobalProcessors->empty());
 }
 
 bool wxHtmlWindow::AppendToPage(const wxString& source)
@@ -603,24 +1758,42 @@ bool wxHtmlWindow::LoadPage(const wxString& location)
             }
 #endif // wxUSE_STATUSBAR
 
+            wxHtmlFilter *filter = NULL;
             node = m_Filters.GetFirst();
             while (node)
             {
                 wxHtmlFilter *h = (wxHtmlFilter*) node->GetData();
                 if (h->CanRead(*f))
                 {
-                    src = h->ReadFile(*f);
+                    filter = h;
                     break;
                 }
                 node = node->GetNext();
             }
-            if (src.empty())
+
+            m_FS->ChangePathTo(f->GetLocation());
+
+            // If enabled, HTML documents, which may be very big, are shown
+            // while they're being read, unless they need to be preprocessed
+            // as a whole (or are read by a custom filter).
+            if ( m_incrementalLoading && filter &&
+                    filter->GetClassInfo() == wxCLASSINFO(wxHtmlFilterHTML) &&
+                        f->GetStream() && !HasProcessors() )
+            {
+                src = DoReadPageIncrementally(*f->GetStream(),
+                                              f->GetMimeType());
+            }
+            else
             {
-                if (m_DefaultFilter == NULL) m_DefaultFilter = GetDefaultFilter();
-                src = m_DefaultFilter->ReadFile(*f);
+                if (filter)
+                    src = filter->ReadFile(*f);
+                if (src.empty())
+                {
+                    if (m_DefaultFilter == NULL) m_DefaultFilter = GetDefaultFilter();
+                    src = m_DefaultFilter->ReadFile(*f);
+                }
             }
 
-            m_FS->ChangePathTo(f->GetLocation());
             rt_val = SetPage(src);
             m_OpenedPage = f->GetLocation();
             if (!f->GetAnchor().empty())
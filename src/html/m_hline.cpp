@@ -37,6 +37,7 @@ class wxHtmlLineCell : public wxHtmlCell
                   wxHtmlRenderingInfo& info) override;
         void Layout(int w) override
             { m_Width = w; wxHtmlCell::Layout(w); }
+        bool NeedsDrawInvisible() const override { return false; }
 
     private:
         // Should we draw 3-D shading or not
@@ -65,6 +65,7 @@ class wxHtmlImageMapAreaCell : public wxHtmlCell
                   int WXUNUSED(x), int WXUNUSED(y),
                   int WXUNUSED(view_y1), int WXUNUSED(view_y2),
                   wxHtmlRenderingInfo& WXUNUSED(info)) override {}
+        bool NeedsDrawInvisible() const override { return false; }
 
 
     wxDECLARE_NO_COPY_CLASS(wxHtmlImageMapAreaCell);
@@ -244,6 +245,7 @@ class wxHtmlImageMapCell : public wxHtmlCell
                   int WXUNUSED(x), int WXUNUSED(y),
                   int WXUNUSED(view_y1), int WXUNUSED(view_y2),
                   wxHtmlRenderingInfo& WXUNUSED(info)) override {}
+        bool NeedsDrawInvisible() const override { return false; }
 
     wxDECLARE_NO_COPY_CLASS(wxHtmlImageMapCell);
 };
@@ -293,6 +295,7 @@ public:
     virtual ~wxHtmlImageCell();
     void Draw(wxDC& dc, int x, int y, int view_y1, int view_y2,
               wxHtmlRenderingInfo& info) override;
+    bool NeedsDrawInvisible() const override { return false; }
     virtual wxHtmlLinkInfo *GetLink(int x = 0, int y = 0) const override;
 
     void SetImage(const wxImage& img, double scaleHDPI = 1.0);
@@ -314,12 +317,26 @@ public:
     }
 
 private:
+    // Return the bitmap to draw, creating it from m_image if necessary.
+    //
+    // The bitmap is only created when the image is shown for the first time,
+    // in the main thread, as the cells may be created by a background thread
+    // (see wxHtmlWindow::SetPageAsync()).
+    wxBitmap *GetBitmap();
+
+    // Return the size of the image in logical pixels or wxDefaultSize if
+    // there is no image at all.
+    wxSize GetLogicalImageSize() const;
+
     wxBitmap           *m_bitmap;
+    wxImage             m_image;
+    double              m_imageScale;
     int                 m_align;
     int                 m_bmpW, m_bmpH;
     bool                m_bmpWpercent:1;
     bool                m_bmpHpresent:1;
     bool                m_showFrame:1;
+    bool                m_brokenImage:1;
     wxHtmlWindowInterface *m_windowIface;
 #if wxUSE_GIF && wxUSE_TIMER
     wxGIFDecoder       *m_gifDecoder;
@@ -367,7 +384,9 @@ wxHtmlImageCell::wxHtmlImageCell(wxHtmlWindowInterface *windowIface,
     m_windowIface = windowIface;
     m_scale = scale;
     m_showFrame = false;
+    m_brokenImage = false;
     m_bitmap = NULL;
+    m_imageScale = 1.0;
     m_bmpW   = w;
     m_bmpH   = h;
     m_align  = align;
@@ -405,18 +424,10 @@ wxHtmlImageCell::wxHtmlImageCell(wxHtmlWindowInterface *windowIface,
 
                         readImg = false;
 
-                        if ( m_gifDecoder->IsAnimation() )
-                        {
-                            m_gifTimer = new wxGIFTimer(this);
-                            long delay = m_gifDecoder->GetDelay(0);
-                            if ( delay == 0 )
-                                delay = 1;
-                            m_gifTimer->Start(delay, true);
-                        }
-                        else
-                        {
+                        // The animation timer is only started when the
+                        // image is drawn for the first time, see Draw().
+                        if ( !m_gifDecoder->IsAnimation() )
                             wxDELETE(m_gifDecoder);
-                        }
                     }
                     else
                     {
@@ -446,8 +457,7 @@ wxHtmlImageCell::wxHtmlImageCell(wxHtmlWindowInterface *windowIface,
                 if ( m_bmpW == wxDefaultCoord ) m_bmpW = 31;
                 if ( m_bmpH == wxDefaultCoord ) m_bmpH = 33;
             }
-            m_bitmap =
-                new wxBitmap(wxArtProvider::GetBitmap(wxART_MISSING_IMAGE));
+            m_brokenImage = true;
         }
     }
     //else: ignore the 0-sized images used sometimes on the Web pages
@@ -459,7 +469,7 @@ void wxHtmlImageCell::SetImage(const wxImage& img, double scaleHDPI)
 #if !defined(__WXMSW__) || wxUSE_WXDIB
     if ( img.IsOk() )
     {
-        delete m_bitmap;
+        wxDELETE(m_bitmap);
 
         int ww, hh;
         ww = img.GetWidth();
@@ -471,12 +481,44 @@ void wxHtmlImageCell::SetImage(const wxImage& img, double scaleHDPI)
             m_bmpH = hh / scaleHDPI;
 
         // On a Mac retina screen, we might have found a @2x version of the image,
-        // so specify this scale factor.
-        m_bitmap = new wxBitmap(img, -1, scaleHDPI);
+        // so remember this scale factor to use it for the bitmap.
+        m_image = img;
+        m_imageScale = scaleHDPI;
     }
 #endif
 }
 
+wxBitmap *wxHtmlImageCell::GetBitmap()
+{
+    if ( !m_bitmap )
+    {
+        if ( m_image.IsOk() )
+        {
+            m_bitmap = new wxBitmap(m_image, -1, m_imageScale);
+            m_image.Destroy();
+        }
+        else if ( m_brokenImage )
+        {
+            m_bitmap =
+                new wxBitmap(wxArtProvider::GetBitmap(wxART_MISSING_IMAGE));
+        }
+    }
+
+    return m_bitmap;
+}
+
+wxSize wxHtmlImageCell::GetLogicalImageSize() const
+{
+    if ( m_bitmap )
+        return m_bitmap->GetLogicalSize();
+
+    if ( m_image.IsOk() )
+        return wxSize(wxRound(m_image.GetWidth() / m_imageScale),
+                      wxRound(m_image.GetHeight() / m_imageScale));
+
+    return wxDefaultSize;
+}
+
 void wxHtmlImageCell::SetAlt(const wxString& alt)
 {
     m_alt = alt;
@@ -521,7 +563,7 @@ void wxHtmlImageCell::AdvanceAnimation(wxTimer *timer)
         {
             wxBitmap bmp(img);
             wxMemoryDC dc;
-            dc.SelectObject(*m_bitmap);
+            dc.SelectObject(*GetBitmap());
             dc.DrawBitmap(bmp, m_gifDecoder->GetFramePosition(m_nCurrFrame),
                           true /* use mask */);
         }
@@ -545,8 +587,9 @@ void wxHtmlImageCell::Layout(int w)
 
         m_Width = w*m_bmpW/100;
 
-        if (!m_bmpHpresent && m_bitmap != NULL)
-            m_Height = m_bitmap->GetLogicalHeight()*m_Width/m_bitmap->GetLogicalWidth();
+        const wxSize sizeImage = GetLogicalImageSize();
+        if (!m_bmpHpresent && sizeImage.x > 0)
+            m_Height = sizeImage.y*m_Width/sizeImage.x;
         else
             m_Height = static_cast<int>(m_scale*m_bmpH);
     } else
@@ -596,7 +639,19 @@ void wxHtmlImageCell::Draw(wxDC& dc, int x, int y,
         dc.DrawRectangle(x + m_PosX, y + m_PosY, m_Width, m_Height);
         x++, y++;
     }
-    if ( m_bitmap && m_Width && m_Height )
+
+#if wxUSE_GIF && wxUSE_TIMER
+    if ( m_gifDecoder && !m_gifTimer )
+    {
+        m_gifTimer = new wxGIFTimer(this);
+        long delay = m_gifDecoder->GetDelay(m_nCurrFrame);
+        if ( delay == 0 )
+            delay = 1;
+        m_gifTimer->Start(delay, true);
+    }
+#endif
+
+    if ( GetBitmap() && m_Width && m_Height )
     {
         // We add in the scaling from the desired bitmap width
         // and height, so we only do the scaling once.
@@ -690,10 +745,14 @@ TAG_HANDLER_BEGIN(IMG, "IMG,MAP,AREA")
 
 #if defined(__WXOSX_COCOA__)
                 // Try to find a 2x resolution image with @2x appended before the file extension.
-                wxWindow* win = m_WParser->GetWindowInterface() ? m_WParser->GetWindowInterface()->GetHTMLWindow() : NULL;
-                if (!win)
-                    win = wxApp::GetMainTopWindow();
-                if (win && win->GetContentScaleFactor() > 1.0)
+                // Don't use the window directly here, as this may be executed
+                // in a worker thread, see wxHtmlWindow::SetPageAsync().
+                double contentScale = 1.0;
+                if (wxHtmlWindowInterface* const winIface = m_WParser->GetWindowInterface())
+                    contentScale = winIface->GetHTMLContentScaleFactor();
+                else if (wxWindow* const win = wxApp::GetMainTopWindow())
+                    contentScale = win->GetContentScaleFactor();
+                if (contentScale > 1.0)
                 {
                     if (tmp.Find('.') != wxNOT_FOUND)
                     {
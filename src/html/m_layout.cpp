@@ -68,6 +68,7 @@ public:
               int WXUNUSED(x), int WXUNUSED(y),
               int WXUNUSED(view_y1), int WXUNUSED(view_y2),
               wxHtmlRenderingInfo& WXUNUSED(info)) override {}
+    bool NeedsDrawInvisible() const override { return false; }
 
 private:
     wxDECLARE_NO_COPY_CLASS(wxHtmlPageBreakCell);
@@ -332,7 +333,7 @@ TAG_HANDLER_BEGIN(BODY, "BODY")
                 {
                     wxImage image(*is);
                     if ( image.IsOk() )
-                        winIface->SetHTMLBackgroundImage(image);
+                        winIface->SetHTMLBackgroundFromImage(image);
                 }
 
                 delete fileBgImage;
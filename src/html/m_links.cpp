@@ -34,6 +34,7 @@ public:
               int WXUNUSED(x), int WXUNUSED(y),
               int WXUNUSED(view_y1), int WXUNUSED(view_y2),
               wxHtmlRenderingInfo& WXUNUSED(info)) override {}
+    virtual bool NeedsDrawInvisible() const override { return false; }
 
     virtual const wxHtmlCell* Find(int condition, const void* param) const override
     {
@@ -36,6 +36,7 @@ class wxHtmlListmarkCell : public wxHtmlCell
         wxHtmlListmarkCell(wxDC *dc, const wxColour& clr);
         void Draw(wxDC& dc, int x, int y, int view_y1, int view_y2,
                   wxHtmlRenderingInfo& info) override;
+        bool NeedsDrawInvisible() const override { return false; }
 
     wxDECLARE_NO_COPY_CLASS(wxHtmlListmarkCell);
 };
@@ -250,7 +251,8 @@ TAG_HANDLER_BEGIN(OLULLI, "OL,UL,LI")
                 c->SetAlignHor(wxHTML_ALIGN_RIGHT);
                 wxString markStr;
                 markStr.Printf(wxT("%i. "), m_Numbering);
-                c->InsertCell(new wxHtmlWordCell(markStr, *(m_WParser->GetDC())));
+                c->InsertCell(new wxHtmlWordCell(markStr, *(m_WParser->GetDC()),
+                                                 &m_WParser->GetTextExtentCache()));
             }
             m_WParser->CloseContainer();
 
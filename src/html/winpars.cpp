@@ -156,6 +156,10 @@ void wxHtmlWinParser::SetFonts(const wxString& normal_face,
     m_FontFaceFixed = fixed_face;
     m_FontFaceNormal = normal_face;
 
+    // The fonts are going to be recreated, so the extents measured with the
+    // old ones are not going to be used any more.
+    m_textExtentCache.Clear();
+
 #if !wxUSE_UNICODE
     SetInputEncoding(m_InputEnc);
 #endif
@@ -202,7 +206,7 @@ void wxHtmlWinParser::InitParser(const wxString& source)
     // we're not using GetCharWidth/Height() because of
     // differences under X and win
     wxCoord w,h;
-    m_DC->GetTextExtent( wxT("H"), &w, &h);
+    m_textExtentCache.GetTextExtent(*m_DC, wxT("H"), &w, &h);
     m_CharWidth = w;
     m_CharHeight = h;
 
@@ -210,10 +214,11 @@ void wxHtmlWinParser::InitParser(const wxString& source)
     m_Link = wxHtmlLinkInfo( wxEmptyString );
     m_LinkColor.Set(0, 0, 0xFF);
     m_ActualColor.Set(0, 0, 0);
-    const wxColour windowColour = wxSystemSettings::GetColour(wxSYS_COLOUR_WINDOW) ;
+    // Don't query the system colour unless really needed, this parser may be
+    // used from a background thread by wxHtmlWindow::SetPageAsync().
     m_ActualBackgroundColor = m_windowInterface
                             ? m_windowInterface->GetHTMLBackgroundColour()
-                            : windowColour;
+                            : wxSystemSettings::GetColour(wxSYS_COLOUR_WINDOW);
     m_ActualBackgroundMode = wxBRUSHSTYLE_TRANSPARENT;
     m_Align = wxHTML_ALIGN_LEFT;
     m_ScriptMode = wxHTML_SCRIPT_NORMAL;
@@ -491,7 +496,8 @@ void wxHtmlWinParser::AddPreBlock(const wxString& text)
         if ( copyFrom != text.end() )
             text2.append(copyFrom, text.end());
 
-        AddWord(new wxHtmlWordWithTabsCell(text2, text, m_posColumn, *(GetDC())));
+        AddWord(new wxHtmlWordWithTabsCell(text2, text, m_posColumn, *(GetDC()),
+                                           &m_textExtentCache));
 
         m_posColumn = posColumn;
     }
@@ -547,6 +553,9 @@ void wxHtmlWinParser::SetDC(wxDC *dc, double pixel_scale, double font_scale)
     m_DC = dc;
     m_PixelScale = pixel_scale;
     m_FontScale = font_scale;
+
+    if ( m_DC )
+        m_textExtentCache.UseDC(*m_DC);
 }
 
 void wxHtmlWinParser::SetFontPointSize(int pt)
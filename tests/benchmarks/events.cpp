@@ -0,0 +1,187 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/events.cpp
+// Purpose:     Event dispatching benchmarks
+// Author:      wxWidgets team
+// Created:     2026-10-17
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/app.h"
+#include "wx/event.h"
+#include "wx/thread.h"
+
+#include "bench.h"
+
+#include <vector>
+
+namespace
+{
+
+// Handler with many dynamically bound event handlers, as typically happens
+// for the windows in big applications.
+wxEvtHandler* gs_handler = NULL;
+
+// All the event types used by the handlers bound to gs_handler.
+std::vector<wxEventType> gs_eventTypes;
+
+// Event type not used by any handler.
+wxEventType gs_unboundEventType = wxEVT_NULL;
+
+int gs_numHandled = 0;
+
+void OnThreadEvent(wxThreadEvent& WXUNUSED(event))
+{
+    gs_numHandled++;
+}
+
+bool InitManyBindings()
+{
+    gs_handler = new wxEvtHandler;
+
+    // Use several handlers for each of the event types, interleaving them.
+    const int numTypes = Bench::GetNumericParameter(100);
+    const int handlersPerType = 4;
+
+    for ( int n = 0; n < numTypes; n++ )
+        gs_eventTypes.push_back(wxNewEventType());
+
+    for ( int h = 0; h < handlersPerType; h++ )
+    {
+        for ( int n = 0; n < numTypes; n++ )
+        {
+            gs_handler->Bind(wxEventTypeTag<wxThreadEvent>(gs_eventTypes[n]),
+                             &OnThreadEvent, wxID_HIGHEST + h);
+        }
+    }
+
+    gs_unboundEventType = wxNewEventType();
+
+    return true;
+}
+
+void DoneManyBindings()
+{
+    wxDELETE(gs_handler);
+    gs_eventTypes.clear();
+}
+
+} // anonymous namespace
+
+// Process the events of all types bound to the handler.
+BENCHMARK_FUNC_WITH_INIT(ProcessEventManyBindings,
+                         InitManyBindings, DoneManyBindings)
+{
+    const int numHandledBefore = gs_numHandled;
+
+    for ( size_t n = 0; n < gs_eventTypes.size(); n++ )
+    {
+        wxThreadEvent event(gs_eventTypes[n], wxID_HIGHEST);
+        gs_handler->ProcessEventLocally(event);
+    }
+
+    return gs_numHandled - numHandledBefore == (int)gs_eventTypes.size();
+}
+
+// Process events for which there are no handlers at all, this is the most
+// common case, e.g. for mouse move events for most of the windows.
+BENCHMARK_FUNC_WITH_INIT(ProcessEventManyBindingsUnhandled,
+                         InitManyBindings, DoneManyBindings)
+{
+    bool handled = false;
+
+    for ( size_t n = 0; n < gs_eventTypes.size(); n++ )
+    {
+        wxThreadEvent event(gs_unboundEventType);
+        handled |= gs_handler->ProcessEventLocally(event);
+    }
+
+    return !handled;
+}
+
+namespace
+{
+
+// Handler used for the benchmarks of the queued events.
+wxEvtHandler* gs_queueHandler = NULL;
+
+bool InitQueue()
+{
+    gs_queueHandler = new wxEvtHandler;
+    gs_queueHandler->Bind(wxEVT_THREAD, &OnThreadEvent);
+
+    return true;
+}
+
+void DoneQueue()
+{
+    wxDELETE(gs_queueHandler);
+}
+
+const int NUM_QUEUED_EVENTS = 10000;
+
+void QueueEvents()
+{
+    for ( int n = 0; n < NUM_QUEUED_EVENTS; n++ )
+        wxQueueEvent(gs_queueHandler, new wxThreadEvent);
+}
+
+#if wxUSE_THREADS
+
+// Thread queuing events for gs_queueHandler.
+class EventQueuingThread : public wxThread
+{
+public:
+    EventQueuingThread() : wxThread(wxTHREAD_JOINABLE) { }
+
+protected:
+    virtual void* Entry() override
+    {
+        QueueEvents();
+
+        return NULL;
+    }
+};
+
+#endif // wxUSE_THREADS
+
+} // anonymous namespace
+
+// Queue many events and then process all of them.
+BENCHMARK_FUNC_WITH_INIT(QueueEvent, InitQueue, DoneQueue)
+{
+    const int numHandledBefore = gs_numHandled;
+
+    QueueEvents();
+    wxTheApp->ProcessPendingEvents();
+
+    return gs_numHandled - numHandledBefore == NUM_QUEUED_EVENTS;
+}
+
+#if wxUSE_THREADS
+
+// Same as above, but queue the events from several threads at once.
+BENCHMARK_FUNC_WITH_INIT(QueueEventFromThreads, InitQueue, DoneQueue)
+{
+    const int numHandledBefore = gs_numHandled;
+
+    const int numThreads = 4;
+    EventQueuingThread* threads[numThreads];
+    for ( int n = 0; n < numThreads; n++ )
+    {
+        threads[n] = new EventQueuingThread;
+        threads[n]->Run();
+    }
+
+    for ( int n = 0; n < numThreads; n++ )
+    {
+        threads[n]->Wait();
+        delete threads[n];
+    }
+
+    wxTheApp->ProcessPendingEvents();
+
+    return gs_numHandled - numHandledBefore == numThreads*NUM_QUEUED_EVENTS;
+}
+
+#endif // wxUSE_THREADS
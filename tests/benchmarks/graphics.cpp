@@ -18,6 +18,8 @@
 #include "wx/stopwatch.h"
 #include "wx/crt.h"
 
+#include <vector>
+
 #if wxUSE_GLCANVAS
     #include "wx/glcanvas.h"
     #ifdef _MSC_VER
@@ -57,6 +59,8 @@ struct GraphicsBenchmarkOptions
         width = 800;
         height = 600;
 
+        clipSize = 0;
+
         numIters = 1000;
 
         testBitmaps =
@@ -64,6 +68,7 @@ struct GraphicsBenchmarkOptions
         testLines =
         testRawBitmaps =
         testRectangles =
+        testBatches =
         testCircles =
         testEllipses =
         testTextExtent =
@@ -85,6 +90,7 @@ struct GraphicsBenchmarkOptions
          penWidth,
          width,
          height,
+         clipSize,
          numIters;
 
     wxPenStyle penStyle;
@@ -95,6 +101,7 @@ struct GraphicsBenchmarkOptions
          testLines,
          testRawBitmaps,
          testRectangles,
+         testBatches,
          testCircles,
          testEllipses,
          testTextExtent,
@@ -389,8 +396,11 @@ private:
         }
         else if ( opts.useGC && gcdc.IsOk() )
         {
-            wxString rendName = gcdc.GetGraphicsContext()->GetRenderer()->GetName();
-            BenchmarkAll(wxString::Format("%6s GC (%s)", dckind, rendName.c_str()), gcdc);
+            wxGraphicsContext* const gc = gcdc.GetGraphicsContext();
+            wxString rendName = gc->GetRenderer()->GetName();
+            const wxString msg = wxString::Format("%6s GC (%s)", dckind, rendName.c_str());
+            BenchmarkAll(msg, gcdc);
+            BenchmarkBatches(msg, *gc);
         }
     }
 
@@ -435,6 +445,12 @@ private:
 
         if ( setPen )
             dc.SetPen(penInfo);
+
+        // This allows to check how much time is spent on drawing the parts
+        // which are not visible at all, as when repainting a small part of
+        // the window.
+        if ( opts.clipSize != 0 )
+            dc.SetClippingRegion(0, 0, opts.clipSize, opts.clipSize);
     }
 
     void BenchmarkLines(const wxString& msg, wxDC& dc)
@@ -554,6 +570,94 @@ private:
                  opts.numIters, t, (1000. * t)/opts.numIters);
     }
 
+    void ReportPrimitives(const char* what, long t)
+    {
+        wxPrintf("%ld %s done in %ldms = %gus/primitive or %.0f primitives/s\n",
+                 opts.numIters, what, t, (1000. * t)/opts.numIters,
+                 t ? (1000. * opts.numIters)/t : 0.);
+    }
+
+    // Compare drawing many primitives one by one and using the batch
+    // functions of wxGraphicsContext.
+    void BenchmarkBatches(const wxString& msg, wxGraphicsContext& gc)
+    {
+        if ( !opts.testBatches )
+            return;
+
+        gc.PushState();
+
+        if ( opts.clipSize != 0 )
+            gc.Clip(0, 0, opts.clipSize, opts.clipSize);
+
+        gc.SetPen(wxPen(*wxWHITE, opts.penWidth));
+        gc.SetBrush(*wxRED_BRUSH);
+
+        std::vector<wxPoint2DDouble> begins(opts.numIters),
+                                     ends(opts.numIters);
+        std::vector<wxRect2DDouble> rects(opts.numIters);
+        for ( long n = 0; n < opts.numIters; n++ )
+        {
+            begins[n] = wxPoint2DDouble(rand() % opts.width, rand() % opts.height);
+            ends[n] = wxPoint2DDouble(rand() % opts.width, rand() % opts.height);
+            rects[n] = wxRect2DDouble(begins[n].m_x, begins[n].m_y, 8, 8);
+        }
+
+        wxPrintf("Benchmarking %s: ", msg);
+        fflush(stdout);
+
+        wxStopWatch sw;
+        for ( long n = 0; n < opts.numIters; n++ )
+            gc.StrokeLine(begins[n].m_x, begins[n].m_y, ends[n].m_x, ends[n].m_y);
+        ReportPrimitives("single lines", sw.Time());
+
+        wxPrintf("Benchmarking %s: ", msg);
+        fflush(stdout);
+
+        sw.Start();
+        gc.StrokeLines(opts.numIters, &begins[0], &ends[0]);
+        ReportPrimitives("batched lines", sw.Time());
+
+        gc.SetPen(wxNullGraphicsPen);
+
+        wxPrintf("Benchmarking %s: ", msg);
+        fflush(stdout);
+
+        sw.Start();
+        for ( long n = 0; n < opts.numIters; n++ )
+            gc.DrawRectangle(rects[n].m_x, rects[n].m_y, rects[n].m_width, rects[n].m_height);
+        ReportPrimitives("single rects", sw.Time());
+
+        wxPrintf("Benchmarking %s: ", msg);
+        fflush(stdout);
+
+        sw.Start();
+        gc.FillRectangles(opts.numIters, &rects[0]);
+        ReportPrimitives("batched rects", sw.Time());
+
+        // Markers are typically small circles with an outline.
+        gc.SetPen(*wxBLACK_PEN);
+        gc.SetBrush(*wxGREEN_BRUSH);
+
+        wxPrintf("Benchmarking %s: ", msg);
+        fflush(stdout);
+
+        sw.Start();
+        for ( long n = 0; n < opts.numIters; n++ )
+            gc.DrawEllipse(begins[n].m_x - 3, begins[n].m_y - 3, 6, 6);
+        ReportPrimitives("single markers", sw.Time());
+
+        wxPrintf("Benchmarking %s: ", msg);
+        fflush(stdout);
+
+        sw.Start();
+        wxGraphicsPath marker = gc.CreatePath();
+        marker.AddCircle(0, 0, 3);
+        gc.DrawMarkers(opts.numIters, &begins[0], marker);
+        ReportPrimitives("batched markers", sw.Time());
+
+        gc.PopState();
+    }
+
     void BenchmarkRoundedRectangles(const wxString& msg, wxDC& dc)
     {
         if ( !opts.testRectangles )
@@ -864,6 +968,7 @@ public:
             { wxCMD_LINE_SWITCH, "",  "lines" },
             { wxCMD_LINE_SWITCH, "",  "rawbmp" },
             { wxCMD_LINE_SWITCH, "",  "rectangles" },
+            { wxCMD_LINE_SWITCH, "",  "batches" },
             { wxCMD_LINE_SWITCH, "",  "circles" },
             { wxCMD_LINE_SWITCH, "",  "ellipses" },
             { wxCMD_LINE_SWITCH, "",  "textextent" },
@@ -883,6 +988,7 @@ public:
             { wxCMD_LINE_OPTION, "",  "pen-quality", "default | low | high", wxCMD_LINE_VAL_STRING },
             { wxCMD_LINE_OPTION, "w", "width", "", wxCMD_LINE_VAL_NUMBER },
             { wxCMD_LINE_OPTION, "h", "height", "", wxCMD_LINE_VAL_NUMBER },
+            { wxCMD_LINE_OPTION, "c", "clip", "size of the clipping square", wxCMD_LINE_VAL_NUMBER },
             { wxCMD_LINE_OPTION, "I", "images", "", wxCMD_LINE_VAL_NUMBER },
             { wxCMD_LINE_OPTION, "N", "number-of-iterations", "", wxCMD_LINE_VAL_NUMBER },
 #ifdef __WXMSW__
@@ -946,6 +1052,8 @@ public:
             return false;
         if ( parser.Found("h", &opts.height) && opts.height < 1 )
             return false;
+        if ( parser.Found("c", &opts.clipSize) && opts.clipSize < 1 )
+            return false;
         if ( parser.Found("N", &opts.numIters) && opts.numIters < 1 )
             return false;
 
@@ -954,6 +1062,7 @@ public:
         opts.testLines = parser.Found("lines");
         opts.testRawBitmaps = parser.Found("rawbmp");
         opts.testRectangles = parser.Found("rectangles");
+        opts.testBatches = parser.Found("batches");
         opts.testCircles = parser.Found("circles");
         opts.testEllipses = parser.Found("ellipses");
         opts.testTextExtent = parser.Found("textextent");
@@ -961,6 +1070,7 @@ public:
         opts.testPartialTextExtents = parser.Found("partialtextextents");
         if ( !(opts.testBitmaps || opts.testImages || opts.testLines
                     || opts.testRawBitmaps || opts.testRectangles
+                    || opts.testBatches
                     || opts.testCircles || opts.testEllipses
                     || opts.testTextExtent || opts.testPartialTextExtents) )
         {
@@ -970,6 +1080,7 @@ public:
             opts.testLines =
             opts.testRawBitmaps =
             opts.testRectangles =
+            opts.testBatches =
             opts.testCircles =
             opts.testEllipses =
             opts.testTextExtent =
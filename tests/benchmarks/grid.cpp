@@ -0,0 +1,214 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/grid.cpp
+// Purpose:     wxGrid table benchmarks
+// Author:      wxWidgets team
+// Created:     2022-05-02
+// Copyright:   (c) 2022 wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/grid.h"
+#include "wx/crt.h"
+
+#include "bench.h"
+
+#if wxUSE_GRID
+
+#include <memory>
+
+#ifdef __LINUX__
+    #include "wx/ffile.h"
+
+    #include <unistd.h>
+#endif
+
+namespace
+{
+
+// Number of columns of each type used in the tables below.
+const int NUM_LONG_COLS = 4;
+const int NUM_DOUBLE_COLS = 4;
+const int NUM_STRING_COLS = 2;
+const int NUM_COLS = NUM_LONG_COLS + NUM_DOUBLE_COLS + NUM_STRING_COLS;
+
+int GetNumRows()
+{
+    return Bench::GetNumericParameter(100000);
+}
+
+// Return the value of the given string cell: use relatively few distinct
+// values, as is typical for the real data.
+wxString GetStringCellValue(int row, int col)
+{
+    return wxString::Format("Item %d", (row * (col + 1)) % 1000);
+}
+
+// Return the resident memory size of the current process in KiB, or -1 if it
+// can't be determined.
+long GetUsedMemory()
+{
+#ifdef __LINUX__
+    wxFFile file("/proc/self/statm");
+    wxString statm;
+    if ( !file.IsOpened() || !file.ReadAll(&statm) )
+        return -1;
+
+    long pages;
+    if ( !statm.AfterFirst(' ').BeforeFirst(' ').ToLong(&pages) )
+        return -1;
+
+    return pages * (sysconf(_SC_PAGESIZE) / 1024);
+#else
+    return -1;
+#endif
+}
+
+void FillStringTable(wxGridStringTable& table)
+{
+    const int numRows = table.GetNumberRows();
+    for ( int row = 0; row < numRows; row++ )
+    {
+        int col = 0;
+        for ( int n = 0; n < NUM_LONG_COLS; n++, col++ )
+            table.SetValue(row, col, wxString::Format("%d", row + n));
+        for ( int n = 0; n < NUM_DOUBLE_COLS; n++, col++ )
+            table.SetValue(row, col, wxString::FromDouble(row / (n + 2.)));
+        for ( int n = 0; n < NUM_STRING_COLS; n++, col++ )
+            table.SetValue(row, col, GetStringCellValue(row, n));
+    }
+}
+
+void FillColumnarTable(wxGridColumnarTable& table)
+{
+    const int numRows = table.GetNumberRows();
+
+    int col = 0;
+    for ( int n = 0; n < NUM_LONG_COLS; n++, col++ )
+    {
+        for ( int row = 0; row < numRows; row++ )
+            table.SetValueAsLong(row, col, row + n);
+    }
+    for ( int n = 0; n < NUM_DOUBLE_COLS; n++, col++ )
+    {
+        for ( int row = 0; row < numRows; row++ )
+            table.SetValueAsDouble(row, col, row / (n + 2.));
+    }
+    for ( int n = 0; n < NUM_STRING_COLS; n++, col++ )
+    {
+        for ( int row = 0; row < numRows; row++ )
+            table.SetValue(row, col, GetStringCellValue(row, n));
+    }
+}
+
+wxGridColumnarTable* CreateColumnarTable(int numRows)
+{
+    wxGridColumnarTable* const table = new wxGridColumnarTable(numRows);
+    for ( int n = 0; n < NUM_LONG_COLS; n++ )
+        table->AppendColumn(wxGRID_COLUMN_LONG);
+    for ( int n = 0; n < NUM_DOUBLE_COLS; n++ )
+        table->AppendColumn(wxGRID_COLUMN_DOUBLE);
+    for ( int n = 0; n < NUM_STRING_COLS; n++ )
+        table->AppendColumn(wxGRID_COLUMN_STRING);
+
+    return table;
+}
+
+// Sum all numeric values in the table, as the numeric renderers would do.
+double SumNumericValues(wxGridTableBase& table)
+{
+    const int numRows = table.GetNumberRows();
+
+    double sum = 0;
+    for ( int col = 0; col < NUM_LONG_COLS + NUM_DOUBLE_COLS; col++ )
+    {
+        const bool canGetDouble = table.CanGetValueAs(0, col,
+                                                      wxGRID_VALUE_FLOAT);
+        for ( int row = 0; row < numRows; row++ )
+        {
+            double d;
+            if ( canGetDouble )
+                d = table.GetValueAsDouble(row, col);
+            else if ( !table.GetValue(row, col).ToDouble(&d) )
+                return -1;
+
+            sum += d;
+        }
+    }
+
+    return sum;
+}
+
+wxGridStringTable* gs_stringTable = NULL;
+wxGridColumnarTable* gs_columnarTable = NULL;
+
+bool InitStringTable()
+{
+    const long memBefore = GetUsedMemory();
+
+    gs_stringTable = new wxGridStringTable(GetNumRows(), NUM_COLS);
+    FillStringTable(*gs_stringTable);
+
+    if ( memBefore != -1 )
+    {
+        wxPrintf("wxGridStringTable with %d rows uses %ldKiB\n",
+                 GetNumRows(), GetUsedMemory() - memBefore);
+    }
+
+    return true;
+}
+
+void DoneStringTable()
+{
+    wxDELETE(gs_stringTable);
+}
+
+bool InitColumnarTable()
+{
+    const long memBefore = GetUsedMemory();
+
+    gs_columnarTable = CreateColumnarTable(GetNumRows());
+    FillColumnarTable(*gs_columnarTable);
+
+    if ( memBefore != -1 )
+    {
+        wxPrintf("wxGridColumnarTable with %d rows uses %ldKiB\n",
+                 GetNumRows(), GetUsedMemory() - memBefore);
+    }
+
+    return true;
+}
+
+void DoneColumnarTable()
+{
+    wxDELETE(gs_columnarTable);
+}
+
+} // anonymous namespace
+
+BENCHMARK_FUNC(GridStringTableFill)
+{
+    wxGridStringTable table(GetNumRows(), NUM_COLS);
+    FillStringTable(table);
+
+    return table.GetNumberRows() == GetNumRows();
+}
+
+BENCHMARK_FUNC(GridColumnarTableFill)
+{
+    std::unique_ptr<wxGridColumnarTable> table(CreateColumnarTable(GetNumRows()));
+    FillColumnarTable(*table);
+
+    return table->GetNumberRows() == GetNumRows();
+}
+
+BENCHMARK_FUNC_WITH_INIT(GridStringTableGet, InitStringTable, DoneStringTable)
+{
+    return SumNumericValues(*gs_stringTable) > 0;
+}
+
+BENCHMARK_FUNC_WITH_INIT(GridColumnarTableGet, InitColumnarTable, DoneColumnarTable)
+{
+    return SumNumericValues(*gs_columnarTable) > 0;
+}
+
+#endif // wxUSE_GRID
@@ -118,3 +118,78 @@ BENCHMARK_FUNC(ShrinkHighQuality)
     return image.Scale(factor*image.GetWidth(), factor*image.GetHeight(),
                        wxIMAGE_QUALITY_HIGH).IsOk();
 }
+
+// Return a 4K image filled with a colour gradient, large enough to make the
+// cost of the per-pixel operations dominate.
+static const wxImage& Get4KImage()
+{
+    static wxImage s_image;
+    if ( !s_image.IsOk() )
+    {
+        const int width = 3840;
+        const int height = 2160;
+
+        s_image.Create(width, height, false);
+        unsigned char* data = s_image.GetData();
+        for ( int y = 0; y < height; y++ )
+        {
+            for ( int x = 0; x < width; x++ )
+            {
+                *data++ = static_cast<unsigned char>(x);
+                *data++ = static_cast<unsigned char>(y);
+                *data++ = static_cast<unsigned char>((x + y) / 2);
+            }
+        }
+    }
+
+    return s_image;
+}
+
+BENCHMARK_FUNC(ConvertToGreyscale)
+{
+    return Get4KImage().ConvertToGreyscale().IsOk();
+}
+
+BENCHMARK_FUNC(ConvertToDisabled)
+{
+    return Get4KImage().ConvertToDisabled().IsOk();
+}
+
+BENCHMARK_FUNC(ChangeLightness)
+{
+    return Get4KImage().ChangeLightness(Bench::GetNumericParameter(150)).IsOk();
+}
+
+BENCHMARK_FUNC(RotateHue)
+{
+    wxImage image = Get4KImage().Copy();
+    image.RotateHue(0.25);
+    return image.IsOk();
+}
+
+BENCHMARK_FUNC(ChangeSaturation)
+{
+    wxImage image = Get4KImage().Copy();
+    image.ChangeSaturation(-0.5);
+    return image.IsOk();
+}
+
+BENCHMARK_FUNC(BlurHorizontal)
+{
+    return Get4KImage().BlurHorizontal(Bench::GetNumericParameter(10)).IsOk();
+}
+
+BENCHMARK_FUNC(BlurVertical)
+{
+    return Get4KImage().BlurVertical(Bench::GetNumericParameter(10)).IsOk();
+}
+
+BENCHMARK_FUNC(Blur)
+{
+    return Get4KImage().Blur(Bench::GetNumericParameter(10)).IsOk();
+}
+
+BENCHMARK_FUNC(GaussianBlur)
+{
+    return Get4KImage().GaussianBlur(Bench::GetNumericParameter(10)).IsOk();
+}
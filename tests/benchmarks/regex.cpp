@@ -34,6 +34,23 @@ BENCHMARK_FUNC(RECompileAndMatch)
     return wxRegEx(RE_SIMPLE).Matches("foo");
 }
 
+BENCHMARK_FUNC(RECompileJIT)
+{
+    return wxRegEx(RE_SIMPLE, wxRE_JIT).IsValid();
+}
+
+BENCHMARK_FUNC(REMatchJIT)
+{
+    static wxRegEx re(RE_SIMPLE, wxRE_JIT);
+    return re.Matches("foo");
+}
+
+BENCHMARK_FUNC(REMatchUTF8)
+{
+    static wxRegEx re(RE_SIMPLE);
+    return re.MatchesUTF8("foo", 3);
+}
+
 // ----------------------------------------------------------------------------
 // Benchmark the cost of using a more complicated regex
 // ----------------------------------------------------------------------------
@@ -72,3 +89,194 @@ BENCHMARK_FUNC(REFindTD)
 
     return matches == 21; // result of "grep -c"
 }
+
+namespace
+{
+
+// Find all matches of the given regex in the test text using GetMatchAll().
+int CountAllMatches(const wxRegEx& re)
+{
+    int matches = 0;
+    wxRegExMatchIterator it = re.GetMatchAll(GetTestText());
+    while ( it.Next() )
+        ++matches;
+
+    return matches;
+}
+
+// Same as above, but working on the UTF-8 buffer.
+int CountAllMatchesUTF8(const wxRegEx& re)
+{
+    static const wxScopedCharBuffer buf = GetTestText().utf8_str();
+
+    int matches = 0;
+    for ( size_t pos = 0; re.MatchesUTF8(buf.data() + pos, buf.length() - pos,
+                                         matches ? wxRE_NOTBOL : 0);
+          ++matches )
+    {
+        size_t start, len;
+        if ( !re.GetMatch(&start, &len) )
+            return -1;
+
+        pos += start + len;
+    }
+
+    return matches;
+}
+
+} // anonymous namespace
+
+BENCHMARK_FUNC(REFindTDJIT)
+{
+    static wxRegEx re("<td>[^<]*</td>", wxRE_ICASE | wxRE_NEWLINE | wxRE_JIT);
+
+    int matches = 0;
+    for ( const wxChar* p = GetTestText().c_str(); re.Matches(p); ++matches )
+    {
+        size_t start, len;
+        if ( !re.GetMatch(&start, &len) )
+            return false;
+
+        p += start + len;
+    }
+
+    return matches == 21;
+}
+
+BENCHMARK_FUNC(REFindAllTD)
+{
+    static wxRegEx re("<td>[^<]*</td>", wxRE_ICASE | wxRE_NEWLINE);
+
+    return CountAllMatches(re) == 21;
+}
+
+BENCHMARK_FUNC(REFindAllTDJIT)
+{
+    static wxRegEx re("<td>[^<]*</td>", wxRE_ICASE | wxRE_NEWLINE | wxRE_JIT);
+
+    return CountAllMatches(re) == 21;
+}
+
+BENCHMARK_FUNC(REFindTDUTF8)
+{
+    static wxRegEx re("<td>[^<]*</td>", wxRE_ICASE | wxRE_NEWLINE);
+
+    return CountAllMatchesUTF8(re) == 21;
+}
+
+BENCHMARK_FUNC(REFindTDUTF8JIT)
+{
+    static wxRegEx re("<td>[^<]*</td>", wxRE_ICASE | wxRE_NEWLINE | wxRE_JIT);
+
+    return CountAllMatchesUTF8(re) == 21;
+}
+
+// ----------------------------------------------------------------------------
+// Benchmark matching many regexes at once
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+const int NUM_SET_PATTERNS = 50;
+
+wxString GetSetPattern(int n)
+{
+    return wxString::Format("error %d: [a-z]+ failed|warning %d", n, n);
+}
+
+const char* const SET_TEXT =
+    "2018-11-15 12:00:00 [info] connection from 10.0.0.1 accepted, "
+    "processing request for /index.html: error 42: read failed";
+
+} // anonymous namespace
+
+BENCHMARK_FUNC(REMatchEach)
+{
+    static wxRegEx* res[NUM_SET_PATTERNS];
+    if ( !res[0] )
+    {
+        for ( int n = 0; n < NUM_SET_PATTERNS; ++n )
+            res[n] = new wxRegEx(GetSetPattern(n), wxRE_NOSUB | wxRE_JIT);
+    }
+
+    int matches = 0;
+    for ( int n = 0; n < NUM_SET_PATTERNS; ++n )
+    {
+        if ( res[n]->Matches(SET_TEXT) )
+            ++matches;
+    }
+
+    return matches == 1;
+}
+
+BENCHMARK_FUNC(REMatchSet)
+{
+    static wxRegExSet set;
+    if ( !set.GetCount() )
+    {
+        for ( int n = 0; n < NUM_SET_PATTERNS; ++n )
+            set.Add(GetSetPattern(n), wxRE_JIT);
+    }
+
+    wxArrayInt indices;
+    return set.Matches(SET_TEXT, &indices) && indices.size() == 1;
+}
+
+// Patterns with wildcards, which may match long strings, are much more
+// expensive to try at every position of the text, notably if the text is long.
+namespace
+{
+
+const char* const SET_WILDCARD_PATTERNS[] =
+{
+    "a.*z",
+    "a.*y",
+    ".*foo",
+    "q$",
+};
+
+wxString GetSetWildcardText()
+{
+    return wxString('a', 10000) + "b";
+}
+
+} // anonymous namespace
+
+BENCHMARK_FUNC(REMatchEachWildcard)
+{
+    static wxRegEx* res[WXSIZEOF(SET_WILDCARD_PATTERNS)];
+    static wxString text;
+    if ( !res[0] )
+    {
+        for ( size_t n = 0; n < WXSIZEOF(SET_WILDCARD_PATTERNS); ++n )
+            res[n] = new wxRegEx(SET_WILDCARD_PATTERNS[n], wxRE_NOSUB | wxRE_JIT);
+
+        text = GetSetWildcardText();
+    }
+
+    int matches = 0;
+    for ( size_t n = 0; n < WXSIZEOF(SET_WILDCARD_PATTERNS); ++n )
+    {
+        if ( res[n]->Matches(text) )
+            ++matches;
+    }
+
+    return matches == 0;
+}
+
+BENCHMARK_FUNC(REMatchSetWildcard)
+{
+    static wxRegExSet set;
+    static wxString text;
+    if ( !set.GetCount() )
+    {
+        for ( size_t n = 0; n < WXSIZEOF(SET_WILDCARD_PATTERNS); ++n )
+            set.Add(SET_WILDCARD_PATTERNS[n], wxRE_JIT);
+
+        text = GetSetWildcardText();
+    }
+
+    wxArrayInt indices;
+    return !set.Matches(text, &indices) && indices.empty();
+}
@@ -0,0 +1,98 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/vscroll.cpp
+// Purpose:     wxVScrolledWindow benchmarks
+// Author:      wxWidgets team
+// Created:     2026-10-17
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/frame.h"
+#include "wx/vscroll.h"
+
+#include "bench.h"
+
+namespace
+{
+
+// Window with many rows of different heights.
+class VarHeightWindow : public wxVScrolledWindow
+{
+public:
+    VarHeightWindow(wxWindow* parent, bool useIndex)
+        : wxVScrolledWindow(parent)
+    {
+        SetClientSize(200, 400);
+
+        if ( useIndex )
+            EnableRowHeightsIndex();
+
+        SetRowCount(Bench::GetNumericParameter(10000000));
+    }
+
+protected:
+    virtual wxCoord OnGetRowHeight(size_t n) const override
+    {
+        return 10 + n % 7;
+    }
+};
+
+wxFrame* gs_frame = NULL;
+VarHeightWindow* gs_window = NULL;
+
+void CreateWindow(bool useIndex)
+{
+    gs_frame = new wxFrame(NULL, wxID_ANY, "wxVScrolledWindow benchmark");
+    gs_window = new VarHeightWindow(gs_frame, useIndex);
+}
+
+bool InitWithoutIndex()
+{
+    CreateWindow(false);
+
+    return true;
+}
+
+bool InitWithIndex()
+{
+    CreateWindow(true);
+
+    return true;
+}
+
+void DoneWindow()
+{
+    gs_window = NULL;
+    wxDELETE(gs_frame);
+}
+
+// Jump to the rows spread over the entire window and find the positions of
+// the visible rows, as is done when repainting the window after scrolling.
+bool ScrollThroughRows()
+{
+    const size_t numRows = gs_window->GetRowCount();
+    const size_t numSteps = 100;
+
+    wxCoord total = 0;
+    for ( size_t n = 0; n < numSteps; n++ )
+    {
+        gs_window->ScrollToRow((numRows / numSteps)*n);
+
+        total += gs_window->CalcUnscrolledPosition(0);
+        total += gs_window->VirtualHitTest(100);
+    }
+
+    return total > 0;
+}
+
+} // anonymous namespace
+
+BENCHMARK_FUNC_WITH_INIT(VScrollEstimatedHeights, InitWithoutIndex, DoneWindow)
+{
+    return ScrollThroughRows();
+}
+
+BENCHMARK_FUNC_WITH_INIT(VScrollIndexedHeights, InitWithIndex, DoneWindow)
+{
+    return ScrollThroughRows();
+}
@@ -639,5 +639,58 @@ TEST_CASE("wxFileConfig::LongLong", "[fileconfig][config][longlong]")
     CHECK( ll == val );
 }
 
+TEST_CASE("wxFileConfig::LazyParse", "[fileconfig][config]")
+{
+    static const char *confTest =
+        "root=1\n"
+        "; comment\n"
+        "[Group1]\n"
+        "Key=value1\n"
+        "Other=other1\n"
+        "[Group2]\n"
+        "# another comment\n"
+        "Key=value2\n"
+        "[Group3]\n"
+        "Key=value3\n"
+        "[group1]\n"
+        "Last=last1\n"
+    ;
+
+    wxStringInputStream sis(confTest);
+    wxFileConfig fc(sis);
+
+    // Not reading anything must preserve the contents exactly.
+    wxVERIFY_FILECONFIG( confTest, fc );
+
+    // Lookup is case-insensitive and finds the entries in all the sections
+    // with the same name.
+    CHECK( fc.Read("/GROUP2/key", "") == "value2" );
+    CHECK( fc.Read("/group1/Key", "") == "value1" );
+    CHECK( fc.Read("/Group1/Last", "") == "last1" );
+    CHECK( fc.GetNumberOfEntries() == 1 );
+    CHECK( fc.GetNumberOfGroups() == 3 );
+
+    fc.SetPath("/Group1");
+    CHECK( fc.GetNumberOfEntries() == 3 );
+    fc.SetPath("/");
+
+    // Modifying one group must leave the other ones untouched.
+    fc.Write("/Group2/Key", "changed");
+    CHECK( fc.DeleteGroup("/Group3") );
+    CHECK( !fc.HasEntry("/Group3/Key") );
+
+    wxVERIFY_FILECONFIG( "root=1\n"
+                         "; comment\n"
+                         "[Group1]\n"
+                         "Key=value1\n"
+                         "Other=other1\n"
+                         "[Group2]\n"
+                         "# another comment\n"
+                         "Key=changed\n"
+                         "[group1]\n"
+                         "Last=last1\n",
+                         fc );
+}
+
 #endif // wxUSE_FILECONFIG
 
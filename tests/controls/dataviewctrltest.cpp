@@ -17,11 +17,10 @@
 
 #include "wx/app.h"
 #include "wx/dataview.h"
+#include "wx/scopedptr.h"
 #include "wx/uiaction.h"
 
-#ifdef __WXGTK__
-    #include "wx/stopwatch.h"
-#endif // __WXGTK__
+#include "wx/stopwatch.h"
 
 #include "testableframe.h"
 #include "asserthelper.h"
@@ -852,6 +851,260 @@ TEST_CASE_METHOD(SingleSelectDataViewCtrlTestCase,
     CHECK( m_dvc->GetChildCount(wxDataViewItem()) == 0 );
 }
 
+#ifdef wxHAS_GENERIC_DATAVIEWCTRL
+
+namespace
+{
+
+// Class allowing to test the mapping between rows and items, which is not
+// public.
+class RowsTestDataViewTreeCtrl : public wxDataViewTreeCtrl
+{
+public:
+    explicit RowsTestDataViewTreeCtrl(wxWindow* parent)
+        : wxDataViewTreeCtrl(parent, wxID_ANY)
+    {
+    }
+
+    using wxDataViewTreeCtrl::GetRowByItem;
+    using wxDataViewTreeCtrl::GetItemByRow;
+};
+
+// Same as above but for the sort test.
+class SortTestDataViewCtrl : public wxDataViewCtrl
+{
+public:
+    explicit SortTestDataViewCtrl(wxWindow* parent)
+        : wxDataViewCtrl(parent, wxID_ANY)
+    {
+    }
+
+    using wxDataViewCtrl::GetItemByRow;
+};
+
+// List model with numbers in decreasing order providing the sort keys.
+class SortKeysTestModel : public wxDataViewIndexListModel
+{
+public:
+    explicit SortKeysTestModel(unsigned int count)
+        : wxDataViewIndexListModel(count),
+          m_count(count)
+    {
+    }
+
+    virtual void GetValueByRow(wxVariant& variant,
+                               unsigned int row,
+                               unsigned int WXUNUSED(col)) const override
+    {
+        variant = static_cast<long>(m_count - row);
+    }
+
+    virtual bool SetValueByRow(const wxVariant& WXUNUSED(variant),
+                               unsigned int WXUNUSED(row),
+                               unsigned int WXUNUSED(col)) override
+    {
+        return false;
+    }
+
+    virtual bool GetSortKeys(const wxDataViewItemArray& items,
+                             unsigned int column,
+                             wxVector<wxDataViewSortKey>& keys) const override
+    {
+        return GetSortKeysFromValues(items, column, keys);
+    }
+
+private:
+    const unsigned int m_count;
+};
+
+// Check that the items are sorted in the reverse order of the model rows.
+void CheckReverseOrder(SortTestDataViewCtrl& dvc,
+                       const SortKeysTestModel& model,
+                       unsigned int count)
+{
+    unsigned int misplaced = 0;
+    for ( unsigned int row = 0; row < count; row++ )
+    {
+        if ( model.GetRow(dvc.GetItemByRow(row)) != count - 1 - row )
+            misplaced++;
+    }
+
+    CHECK( misplaced == 0 );
+}
+
+} // anonymous namespace
+
+TEST_CASE("wxDVC::RowByItem", "[wxDataViewCtrl][item]")
+{
+    wxScopedPtr<RowsTestDataViewTreeCtrl>
+        dvc(new RowsTestDataViewTreeCtrl(wxTheApp->GetTopWindow()));
+
+    const wxDataViewItem root = dvc->AppendContainer(wxDataViewItem(), "root");
+    const wxDataViewItem child1 = dvc->AppendContainer(root, "child1");
+    const wxDataViewItem grandchild = dvc->AppendItem(child1, "grandchild");
+    const wxDataViewItem child2 = dvc->AppendItem(root, "child2");
+    dvc->Expand(root);
+
+    // Initially we have root, child1 (collapsed) and child2.
+    CHECK( dvc->GetRowByItem(root) == 0 );
+    CHECK( dvc->GetRowByItem(child1) == 1 );
+    CHECK( dvc->GetRowByItem(child2) == 2 );
+    CHECK( dvc->GetItemByRow(2) == child2 );
+    CHECK( !dvc->GetItemByRow(3).IsOk() );
+
+    // Add many children to check that the index of the rows is updated.
+    const int count = 1000;
+    wxVector<wxDataViewItem> items;
+    for ( int n = 0; n < count; n++ )
+        items.push_back(dvc->AppendItem(child1, wxString::Format("item%d", n)));
+
+    dvc->Expand(child1);
+
+    // The first child of child1 is grandchild.
+    CHECK( dvc->GetItemByRow(2) == grandchild );
+    CHECK( dvc->GetRowByItem(items[0]) == 3 );
+    CHECK( dvc->GetRowByItem(items[count - 1]) == count + 2 );
+    CHECK( dvc->GetItemByRow(count / 2 + 3) == items[count / 2] );
+    CHECK( dvc->GetRowByItem(child2) == count + 3 );
+    CHECK( dvc->GetItemByRow(count + 3) == child2 );
+
+    // Inserting (before the given item) and deleting items in the middle must
+    // update the rows of the subsequent ones.
+    const wxDataViewItem inserted =
+        dvc->InsertItem(child1, items[9], "inserted");
+    CHECK( dvc->GetRowByItem(inserted) == 12 );
+    CHECK( dvc->GetRowByItem(items[9]) == 13 );
+    CHECK( dvc->GetRowByItem(items[10]) == 14 );
+    CHECK( dvc->GetItemByRow(14) == items[10] );
+    CHECK( dvc->GetRowByItem(child2) == count + 4 );
+
+    dvc->DeleteItem(items[5]);
+    CHECK( dvc->GetRowByItem(items[4]) == 7 );
+    CHECK( dvc->GetRowByItem(items[6]) == 8 );
+    CHECK( dvc->GetItemByRow(8) == items[6] );
+    CHECK( dvc->GetRowByItem(child2) == count + 3 );
+
+    // Collapsing the branch must hide all its rows.
+    dvc->Collapse(child1);
+    CHECK( dvc->GetRowByItem(child2) == 2 );
+    CHECK( dvc->GetItemByRow(2) == child2 );
+
+    dvc->Expand(child1);
+    CHECK( dvc->GetRowByItem(child2) == count + 3 );
+    CHECK( dvc->GetItemByRow(count + 2) == items[count - 1] );
+}
+
+TEST_CASE("wxDVC::SortKeys", "[wxDataViewCtrl][sort]")
+{
+    wxScopedPtr<SortTestDataViewCtrl>
+        dvc(new SortTestDataViewCtrl(wxTheApp->GetTopWindow()));
+
+    SECTION("Sync")
+    {
+        const unsigned int count = 100;
+
+        wxObjectDataPtr<SortKeysTestModel> model(new SortKeysTestModel(count));
+        dvc->AssociateModel(model.get());
+
+        wxDataViewColumn* const
+            column = dvc->AppendTextColumn("Value", 0, wxDATAVIEW_CELL_INERT,
+                                           -1, wxALIGN_LEFT,
+                                           wxDATAVIEW_COL_SORTABLE);
+        column->SetSortOrder(true);
+        model->Resort();
+
+        CheckReverseOrder(*dvc, *model, count);
+    }
+
+#if wxUSE_THREADS
+    SECTION("Async")
+    {
+        // This must be big enough for the items to be sorted asynchronously.
+        const unsigned int count = 20000;
+
+        wxObjectDataPtr<SortKeysTestModel> model(new SortKeysTestModel(count));
+        dvc->AssociateModel(model.get());
+
+        wxDataViewColumn* const
+            column = dvc->AppendTextColumn("Value", 0, wxDATAVIEW_CELL_INERT,
+                                           -1, wxALIGN_LEFT,
+                                           wxDATAVIEW_COL_SORTABLE);
+
+        REQUIRE( dvc->EnableAsyncSort() );
+        CHECK( dvc->IsAsyncSortEnabled() );
+
+        column->SetSortOrder(true);
+        model->Resort();
+
+        // Wait until the new order is applied.
+        wxStopWatch sw;
+        while ( model->GetRow(dvc->GetItemByRow(0)) != count - 1 )
+        {
+            if ( sw.Time() > 10000 )
+            {
+                FAIL("Timed out waiting for the items to be sorted.");
+                break;
+            }
+
+            wxYield();
+        }
+
+        CheckReverseOrder(*dvc, *model, count);
+    }
+#endif // wxUSE_THREADS
+}
+
+TEST_CASE("wxDVC::BatchChanges", "[wxDataViewCtrl][batch]")
+{
+    wxScopedPtr<wxDataViewListCtrl>
+        dvc(new wxDataViewListCtrl(wxTheApp->GetTopWindow(), wxID_ANY));
+    dvc->AppendTextColumn("Text");
+
+    const unsigned int count = 100;
+    for ( unsigned int n = 0; n < count; n++ )
+    {
+        wxVector<wxVariant> values;
+        values.push_back(wxString::Format("item %u", n));
+        dvc->AppendItem(values);
+    }
+
+    wxDataViewModel* const model = dvc->GetModel();
+
+    EventCounter changed(dvc.get(), wxEVT_DATAVIEW_ITEM_VALUE_CHANGED);
+    dvc->ResetUpdateStats();
+
+    model->BeginBatch();
+    CHECK( model->IsInBatch() );
+
+    // Nested batches must be handled too.
+    model->BeginBatch();
+    for ( unsigned int n = 0; n < count; n++ )
+        dvc->SetTextValue(wxString::Format("changed %u", n), n, 0);
+    model->EndBatch();
+
+    // Change some items once again.
+    for ( unsigned int n = 0; n < count; n += 2 )
+        dvc->SetTextValue(wxString::Format("changed again %u", n), n, 0);
+
+    // Nothing is done until the end of the outermost batch.
+    CHECK( dvc->GetUpdateStats().notifications == count + count / 2 );
+    CHECK( dvc->GetUpdateStats().refreshes == 0 );
+    CHECK( changed.GetCount() == 0 );
+
+    model->EndBatch();
+    CHECK( !model->IsInBatch() );
+
+    // The rows are refreshed at most once and the event is sent once for each
+    // changed item.
+    CHECK( dvc->GetUpdateStats().refreshes <= 1 );
+    CHECK( changed.GetCount() == static_cast<int>(count) );
+
+    CHECK( dvc->GetTextValue(0, 0) == "changed again 0" );
+    CHECK( dvc->GetTextValue(1, 0) == "changed 1" );
+}
+
+#endif // wxHAS_GENERIC_DATAVIEWCTRL
+
 TEST_CASE_METHOD(MultiColumnsDataViewCtrlTestCase,
                  "wxDVC::AppendTextColumn",
                  "[wxDataViewCtrl][column]")
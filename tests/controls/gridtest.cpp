@@ -22,6 +22,8 @@
 #include "asserthelper.h"
 #include "wx/uiaction.h"
 
+#include <limits>
+
 #ifdef __WXGTK__
     #include "wx/stopwatch.h"
 #endif // __WXGTK__
@@ -2286,6 +2288,234 @@ TEST_CASE("GridBlockCoords::SymDifference", "[grid]")
     }
 }
 
+TEST_CASE("GridCellAttrProvider::RangeAttr", "[grid]")
+{
+    wxGridCellAttrProvider provider;
+
+    wxGridCellAttr* const attrGrey = new wxGridCellAttr;
+    attrGrey->SetBackgroundColour(*wxLIGHT_GREY);
+
+    provider.SetRowRangeAttr(attrGrey, 10, 20);
+
+    // Return the attribute of the given row, without taking its ownership.
+    const auto attrOf = [&provider](int row)
+    {
+        return provider.GetAttrPtr(row, 0, wxGridCellAttr::Row).get();
+    };
+
+    CHECK( attrOf(9) == NULL );
+    CHECK( attrOf(10) == attrGrey );
+    CHECK( attrOf(20) == attrGrey );
+    CHECK( attrOf(21) == NULL );
+
+    SECTION("Override part of the range")
+    {
+        wxGridCellAttr* const attrRed = new wxGridCellAttr;
+        attrRed->SetBackgroundColour(*wxRED);
+        provider.SetRowAttr(attrRed, 15);
+
+        CHECK( attrOf(14) == attrGrey );
+        CHECK( attrOf(15) == attrRed );
+        CHECK( attrOf(16) == attrGrey );
+
+        provider.SetRowRangeAttr(NULL, 12, 17);
+        CHECK( attrOf(11) == attrGrey );
+        CHECK( attrOf(12) == NULL );
+        CHECK( attrOf(15) == NULL );
+        CHECK( attrOf(17) == NULL );
+        CHECK( attrOf(18) == attrGrey );
+    }
+
+    SECTION("Insert rows")
+    {
+        provider.UpdateAttrRows(15, 3);
+
+        CHECK( attrOf(14) == attrGrey );
+        CHECK( attrOf(15) == NULL );
+        CHECK( attrOf(17) == NULL );
+        CHECK( attrOf(18) == attrGrey );
+        CHECK( attrOf(23) == attrGrey );
+        CHECK( attrOf(24) == NULL );
+    }
+
+    SECTION("Delete rows")
+    {
+        provider.UpdateAttrRows(5, -10);
+
+        CHECK( attrOf(4) == NULL );
+        CHECK( attrOf(5) == attrGrey );
+        CHECK( attrOf(10) == attrGrey );
+        CHECK( attrOf(11) == NULL );
+
+        provider.UpdateAttrRows(6, -2);
+        CHECK( attrOf(8) == attrGrey );
+        CHECK( attrOf(9) == NULL );
+    }
+}
+
+TEST_CASE("GridColumnarTable", "[grid]")
+{
+    wxGridColumnarTable table(3);
+    REQUIRE( table.AppendColumn(wxGRID_COLUMN_STRING, "Name") );
+    REQUIRE( table.AppendColumn(wxGRID_COLUMN_LONG) );
+    REQUIRE( table.AppendColumn(wxGRID_COLUMN_DOUBLE) );
+
+    CHECK( table.GetNumberRows() == 3 );
+    CHECK( table.GetNumberCols() == 3 );
+    CHECK( table.GetColLabelValue(0) == "Name" );
+    CHECK( table.GetColLabelValue(1) == "B" );
+
+    CHECK( table.GetTypeName(0, 0) == wxGRID_VALUE_STRING );
+    CHECK( table.GetTypeName(0, 1) == wxGRID_VALUE_NUMBER );
+    CHECK( table.GetTypeName(0, 2) == wxGRID_VALUE_FLOAT );
+    CHECK( table.CanGetValueAs(0, 2, wxGRID_VALUE_STRING) );
+    CHECK( !table.CanGetValueAs(0, 2, wxGRID_VALUE_NUMBER) );
+
+    for ( int col = 0; col < 3; col++ )
+        CHECK( table.IsEmptyCell(1, col) );
+
+    SECTION("Values")
+    {
+        table.SetValue(0, 0, "foo");
+        table.SetValue(1, 0, "bar");
+        table.SetValue(2, 0, "foo");
+        CHECK( table.GetValue(2, 0) == "foo" );
+        CHECK( table.GetStringPoolSize() == 2 );
+
+        table.SetValue(0, 1, "17");
+        table.SetValueAsLong(1, 1, -3);
+        CHECK( table.GetValueAsLong(0, 1) == 17 );
+        CHECK( table.GetValue(1, 1) == "-3" );
+        CHECK( table.GetValueAsDouble(1, 1) == -3.0 );
+        CHECK( table.IsEmptyCell(2, 1) );
+
+        table.SetValueAsDouble(0, 2, 0.5);
+        CHECK( table.GetValueAsDouble(0, 2) == 0.5 );
+        CHECK( !table.IsEmptyCell(0, 2) );
+
+        table.SetValue(0, 2, "");
+        CHECK( table.IsEmptyCell(0, 2) );
+
+        table.Clear();
+        CHECK( table.GetNumberRows() == 3 );
+        CHECK( table.IsEmptyCell(0, 0) );
+        CHECK( table.IsEmptyCell(0, 1) );
+        CHECK( table.GetStringPoolSize() == 0 );
+    }
+
+    SECTION("Rows")
+    {
+        table.SetValueAsLong(0, 1, 0);
+        table.SetValueAsLong(1, 1, 1);
+        table.SetValueAsLong(2, 1, 2);
+
+        REQUIRE( table.InsertRows(1, 2) );
+        CHECK( table.GetNumberRows() == 5 );
+        CHECK( table.GetValueAsLong(0, 1) == 0 );
+        CHECK( table.IsEmptyCell(1, 1) );
+        CHECK( table.IsEmptyCell(2, 1) );
+        CHECK( table.GetValueAsLong(3, 1) == 1 );
+
+        REQUIRE( table.DeleteRows(0, 3) );
+        CHECK( table.GetNumberRows() == 2 );
+        CHECK( table.GetValueAsLong(0, 1) == 1 );
+        CHECK( table.GetValueAsLong(1, 1) == 2 );
+
+        REQUIRE( table.AppendRows(1) );
+        CHECK( table.IsEmptyCell(2, 2) );
+    }
+
+    SECTION("Columns")
+    {
+        table.SetValue(0, 0, "foo");
+
+        REQUIRE( table.InsertCols(0) );
+        CHECK( table.GetNumberCols() == 4 );
+        CHECK( table.GetColumnType(0) == wxGRID_COLUMN_STRING );
+        CHECK( table.GetColumnType(2) == wxGRID_COLUMN_LONG );
+        CHECK( table.GetValue(0, 1) == "foo" );
+        CHECK( table.GetColLabelValue(1) == "Name" );
+
+        REQUIRE( table.DeleteCols(1, 2) );
+        CHECK( table.GetNumberCols() == 2 );
+        CHECK( table.GetColumnType(1) == wxGRID_COLUMN_DOUBLE );
+    }
+
+    SECTION("ExtremeValues")
+    {
+        const long longMin = std::numeric_limits<long>::min();
+        const long longMax = std::numeric_limits<long>::max();
+        const double nan = std::numeric_limits<double>::quiet_NaN();
+
+        // Any values can be stored, they're not confused with empty cells.
+        table.SetValueAsLong(0, 1, longMin);
+        CHECK( !table.IsEmptyCell(0, 1) );
+        CHECK( table.GetValueAsLong(0, 1) == longMin );
+
+        table.SetValueAsDouble(0, 2, nan);
+        CHECK( !table.IsEmptyCell(0, 2) );
+        CHECK( table.GetValueAsLong(0, 2) == 0 );
+
+        // Values out of range of long are clamped when converting them.
+        table.SetValueAsDouble(1, 2, 1e300);
+        CHECK( table.GetValueAsLong(1, 2) == longMax );
+        table.SetValueAsDouble(2, 2, -1e300);
+        CHECK( table.GetValueAsLong(2, 2) == longMin );
+
+        table.SetValueAsDouble(1, 1, 1e300);
+        CHECK( table.GetValueAsLong(1, 1) == longMax );
+        table.SetValueAsDouble(1, 1, -2.5);
+        CHECK( table.GetValueAsLong(1, 1) == -2 );
+
+        // And NaN can't be stored in a long column.
+        table.SetValueAsDouble(1, 1, nan);
+        CHECK( table.IsEmptyCell(1, 1) );
+    }
+}
+
+namespace
+{
+
+// Renderers giving access to the string they display.
+class TestNumberRenderer : public wxGridCellNumberRenderer
+{
+public:
+    using wxGridCellNumberRenderer::GetString;
+};
+
+class TestFloatRenderer : public wxGridCellFloatRenderer
+{
+public:
+    using wxGridCellFloatRenderer::GetString;
+};
+
+} // anonymous namespace
+
+TEST_CASE_METHOD(GridTestCase, "Grid::ColumnarTableEmptyCells", "[grid]")
+{
+    wxGridColumnarTable* const table = new wxGridColumnarTable(2);
+    REQUIRE( table->AppendColumn(wxGRID_COLUMN_LONG) );
+    REQUIRE( table->AppendColumn(wxGRID_COLUMN_DOUBLE) );
+    m_grid->SetTable(table, true);
+
+    table->SetValueAsLong(0, 0, 17);
+    table->SetValueAsDouble(0, 1, 0.5);
+
+    CHECK( table->CanGetValueAs(0, 0, wxGRID_VALUE_NUMBER) );
+    CHECK( !table->CanGetValueAs(1, 0, wxGRID_VALUE_NUMBER) );
+    CHECK( table->CanGetValueAs(0, 1, wxGRID_VALUE_FLOAT) );
+    CHECK( !table->CanGetValueAs(1, 1, wxGRID_VALUE_FLOAT) );
+
+    // Empty cells must be shown as empty and not as zeroes.
+    wxObjectDataPtr<TestNumberRenderer> numberRenderer(new TestNumberRenderer);
+    CHECK( numberRenderer->GetString(*m_grid, 0, 0) == "17" );
+    CHECK( numberRenderer->GetString(*m_grid, 1, 0) == "" );
+
+    wxObjectDataPtr<TestFloatRenderer> floatRenderer(new TestFloatRenderer);
+    CHECK( floatRenderer->GetString(*m_grid, 0, 1) != "" );
+    CHECK( floatRenderer->GetString(*m_grid, 1, 1) == "" );
+}
+
 //
 // TestableGrid
 //
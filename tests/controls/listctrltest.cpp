@@ -23,6 +23,8 @@
 #include "wx/listctrl.h"
 #include "wx/artprov.h"
 #include "wx/imaglist.h"
+#include "wx/scopedptr.h"
+#include "wx/vector.h"
 #include "listbasetest.h"
 #include "testableframe.h"
 #include "wx/uiaction.h"
@@ -49,11 +51,13 @@ private:
         WXUISIM_TEST( ColumnDrag );
         CPPUNIT_TEST( SubitemRect );
         CPPUNIT_TEST( ColumnCount );
+        CPPUNIT_TEST( AutoSizeColumn );
     CPPUNIT_TEST_SUITE_END();
 
     void EditLabel();
     void SubitemRect();
     void ColumnCount();
+    void AutoSizeColumn();
 #if wxUSE_UIACTIONSIMULATOR
     // Column events are only supported in wxListCtrl currently so we test them
     // here rather than in ListBaseTest
@@ -168,6 +172,81 @@ void ListCtrlTestCase::ColumnCount()
     CHECK(m_list->GetColumnCount() == 0);
 }
 
+void ListCtrlTestCase::AutoSizeColumn()
+{
+    m_list->InsertColumn(0, "Column 0");
+    m_list->InsertItem(0, "short");
+    m_list->InsertItem(1, "this is a much longer item text");
+
+    m_list->SetColumnWidth(0, wxLIST_AUTOSIZE);
+    const int widthLong = m_list->GetColumnWidth(0);
+
+    // Making the widest item narrower must make the column narrower too.
+    m_list->SetItemText(1, "x");
+    m_list->SetColumnWidth(0, wxLIST_AUTOSIZE);
+    CHECK( m_list->GetColumnWidth(0) < widthLong );
+
+    // And making another one wider must make it wider.
+    m_list->SetItemText(0, "this is an even longer item text than before");
+    m_list->SetColumnWidth(0, wxLIST_AUTOSIZE);
+    const int widthLonger = m_list->GetColumnWidth(0);
+    CHECK( widthLonger > widthLong );
+
+    // Finally check that deleting the widest item is taken into account.
+    m_list->DeleteItem(0);
+    m_list->SetColumnWidth(0, wxLIST_AUTOSIZE);
+    CHECK( m_list->GetColumnWidth(0) < widthLonger );
+
+    // Check that deleting items works for virtual controls too, in which the
+    // items after the deleted one are shifted.
+    class VirtListCtrl : public wxListCtrl
+    {
+    public:
+        VirtListCtrl()
+            : wxListCtrl(wxTheApp->GetTopWindow(), wxID_ANY,
+                         wxPoint(0, 0), wxSize(400, 200),
+                         wxLC_REPORT | wxLC_VIRTUAL)
+        {
+            m_items.push_back("short");
+            m_items.push_back("this is a much longer item text");
+            m_items.push_back("medium item");
+
+            InsertColumn(0, "Column 0");
+            SetItemCount(m_items.size());
+        }
+
+        void DeleteVirtualItem(long item)
+        {
+            m_items.erase(m_items.begin() + item);
+            DeleteItem(item);
+        }
+
+    protected:
+        virtual wxString OnGetItemText(long item, long WXUNUSED(column)) const override
+        {
+            return m_items[item];
+        }
+
+    private:
+        wxVector<wxString> m_items;
+    };
+
+    wxScopedPtr<VirtListCtrl> virt(new VirtListCtrl);
+
+    virt->SetColumnWidth(0, wxLIST_AUTOSIZE);
+    const int widthVirt = virt->GetColumnWidth(0);
+
+    // Deleting an item before the widest one must not affect the width...
+    virt->DeleteVirtualItem(0);
+    virt->SetColumnWidth(0, wxLIST_AUTOSIZE);
+    CHECK( virt->GetColumnWidth(0) == widthVirt );
+
+    // ... but deleting the widest one, now at a different index, must.
+    virt->DeleteVirtualItem(0);
+    virt->SetColumnWidth(0, wxLIST_AUTOSIZE);
+    CHECK( virt->GetColumnWidth(0) < widthVirt );
+}
+
 #if wxUSE_UIACTIONSIMULATOR
 void ListCtrlTestCase::ColumnDrag()
 {
@@ -0,0 +1,208 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        tests/controls/vscrolltest.cpp
+// Purpose:     wxVScrolledWindow unit tests
+// Created:     2026-10-18
+// Copyright:   (c) 2026 wxWidgets development team
+///////////////////////////////////////////////////////////////////////////////
+
+// ----------------------------------------------------------------------------
+// headers
+// ----------------------------------------------------------------------------
+
+#include "testprec.h"
+
+
+#ifndef WX_PRECOMP
+    #include "wx/app.h"
+#endif // WX_PRECOMP
+
+#include "wx/scopedptr.h"
+#include "wx/vscroll.h"
+
+#include <limits>
+#include <vector>
+
+namespace
+{
+
+// Window with the rows of the given heights, using the heights index.
+class IndexedVScrolledWindow : public wxVScrolledWindow
+{
+public:
+    explicit IndexedVScrolledWindow(const std::vector<wxCoord>& heights)
+        : wxVScrolledWindow(wxTheApp->GetTopWindow(), wxID_ANY,
+                            wxDefaultPosition, wxSize(200, 100)),
+          m_heights(heights)
+    {
+        EnableRowHeightsIndex();
+        SetRowCount(m_heights.size());
+    }
+
+    // Change the height of the given row, RefreshRow[s]() must be called
+    // after it.
+    void SetRowHeight(size_t row, wxCoord height) { m_heights[row] = height; }
+
+    // Add more rows of the given height.
+    void AddRows(size_t count, wxCoord height)
+    {
+        m_heights.insert(m_heights.end(), count, height);
+        SetRowCount(m_heights.size());
+    }
+
+    // Return the expected height of the given rows.
+    wxCoord ComputeRowsHeight(size_t rowMin, size_t rowMax) const
+    {
+        wxCoord height = 0;
+        for ( size_t row = rowMin; row < rowMax; ++row )
+            height += m_heights[row];
+
+        return height;
+    }
+
+    // Simulate dragging the scrollbar thumb to the given position.
+    void DragThumbTo(int pos)
+    {
+        wxScrollWinEvent event(wxEVT_SCROLLWIN_THUMBTRACK, pos, wxVERTICAL);
+        event.SetEventObject(this);
+        GetEventHandler()->ProcessEvent(event);
+    }
+
+    using wxVScrolledWindow::GetRowsHeight;
+
+protected:
+    virtual wxCoord OnGetRowHeight(size_t row) const override
+    {
+        return m_heights[row];
+    }
+
+private:
+    std::vector<wxCoord> m_heights;
+};
+
+// Return the heights of rows used by the tests, which are all different.
+std::vector<wxCoord> GetTestHeights()
+{
+    std::vector<wxCoord> heights;
+    for ( int n = 0; n < 1000; n++ )
+        heights.push_back(10 + n % 7);
+
+    return heights;
+}
+
+// Check that the heights of all the ranges of rows starting or ending at
+// multiples of the given step are computed correctly.
+void CheckRowsHeights(const IndexedVScrolledWindow& win, size_t step)
+{
+    const size_t count = win.GetRowCount();
+    for ( size_t rowMin = 0; rowMin <= count; rowMin += step )
+    {
+        for ( size_t rowMax = rowMin; rowMax <= count; rowMax++ )
+        {
+            INFO( "Rows from " << rowMin << " to " << rowMax );
+            CHECK( win.GetRowsHeight(rowMin, rowMax) ==
+                    win.ComputeRowsHeight(rowMin, rowMax) );
+        }
+    }
+
+    CHECK( win.GetRowsHeight(count, 0) == -win.ComputeRowsHeight(0, count) );
+}
+
+} // anonymous namespace
+
+TEST_CASE("wxVScrolledWindow::HeightsIndex", "[vscroll]")
+{
+    wxScopedPtr<IndexedVScrolledWindow>
+        win(new IndexedVScrolledWindow(GetTestHeights()));
+
+    SECTION("Ranges")
+    {
+        CheckRowsHeights(*win, 37);
+    }
+
+    SECTION("RefreshRow")
+    {
+        win->SetRowHeight(0, 50);
+        win->SetRowHeight(500, 1);
+        win->SetRowHeight(999, 100);
+
+        // The heights are not updated until the rows are refreshed.
+        CHECK( win->GetRowsHeight(0, 1) == 10 );
+
+        win->RefreshRow(0);
+        win->RefreshRow(500);
+        win->RefreshRow(999);
+        CheckRowsHeights(*win, 37);
+    }
+
+    SECTION("RefreshRows")
+    {
+        for ( size_t row = 100; row <= 200; row++ )
+            win->SetRowHeight(row, 20 + row % 3);
+
+        win->RefreshRows(100, 200);
+        CheckRowsHeights(*win, 37);
+    }
+
+    SECTION("SetRowCount")
+    {
+        win->AddRows(500, 30);
+        REQUIRE( win->GetRowCount() == 1500 );
+        CheckRowsHeights(*win, 53);
+
+        win->SetRowCount(10);
+        CHECK( win->GetRowsHeight(0, 10) == win->ComputeRowsHeight(0, 10) );
+
+        win->SetRowCount(0);
+        CHECK( win->GetRowsHeight(0, 0) == 0 );
+    }
+
+    SECTION("Scroll")
+    {
+        // The scrollbar position is in pixels when using the index, check
+        // that it's mapped to the right rows at their boundaries.
+        for ( size_t row = 1; row < 900; row += 89 )
+        {
+            INFO( "Row " << row );
+
+            const wxCoord pos = win->ComputeRowsHeight(0, row);
+
+            win->DragThumbTo(pos);
+            CHECK( win->GetVisibleRowsBegin() == row );
+
+            win->DragThumbTo(pos - 1);
+            CHECK( win->GetVisibleRowsBegin() == row - 1 );
+
+            win->DragThumbTo(pos + win->ComputeRowsHeight(row, row + 1) - 1);
+            CHECK( win->GetVisibleRowsBegin() == row );
+        }
+
+        win->DragThumbTo(0);
+        CHECK( win->GetVisibleRowsBegin() == 0 );
+
+        // Dragging the thumb beyond the end scrolls to the last page.
+        const size_t rowLast = win->GetVisibleRowsBegin();
+        win->DragThumbTo(win->ComputeRowsHeight(0, 1000) + 1);
+        CHECK( win->GetVisibleRowsEnd() == 1000 );
+        CHECK( win->GetVisibleRowsBegin() > rowLast );
+    }
+}
+
+TEST_CASE("wxVScrolledWindow::HeightsIndexOverflow", "[vscroll]")
+{
+    // The total height of these rows doesn't fit into wxCoord, but the
+    // heights of their ranges which do must still be computed correctly.
+    const wxCoord height = std::numeric_limits<wxCoord>::max() / 2;
+    wxScopedPtr<IndexedVScrolledWindow>
+        win(new IndexedVScrolledWindow(std::vector<wxCoord>(4, height)));
+
+    CHECK( win->GetRowsHeight(0, 2) == 2*height );
+    CHECK( win->GetRowsHeight(2, 4) == 2*height );
+    CHECK( win->GetRowsHeight(1, 3) == 2*height );
+    CHECK( win->GetRowsHeight(0, 4) == std::numeric_limits<wxCoord>::max() );
+    CHECK( win->GetRowsHeight(4, 0) == -std::numeric_limits<wxCoord>::max() );
+
+    win->SetRowHeight(3, 1);
+    win->RefreshRow(3);
+    CHECK( win->GetRowsHeight(2, 4) == height + 1 );
+    CHECK( win->GetRowsHeight(0, 4) == std::numeric_limits<wxCoord>::max() );
+}
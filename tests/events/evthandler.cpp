@@ -13,8 +13,11 @@
 #include "testprec.h"
 
 
+#include "wx/app.h"
 #include "wx/event.h"
 
+#include <vector>
+
 // ----------------------------------------------------------------------------
 // test events and their handlers
 // ----------------------------------------------------------------------------
@@ -507,6 +510,204 @@ TEST_CASE("Event::UnbindFromHandler", "[event][bind][unbind]")
     handler.ProcessEvent(e);
 }
 
+// Handlers used by the test below, recording the order in which they're called.
+struct OrderRecorder
+{
+    OrderRecorder(std::vector<int>& order, int n) : m_order(order), m_n(n) { }
+
+    void operator()(wxThreadEvent& event)
+    {
+        m_order.push_back(m_n);
+        event.Skip();
+    }
+
+    std::vector<int>& m_order;
+    const int m_n;
+};
+
+TEST_CASE("Event::ManyBindings", "[event][bind][unbind]")
+{
+    // Bind enough handlers for the dynamic event table to be indexed.
+    const int numTypes = 10;
+    wxEventType types[numTypes];
+    for ( int n = 0; n < numTypes; n++ )
+        types[n] = wxNewEventType();
+
+    std::vector<int> order;
+
+    // Functors are compared by address when unbinding, so keep them alive.
+    std::vector<OrderRecorder> recorders;
+    recorders.reserve(3*numTypes);
+
+    wxEvtHandler handler;
+    for ( int n = 0; n < 3*numTypes; n++ )
+    {
+        recorders.push_back(OrderRecorder(order, n));
+        handler.Bind(wxEventTypeTag<wxThreadEvent>(types[n % numTypes]),
+                     recorders.back());
+    }
+
+    // The handlers must be called in the reverse order of binding.
+    wxThreadEvent event(types[2]);
+    handler.ProcessEvent(event);
+    REQUIRE( order.size() == 3 );
+    CHECK( order[0] == 22 );
+    CHECK( order[1] == 12 );
+    CHECK( order[2] == 2 );
+
+    // Check that unbinding and binding more handlers works too.
+    order.clear();
+    CHECK( handler.Unbind(wxEventTypeTag<wxThreadEvent>(types[2]),
+                          recorders[12]) );
+    OrderRecorder recorder100(order, 100);
+    handler.Bind(wxEventTypeTag<wxThreadEvent>(types[2]), recorder100);
+    handler.ProcessEvent(event);
+    REQUIRE( order.size() == 3 );
+    CHECK( order[0] == 100 );
+    CHECK( order[1] == 22 );
+    CHECK( order[2] == 2 );
+
+    // And that the handlers for the other events are still found.
+    order.clear();
+    wxThreadEvent event2(types[numTypes - 1]);
+    handler.ProcessEvent(event2);
+    REQUIRE( order.size() == 3 );
+    CHECK( order[0] == 29 );
+
+    // Finally check that the events without handlers are not handled.
+    wxThreadEvent event3(wxNewEventType());
+    CHECK( !handler.ProcessEvent(event3) );
+}
+
+TEST_CASE("Event::BindUnbindLoop", "[event][bind][unbind]")
+{
+    const wxEventTypeTag<wxThreadEvent> type1(wxNewEventType()),
+                                        type2(wxNewEventType());
+
+    std::vector<int> order;
+    std::vector<OrderRecorder> recorders;
+    recorders.reserve(20);
+
+    // Bind enough handlers for the dynamic event table to be indexed.
+    wxEvtHandler handler;
+    for ( int n = 0; n < 20; n++ )
+    {
+        recorders.push_back(OrderRecorder(order, n));
+        handler.Bind(type1, recorders.back());
+    }
+
+    wxThreadEvent event1(type1);
+    wxThreadEvent event2(type2);
+
+    // Bind and immediately unbind the same handler many times.
+    OrderRecorder recorder100(order, 100),
+                  recorder101(order, 101);
+    for ( int n = 0; n < 10000; n++ )
+    {
+        handler.Bind(type2, recorder100);
+        CHECK( handler.Unbind(type2, recorder100) );
+    }
+
+    CHECK( !handler.ProcessEvent(event2) );
+    CHECK( order.empty() );
+
+    // Replace the handler bound before with another one many times, while
+    // processing only the events of another type.
+    handler.Bind(type2, recorder100);
+    for ( int n = 0; n < 10000; n++ )
+    {
+        order.clear();
+        handler.ProcessEvent(event1);
+        REQUIRE( order.size() == 20 );
+
+        OrderRecorder& recorderOld = n % 2 ? recorder101 : recorder100;
+        OrderRecorder& recorderNew = n % 2 ? recorder100 : recorder101;
+        handler.Bind(type2, recorderNew);
+        CHECK( handler.Unbind(type2, recorderOld) );
+    }
+
+    order.clear();
+    handler.ProcessEvent(event2);
+    REQUIRE( order.size() == 1 );
+    CHECK( order[0] == 100 );
+}
+
+// Handler merging the queued events with the same id by adding up their values.
+class CoalescingHandler : public wxEvtHandler
+{
+public:
+    CoalescingHandler()
+    {
+        Bind(wxEVT_THREAD, &CoalescingHandler::OnThreadEvent, this);
+    }
+
+    std::vector<int> m_values;
+
+protected:
+    virtual bool
+    CoalescePendingEvent(wxEvent& pending, const wxEvent& event) override
+    {
+        wxThreadEvent& pendingThread = static_cast<wxThreadEvent&>(pending);
+        pendingThread.SetInt(pendingThread.GetInt() +
+                             static_cast<const wxThreadEvent&>(event).GetInt());
+        return true;
+    }
+
+private:
+    void OnThreadEvent(wxThreadEvent& event)
+    {
+        m_values.push_back(event.GetInt());
+    }
+};
+
+static void QueueThreadEvent(wxEvtHandler& handler, int id, int value)
+{
+    wxThreadEvent* const event = new wxThreadEvent(wxEVT_THREAD, id);
+    event->SetInt(value);
+    handler.QueueEvent(event);
+}
+
+TEST_CASE("Event::CoalescePending", "[event][queue]")
+{
+    CoalescingHandler handler;
+
+    // Consecutive events with the same id are merged...
+    for ( int n = 1; n <= 4; n++ )
+        QueueThreadEvent(handler, 1, n);
+
+    // ...but an event with a different one is not...
+    QueueThreadEvent(handler, 2, 100);
+
+    // ...and the next one is not merged with the first ones neither.
+    QueueThreadEvent(handler, 1, 1000);
+
+    wxTheApp->ProcessPendingEvents();
+
+    REQUIRE( handler.m_values.size() == 3 );
+    CHECK( handler.m_values[0] == 10 );
+    CHECK( handler.m_values[1] == 100 );
+    CHECK( handler.m_values[2] == 1000 );
+
+    // Events queued after processing the previous ones are processed too.
+    handler.m_values.clear();
+    QueueThreadEvent(handler, 1, 1);
+    QueueThreadEvent(handler, 1, 2);
+    wxTheApp->ProcessPendingEvents();
+
+    REQUIRE( handler.m_values.size() == 1 );
+    CHECK( handler.m_values[0] == 3 );
+
+    // And calling ProcessPendingEvents() without any pending events is fine.
+    handler.ProcessPendingEvents();
+    CHECK( handler.m_values.size() == 1 );
+
+    // Finally check that pending events are deleted without being processed.
+    QueueThreadEvent(handler, 1, 1);
+    handler.DeletePendingEvents();
+    wxTheApp->ProcessPendingEvents();
+    CHECK( handler.m_values.size() == 1 );
+}
+
 // This is a compilation-time-only test: just check that a class inheriting
 // from wxEvtHandler non-publicly can use Bind() with its method, this used to
 // result in compilation errors.
@@ -4938,6 +4938,137 @@ TEST_CASE("ClippingBoxTestCaseGC::CairoRenderer", "[clip][gc][cairo]")
         RegionsAndPushPopState(gc, bmp);
     }
 }
+
+#if wxUSE_IMAGE
+// Clipping region used by the culling tests below.
+static const wxRect s_cullingClip(20, 20, 40, 40);
+
+// Draw primitives either lying entirely outside of the culling clipping
+// region or overlapping it only partially.
+static void DrawCullingScene(wxGraphicsContext* gc)
+{
+    gc->SetPen(*wxTRANSPARENT_PEN);
+    gc->SetBrush(wxBrush(s_tmpColour, wxBRUSHSTYLE_SOLID));
+
+    // Entirely outside of the clipping region.
+    gc->DrawRectangle(70, 80, 20, 20);
+
+    // Overlapping its left edge.
+    gc->DrawRectangle(0, 30, 30, 10);
+
+    // Outside of it in user coordinates, but inside it in device ones.
+    gc->PushState();
+    gc->Translate(-50, 0);
+    gc->DrawRectangle(90, 50, 10, 5);
+    gc->PopState();
+
+    // The path itself is outside of the clipping region, but its stroke
+    // overlaps the top edge of it.
+    gc->SetPen(wxPen(s_tmpColour, 20));
+    wxGraphicsPath path = gc->CreatePath();
+    path.MoveToPoint(30, 15);
+    path.AddLineToPoint(50, 15);
+    gc->StrokePath(path);
+}
+
+static wxImage DrawCullingImage(wxGraphicsRenderer* rend, bool clip)
+{
+    wxBitmap bmp(s_dcSize);
+    {
+        wxMemoryDC dc(bmp);
+        dc.SetBackground(wxBrush(s_bgColour, wxBRUSHSTYLE_SOLID));
+        dc.Clear();
+        wxScopedPtr<wxGraphicsContext> gc(rend->CreateContext(dc));
+        REQUIRE(gc.get());
+        gc->SetAntialiasMode(wxANTIALIAS_NONE);
+        gc->DisableOffset();
+
+        if ( clip )
+        {
+            gc->Clip(s_cullingClip.x, s_cullingClip.y,
+                     s_cullingClip.width, s_cullingClip.height);
+        }
+
+        DrawCullingScene(gc.get());
+    }
+
+    return bmp.ConvertToImage();
+}
+
+TEST_CASE("ClippingBoxTestCaseGC::CairoCulling", "[clip][gc][cairo]")
+{
+    wxGraphicsRenderer* rend = wxGraphicsRenderer::GetCairoRenderer();
+    REQUIRE(rend);
+
+    // The primitives not visible at all are skipped when drawing, but those
+    // overlapping the clipping region, even if only because of their stroke
+    // or transformation, must be drawn exactly as without clipping.
+    const wxImage imgRef = DrawCullingImage(rend, false);
+    const wxImage img = DrawCullingImage(rend, true);
+
+    CHECK( imgRef.GetGreen(75, 85) == s_tmpColour.Green() );
+    CHECK( img.GetGreen(75, 85) == s_bgColour.Green() );
+
+    CHECK( img.GetGreen(25, 35) == s_tmpColour.Green() );
+    CHECK( img.GetGreen(45, 52) == s_tmpColour.Green() );
+    CHECK( img.GetGreen(40, 22) == s_tmpColour.Green() );
+
+    int diffInside = 0,
+        drawnOutside = 0;
+    for ( int y = 0; y < s_dcSize.y; y++ )
+    {
+        for ( int x = 0; x < s_dcSize.x; x++ )
+        {
+            const wxColour c(img.GetRed(x, y), img.GetGreen(x, y), img.GetBlue(x, y));
+            if ( s_cullingClip.Contains(x, y) )
+            {
+                if ( c != wxColour(imgRef.GetRed(x, y),
+                                   imgRef.GetGreen(x, y),
+                                   imgRef.GetBlue(x, y)) )
+                    diffInside++;
+            }
+            else if ( c != s_bgColour )
+            {
+                drawnOutside++;
+            }
+        }
+    }
+
+    CHECK( diffInside == 0 );
+    CHECK( drawnOutside == 0 );
+}
+
+TEST_CASE("ClippingBoxTestCaseGC::CairoCullingUnbounded", "[clip][gc][cairo]")
+{
+    wxGraphicsRenderer* rend = wxGraphicsRenderer::GetCairoRenderer();
+    REQUIRE(rend);
+
+    wxBitmap bmp(s_dcSize);
+    {
+        wxMemoryDC dc(bmp);
+        dc.SetBackground(wxBrush(s_bgColour, wxBRUSHSTYLE_SOLID));
+        dc.Clear();
+        wxScopedPtr<wxGraphicsContext> gc(rend->CreateContext(dc));
+        REQUIRE(gc.get());
+        gc->SetAntialiasMode(wxANTIALIAS_NONE);
+        gc->DisableOffset();
+
+        gc->Clip(s_cullingClip.x, s_cullingClip.y,
+                 s_cullingClip.width, s_cullingClip.height);
+        ClearGC(gc.get());
+
+        // Unbounded composition modes affect the destination outside of the
+        // shape too, so drawing it can't be skipped even if it's invisible.
+        gc->SetCompositionMode(wxCOMPOSITION_IN);
+        gc->SetBrush(wxBrush(s_tmpColour, wxBRUSHSTYLE_SOLID));
+        gc->DrawRectangle(70, 80, 20, 20);
+    }
+
+    const wxImage img = bmp.ConvertToImage();
+    CHECK( img.GetGreen(40, 40) != s_fgColour.Green() );
+    CHECK( img.GetGreen(10, 10) == s_bgColour.Green() );
+}
+#endif // wxUSE_IMAGE
 #endif // wxUSE_GRAPHICS_CAIRO
 
 #endif // wxUSE_GRAPHICS_CONTEXT
@@ -0,0 +1,192 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        tests/graphics/displaylist.cpp
+// Purpose:     wxGraphicsDisplayList unit tests
+// Created:     2026-10-17
+// Copyright:   (c) 2026 wxWidgets development team
+///////////////////////////////////////////////////////////////////////////////
+
+// ----------------------------------------------------------------------------
+// headers
+// ----------------------------------------------------------------------------
+
+#include "testprec.h"
+
+
+#if wxUSE_GRAPHICS_CONTEXT
+
+#include "wx/brush.h"
+#include "wx/font.h"
+#include "wx/graphics.h"
+#include "wx/image.h"
+#include "wx/math.h"
+#include "wx/pen.h"
+
+#include <memory>
+
+namespace
+{
+
+// Draw some shapes using different transformations and states.
+//
+// Only the primitive functions are used as the convenience ones may be
+// implemented differently by the native contexts, while the recording context
+// always records them as paths.
+void DrawScene(wxGraphicsContext& gc)
+{
+    wxGraphicsPath rect = gc.CreatePath();
+    rect.AddRectangle(10, 10, 30, 20);
+    gc.SetBrush(*wxRED_BRUSH);
+    gc.SetPen(wxPen(*wxBLUE, 3));
+    gc.FillPath(rect);
+    gc.StrokePath(rect);
+
+    gc.PushState();
+    gc.Translate(50, 50);
+    gc.Rotate(M_PI / 6);
+    wxGraphicsPath ellipse = gc.CreatePath();
+    ellipse.AddEllipse(0, 0, 40, 20);
+    gc.SetBrush(*wxGREEN_BRUSH);
+    gc.FillPath(ellipse);
+    gc.PopState();
+
+    gc.SetTransform(gc.CreateMatrix(1, 0, 0, 2, 60, 0));
+    wxGraphicsPath line = gc.CreatePath();
+    line.MoveToPoint(0, 5);
+    line.AddLineToPoint(30, 5);
+    gc.StrokePath(line);
+}
+
+wxImage CreateWhiteImage()
+{
+    wxImage image(100, 100);
+    image.SetRGB(wxRect(0, 0, 100, 100), 0xff, 0xff, 0xff);
+    return image;
+}
+
+bool AreImagesSame(const wxImage& image1, const wxImage& image2)
+{
+    return memcmp(image1.GetData(), image2.GetData(),
+                  3*image1.GetWidth()*image1.GetHeight()) == 0;
+}
+
+} // anonymous namespace
+
+TEST_CASE("GraphicsDisplayList::Replay", "[graphics][displaylist]")
+{
+    wxGraphicsDisplayList list;
+    CHECK( list.IsEmpty() );
+
+    {
+        std::unique_ptr<wxGraphicsContext> gc(list.CreateRecordingContext(100, 100));
+        REQUIRE( gc );
+        DrawScene(*gc);
+    }
+
+    CHECK( !list.IsEmpty() );
+    CHECK( list.GetCount() > 0 );
+
+    wxImage expected = CreateWhiteImage();
+    {
+        std::unique_ptr<wxGraphicsContext> gc(wxGraphicsContext::Create(expected));
+        REQUIRE( gc );
+        DrawScene(*gc);
+    }
+
+    wxImage actual = CreateWhiteImage();
+    {
+        std::unique_ptr<wxGraphicsContext> gc(wxGraphicsContext::Create(actual));
+        REQUIRE( gc );
+        list.Replay(*gc);
+    }
+
+    CHECK( AreImagesSame(actual, expected) );
+
+    SECTION("Translated")
+    {
+        wxImage translated = CreateWhiteImage();
+        {
+            std::unique_ptr<wxGraphicsContext> gc(wxGraphicsContext::Create(translated));
+            REQUIRE( gc );
+            gc->Translate(10, 0);
+            list.Replay(*gc);
+
+            // The state of the context must have been restored.
+            wxDouble tx, ty;
+            gc->GetTransform().Get(NULL, NULL, NULL, NULL, &tx, &ty);
+            CHECK( tx == 10 );
+            CHECK( ty == 0 );
+        }
+
+        // The first rectangle is now at (20, 10).
+        CHECK( translated.GetRed(25, 20) == 0xff );
+        CHECK( translated.GetGreen(25, 20) == 0 );
+        CHECK( translated.GetRed(15, 20) == 0xff );
+        CHECK( translated.GetGreen(15, 20) == 0xff );
+    }
+
+    SECTION("Clear")
+    {
+        list.Clear();
+        CHECK( list.IsEmpty() );
+        CHECK( list.GetCount() == 0 );
+    }
+}
+
+TEST_CASE("GraphicsDisplayList::Partial", "[graphics][displaylist]")
+{
+    wxGraphicsDisplayList list;
+    {
+        std::unique_ptr<wxGraphicsContext> gc(list.CreateRecordingContext());
+        REQUIRE( gc );
+        gc->SetPen(wxNullGraphicsPen);
+        gc->SetBrush(*wxBLACK_BRUSH);
+
+        wxGraphicsPath path = gc->CreatePath();
+        path.AddRectangle(10, 10, 20, 20);
+        gc->FillPath(path);
+
+        path = gc->CreatePath();
+        path.AddRectangle(70, 70, 20, 20);
+        gc->FillPath(path);
+    }
+
+    const wxRect2DDouble box = list.GetBoundingBox();
+    CHECK( box.m_x <= 10 );
+    CHECK( box.m_y <= 10 );
+    CHECK( box.GetRight() >= 90 );
+    CHECK( box.GetBottom() >= 90 );
+
+    wxImage image = CreateWhiteImage();
+    {
+        std::unique_ptr<wxGraphicsContext> gc(wxGraphicsContext::Create(image));
+        REQUIRE( gc );
+        list.Replay(*gc, wxRect2DDouble(0, 0, 50, 50));
+    }
+
+    CHECK( image.GetRed(20, 20) == 0 );
+    CHECK( image.GetRed(80, 80) == 0xff );
+}
+
+TEST_CASE("GraphicsDisplayList::PartialText", "[graphics][displaylist]")
+{
+    wxGraphicsDisplayList list;
+    {
+        std::unique_ptr<wxGraphicsContext> gc(list.CreateRecordingContext());
+        REQUIRE( gc );
+        gc->SetFont(*wxNORMAL_FONT, *wxBLACK);
+        gc->DrawText("WWW", 10, 10);
+    }
+
+    // The text must be drawn when replaying any area overlapping it, whether
+    // its extent could be determined when recording or not.
+    wxImage image = CreateWhiteImage();
+    {
+        std::unique_ptr<wxGraphicsContext> gc(wxGraphicsContext::Create(image));
+        REQUIRE( gc );
+        list.Replay(*gc, wxRect2DDouble(12, 12, 4, 4));
+    }
+
+    CHECK( !AreImagesSame(image, CreateWhiteImage()) );
+}
+
+#endif // wxUSE_GRAPHICS_CONTEXT
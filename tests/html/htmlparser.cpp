@@ -41,6 +41,111 @@ TEST_CASE("wxHtmlParser::ParseInvalid", "[html][parser][error]")
     delete p.Parse("<!---");
 }
 
+TEST_CASE("wxHtmlParser::ParseChunk", "[html][parser]")
+{
+    // Parser producing just the text of the document.
+    class TextParser : public wxHtmlParser
+    {
+    public:
+        class Product : public wxObject
+        {
+        public:
+            explicit Product(const wxString& text) : m_text(text) { }
+
+            const wxString m_text;
+        };
+
+        virtual wxObject* GetProduct() override
+        {
+            Product* const product = new Product(m_text);
+            m_text.clear();
+            return product;
+        }
+
+    protected:
+        virtual void AddText(const wxString& txt) override { m_text += txt; }
+
+    private:
+        wxString m_text;
+    };
+
+    class NullHandler : public wxHtmlTagHandler
+    {
+    public:
+        virtual wxString GetSupportedTags() override { return "P"; }
+        virtual bool HandleTag(const wxHtmlTag& WXUNUSED(tag)) override
+            { return false; }
+    };
+
+    TextParser p;
+    p.AddTagHandler(new NullHandler);
+
+    wxString doc;
+    for ( int n = 0; n < 10000; n++ )
+        doc += wxString::Format("<p>Line %d</p>\n", n);
+
+    wxScopedPtr<wxObject> product(p.Parse(doc));
+    const wxString text = static_cast<TextParser::Product*>(product.get())->m_text;
+
+    int partial = 0;
+    p.BeginIncrementalParsing();
+    for ( size_t pos = 0; pos < doc.length(); pos += 1000 )
+    {
+        product.reset(p.ParseChunk(doc.substr(pos, 1000)));
+        if ( product )
+        {
+            partial++;
+
+            const wxString&
+                textPartial = static_cast<TextParser::Product*>(product.get())->m_text;
+            CHECK( textPartial.length() < text.length() );
+            CHECK( text.StartsWith(textPartial) );
+        }
+    }
+
+    CHECK( partial > 0 );
+
+    product.reset(p.EndIncrementalParsing());
+    CHECK( static_cast<TextParser::Product*>(product.get())->m_text == text );
+
+    // The document must not be cut inside comments or scripts, even if they
+    // contain ">".
+    doc.clear();
+    for ( int n = 0; n < 5000; n++ )
+        doc += wxString::Format("<p>Line %d</p>\n", n);
+    doc += "<!--";
+    for ( int n = 0; n < 10000; n++ )
+        doc += "a -> b\n";
+    doc += "-->\n";
+    for ( int n = 0; n < 5000; n++ )
+        doc += wxString::Format("<p>Line %d</p>\n", n);
+    doc += "<script>";
+    for ( int n = 0; n < 20000; n++ )
+        doc += "if (a > b) a--;\n";
+    doc += "</script>\n";
+    for ( int n = 0; n < 5000; n++ )
+        doc += wxString::Format("<p>Line %d</p>\n", n);
+
+    partial = 0;
+    p.BeginIncrementalParsing();
+    for ( size_t pos = 0; pos < doc.length(); pos += 1000 )
+    {
+        product.reset(p.ParseChunk(doc.substr(pos, 1000)));
+        if ( product )
+        {
+            partial++;
+
+            const wxString& source = *p.GetSource();
+            CHECK( source.Contains("<!--") == source.Contains("-->") );
+            CHECK( source.Contains("<script>") == source.Contains("</script>") );
+        }
+    }
+
+    CHECK( partial > 2 );
+
+    CHECK( p.CancelIncrementalParsing() == doc );
+}
+
 TEST_CASE("wxHtmlCell::Detach", "[html][cell]")
 {
     wxMemoryDC dc;
@@ -101,4 +206,124 @@ TEST_CASE("wxHtmlCell::Detach", "[html][cell]")
     }
 }
 
+// Check that FindCellByPos() finds all the cells of a long page, as it uses the
+// index built by Layout() for the containers with many children.
+static void CheckFindCellByPos(const wxHtmlContainerCell* top)
+{
+    int count = 0;
+    for ( wxHtmlTerminalCellsInterator i(top->GetFirstTerminal(),
+                                         top->GetLastTerminal()); i; ++i )
+    {
+        if ( !i->GetWidth() || !i->GetHeight() )
+            continue;
+
+        const wxPoint pos = i->GetAbsPos(top);
+        INFO("Cell " << count << " at " << pos.x << ", " << pos.y);
+        CHECK( top->FindCellByPos(pos.x, pos.y) == *i );
+
+        count++;
+    }
+
+    CHECK( count > 100 );
+}
+
+TEST_CASE("wxHtmlContainerCell::FindCellByPos", "[html][cell]")
+{
+    wxMemoryDC dc;
+
+    wxString html;
+    for ( int n = 0; n < 100; n++ )
+        html += wxString::Format("<p>Paragraph %d<br>with <b>several</b> words</p>", n);
+
+    wxHtmlWinParser p;
+    p.SetDC(&dc);
+
+    wxScopedPtr<wxHtmlContainerCell> const
+        top(static_cast<wxHtmlContainerCell*>(p.Parse(html)));
+    REQUIRE( top );
+
+    top->Layout(200);
+    CheckFindCellByPos(top.get());
+
+    SECTION("relayout")
+    {
+        top->Layout(100);
+        CheckFindCellByPos(top.get());
+    }
+
+    SECTION("insert")
+    {
+        wxHtmlContainerCell* const cont = new wxHtmlContainerCell(top.get());
+        cont->InsertCell(new wxHtmlWordCell("Appended", dc));
+
+        top->Layout(200);
+        CheckFindCellByPos(top.get());
+
+        const wxPoint pos = cont->GetFirstChild()->GetAbsPos(top.get());
+        CHECK( top->FindCellByPos(pos.x, pos.y) == cont->GetFirstChild() );
+    }
+}
+
+TEST_CASE("wxHtmlTextExtentCache", "[html][cell]")
+{
+    wxMemoryDC dc;
+    dc.SetFont(*wxNORMAL_FONT);
+
+    wxHtmlTextExtentCache cache(2);
+    cache.UseDC(dc);
+
+    wxCoord w, h, d;
+    dc.GetTextExtent("Hello", &w, &h, &d);
+
+    wxCoord cw, ch, cd;
+    cache.GetTextExtent(dc, "Hello", &cw, &ch, &cd);
+    CHECK( cache.GetMissCount() == 1 );
+    CHECK( cache.GetHitCount() == 0 );
+
+    cache.GetTextExtent(dc, "Hello", &cw, &ch, &cd);
+    CHECK( cache.GetMissCount() == 1 );
+    CHECK( cache.GetHitCount() == 1 );
+    CHECK( cw == w );
+    CHECK( ch == h );
+    CHECK( cd == d );
+
+    // Using a different font must not reuse the extent of the same string.
+    dc.SetFont(*wxITALIC_FONT);
+    cache.GetTextExtent(dc, "Hello", &cw, &ch);
+    CHECK( cache.GetMissCount() == 2 );
+
+    // Only 2 strings per font are kept, so "Hello" gets evicted here.
+    dc.SetFont(*wxNORMAL_FONT);
+    cache.GetTextExtent(dc, "world", &cw, &ch);
+    cache.GetTextExtent(dc, "!", &cw, &ch);
+    cache.GetTextExtent(dc, "world", &cw, &ch);
+    CHECK( cache.GetMissCount() == 4 );
+    CHECK( cache.GetHitCount() == 2 );
+
+    cache.GetTextExtent(dc, "Hello", &cw, &ch);
+    CHECK( cache.GetMissCount() == 5 );
+
+    cache.ResetCounters();
+    cache.Clear();
+    cache.GetTextExtent(dc, "Hello", &cw, &ch);
+    CHECK( cache.GetMissCount() == 1 );
+    CHECK( cache.GetHitCount() == 0 );
+
+    SECTION("parser")
+    {
+        wxHtmlWinParser p;
+        p.SetDC(&dc);
+
+        wxScopedPtr<wxObject> top(p.Parse("<p>the same the same the same</p>"));
+        REQUIRE( top );
+
+        // Words include the trailing space, so "the ", "same " and the last
+        // "same" are measured only once each, as is "H" used to get the
+        // default character size.
+        const wxHtmlTextExtentCache& parserCache = p.GetTextExtentCache();
+        CHECK( parserCache.GetMissCount() == 4 );
+        CHECK( parserCache.GetHitCount() == 3 );
+    }
+}
+
 #endif //wxUSE_HTML
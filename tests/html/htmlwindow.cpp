@@ -20,8 +20,11 @@
 #endif // WX_PRECOMP
 
 #include "wx/html/htmlwin.h"
+#include "wx/ffile.h"
+#include "wx/stopwatch.h"
 #include "wx/uiaction.h"
 #include "testableframe.h"
+#include "testfile.h"
 
 // ----------------------------------------------------------------------------
 // test class
@@ -44,6 +47,9 @@ private:
         WXUISIM_TEST( LinkClick );
 #endif // wxUSE_UIACTIONSIMULATOR
         CPPUNIT_TEST( AppendToPage );
+        CPPUNIT_TEST( SetPageAsync );
+        CPPUNIT_TEST( SetPageFromOpeningURL );
+        CPPUNIT_TEST( LoadPageIncrementally );
     CPPUNIT_TEST_SUITE_END();
 
     void SelectionToText();
@@ -51,6 +57,9 @@ private:
     void CellClick();
     void LinkClick();
     void AppendToPage();
+    void SetPageAsync();
+    void SetPageFromOpeningURL();
+    void LoadPageIncrementally();
 
     wxHtmlWindow *m_win;
 
@@ -166,4 +175,141 @@ void HtmlWindowTestCase::AppendToPage()
 #endif // wxUSE_CLIPBOARD
 }
 
+void HtmlWindowTestCase::SetPageAsync()
+{
+    EventCounter loaded(m_win, wxEVT_HTML_PAGE_LOADED);
+
+    m_win->SetPage(TEST_MARKUP_LINK);
+    CPPUNIT_ASSERT( m_win->SetPageAsync(TEST_MARKUP) );
+
+    CPPUNIT_ASSERT( loaded.WaitEvent(10000) );
+    CPPUNIT_ASSERT( !m_win->IsLoadingPageAsync() );
+    CPPUNIT_ASSERT_EQUAL( "Page", m_win->GetOpenedPageTitle() );
+#if wxUSE_CLIPBOARD
+    CPPUNIT_ASSERT_EQUAL( TEST_PLAIN_TEXT, m_win->ToText() );
+#endif // wxUSE_CLIPBOARD
+
+    // Starting loading another page asynchronously cancels the pending one.
+    loaded.Clear();
+    CPPUNIT_ASSERT( m_win->SetPageAsync(TEST_MARKUP_LINK) );
+    CPPUNIT_ASSERT( m_win->SetPageAsync(TEST_MARKUP) );
+
+    CPPUNIT_ASSERT( loaded.WaitEvent(10000) );
+    CPPUNIT_ASSERT( !m_win->IsLoadingPageAsync() );
+    CPPUNIT_ASSERT_EQUAL( "Page", m_win->GetOpenedPageTitle() );
+
+    wxYield();
+    CPPUNIT_ASSERT_EQUAL( 1, loaded.GetCount() );
+
+    // Setting another page synchronously cancels loading the pending one.
+    loaded.Clear();
+    CPPUNIT_ASSERT( m_win->SetPageAsync(TEST_MARKUP) );
+    m_win->SetPage(TEST_MARKUP_LINK);
+    CPPUNIT_ASSERT( !m_win->IsLoadingPageAsync() );
+
+    wxYield();
+    CPPUNIT_ASSERT_EQUAL( 0, loaded.GetCount() );
+    CPPUNIT_ASSERT( m_win->GetOpenedPageTitle().empty() );
+}
+
+void HtmlWindowTestCase::SetPageFromOpeningURL()
+{
+    // This window sets another page when asked to open the image URL, which
+    // happens in the main thread while the worker thread waits for it.
+    class ReloadingHtmlWindow : public wxHtmlWindow
+    {
+    public:
+        ReloadingHtmlWindow()
+            : wxHtmlWindow(wxTheApp->GetTopWindow(), wxID_ANY,
+                           wxDefaultPosition, wxSize(400, 200)),
+              m_reloaded(false)
+        {
+        }
+
+        bool IsReloaded() const { return m_reloaded; }
+
+        virtual wxHtmlOpeningStatus
+        OnOpeningURL(wxHtmlURLType WXUNUSED(type),
+                     const wxString& WXUNUSED(url),
+                     wxString *WXUNUSED(redirect)) const override
+        {
+            if ( !m_reloaded )
+            {
+                m_reloaded = true;
+                const_cast<ReloadingHtmlWindow*>(this)->SetPage(TEST_MARKUP);
+            }
+
+            return wxHTML_BLOCK;
+        }
+
+    private:
+        mutable bool m_reloaded;
+    };
+
+    ReloadingHtmlWindow* const win = new ReloadingHtmlWindow;
+    EventCounter loaded(win, wxEVT_HTML_PAGE_LOADED);
+
+    CPPUNIT_ASSERT( win->SetPageAsync("<html><body><img src=\"x.png\"></body></html>") );
+
+    // Setting the page cancels the asynchronous loading, which must neither
+    // deadlock nor crash.
+    wxStopWatch sw;
+    while ( win->IsLoadingPageAsync() && sw.Time() < 10000 )
+        wxYield();
+
+    CPPUNIT_ASSERT( win->IsReloaded() );
+    CPPUNIT_ASSERT( !win->IsLoadingPageAsync() );
+    CPPUNIT_ASSERT_EQUAL( "Page", win->GetOpenedPageTitle() );
+
+    wxYield();
+    CPPUNIT_ASSERT_EQUAL( 0, loaded.GetCount() );
+
+    DeleteTestWindow(win);
+}
+
+void HtmlWindowTestCase::LoadPageIncrementally()
+{
+    // This window records the pages passed to SetPage().
+    class RecordingHtmlWindow : public wxHtmlWindow
+    {
+    public:
+        RecordingHtmlWindow()
+            : wxHtmlWindow(wxTheApp->GetTopWindow(), wxID_ANY,
+                           wxDefaultPosition, wxSize(400, 200))
+        {
+        }
+
+        const wxArrayString& GetPages() const { return m_pages; }
+
+        virtual bool SetPage(const wxString& source) override
+        {
+            m_pages.push_back(source);
+            return wxHtmlWindow::SetPage(source);
+        }
+
+    private:
+        wxArrayString m_pages;
+    };
+
+    // Use a page big enough to be shown before it's fully loaded.
+    wxString page = "<html><head><title>Page</title></head><body>";
+    for ( int n = 0; n < 10000; n++ )
+        page += wxString::Format("<p>Line %d</p>\n", n);
+    page += "</body></html>";
+
+    TempFile file("htmlwintest.html");
+    CPPUNIT_ASSERT( wxFFile(file.GetName(), "wb").Write(page) );
+
+    RecordingHtmlWindow* const win = new RecordingHtmlWindow;
+    CPPUNIT_ASSERT( !win->IsIncrementalLoadingEnabled() );
+    win->EnableIncrementalLoading();
+
+    CPPUNIT_ASSERT( win->LoadPage(file.GetName()) );
+    CPPUNIT_ASSERT_EQUAL( 1, win->GetPages().size() );
+    CPPUNIT_ASSERT( win->GetPages()[0] == page );
+    CPPUNIT_ASSERT_EQUAL( "Page", win->GetOpenedPageTitle() );
+
+    DeleteTestWindow(win);
+}
+
 #endif //wxUSE_HTML
@@ -32,6 +32,7 @@
 #include "wx/clipbrd.h"
 #include "wx/dataobj.h"
 #include "wx/scopedptr.h"
+#include "wx/sysopt.h"
 
 #include "testimage.h"
 
@@ -2333,6 +2334,92 @@ TEST_CASE("wxImage::SizeLimits", "[image]")
 #endif // SIZEOF_VOID_P == 8
 }
 
+TEST_CASE("wxImage::ScaleThreads", "[image]")
+{
+    // Use an image big enough for using several threads.
+    wxImage image(1031, 777);
+    image.SetAlpha();
+
+    unsigned char* data = image.GetData();
+    unsigned char* alpha = image.GetAlpha();
+    for ( int n = 0; n < image.GetWidth()*image.GetHeight(); n++ )
+    {
+        *data++ = n % 251;
+        *data++ = n % 241;
+        *data++ = n % 239;
+        *alpha++ = n % 233;
+    }
+
+    const wxImageResizeQuality qualities[] =
+    {
+        wxIMAGE_QUALITY_BILINEAR,
+        wxIMAGE_QUALITY_BICUBIC,
+        wxIMAGE_QUALITY_BOX_AVERAGE,
+    };
+
+    for ( size_t n = 0; n < WXSIZEOF(qualities); n++ )
+    {
+        INFO("Quality " << qualities[n]);
+
+        wxSystemOptions::SetOption("image.resample-threads", 0);
+        const wxImage expectedSmall = image.Scale(300, 200, qualities[n]);
+        const wxImage expectedBig = image.Scale(2000, 1500, qualities[n]);
+
+        wxSystemOptions::SetOption("image.resample-threads", 4);
+        CHECK_THAT( image.Scale(300, 200, qualities[n]),
+                    RGBASameAs(expectedSmall) );
+        CHECK_THAT( image.Scale(2000, 1500, qualities[n]),
+                    RGBASameAs(expectedBig) );
+    }
+
+    wxSystemOptions::SetOption("image.resample-threads", 0);
+}
+
+TEST_CASE("wxImage::GaussianBlur", "[image]")
+{
+    wxImage image(40, 30);
+    image.SetAlpha();
+    memset(image.GetData(), 77, 40*30*3);
+    memset(image.GetAlpha(), 200, 40*30);
+
+    SECTION("Uniform")
+    {
+        // Blurring an image of a single colour must not change it, whatever
+        // the blur radius is.
+        CHECK_THAT( image.GaussianBlur(0), RGBASameAs(image) );
+        CHECK_THAT( image.GaussianBlur(2.5), RGBASameAs(image) );
+        CHECK_THAT( image.GaussianBlur(1000), RGBASameAs(image) );
+        CHECK_THAT( image.GaussianBlur(1e10), RGBASameAs(image) );
+        CHECK_THAT( image.Blur(1000), RGBASameAs(image) );
+    }
+
+    SECTION("Square")
+    {
+        for ( int y = 13; y <= 17; y++ )
+        {
+            for ( int x = 18; x <= 22; x++ )
+                image.SetRGB(x, y, 255, 0, 0);
+        }
+
+        const wxImage blurred = image.GaussianBlur(3);
+        REQUIRE( blurred.IsOk() );
+
+        // The blur must be symmetric and decreasing from the centre.
+        for ( int d = 1; d < 10; d++ )
+        {
+            INFO("Distance " << d);
+            CHECK( blurred.GetRed(20 - d, 15) == blurred.GetRed(20 + d, 15) );
+            CHECK( blurred.GetRed(20, 15 - d) == blurred.GetRed(20, 15 + d) );
+            CHECK( blurred.GetRed(20 + d, 15) <= blurred.GetRed(20 + d - 1, 15) );
+        }
+
+        CHECK( blurred.GetRed(20, 15) > blurred.GetRed(20, 18) );
+        CHECK( blurred.GetRed(20, 18) > 77 );
+        CHECK( blurred.GetRed(0, 0) == 77 );
+        CHECK( blurred.GetAlpha(20, 15) == 200 );
+    }
+}
+
 // This can be used to test loading an arbitrary image file by setting the
 // environment variable WX_TEST_IMAGE_PATH to point to it.
 TEST_CASE("wxImage::LoadPath", "[.]")
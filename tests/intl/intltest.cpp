@@ -19,6 +19,9 @@
 
 #include "wx/intl.h"
 #include "wx/uilocale.h"
+#include "wx/sysopt.h"
+#include "wx/translation.h"
+#include "wx/file.h"
 
 #include "wx/private/glibc.h"
 
@@ -40,6 +43,7 @@ private:
     CPPUNIT_TEST_SUITE( IntlTestCase );
         CPPUNIT_TEST( RestoreLocale );
         CPPUNIT_TEST( Domain );
+        CPPUNIT_TEST( CachedTranslation );
         CPPUNIT_TEST( Headers );
         CPPUNIT_TEST( DateTimeFmtFrench );
         CPPUNIT_TEST( IsAvailable );
@@ -47,6 +51,7 @@ private:
 
     void RestoreLocale();
     void Domain();
+    void CachedTranslation();
     void Headers();
     void DateTimeFmtFrench();
     void IsAvailable();
@@ -130,6 +135,34 @@ void IntlTestCase::Domain()
     CPPUNIT_ASSERT_EQUAL( "&Open bogus file", wxGetTranslation("&Open bogus file", "BogusDomain") );
 }
 
+// Use a function to ensure that the same literal is used in all calls.
+static const wxString& GetCachedOpenTranslation()
+{
+    return wxGETTEXT_CACHED("&Open bogus file");
+}
+
+void IntlTestCase::CachedTranslation()
+{
+    if (!m_locale)
+        return;
+
+    CPPUNIT_ASSERT_EQUAL( "&Ouvrir un fichier", GetCachedOpenTranslation() );
+
+    // the same string should be returned when using the cache
+    CPPUNIT_ASSERT( &GetCachedOpenTranslation() == &GetCachedOpenTranslation() );
+
+    CPPUNIT_ASSERT_EQUAL( "Not translated", wxGETTEXT_CACHED("Not translated") );
+    CPPUNIT_ASSERT_EQUAL( "&Open bogus file",
+                          wxGETTEXT_IN_CONTEXT_CACHED("Bogus", "&Open bogus file") );
+
+    // the cached translation must not be used any more after the catalogs
+    // are unloaded
+    delete m_locale;
+    m_locale = NULL;
+
+    CPPUNIT_ASSERT_EQUAL( "&Open bogus file", GetCachedOpenTranslation() );
+}
+
 void IntlTestCase::Headers()
 {
     if ( !m_locale )
@@ -246,6 +279,88 @@ TEST_CASE("wxLocale::Default", "[locale]")
     REQUIRE( loc.Init(wxLANGUAGE_DEFAULT, wxLOCALE_DONT_LOAD_DEFAULT) );
 }
 
+#if wxUSE_SYSTEM_OPTIONS
+
+// Return the translation of the given string or "(null)" if there is none.
+static wxString GetCatalogString(const wxMsgCatalog& cat,
+                                 const wxString& str,
+                                 unsigned n = UINT_MAX)
+{
+    const wxString* const trans = cat.GetString(str, n);
+    return trans ? *trans : wxString("(null)");
+}
+
+TEST_CASE("wxMsgCatalog::Lazy", "[translations]")
+{
+    // Load the same catalog in both the normal and lazy modes and check that
+    // the results are identical.
+    wxScopedPtr<wxMsgCatalog> cats[2];
+    for ( int lazy = 0; lazy < 2; lazy++ )
+    {
+        wxSystemOptions::SetOption("intl.lazy-catalogs", lazy);
+        cats[lazy].reset(wxMsgCatalog::CreateFromFile("./intl/fr/internat.mo",
+                                                      "internat"));
+        REQUIRE( cats[lazy] );
+    }
+    wxSystemOptions::SetOption("intl.lazy-catalogs", 0);
+
+    const char* const strings[] =
+    {
+        "",
+        "&Open bogus file",
+        "&File",
+        "Bad luck! try again...",
+        "&Open",
+        "Not in the catalog",
+    };
+
+    for ( size_t i = 0; i < WXSIZEOF(strings); i++ )
+    {
+        INFO("String \"" << strings[i] << "\"");
+
+        // Do it twice to check that the cached values are returned correctly.
+        for ( int n = 0; n < 2; n++ )
+        {
+            CHECK( GetCatalogString(*cats[1], strings[i]) ==
+                        GetCatalogString(*cats[0], strings[i]) );
+            CHECK( GetCatalogString(*cats[1], strings[i], 1) ==
+                        GetCatalogString(*cats[0], strings[i], 1) );
+        }
+    }
+
+    CHECK( GetCatalogString(*cats[1], "&Open bogus file") == "&Ouvrir un fichier" );
+    CHECK( GetCatalogString(*cats[1], "Not in the catalog") == "(null)" );
+    CHECK( GetCatalogString(*cats[1], "").Contains("Vadim Zeitlin") );
+}
+
+TEST_CASE("wxMsgCatalog::LazyFromData", "[translations]")
+{
+    wxFile file("./intl/fr/internat.mo");
+    REQUIRE( file.IsOpened() );
+
+    const size_t len = static_cast<size_t>(file.Length());
+    wxCharBuffer buf(len);
+    REQUIRE( file.Read(buf.data(), len) == static_cast<ssize_t>(len) );
+
+    wxSystemOptions::SetOption("intl.lazy-catalogs", 1);
+    wxScopedPtr<wxMsgCatalog>
+        cat(wxMsgCatalog::CreateFromData
+            (
+                wxScopedCharBuffer::CreateNonOwned(buf.data(), len),
+                "internat"
+            ));
+    wxSystemOptions::SetOption("intl.lazy-catalogs", 0);
+    REQUIRE( cat );
+
+    // The non-owned data is only valid during CreateFromData() call, so the
+    // catalog must not use it any more after it returns.
+    memset(buf.data(), 0, len);
+
+    CHECK( GetCatalogString(*cat, "&Open bogus file") == "&Ouvrir un fichier" );
+}
+
+#endif // wxUSE_SYSTEM_OPTIONS
+
 #endif // wxUSE_UNICODE
 
 // Under MSW and macOS all the locales used below should be supported, but
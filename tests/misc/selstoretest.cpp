@@ -166,3 +166,44 @@ TEST_CASE_METHOD(SelStoreTest, "wxSelectionStore::InsertInSelected", "[selstore]
     CHECK( !m_store.IsSelected(3) );
     CHECK( m_store.GetSelectedCount() == NUM_ITEMS );
 }
+
+TEST_CASE("wxSelectionStore::Huge", "[selstore]")
+{
+    // This would take a lot of time and memory if the individual selected
+    // items were stored.
+    const unsigned count = 10000000;
+
+    wxSelectionStore store;
+    store.SetItemCount(count);
+
+    store.SelectRange(0, count - 1);
+    CHECK( store.GetSelectedCount() == count );
+
+    CHECK( store.SelectItem(1, false) );
+    CHECK( store.SelectItem(count / 2, false) );
+    CHECK( !store.SelectItem(count / 2, false) );
+    CHECK( store.GetSelectedCount() == count - 2 );
+    CHECK( !store.IsSelected(1) );
+    CHECK( store.IsSelected(2) );
+
+    wxSelectionStore::IterationState cookie;
+    CHECK( store.GetFirstSelectedItem(cookie) == 0 );
+    CHECK( store.GetNextSelectedItem(cookie) == 2 );
+
+    // Selecting the item back must merge it with its neighbours.
+    CHECK( store.SelectItem(count / 2) );
+    CHECK( store.IsSelected(count / 2) );
+
+    // Unselecting all items changes too many of them to return them.
+    wxArrayInt changed;
+    CHECK( !store.SelectRange(0, count - 1, false, &changed) );
+    CHECK( store.IsEmpty() );
+
+    // But not when only a few of them are selected.
+    store.SelectItem(10);
+    store.SelectItem(count - 1);
+    CHECK( store.SelectRange(0, count - 1, false, &changed) );
+    REQUIRE( changed.size() == 2 );
+    CHECK( changed[0] == 10 );
+    CHECK( changed[1] == static_cast<int>(count - 1) );
+}
@@ -196,6 +196,153 @@ TEST_CASE("wxRegEx::Unicode", "[regex][unicode]")
     CHECK( re.GetMatch(cyrillicSmallA) == cyrillicSmallA );
 }
 
+TEST_CASE("wxRegEx::JIT", "[regex][jit]")
+{
+    // JIT compilation may be unavailable, but the results must be the same.
+    wxRegEx re("([a-z]+)([0-9]+)", wxRE_JIT);
+    REQUIRE( re.IsValid() );
+
+    const wxString text("foo123 bar");
+    REQUIRE( re.Matches(text) );
+    CHECK( re.GetMatch(text) == "foo123" );
+    CHECK( re.GetMatch(text, 1) == "foo" );
+    CHECK( re.GetMatch(text, 2) == "123" );
+
+    CHECK_FALSE( re.Matches("bar") );
+}
+
+TEST_CASE("wxRegEx::MatchesUTF8", "[regex][unicode]")
+{
+    wxRegEx re(wxString::FromUTF8("(\xc3\xa9+)z"));
+    REQUIRE( re.IsValid() );
+
+    // The offsets are in bytes, whatever the build.
+    const char* const text = "a\xc3\xa9\xc3\xa9z\xf0\x9f\x98\x80z";
+    REQUIRE( re.MatchesUTF8(text, strlen(text)) );
+
+    size_t start, len;
+    REQUIRE( re.GetMatch(&start, &len) );
+    CHECK( start == 1 );
+    CHECK( len == 5 );
+
+    REQUIRE( re.GetMatch(&start, &len, 1) );
+    CHECK( start == 1 );
+    CHECK( len == 4 );
+
+    wxRegEx reEnd("z$");
+    REQUIRE( reEnd.MatchesUTF8(text, strlen(text)) );
+    REQUIRE( reEnd.GetMatch(&start, &len) );
+    CHECK( start == 10 );
+
+    // Only the given length must be used.
+    CHECK_FALSE( reEnd.MatchesUTF8(text, 5) );
+}
+
+static wxString GetAllMatches(const char* pattern, const wxString& text)
+{
+    wxRegEx re(pattern);
+
+    wxString matches;
+    wxRegExMatchIterator it = re.GetMatchAll(text);
+    while ( it.Next() )
+    {
+        size_t start, len;
+        REQUIRE( it.GetMatch(&start, &len) );
+
+        matches += wxString::Format("%zu:%s,", start, it.GetMatch());
+    }
+
+    CHECK_FALSE( it.Next() );
+
+    return matches;
+}
+
+TEST_CASE("wxRegEx::GetMatchAll", "[regex][match]")
+{
+    CHECK( GetAllMatches("[0-9]+", "no digits") == "" );
+    CHECK( GetAllMatches("[0-9]+", "a1b22c333") == "1:1,3:22,6:333," );
+
+    // "^" must match only at the start of the text.
+    CHECK( GetAllMatches("^a", "aaa") == "0:a," );
+
+    // Lookbehind must see the text before the current position.
+    CHECK( GetAllMatches("(?<=a)b", "abab") == "1:b,3:b," );
+
+    // Empty matches must not result in an infinite loop.
+    CHECK( GetAllMatches("x*", "axxb") == "0:,1:xx,3:,4:," );
+}
+
+static wxString GetSetMatches(const wxRegExSet& set,
+                              const wxString& text,
+                              int flags = 0)
+{
+    wxArrayInt indices;
+    const bool matched = set.Matches(text, &indices, flags);
+    CHECK( matched == !indices.empty() );
+    CHECK( set.Matches(text, NULL, flags) == matched );
+
+    wxString s;
+    for ( size_t n = 0; n < indices.size(); ++n )
+        s += wxString::Format("%d,", indices[n]);
+
+    return s;
+}
+
+TEST_CASE("wxRegExSet", "[regex][set]")
+{
+    wxRegExSet set;
+    CHECK( set.GetCount() == 0 );
+    CHECK( GetSetMatches(set, "foo") == "" );
+
+    CHECK( set.Add("foo") == 0 );
+    CHECK( set.Add("ba+r", wxRE_ICASE) == 1 );
+    CHECK( set.Add("(a)\\1") == 2 ); // Can't be combined with the others.
+    CHECK( set.Add("^x") == 3 );
+    CHECK( set.Add("end$", wxRE_NEWLINE) == 4 );
+    CHECK( set.Add("(?<=q)w") == 5 );
+    CHECK( set.Add("a*") == 6 );
+
+    {
+        wxLogNull noLog;
+        CHECK( set.Add("foo(") == wxNOT_FOUND );
+    }
+
+    CHECK( set.GetCount() == 7 );
+
+    CHECK( GetSetMatches(set, "xfoo BAAR aa") == "0,1,2,3,6," );
+    CHECK( GetSetMatches(set, "end\nqw") == "4,5,6," );
+    CHECK( GetSetMatches(set, "xyz", wxRE_NOTBOL | wxRE_NOTEMPTY) == "" );
+
+    set.Clear();
+    CHECK( set.GetCount() == 0 );
+
+    CHECK( set.Add("b", wxRE_JIT) == 0 );
+    CHECK( GetSetMatches(set, "abc") == "0," );
+
+    // Callouts must not make the pattern match if the rest of it doesn't.
+    CHECK( set.Add("x(?C1)y") == 1 );
+    CHECK( GetSetMatches(set, "xz") == "" );
+    CHECK( GetSetMatches(set, "xy") == "1," );
+
+    // Patterns which can match long strings must still be found correctly,
+    // whether they can only match at the start or not.
+    set.Clear();
+    CHECK( set.Add("a.*z") == 0 );
+    CHECK( set.Add(".*foo") == 1 );
+    CHECK( set.Add("q$") == 2 );
+    CHECK( set.Add("x.*y", wxRE_ICASE) == 3 );
+    CHECK( set.Add("^.*bar", wxRE_NEWLINE) == 4 );
+
+    const wxString aaa('a', 10000);
+    CHECK( GetSetMatches(set, aaa) == "" );
+    CHECK( GetSetMatches(set, aaa + "z") == "0," );
+    CHECK( GetSetMatches(set, "z" + aaa) == "" );
+    CHECK( GetSetMatches(set, "z" + aaa + "fooq") == "1,2," );
+    CHECK( GetSetMatches(set, aaa + "X" + aaa + "Y") == "3," );
+    CHECK( GetSetMatches(set, "zX" + aaa + "\nbar") == "4," );
+    CHECK( GetSetMatches(set, "zX" + aaa + "\nbar", wxRE_NOTBOL) == "4," );
+}
+
 // This pseudo test can be used just to see the version of PCRE being used.
 TEST_CASE("wxRegEx::GetLibraryVersionInfo", "[.]")
 {